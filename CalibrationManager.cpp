@@ -1,7 +1,7 @@
 #include "CalibrationManager.h"
-#include "client.h"
+#include <QDebug>
 
-CalibrationManager::CalibrationManager(Client *pClient,
+CalibrationManager::CalibrationManager(CalibrationDataSource *pClient,
                                        QObject *parent) :
     m_pClient(pClient),
     QObject(parent),
@@ -4,6 +4,7 @@
 #include <QObject>
 #include <QTimer>
 #include <QDateTime>
+#include <QString>
 
 static const double TEMPERATURE_SETPOINT_4C_REFRIGERATOR = 4.0;
 static const double TEMPERATURE_SETPOINT_NEG_30C_FREEZER = -30.0;
@@ -27,6 +28,17 @@ enum eCalibrationStates
 };
 
 
+enum eRTDNumber
+{
+    eRTD_UNKNOWN =-1,
+    eRTD1        = 0,
+    eRTD2        = 1,
+    eRTD3        = 2,
+    eRTD4        = 3,
+    eRTD5        = 4,
+};
+
+
 struct cycleData
 {
     QDateTime dtDateTimeStart;
@@ -37,7 +49,22 @@ struct cycleData
 };
 
 
-class Client;
+// the readings calibration works from and where it sends the offsets - the Client, or the simulator's benchmark
+class CalibrationDataSource
+{
+public:
+    virtual ~CalibrationDataSource() {}
+
+    virtual void sendCalibrationRequest(eRTDNumber eRTDNum , double dRTDOffsetVal) = 0;
+
+    virtual double getFlukeTemp1() = 0;
+    virtual double getPrimaryTemp() = 0;
+    virtual double getControlTemp() = 0;
+    virtual double getPrimaryOffset() = 0;
+    virtual double getControlOffset() = 0;
+    virtual bool getCompressorState() = 0;
+    virtual QString getDeviceType() = 0;
+};
 
 
 class CalibrationManager : public QObject
@@ -45,7 +72,7 @@ class CalibrationManager : public QObject
     Q_OBJECT
 
 public:
-    CalibrationManager(Client *pClient,
+    CalibrationManager(CalibrationDataSource *pClient,
                        QObject *parent = 0);
     ~CalibrationManager();
     eCalibrationStates getCalibrationState();
@@ -62,7 +89,7 @@ public slots:
     void    slot_CompressorStateCheckTimeout();
 
 private:
-    Client* m_pClient;
+    CalibrationDataSource* m_pClient;
     QList<cycleData> m_CycleDataList;
     QTimer  m_tFifteenMinuteTimer;
     QTimer  m_tUpdateTemperatureValuesTimer;
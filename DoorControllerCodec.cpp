@@ -0,0 +1,168 @@
+#include "DoorControllerCodec.h"
+
+namespace
+{
+    struct DoorCommandDef
+    {
+        quint8       ucAddress;
+        quint8       ucState;
+        const char * pName;
+    };
+
+    // indexed by eDoorControllerCommands
+    const DoorCommandDef DOOR_COMMAND_TABLE[eDOOR_CMD_COUNT] =
+    {
+        { DOOR_ADDRESS_DOOR,  0, "Unlock Door" },
+        { DOOR_ADDRESS_DOOR,  1, "Lock Door"   },
+        { DOOR_ADDRESS_LIGHT, 0, "Light Off"   },
+        { DOOR_ADDRESS_LIGHT, 1, "Light On"    }
+    };
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+quint8 DoorControllerCodec::computeChecksum( const char * pFrame )
+{
+    quint8 ucSum = 0;
+
+    for ( int iIndex = 1; iIndex <= 6; iIndex++ )
+    {
+        ucSum += (quint8) pFrame[iIndex];
+    }
+
+    return (quint8) ~ucSum;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+QByteArray DoorControllerCodec::encodeFrame( quint8 ucAddress, quint8 ucFunction, quint8 ucState )
+{
+    char frame[DOOR_FRAME_LENGTH];
+
+    frame[0]  = (char) DOOR_FRAME_STX;
+    frame[1]  = (char) ucAddress;
+    frame[2]  = (char) ucFunction;
+    frame[3]  = (char) 0x01;
+    frame[4]  = (char) 0x00;
+    frame[5]  = (char) ~ucState;
+    frame[6]  = (char) 0xFF;
+    frame[7]  = (char) computeChecksum( frame );
+    frame[8]  = (char) DOOR_FRAME_MARKER;
+    frame[9]  = (char) ucState;
+    frame[10] = (char) DOOR_FRAME_ETX;
+
+    return QByteArray( frame, DOOR_FRAME_LENGTH );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+QByteArray DoorControllerCodec::encodeCommand( eDoorControllerCommands eCommand )
+{
+    if ( ( eCommand < 0 ) || ( eCommand >= eDOOR_CMD_COUNT ) )
+    {
+        return QByteArray();
+    }
+
+    return encodeFrame( DOOR_COMMAND_TABLE[eCommand].ucAddress, DOOR_FUNCTION_COMMAND, DOOR_COMMAND_TABLE[eCommand].ucState );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+bool DoorControllerCodec::decodeFrame( const QByteArray & baFrame, DoorControllerFrame & frame )
+{
+    if ( baFrame.size() != DOOR_FRAME_LENGTH )
+    {
+        return false;
+    }
+
+    const char * pFrame = baFrame.constData();
+
+    if ( ( (quint8) pFrame[0]  != DOOR_FRAME_STX )    ||
+         ( (quint8) pFrame[10] != DOOR_FRAME_ETX )    ||
+         ( (quint8) pFrame[8]  != DOOR_FRAME_MARKER ) ||
+         ( (quint8) pFrame[7]  != computeChecksum( pFrame ) ) )
+    {
+        return false;
+    }
+
+    frame.ucAddress  = (quint8) pFrame[1];
+    frame.ucFunction = (quint8) pFrame[2];
+    frame.ucState    = (quint8) pFrame[9];
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// Maps a decoded frame back to the command it belongs to, e.g. an ACK to the command it acknowledges.
+//-----------------------------------------------------------------------------------------------------------------
+eDoorControllerCommands DoorControllerCodec::commandForFrame( const DoorControllerFrame & frame )
+{
+    int iIndex;
+
+    if ( frame.ucState > 1 )
+    {
+        return eDOOR_CMD_UNKNOWN;
+    }
+
+    if ( frame.ucAddress == DOOR_ADDRESS_DOOR )
+    {
+        iIndex = frame.ucState;
+    }
+    else if ( frame.ucAddress == DOOR_ADDRESS_LIGHT )
+    {
+        iIndex = 2 | frame.ucState;
+    }
+    else
+    {
+        return eDOOR_CMD_UNKNOWN;
+    }
+
+    return (eDoorControllerCommands) iIndex;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+QString DoorControllerCodec::commandName( eDoorControllerCommands eCommand )
+{
+    if ( ( eCommand < 0 ) || ( eCommand >= eDOOR_CMD_COUNT ) )
+    {
+        return QString("Unknown");
+    }
+
+    return QString( DOOR_COMMAND_TABLE[eCommand].pName );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+int DoorControllerCodec::extractFrame( const QByteArray & baBuffer ) const
+{
+    const char * pBuffer = baBuffer.constData();
+    int iSize = baBuffer.size();
+
+    if ( iSize == 0 )
+    {
+        return 0;
+    }
+
+    // drop anything in front of the next STX
+    if ( (quint8) pBuffer[0] != DOOR_FRAME_STX )
+    {
+        int iIndex = baBuffer.indexOf( (char) DOOR_FRAME_STX );
+        return ( iIndex < 0 ) ? -iSize : -iIndex;
+    }
+
+    if ( iSize < DOOR_FRAME_LENGTH )
+    {
+        return 0;
+    }
+
+    if ( ( (quint8) pBuffer[10] != DOOR_FRAME_ETX )    ||
+         ( (quint8) pBuffer[8]  != DOOR_FRAME_MARKER ) ||
+         ( (quint8) pBuffer[7]  != computeChecksum( pBuffer ) ) )
+    {
+        // not a real frame start - skip this STX and resync on the next one
+        return -1;
+    }
+
+    return DOOR_FRAME_LENGTH;
+}
@@ -0,0 +1,69 @@
+#ifndef DOORCONTROLLERCODEC_H
+#define DOORCONTROLLERCODEC_H
+
+#include <QByteArray>
+#include <QString>
+
+#include "SerialPortBroker.h"
+
+//-----------------------------------------------------------------------------------------------------------------
+// Door/light controller frame layout (11 bytes):
+//
+//   [0] STX 0x02
+//   [1] device address          0x08 door, 0x0A light
+//   [2] function                0xA0 command, 0xA1 acknowledge
+//   [3] 0x01
+//   [4] 0x00
+//   [5] ~state
+//   [6] 0xFF
+//   [7] checksum                ~(sum of bytes 1..6)
+//   [8] 0xFD
+//   [9] state                   1 = locked / on, 0 = unlocked / off
+//   [10] ETX 0x03
+//-----------------------------------------------------------------------------------------------------------------
+static const int     DOOR_FRAME_LENGTH         = 11;
+static const quint8  DOOR_FRAME_STX            = 0x02;
+static const quint8  DOOR_FRAME_ETX            = 0x03;
+static const quint8  DOOR_FRAME_MARKER         = 0xFD;
+static const quint8  DOOR_FUNCTION_COMMAND     = 0xA0;
+static const quint8  DOOR_FUNCTION_ACK         = 0xA1;
+static const quint8  DOOR_ADDRESS_DOOR         = 0x08;
+static const quint8  DOOR_ADDRESS_LIGHT        = 0x0A;
+
+// the order matters - the ACK lookup indexes this enum by ( light ? 2 : 0 ) | state
+enum eDoorControllerCommands
+{
+    eDOOR_CMD_UNKNOWN   =-1,
+    eDOOR_CMD_UNLOCK    = 0,
+    eDOOR_CMD_LOCK      = 1,
+    eDOOR_CMD_LIGHT_OFF = 2,
+    eDOOR_CMD_LIGHT_ON  = 3,
+    eDOOR_CMD_COUNT     = 4
+};
+
+struct DoorControllerFrame
+{
+    quint8 ucAddress;
+    quint8 ucFunction;
+    quint8 ucState;
+};
+
+//-----------------------------------------------------------------------------------------------------------------
+// DoorControllerCodec - builds command frames from typed commands and, as the broker's frame extractor for the
+// controller, pulls validated frames out of the received byte stream.  Noise in front of an STX and frames with a
+// bad ETX, marker or checksum are discarded so the stream resynchronizes on the next STX.
+//-----------------------------------------------------------------------------------------------------------------
+class DoorControllerCodec : public SerialFrameExtractor
+{
+public:
+    int extractFrame( const QByteArray & baBuffer ) const;
+
+    static QByteArray encodeCommand( eDoorControllerCommands eCommand );
+    static QByteArray encodeFrame( quint8 ucAddress, quint8 ucFunction, quint8 ucState );
+    static bool decodeFrame( const QByteArray & baFrame, DoorControllerFrame & frame );
+    static eDoorControllerCommands commandForFrame( const DoorControllerFrame & frame );
+    static quint8 computeChecksum( const char * pFrame );
+    static QString commandName( eDoorControllerCommands eCommand );
+};
+
+#endif // DOORCONTROLLERCODEC_H
@@ -1,373 +1,302 @@
-#include "DoorManager.h"
-#include <QDebug>
-#include <QtSerialPort>
-#include <QtSerialPort/QSerialPortInfo>
-
-//-----------------------------------------------------------------------------------------------------------------
-//-----------------------------------------------------------------------------------------------------------------
-DoorManager::DoorManager(QObject *parent) :
-    QObject(parent),
-    m_sComPort("COM5"),
-    m_iWaitTimeoutMS(500),
-    m_bWaitingForTimeout(false)
-{
-    m_bSerialPortFound = findSerialPort();
-
-    // ---------------------------------------------------------
-    // set up the unlock door serial port command
-    //----------------------------------------------------------
-    const char UNLOCK_DOOR_COMMAND[] = {(char)0x02,
-                                        (char)0x08,
-                                        (char)0xA0,
-                                        (char)0x01,
-                                        (char)0x00,
-                                        (char)0xFF,
-                                        (char)0xFF,
-                                        (char)0x58,
-                                        (char)0xFD,
-                                        (char)0x00,
-                                        (char)0x03};
-    m_baUnlockDoor.clear();
-    m_baUnlockDoor.append( UNLOCK_DOOR_COMMAND, 11 );
-
-    const char UNLOCK_DOOR_ACK[] = {(char)0x02,
-                                    (char)0x08,
-                                    (char)0xA1,
-                                    (char)0x01,
-                                    (char)0x00,
-                                    (char)0xFF,
-                                    (char)0xFF,
-                                    (char)0x57,
-                                    (char)0xFD,
-                                    (char)0x00,
-                                    (char)0x03};
-    m_baUnlockDoorAck.clear();
-    m_baUnlockDoorAck.append( UNLOCK_DOOR_ACK, 11 );
-
-    // ---------------------------------------------------------
-    // set up the lock door serial port command
-    //----------------------------------------------------------
-    const char LOCK_DOOR_COMMAND[]   = {(char)0x02,
-                                        (char)0x08, \
-                                        (char)0xA0,
-                                        (char)0x01,
-                                        (char)0x00,
-                                        (char)0xFE,
-                                        (char)0xFF,
-                                        (char)0x59,
-                                        (char)0xFD,
-                                        (char)0x01,
-                                        (char)0x03};
-    m_baLockDoor.clear();
-    m_baLockDoor.append( LOCK_DOOR_COMMAND, 11 );
-
-    const char LOCK_DOOR_ACK[]   = {(char)0x02,
-                                    (char)0x08, \
-                                    (char)0xA1,
-                                    (char)0x01,
-                                    (char)0x00,
-                                    (char)0xFE,
-                                    (char)0xFF,
-                                    (char)0x58,
-                                    (char)0xFD,
-                                    (char)0x01,
-                                    (char)0x03};
-    m_baLockDoorAck.clear();
-    m_baLockDoorAck.append( LOCK_DOOR_ACK, 11 );
-
-
-    // ---------------------------------------------------------
-    // set up the light On serial port command
-    //----------------------------------------------------------
-    const char LIGHT_ON_COMMAND[]   = {(char)0x02,
-                                       (char)0x0A, \
-                                       (char)0xA0,
-                                       (char)0x01,
-                                       (char)0x00,
-                                       (char)0xFE,
-                                       (char)0xFF,
-                                       (char)0x57,
-                                       (char)0xFD,
-                                       (char)0x01,
-                                       (char)0x03};
-    m_baLightOn.clear();
-    m_baLightOn.append( LIGHT_ON_COMMAND, 11 );
-
-    const char LIGHT_ON_ACK[]       = {(char)0x02,
-                                       (char)0x0A, \
-                                       (char)0xA1,
-                                       (char)0x01,
-                                       (char)0x00,
-                                       (char)0xFE,
-                                       (char)0xFF,
-                                       (char)0x56,
-                                       (char)0xFD,
-                                       (char)0x01,
-                                       (char)0x03};
-    m_baLightOnAck.clear();
-    m_baLightOnAck.append( LIGHT_ON_ACK, 11 );
-
-    // ---------------------------------------------------------
-    // set up the light Off serial port command
-    //----------------------------------------------------------
-    const char LIGHT_OFF_COMMAND[]   = {(char)0x02,
-                                        (char)0x0A, \
-                                        (char)0xA0,
-                                        (char)0x01,
-                                        (char)0x00,
-                                        (char)0xFF,
-                                        (char)0xFF,
-                                        (char)0x56,
-                                        (char)0xFD,
-                                        (char)0x00,
-                                        (char)0x03};
-    m_baLightOff.clear();
-    m_baLightOff.append( LIGHT_OFF_COMMAND, 11 );
-
-    const char LIGHT_OFF_ACK[]      = {(char)0x02,
-                                       (char)0x0A, \
-                                       (char)0xA1,
-                                       (char)0x01,
-                                       (char)0x00,
-                                       (char)0xFF,
-                                       (char)0xFF,
-                                       (char)0x55,
-                                       (char)0xFD,
-                                       (char)0x00,
-                                       (char)0x03};
-    m_baLightOffAck.clear();
-    m_baLightOffAck.append( LIGHT_OFF_ACK, 11 );
-
-    // ---------------------------------------------------------
-    connect(&m_SerialPort, SIGNAL(response(QByteArray)), this, SLOT(handleResponse(QByteArray)));
-    connect(&m_SerialPort, SIGNAL(error(QString)), this, SLOT(handleSerialPortError(QString)));
-    connect(&m_SerialPort, SIGNAL(timeout(QString)), this, SLOT(handleTimeout(QString)));
-}
-
-//-----------------------------------------------------------------------------------------------------------------
-//-----------------------------------------------------------------------------------------------------------------
-void DoorManager::sendSerialRequest( QString sPortName, int iWaitTimeoutMS, QByteArray baRequest )
-{
-    m_SerialPort.transaction( sPortName, iWaitTimeoutMS, baRequest );
-}
-
-//-----------------------------------------------------------------------------------------------------------------
-//-----------------------------------------------------------------------------------------------------------------
-void DoorManager::handleResponse( QByteArray baResponse )
-{
-    m_bWaitingForTimeout = false;
-
-    qDebug() << "+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++";
-    qDebug() << "   Serial Port Response";
-    qDebug() << "+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++";
-    qDebug() << byteArrayToHexString( baResponse );
-    qDebug() << "+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++";
-
-    if( baResponse == m_baLightOffAck )
-    {
-        qDebug() << "++ received Light Off Ack";
-        emit signalLightOff(); 
-    }
-    else if ( baResponse == m_baLightOnAck )
-    {
-        qDebug() << "++ received Light On Ack";
-        emit signalLightOn();
-    }
-    else if ( baResponse == m_baUnlockDoorAck )
-    {
-        qDebug() << "++ received Door Unlocked Ack";
-        emit signalDoorUnlocked(); 
-    }
-    else if ( baResponse == m_baLockDoorAck )
-    {
-        qDebug() << "++received Door Locked Ack";
-        emit signalDoorLocked();
-    }
-    else
-    {
-        qDebug() << "+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++";
-        qDebug() << "   Serial Port Response";
-        qDebug() << "+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++";
-        qDebug() << byteArrayToHexString( baResponse );
-        qDebug() << "+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++";
-    }
-}
-
-//-----------------------------------------------------------------------------------------------------------------
-//-----------------------------------------------------------------------------------------------------------------
-void DoorManager::handleSerialPortError( QString sError )
-{
-    qWarning() << sError;
-    qDebug() << "Serial Port Error: " << sError;
-    m_bWaitingForTimeout = false;
-}
-
-//-----------------------------------------------------------------------------------------------------------------
-//-----------------------------------------------------------------------------------------------------------------
-void DoorManager::handleTimeout( QString sMessage )
-{
-    qDebug() << "Serial Port Timeout: " << sMessage;
-    m_bWaitingForTimeout = false;
-}
-
-//-----------------------------------------------------------------------------------------------------------------
-//-----------------------------------------------------------------------------------------------------------------
-void DoorManager::lockDoor( void )
-{
-    if ( m_bWaitingForTimeout == false )
-    {
-        qDebug() << "===========================================================";
-        qDebug() << "   Locking Door: Serial Port Send";
-        qDebug() << "===========================================================";
-        qDebug() << byteArrayToHexString( m_baLockDoor );
-        qDebug() << "===========================================================";
-
-        sendSerialRequest(m_sComPort, m_iWaitTimeoutMS, m_baLockDoor );
-        m_bWaitingForTimeout = true;
-    }
-    else
-    {
-        qWarning() << "Can not send the unlockDoor command - waiting for previous serial port command response";
-    }
-}
-
-//-----------------------------------------------------------------------------------------------------------------
-//-----------------------------------------------------------------------------------------------------------------
-void DoorManager::unlockDoor(DataManager * pDataManager, QString sUserID)
-{
-    if ( m_bWaitingForTimeout == false )
-    {
-        qDebug() << "===========================================================";
-        qDebug() << "   Unlocking Door: Serial Port Send";
-        qDebug() << "===========================================================";
-        qDebug() << byteArrayToHexString( m_baUnlockDoor );
-        qDebug() << "===========================================================";
-
-        pDataManager->recordDoorOpening( sUserID );
-        sendSerialRequest(m_sComPort, m_iWaitTimeoutMS, m_baUnlockDoor );
-        m_bWaitingForTimeout = true;
-    }
-    else
-    {
-        qWarning() << "Can not send the unlockDoor command - waiting for previous serial port command response";
-    }
-}
-
-//-----------------------------------------------------------------------------------------------------------------
-//-----------------------------------------------------------------------------------------------------------------
-void DoorManager::turnLightOn(void)
-{
-    if ( m_bWaitingForTimeout == false )
-    {
-        qDebug() << "===========================================================";
-        qDebug() << "  Sending Light On";
-        qDebug() << "===========================================================";
-        qDebug() << byteArrayToHexString( m_baLightOn );
-        qDebug() << "===========================================================";
-
-        sendSerialRequest(m_sComPort, m_iWaitTimeoutMS, m_baLightOn );
-        m_bWaitingForTimeout = true;
-    }
-    else
-    {
-        qWarning() << "Can not send the light on command - waiting for previous serial port command response";
-    }
-}
-
-
-//-----------------------------------------------------------------------------------------------------------------
-//-----------------------------------------------------------------------------------------------------------------
-void DoorManager::turnLightOff( void )
-{
-    if ( m_bWaitingForTimeout == false )
-    {
-        qDebug() << "===========================================================";
-        qDebug() << "  Sending Light Off";
-        qDebug() << "===========================================================";
-        qDebug() << byteArrayToHexString( m_baLightOff );
-        qDebug() << "===========================================================";
-
-        sendSerialRequest(m_sComPort, m_iWaitTimeoutMS, m_baLightOff );
-        m_bWaitingForTimeout = true;
-    }
-    else
-    {
-        qWarning() << "Can not send the light off command - waiting for previous serial port command response";
-    }
-}
-
-//-----------------------------------------------------------------------------------------------------------------
-//-----------------------------------------------------------------------------------------------------------------
-void DoorManager::setSerialPortName( QString sSerialPortName )
-{
-    m_sComPort = sSerialPortName;
-}
-
-//-----------------------------------------------------------------------------------------------------------------
-//-----------------------------------------------------------------------------------------------------------------
-void DoorManager::setWaitTimeoutMS( int iTimeoutMS )
-{
-    m_iWaitTimeoutMS = iTimeoutMS;
-}
-
-//-----------------------------------------------------------------------------------------------------------------
-//-----------------------------------------------------------------------------------------------------------------
-bool DoorManager::findSerialPort( void )
-{
-    bool bRC = false;
-    QSerialPort serial;
-    QString sPortName;
-
-    const auto infos = QSerialPortInfo::availablePorts();
-    for (const QSerialPortInfo &info : infos)
-    {
-        sPortName = info.portName();
-        qDebug() << "Trying Serial Port: " << sPortName;
-        serial.close();
-        serial.setPortName(sPortName);
-
-        bRC = serial.open(QIODevice::ReadWrite);
-
-        if ( bRC == true )
-        {
-            setSerialPortName( sPortName );
-            qDebug() << "Using Serial Port: " << sPortName;
-            serial.close();
-            break;
-        }
-        else
-        {
-            qDebug() << "Serial Port: " << sPortName << " not connected.";
-        }
-    }
-
-    serial.close();
-
-    return bRC;
-}
-
-//-----------------------------------------------------------------------------------------------------------------
-//-----------------------------------------------------------------------------------------------------------------
-bool DoorManager::isSerialPortFound( void )
-{
-    return m_bSerialPortFound;
-}
-
-//-----------------------------------------------------------------------------------------------------------------
-//-----------------------------------------------------------------------------------------------------------------
-QString DoorManager::byteArrayToHexString( QByteArray & buffer )
-{
-    int iIndex;
-    QString sReturnString;
-    QString sTempString = buffer.toHex().toUpper();
-    int iBuffSize = sTempString.size();
-
-    for ( iIndex = 0; iIndex < iBuffSize; iIndex+=2 )
-    {
-        //sReturnString.append("0x");
-        sReturnString.append( sTempString.mid(iIndex, 2) );
-        sReturnString.append(" ");
-    }
-
-    return sReturnString;
-}
+#include "DoorManager.h"
+#include <QDebug>
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+DoorManager::DoorManager(SerialPortBroker *pSerialBroker, QObject *parent) :
+    QObject(parent),
+    m_pSerialBroker(pSerialBroker),
+    m_iDoorDevice(SERIAL_INVALID_DEVICE),
+    m_iWaitTimeoutMS(SERIAL_ADAPTIVE_TIMEOUT),
+    m_bSerialPortFound(false)
+{
+    for ( int iIndex = 0; iIndex < eDOOR_CMD_COUNT; iIndex++ )
+    {
+        m_OutstandingCommands[iIndex].bActive         = false;
+        m_OutstandingCommands[iIndex].uiRequestID     = 0;
+        m_OutstandingCommands[iIndex].iAttempt        = 0;
+        m_OutstandingCommands[iIndex].llLastLatencyMS = -1;
+    }
+
+    // ---------------------------------------------------------
+    // The door/light controller has no identification command, so it is registered without a probe and is
+    // only opened on the port given to setSerialPortName().  The codec reassembles and validates the 11 byte
+    // frames coming back from it.
+    //----------------------------------------------------------
+    SerialDeviceDescriptor doorDescriptor;
+    doorDescriptor.sDeviceName        = "Door Controller";
+    doorDescriptor.iBaudRate          = QSerialPort::Baud19200;
+    doorDescriptor.iDefaultTimeoutMS  = DOOR_COMMAND_TIMEOUT_MS;
+    doorDescriptor.iMinTimeoutMS      = DOOR_COMMAND_MIN_TIMEOUT_MS;
+    doorDescriptor.iMaxTimeoutMS      = DOOR_COMMAND_TIMEOUT_MS;
+    doorDescriptor.pFrameExtractor    = QSharedPointer<SerialFrameExtractor>( new DoorControllerCodec );
+
+    m_iDoorDevice = m_pSerialBroker->registerDevice( doorDescriptor );
+
+    connect(m_pSerialBroker, SIGNAL(signalResponse(int,uint,QByteArray)), this, SLOT(handleResponse(int,uint,QByteArray)));
+    connect(m_pSerialBroker, SIGNAL(signalError(int,uint,QString)), this, SLOT(handleSerialPortError(int,uint,QString)));
+    connect(m_pSerialBroker, SIGNAL(signalTimeout(int,uint,QString)), this, SLOT(handleTimeout(int,uint,QString)));
+    connect(m_pSerialBroker, SIGNAL(signalDeviceConnected(int,QString)), this, SLOT(handleSerialDeviceConnected(int,QString)));
+    connect(m_pSerialBroker, SIGNAL(signalDeviceDisconnected(int)), this, SLOT(handleSerialDeviceDisconnected(int)));
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void DoorManager::sendSerialRequest( eDoorControllerCommands eCommand )
+{
+    OutstandingCommand & command = m_OutstandingCommands[eCommand];
+    QByteArray baRequest = DoorControllerCodec::encodeCommand( eCommand );
+
+    qDebug() << "Sending" << DoorControllerCodec::commandName( eCommand ) << "attempt" << command.iAttempt + 1
+             << ":" << byteArrayToHexString( baRequest );
+
+    command.uiRequestID = m_pSerialBroker->submitRequest( m_iDoorDevice, baRequest, eCommand, m_iWaitTimeoutMS );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void DoorManager::sendCommand( eDoorControllerCommands eCommand )
+{
+    OutstandingCommand & command = m_OutstandingCommands[eCommand];
+
+    if ( command.bActive )
+    {
+        qWarning() << "Can not send the" << DoorControllerCodec::commandName( eCommand )
+                   << "command - waiting for the previous one to be acknowledged";
+        return;
+    }
+
+    command.bActive  = true;
+    command.iAttempt = 0;
+    command.latencyTimer.start();
+
+    sendSerialRequest( eCommand );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+eDoorControllerCommands DoorManager::findOutstandingCommand( uint uiRequestID )
+{
+    for ( int iIndex = 0; iIndex < eDOOR_CMD_COUNT; iIndex++ )
+    {
+        if ( m_OutstandingCommands[iIndex].bActive && ( m_OutstandingCommands[iIndex].uiRequestID == uiRequestID ) )
+        {
+            return (eDoorControllerCommands) iIndex;
+        }
+    }
+
+    return eDOOR_CMD_UNKNOWN;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void DoorManager::retryOrFail( eDoorControllerCommands eCommand, QString sReason )
+{
+    OutstandingCommand & command = m_OutstandingCommands[eCommand];
+
+    if ( command.iAttempt < DOOR_COMMAND_MAX_RETRIES )
+    {
+        command.iAttempt++;
+        sendSerialRequest( eCommand );
+        return;
+    }
+
+    command.bActive = false;
+
+    QString sError = QString("%1 failed after %2 attempts: %3").arg( DoorControllerCodec::commandName( eCommand ) )
+                                                               .arg( command.iAttempt + 1 )
+                                                               .arg( sReason );
+    qWarning() << sError;
+    emit signalCommError( sError );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void DoorManager::handleResponse( int iDevice, uint uiRequestID, QByteArray baResponse )
+{
+    if ( iDevice != m_iDoorDevice )
+    {
+        return;
+    }
+
+    eDoorControllerCommands eSent = findOutstandingCommand( uiRequestID );
+    DoorControllerFrame frame;
+
+    if ( !DoorControllerCodec::decodeFrame( baResponse, frame ) ||
+         ( frame.ucFunction != DOOR_FUNCTION_ACK ) ||
+         ( DoorControllerCodec::commandForFrame( frame ) != eSent ) )
+    {
+        qDebug() << "Unexpected door controller response: " << byteArrayToHexString( baResponse );
+
+        if ( eSent != eDOOR_CMD_UNKNOWN )
+        {
+            retryOrFail( eSent, "unexpected response" );
+        }
+        return;
+    }
+
+    OutstandingCommand & command = m_OutstandingCommands[eSent];
+    command.bActive = false;
+    command.llLastLatencyMS = command.latencyTimer.elapsed();
+
+    qDebug() << "++ received" << DoorControllerCodec::commandName( eSent ) << "Ack in" << command.llLastLatencyMS << "ms";
+
+    switch ( eSent )
+    {
+    case eDOOR_CMD_LIGHT_OFF:
+        emit signalLightOff();
+        break;
+    case eDOOR_CMD_LIGHT_ON:
+        emit signalLightOn();
+        break;
+    case eDOOR_CMD_UNLOCK:
+        emit signalDoorUnlocked();
+        break;
+    case eDOOR_CMD_LOCK:
+        emit signalDoorLocked();
+        break;
+    default:
+        break;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void DoorManager::handleSerialPortError( int iDevice, uint uiRequestID, QString sError )
+{
+    if ( iDevice != m_iDoorDevice )
+    {
+        return;
+    }
+
+    qDebug() << "Serial Port Error: " << sError;
+
+    // the broker could not send it at all, so retrying right away will not help
+    eDoorControllerCommands eSent = findOutstandingCommand( uiRequestID );
+    if ( eSent != eDOOR_CMD_UNKNOWN )
+    {
+        m_OutstandingCommands[eSent].iAttempt = DOOR_COMMAND_MAX_RETRIES;
+        retryOrFail( eSent, sError );
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void DoorManager::handleTimeout( int iDevice, uint uiRequestID, QString sMessage )
+{
+    if ( iDevice != m_iDoorDevice )
+    {
+        return;
+    }
+
+    qDebug() << "Serial Port Timeout: " << sMessage;
+
+    eDoorControllerCommands eSent = findOutstandingCommand( uiRequestID );
+    if ( eSent != eDOOR_CMD_UNKNOWN )
+    {
+        retryOrFail( eSent, sMessage );
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void DoorManager::lockDoor( void )
+{
+    sendCommand( eDOOR_CMD_LOCK );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// The opening itself is recorded by the database when the door status reports it open.
+//-----------------------------------------------------------------------------------------------------------------
+void DoorManager::unlockDoor(void)
+{
+    sendCommand( eDOOR_CMD_UNLOCK );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void DoorManager::turnLightOn(void)
+{
+    sendCommand( eDOOR_CMD_LIGHT_ON );
+}
+
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void DoorManager::turnLightOff( void )
+{
+    sendCommand( eDOOR_CMD_LIGHT_OFF );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void DoorManager::setSerialPortName( QString sSerialPortName )
+{
+    m_pSerialBroker->setPreferredPortName( m_iDoorDevice, sSerialPortName );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void DoorManager::setWaitTimeoutMS( int iTimeoutMS )
+{
+    m_iWaitTimeoutMS = iTimeoutMS;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+qint64 DoorManager::getLastCommandLatencyMS( eDoorControllerCommands eCommand )
+{
+    if ( ( eCommand < 0 ) || ( eCommand >= eDOOR_CMD_COUNT ) )
+    {
+        return -1;
+    }
+
+    return m_OutstandingCommands[eCommand].llLastLatencyMS;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void DoorManager::handleSerialDeviceConnected( int iDevice, QString sPortName )
+{
+    if ( iDevice == m_iDoorDevice )
+    {
+        qDebug() << "Door controller using Serial Port: " << sPortName;
+        m_bSerialPortFound = true;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void DoorManager::handleSerialDeviceDisconnected( int iDevice )
+{
+    if ( iDevice == m_iDoorDevice )
+    {
+        m_bSerialPortFound = false;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+bool DoorManager::isSerialPortFound( void )
+{
+    return m_bSerialPortFound;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+QString DoorManager::byteArrayToHexString( QByteArray & buffer )
+{
+    int iIndex;
+    QString sReturnString;
+    QString sTempString = buffer.toHex().toUpper();
+    int iBuffSize = sTempString.size();
+
+    for ( iIndex = 0; iIndex < iBuffSize; iIndex+=2 )
+    {
+        //sReturnString.append("0x");
+        sReturnString.append( sTempString.mid(iIndex, 2) );
+        sReturnString.append(" ");
+    }
+
+    return sReturnString;
+}
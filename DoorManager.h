@@ -1,75 +1,85 @@
-#ifndef DOORMANAGER_H
-#define DOORMANAGER_H
-
-#include <QObject>
-
-
-#include "DataManager.h"
-#include "SerialPortThread.h"
-
-class DoorManager : public QObject
-{
-    Q_OBJECT
-
-public:
-    explicit DoorManager( QObject *parent = 0);
-
-    void lockDoor(void);
-    void unlockDoor(DataManager *pDataManager, QString sUserID );
-
-    void turnLightOff( void );
-    void turnLightOn( void );
-
-    void setSerialPortName( QString sSerialPortName );
-    void setWaitTimeoutMS( int iTimeoutMS );
-
-    bool isSerialPortFound( void );
-
-private slots:
-
-    void handleResponse(QByteArray baResponse);
-    void handleSerialPortError(QString sError);
-    void handleTimeout(QString sMessage);
-
-signals:
-
-    void signalCommError( QString sErrorMessage );
-    void signalDBError( QString sErrorMessage );
-
-    void signalLightOn(void);
-    void signalLightOff(void);
-    void signalDoorLocked(void);
-    void signalDoorUnlocked(void);
-
-private:
-
-    //------------------------------------------
-    // Private Functions
-    //------------------------------------------
-    bool findSerialPort( void );
-    void sendSerialRequest(QString sPortName, int iWaitTimeoutMS, QByteArray baRequest );
-    QString byteArrayToHexString( QByteArray & buffer );
-
-    //------------------------------------------
-    // Private Data
-    //------------------------------------------
-    SerialPortThread m_SerialPort;
-
-    QString m_sComPort;
-    int     m_iWaitTimeoutMS;
-
-    QByteArray m_baUnlockDoor;
-    QByteArray m_baUnlockDoorAck;
-    QByteArray m_baLockDoor;
-    QByteArray m_baLockDoorAck;
-
-    QByteArray m_baLightOn;
-    QByteArray m_baLightOnAck;
-    QByteArray m_baLightOff;
-    QByteArray m_baLightOffAck;
-
-    bool m_bWaitingForTimeout;
-    bool m_bSerialPortFound;
-};
-
-#endif // DOORMANAGER_H
+#ifndef DOORMANAGER_H
+#define DOORMANAGER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+
+#include "SerialPortBroker.h"
+#include "DoorControllerCodec.h"
+
+static const int DOOR_COMMAND_TIMEOUT_MS     = 500;     // until enough round trips have been measured
+static const int DOOR_COMMAND_MIN_TIMEOUT_MS = 250;     // 11 byte frames both ways plus the relay switching
+static const int DOOR_COMMAND_MAX_RETRIES    = 2;
+
+class DoorManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DoorManager( SerialPortBroker *pSerialBroker, QObject *parent = 0);
+
+    void lockDoor(void);
+    void unlockDoor(void);
+
+    void turnLightOff( void );
+    void turnLightOn( void );
+
+    void setSerialPortName( QString sSerialPortName );
+    void setWaitTimeoutMS( int iTimeoutMS );
+
+    bool isSerialPortFound( void );
+    qint64 getLastCommandLatencyMS( eDoorControllerCommands eCommand );
+
+private slots:
+
+    void handleResponse(int iDevice, uint uiRequestID, QByteArray baResponse);
+    void handleSerialPortError(int iDevice, uint uiRequestID, QString sError);
+    void handleTimeout(int iDevice, uint uiRequestID, QString sMessage);
+    void handleSerialDeviceConnected(int iDevice, QString sPortName);
+    void handleSerialDeviceDisconnected(int iDevice);
+
+signals:
+
+    void signalCommError( QString sErrorMessage );
+
+    void signalLightOn(void);
+    void signalLightOff(void);
+    void signalDoorLocked(void);
+    void signalDoorUnlocked(void);
+
+private:
+
+    // one slot per command type - a command is outstanding from the first send until its ACK arrives or the
+    // last retry times out
+    struct OutstandingCommand
+    {
+        bool          bActive;
+        uint          uiRequestID;
+        int           iAttempt;
+        QElapsedTimer latencyTimer;
+        qint64        llLastLatencyMS;
+    };
+
+    //------------------------------------------
+    // Private Functions
+    //------------------------------------------
+    void sendCommand( eDoorControllerCommands eCommand );
+    void sendSerialRequest( eDoorControllerCommands eCommand );
+    eDoorControllerCommands findOutstandingCommand( uint uiRequestID );
+    void retryOrFail( eDoorControllerCommands eCommand, QString sReason );
+    QString byteArrayToHexString( QByteArray & buffer );
+
+    //------------------------------------------
+    // Private Data
+    //------------------------------------------
+    SerialPortBroker * m_pSerialBroker;
+    int                m_iDoorDevice;
+
+    int     m_iWaitTimeoutMS;
+
+    OutstandingCommand m_OutstandingCommands[eDOOR_CMD_COUNT];
+
+    bool m_bSerialPortFound;
+};
+
+#endif // DOORMANAGER_H
@@ -0,0 +1,232 @@
+#include "ScpiReplyDecoder.h"
+
+namespace
+{
+    const double POWERS_OF_TEN[] = { 1E0,  1E1,  1E2,  1E3,  1E4,  1E5,  1E6,  1E7,
+                                     1E8,  1E9,  1E10, 1E11, 1E12, 1E13, 1E14, 1E15,
+                                     1E16, 1E17, 1E18, 1E19, 1E20, 1E21, 1E22 };
+    const int    MAX_TABLE_EXPONENT = 22;
+    const int    MAX_MANTISSA_DIGITS = 18;
+
+    inline bool isDigit( char c )
+    {
+        return ( c >= '0' ) && ( c <= '9' );
+    }
+
+    inline bool isSeparator( char c )
+    {
+        return ( c == ',' ) || ( c == ' ' ) || ( c == '\t' ) || ( c == '\r' ) || ( c == '\n' ) || ( c == ';' );
+    }
+
+    double scaleByPowerOfTen( double dValue, int iExponent )
+    {
+        bool bNegative = ( iExponent < 0 );
+
+        if ( bNegative )
+        {
+            iExponent = -iExponent;
+        }
+
+        double dScale = 1.0;
+        while ( iExponent > MAX_TABLE_EXPONENT )
+        {
+            dScale *= POWERS_OF_TEN[MAX_TABLE_EXPONENT];
+            iExponent -= MAX_TABLE_EXPONENT;
+        }
+        dScale *= POWERS_OF_TEN[iExponent];
+
+        return bNegative ? ( dValue / dScale ) : ( dValue * dScale );
+    }
+
+    eScpiValueStatus classifyValue( double dValue )
+    {
+        double dMagnitude = ( dValue < 0.0 ) ? -dValue : dValue;
+
+        // 9.90E37 and 9.91E37 are 1E35 apart - split the difference
+        if ( dMagnitude >= ( SCPI_OVERLOAD_VALUE + SCPI_OPEN_TC_VALUE ) / 2.0 )
+        {
+            return eSCPI_VALUE_OPEN;
+        }
+
+        if ( dMagnitude >= SCPI_OVERLOAD_VALUE * 0.999 )
+        {
+            return eSCPI_VALUE_OVERLOAD;
+        }
+
+        return eSCPI_VALUE_OK;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// Parses one <NR1>/<NR2>/<NR3> number at pCursor and leaves pCursor just past it.
+//-----------------------------------------------------------------------------------------------------------------
+bool ScpiReplyDecoder::parseNumber( const char * & pCursor, const char * pEnd, double & dValue )
+{
+    const char * p = pCursor;
+    bool bNegative = false;
+    unsigned long long ullMantissa = 0;
+    int iMantissaDigits = 0;
+    int iDecimalExponent = 0;
+    bool bHaveDigits = false;
+
+    if ( ( p < pEnd ) && ( ( *p == '+' ) || ( *p == '-' ) ) )
+    {
+        bNegative = ( *p == '-' );
+        p++;
+    }
+
+    while ( ( p < pEnd ) && isDigit( *p ) )
+    {
+        if ( iMantissaDigits < MAX_MANTISSA_DIGITS )
+        {
+            ullMantissa = ullMantissa * 10 + ( *p - '0' );
+            if ( ullMantissa != 0 )
+            {
+                iMantissaDigits++;
+            }
+        }
+        else
+        {
+            iDecimalExponent++;
+        }
+        bHaveDigits = true;
+        p++;
+    }
+
+    if ( ( p < pEnd ) && ( *p == '.' ) )
+    {
+        p++;
+        while ( ( p < pEnd ) && isDigit( *p ) )
+        {
+            if ( iMantissaDigits < MAX_MANTISSA_DIGITS )
+            {
+                ullMantissa = ullMantissa * 10 + ( *p - '0' );
+                if ( ullMantissa != 0 )
+                {
+                    iMantissaDigits++;
+                }
+                iDecimalExponent--;
+            }
+            bHaveDigits = true;
+            p++;
+        }
+    }
+
+    if ( !bHaveDigits )
+    {
+        return false;
+    }
+
+    if ( ( p < pEnd ) && ( ( *p == 'E' ) || ( *p == 'e' ) ) )
+    {
+        const char * pExponent = p + 1;
+        bool bExponentNegative = false;
+        int iExponent = 0;
+
+        if ( ( pExponent < pEnd ) && ( ( *pExponent == '+' ) || ( *pExponent == '-' ) ) )
+        {
+            bExponentNegative = ( *pExponent == '-' );
+            pExponent++;
+        }
+
+        if ( ( pExponent >= pEnd ) || !isDigit( *pExponent ) )
+        {
+            return false;
+        }
+
+        while ( ( pExponent < pEnd ) && isDigit( *pExponent ) )
+        {
+            if ( iExponent < 10000 )
+            {
+                iExponent = iExponent * 10 + ( *pExponent - '0' );
+            }
+            pExponent++;
+        }
+
+        iDecimalExponent += bExponentNegative ? -iExponent : iExponent;
+        p = pExponent;
+    }
+
+    dValue = scaleByPowerOfTen( (double) ullMantissa, iDecimalExponent );
+    if ( bNegative )
+    {
+        dValue = -dValue;
+    }
+
+    pCursor = p;
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// Decodes a comma separated list of numbers.  Returns false if the reply holds anything that is not a number
+// (e.g. an error string), in which case list.iCount holds the values decoded before the bad token.
+//-----------------------------------------------------------------------------------------------------------------
+bool ScpiReplyDecoder::decodeNumericList( const char * pData, int iLength, ScpiNumericList & list )
+{
+    const char * p = pData;
+    const char * pEnd = pData + iLength;
+
+    list.iCount = 0;
+    list.bTruncated = false;
+
+    while ( p < pEnd )
+    {
+        if ( isSeparator( *p ) )
+        {
+            p++;
+            continue;
+        }
+
+        double dValue;
+        if ( !parseNumber( p, pEnd, dValue ) )
+        {
+            return false;
+        }
+
+        if ( ( p < pEnd ) && !isSeparator( *p ) )
+        {
+            return false;
+        }
+
+        if ( list.iCount < SCPI_MAX_LIST_VALUES )
+        {
+            list.adValues[list.iCount] = dValue;
+            list.aeStatus[list.iCount] = classifyValue( dValue );
+            list.iCount++;
+        }
+        else
+        {
+            list.bTruncated = true;
+        }
+    }
+
+    return ( list.iCount > 0 );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// Decodes a SYST:ERR? reply ( +0,"No error" / -222,"Data out of range" ).  Only the code is extracted.
+//-----------------------------------------------------------------------------------------------------------------
+bool ScpiReplyDecoder::decodeErrorReply( const char * pData, int iLength, int & iErrorCode )
+{
+    const char * p = pData;
+    const char * pEnd = pData + iLength;
+    double dCode;
+
+    while ( ( p < pEnd ) && isSeparator( *p ) && ( *p != ',' ) )
+    {
+        p++;
+    }
+
+    if ( !parseNumber( p, pEnd, dCode ) )
+    {
+        return false;
+    }
+
+    if ( ( p < pEnd ) && ( *p != ',' ) && !isSeparator( *p ) )
+    {
+        return false;
+    }
+
+    iErrorCode = (int) dCode;
+    return true;
+}
@@ -0,0 +1,38 @@
+#ifndef SCPIREPLYDECODER_H
+#define SCPIREPLYDECODER_H
+
+static const int    SCPI_MAX_LIST_VALUES   = 20;
+static const double SCPI_OVERLOAD_VALUE    = 9.9E37;
+static const double SCPI_OPEN_TC_VALUE     = 9.91E37;
+
+enum eScpiValueStatus
+{
+    eSCPI_VALUE_OK       = 0,
+    eSCPI_VALUE_OVERLOAD = 1,   // +/-9.9E37 - reading out of range
+    eSCPI_VALUE_OPEN     = 2    // 9.91E37   - open thermocouple / no reading
+};
+
+//-----------------------------------------------------------------------------------------------------------------
+// Result of decoding a numeric list reply such as "+2.312E+01,-3.200E-01\r\n".  Fixed size so that decoding a
+// reply never touches the heap.
+//-----------------------------------------------------------------------------------------------------------------
+struct ScpiNumericList
+{
+    int              iCount;
+    bool             bTruncated;                    // more values than SCPI_MAX_LIST_VALUES in the reply
+    double           adValues[SCPI_MAX_LIST_VALUES];
+    eScpiValueStatus aeStatus[SCPI_MAX_LIST_VALUES];
+};
+
+//-----------------------------------------------------------------------------------------------------------------
+// ScpiReplyDecoder - parses SCPI replies straight out of the receive buffer.
+//-----------------------------------------------------------------------------------------------------------------
+class ScpiReplyDecoder
+{
+public:
+    static bool decodeNumericList( const char * pData, int iLength, ScpiNumericList & list );
+    static bool decodeErrorReply( const char * pData, int iLength, int & iErrorCode );
+    static bool parseNumber( const char * & pCursor, const char * pEnd, double & dValue );
+};
+
+#endif // SCPIREPLYDECODER_H
@@ -0,0 +1,103 @@
+#include "SerialLatencyHistogram.h"
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+SerialLatencyHistogram::SerialLatencyHistogram() :
+    m_ulTotal( 0 )
+{
+    for ( int iIndex = 0; iIndex < SERIAL_LATENCY_BUCKETS; iIndex++ )
+    {
+        m_aulCounts[iIndex] = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// 0..3 ms get a bucket each, after that each power of two is split into 4 buckets.
+//-----------------------------------------------------------------------------------------------------------------
+int SerialLatencyHistogram::bucketForLatency( qint64 llLatencyMS )
+{
+    if ( llLatencyMS < 4 )
+    {
+        return ( llLatencyMS < 0 ) ? 0 : (int) llLatencyMS;
+    }
+
+    int iExponent = 0;
+    for ( qint64 llValue = llLatencyMS; llValue > 1; llValue >>= 1 )
+    {
+        iExponent++;
+    }
+
+    int iSubBucket = (int) ( ( llLatencyMS >> ( iExponent - 2 ) ) & 3 );
+    int iBucket = 4 * ( iExponent - 1 ) + iSubBucket;
+
+    return ( iBucket < SERIAL_LATENCY_BUCKETS ) ? iBucket : ( SERIAL_LATENCY_BUCKETS - 1 );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+qint64 SerialLatencyHistogram::bucketUpperEdgeMS( int iBucket )
+{
+    if ( iBucket < 4 )
+    {
+        return iBucket + 1;
+    }
+
+    int iExponent = iBucket / 4 + 1;
+    int iSubBucket = iBucket % 4;
+
+    return (qint64) ( 5 + iSubBucket ) << ( iExponent - 2 );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialLatencyHistogram::addSample( qint64 llLatencyMS )
+{
+    m_aulCounts[bucketForLatency( llLatencyMS )]++;
+    m_ulTotal++;
+
+    if ( m_ulTotal >= SERIAL_LATENCY_WINDOW_SAMPLES )
+    {
+        m_ulTotal = 0;
+        for ( int iIndex = 0; iIndex < SERIAL_LATENCY_BUCKETS; iIndex++ )
+        {
+            m_aulCounts[iIndex] /= 2;
+            m_ulTotal += m_aulCounts[iIndex];
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+quint32 SerialLatencyHistogram::getSampleCount( void ) const
+{
+    return m_ulTotal;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// Returns the upper edge of the bucket holding the requested percentile (0.0 - 1.0), or -1 with no samples.
+//-----------------------------------------------------------------------------------------------------------------
+qint64 SerialLatencyHistogram::getPercentileMS( double dPercentile ) const
+{
+    if ( m_ulTotal == 0 )
+    {
+        return -1;
+    }
+
+    quint32 ulTarget = (quint32) ( dPercentile * m_ulTotal + 0.5 );
+    if ( ulTarget == 0 )
+    {
+        ulTarget = 1;
+    }
+
+    quint32 ulRunning = 0;
+    for ( int iIndex = 0; iIndex < SERIAL_LATENCY_BUCKETS; iIndex++ )
+    {
+        ulRunning += m_aulCounts[iIndex];
+        if ( ulRunning >= ulTarget )
+        {
+            return bucketUpperEdgeMS( iIndex );
+        }
+    }
+
+    return bucketUpperEdgeMS( SERIAL_LATENCY_BUCKETS - 1 );
+}
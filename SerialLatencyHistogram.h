@@ -0,0 +1,31 @@
+#ifndef SERIALLATENCYHISTOGRAM_H
+#define SERIALLATENCYHISTOGRAM_H
+
+#include <QtGlobal>
+
+static const int     SERIAL_LATENCY_BUCKETS        = 64;
+static const quint32 SERIAL_LATENCY_WINDOW_SAMPLES = 512;
+
+//-----------------------------------------------------------------------------------------------------------------
+// SerialLatencyHistogram - running distribution of response times in log spaced buckets (4 per octave, so any
+// percentile is within ~19% of the true value).  Once the window fills, every count is halved so that old
+// samples fade out and the distribution follows the device as it warms up, slows down, etc.
+//-----------------------------------------------------------------------------------------------------------------
+class SerialLatencyHistogram
+{
+public:
+    SerialLatencyHistogram();
+
+    void    addSample( qint64 llLatencyMS );
+    quint32 getSampleCount( void ) const;
+    qint64  getPercentileMS( double dPercentile ) const;
+
+private:
+    static int    bucketForLatency( qint64 llLatencyMS );
+    static qint64 bucketUpperEdgeMS( int iBucket );
+
+    quint32 m_aulCounts[SERIAL_LATENCY_BUCKETS];
+    quint32 m_ulTotal;
+};
+
+#endif // SERIALLATENCYHISTOGRAM_H
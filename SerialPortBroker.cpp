@@ -0,0 +1,983 @@
+#include "SerialPortBroker.h"
+
+#include <QDebug>
+#include <QTimer>
+#include <QTime>
+#include <QMutexLocker>
+#include <QtSerialPort/QSerialPortInfo>
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+SerialLineFrameExtractor::SerialLineFrameExtractor( char cTerminator ) :
+    m_cTerminator( cTerminator )
+{
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+int SerialLineFrameExtractor::extractFrame( const QByteArray & baBuffer ) const
+{
+    int iIndex = baBuffer.indexOf( m_cTerminator );
+
+    if ( iIndex < 0 )
+    {
+        return 0;
+    }
+
+    return iIndex + 1;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+SerialFixedLengthFrameExtractor::SerialFixedLengthFrameExtractor( int iFrameLength ) :
+    m_iFrameLength( iFrameLength )
+{
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+int SerialFixedLengthFrameExtractor::extractFrame( const QByteArray & baBuffer ) const
+{
+    if ( baBuffer.size() < m_iFrameLength )
+    {
+        return 0;
+    }
+
+    return m_iFrameLength;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+SerialDeviceDescriptor::SerialDeviceDescriptor() :
+    iBaudRate( QSerialPort::Baud19200 ),
+    iDefaultTimeoutMS( SERIAL_DEFAULT_TIMEOUT_MS ),
+    iMinTimeoutMS( SERIAL_MIN_TIMEOUT_MS ),
+    iMaxTimeoutMS( SERIAL_DEFAULT_TIMEOUT_MS )
+{
+}
+
+//=================================================================================================================
+// SerialPortIOWorker
+//=================================================================================================================
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+SerialPortIOWorker::SerialPortIOWorker( QObject *parent ) :
+    QObject( parent ),
+    m_pProbePort( NULL ),
+    m_pProbeTimer( NULL ),
+    m_bDiscoveryRunning( false ),
+    m_bDiscoveryPending( false )
+{
+    m_ActiveProbe.iDevice = SERIAL_INVALID_DEVICE;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+SerialPortIOWorker::~SerialPortIOWorker()
+{
+    qDeleteAll( m_Devices );
+    m_Devices.clear();
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortIOWorker::addDevice( int iDevice, SerialDeviceDescriptor descriptor )
+{
+    SerialDeviceState * pState = new SerialDeviceState;
+
+    if ( descriptor.pFrameExtractor.isNull() )
+    {
+        descriptor.pFrameExtractor = QSharedPointer<SerialFrameExtractor>( new SerialLineFrameExtractor() );
+    }
+
+    pState->descriptor = descriptor;
+    pState->pPort = NULL;
+    pState->bRequestActive = false;
+    pState->pTimeoutTimer = new QTimer( this );
+    pState->pTimeoutTimer->setSingleShot( true );
+
+    m_TimerToDevice.insert( pState->pTimeoutTimer, iDevice );
+    connect( pState->pTimeoutTimer, SIGNAL(timeout()), this, SLOT(handleRequestTimeout()) );
+
+    pState->pQuietTimer = new QTimer( this );
+    pState->pQuietTimer->setSingleShot( true );
+
+    m_QuietTimerToDevice.insert( pState->pQuietTimer, iDevice );
+    connect( pState->pQuietTimer, SIGNAL(timeout()), this, SLOT(handleQuietIntervalElapsed()) );
+
+    pState->eCircuitState = eCIRCUIT_CLOSED;
+    pState->iConsecutiveFailures = 0;
+    pState->pBreakerTimer = new QTimer( this );
+    pState->pBreakerTimer->setSingleShot( true );
+
+    m_BreakerTimerToDevice.insert( pState->pBreakerTimer, iDevice );
+    connect( pState->pBreakerTimer, SIGNAL(timeout()), this, SLOT(handleBreakerTimeout()) );
+
+    m_Devices.insert( iDevice, pState );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortIOWorker::setPreferredPortName( int iDevice, QString sPortName )
+{
+    SerialDeviceState * pState = m_Devices.value( iDevice, NULL );
+
+    if ( pState != NULL )
+    {
+        pState->descriptor.sPreferredPortName = sPortName;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortIOWorker::queueRequest( int iDevice, uint uiRequestID, QByteArray baRequest, int iTimeoutMS, int iCommandType )
+{
+    SerialDeviceState * pState = m_Devices.value( iDevice, NULL );
+
+    if ( pState == NULL )
+    {
+        emit signalError( iDevice, uiRequestID, tr("Unknown serial device %1").arg( iDevice ) );
+        return;
+    }
+
+    if ( pState->pPort == NULL )
+    {
+        emit signalError( iDevice, uiRequestID, tr("%1 is not connected").arg( pState->descriptor.sDeviceName ) );
+        return;
+    }
+
+    if ( pState->eCircuitState == eCIRCUIT_OPEN )
+    {
+        emit signalError( iDevice, uiRequestID, tr("%1 is not responding").arg( pState->descriptor.sDeviceName ) );
+        return;
+    }
+
+    SerialRequest request;
+    request.uiRequestID   = uiRequestID;
+    request.baRequest     = baRequest;
+    request.iTimeoutMS    = iTimeoutMS;
+    request.iCommandType  = iCommandType;
+    request.bBreakerProbe = false;
+
+    pState->requestQueue.enqueue( request );
+
+    if ( pState->bRequestActive == false )
+    {
+        startNextRequest( iDevice );
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// Nothing is sent while the quiet interval after a timeout is running; handleQuietIntervalElapsed() picks the
+// queue up again.
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortIOWorker::startNextRequest( int iDevice )
+{
+    SerialDeviceState * pState = m_Devices.value( iDevice, NULL );
+
+    if ( ( pState == NULL ) || ( pState->pPort == NULL ) || pState->requestQueue.isEmpty() ||
+         pState->pQuietTimer->isActive() )
+    {
+        return;
+    }
+
+    pState->activeRequest = pState->requestQueue.dequeue();
+    pState->bRequestActive = true;
+
+    // anything left over from a previous exchange belongs to nobody - including bytes still in the driver
+    pState->pPort->clear( QSerialPort::Input );
+    pState->pPort->readAll();
+    pState->baRxBuffer.clear();
+
+    if ( pState->pPort->write( pState->activeRequest.baRequest ) != pState->activeRequest.baRequest.size() )
+    {
+        pState->bRequestActive = false;
+        emit signalError( iDevice, pState->activeRequest.uiRequestID,
+                          tr("Write to %1 failed: %2").arg( pState->sPortName ).arg( pState->pPort->errorString() ) );
+        startNextRequest( iDevice );
+        return;
+    }
+
+    int iTimeoutMS = pState->activeRequest.iTimeoutMS;
+    if ( iTimeoutMS <= 0 )
+    {
+        iTimeoutMS = getRequestTimeoutMS( pState, pState->activeRequest.iCommandType );
+    }
+
+    pState->requestTimer.start();
+    pState->pTimeoutTimer->start( iTimeoutMS );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// p99 of the measured latency times the safety factor, clamped.  Until there are enough samples for the command
+// type the descriptor's default timeout is used.
+//-----------------------------------------------------------------------------------------------------------------
+int SerialPortIOWorker::getRequestTimeoutMS( SerialDeviceState * pState, int iCommandType )
+{
+    QHash<int, SerialLatencyHistogram>::const_iterator it = pState->latencyHistograms.constFind( iCommandType );
+
+    if ( ( it == pState->latencyHistograms.constEnd() ) || ( it->getSampleCount() < SERIAL_MIN_LATENCY_SAMPLES ) )
+    {
+        return pState->descriptor.iDefaultTimeoutMS;
+    }
+
+    int iTimeoutMS = (int) ( it->getPercentileMS( SERIAL_TIMEOUT_PERCENTILE ) * SERIAL_TIMEOUT_SAFETY_FACTOR );
+
+    return qBound( pState->descriptor.iMinTimeoutMS, iTimeoutMS, pState->descriptor.iMaxTimeoutMS );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortIOWorker::completeActiveRequest( int iDevice, const QByteArray & baResponse )
+{
+    SerialDeviceState * pState = m_Devices.value( iDevice, NULL );
+
+    if ( pState == NULL )
+    {
+        return;
+    }
+
+    pState->pTimeoutTimer->stop();
+    pState->bRequestActive = false;
+
+    if ( pState->activeRequest.bBreakerProbe )
+    {
+        if ( baResponse.contains( pState->descriptor.baProbeSignature ) )
+        {
+            recordSuccess( iDevice );
+        }
+        else
+        {
+            recordFailure( iDevice );
+        }
+    }
+    else
+    {
+        pState->latencyHistograms[pState->activeRequest.iCommandType].addSample( pState->requestTimer.elapsed() );
+        recordSuccess( iDevice );
+
+        emit signalResponse( iDevice, pState->activeRequest.uiRequestID, baResponse );
+    }
+
+    startNextRequest( iDevice );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortIOWorker::recordSuccess( int iDevice )
+{
+    SerialDeviceState * pState = m_Devices.value( iDevice, NULL );
+
+    pState->iConsecutiveFailures = 0;
+
+    if ( pState->eCircuitState != eCIRCUIT_CLOSED )
+    {
+        pState->eCircuitState = eCIRCUIT_CLOSED;
+        pState->pBreakerTimer->stop();
+
+        qDebug() << pState->descriptor.sDeviceName << "is responding again";
+        emit signalCircuitClosed( iDevice );
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortIOWorker::recordFailure( int iDevice )
+{
+    SerialDeviceState * pState = m_Devices.value( iDevice, NULL );
+
+    pState->iConsecutiveFailures++;
+
+    if ( ( pState->eCircuitState == eCIRCUIT_HALF_OPEN ) ||
+         ( pState->iConsecutiveFailures >= SERIAL_BREAKER_FAILURE_THRESHOLD ) )
+    {
+        openCircuit( iDevice );
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortIOWorker::openCircuit( int iDevice )
+{
+    SerialDeviceState * pState = m_Devices.value( iDevice, NULL );
+    bool bWasOpen = ( pState->eCircuitState == eCIRCUIT_OPEN );
+
+    pState->eCircuitState = eCIRCUIT_OPEN;
+    pState->pBreakerTimer->start( SERIAL_BREAKER_RETRY_MS );
+
+    failQueuedRequests( iDevice, tr("%1 is not responding").arg( pState->descriptor.sDeviceName ) );
+
+    if ( !bWasOpen )
+    {
+        qDebug() << pState->descriptor.sDeviceName << "is not responding - holding requests";
+        emit signalCircuitOpened( iDevice );
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// Runs SERIAL_BREAKER_RETRY_MS after the circuit opened.  A device that lost its port is searched for again,
+// otherwise it is sent its probe request and the answer decides whether the circuit closes.
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortIOWorker::handleBreakerTimeout( void )
+{
+    QTimer * pTimer = qobject_cast<QTimer *>( sender() );
+    int iDevice = m_BreakerTimerToDevice.value( pTimer, SERIAL_INVALID_DEVICE );
+    SerialDeviceState * pState = m_Devices.value( iDevice, NULL );
+
+    if ( ( pState == NULL ) || ( pState->eCircuitState != eCIRCUIT_OPEN ) )
+    {
+        return;
+    }
+
+    if ( pState->pPort == NULL )
+    {
+        pState->pBreakerTimer->start( SERIAL_BREAKER_RETRY_MS );
+        discoverDevices();
+        return;
+    }
+
+    pState->eCircuitState = eCIRCUIT_HALF_OPEN;
+
+    // without a probe request the next real request is the trial
+    if ( pState->descriptor.baProbeRequest.isEmpty() )
+    {
+        return;
+    }
+
+    SerialRequest probe;
+    probe.uiRequestID   = 0;
+    probe.baRequest     = pState->descriptor.baProbeRequest;
+    probe.iTimeoutMS    = SERIAL_PROBE_TIMEOUT_MS;
+    probe.iCommandType  = SERIAL_DEFAULT_COMMAND;
+    probe.bBreakerProbe = true;
+
+    pState->requestQueue.prepend( probe );
+
+    if ( pState->bRequestActive == false )
+    {
+        startNextRequest( iDevice );
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortIOWorker::handleReadyRead( void )
+{
+    QSerialPort * pPort = qobject_cast<QSerialPort *>( sender() );
+    int iDevice = m_PortToDevice.value( pPort, SERIAL_INVALID_DEVICE );
+    SerialDeviceState * pState = m_Devices.value( iDevice, NULL );
+
+    if ( pState == NULL )
+    {
+        return;
+    }
+
+    // the tail of a reply that already timed out
+    if ( pState->pQuietTimer->isActive() )
+    {
+        pPort->readAll();
+        return;
+    }
+
+    pState->baRxBuffer.append( pPort->readAll() );
+
+    forever
+    {
+        int iFrameLength = pState->descriptor.pFrameExtractor->extractFrame( pState->baRxBuffer );
+
+        if ( iFrameLength == 0 )
+        {
+            break;
+        }
+
+        if ( iFrameLength < 0 )
+        {
+            pState->baRxBuffer.remove( 0, -iFrameLength );
+            continue;
+        }
+
+        QByteArray baFrame = pState->baRxBuffer.left( iFrameLength );
+        pState->baRxBuffer.remove( 0, iFrameLength );
+
+        if ( pState->bRequestActive )
+        {
+            completeActiveRequest( iDevice, baFrame );
+        }
+        else
+        {
+            emit signalUnsolicitedFrame( iDevice, baFrame );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortIOWorker::handleRequestTimeout( void )
+{
+    QTimer * pTimer = qobject_cast<QTimer *>( sender() );
+    int iDevice = m_TimerToDevice.value( pTimer, SERIAL_INVALID_DEVICE );
+    SerialDeviceState * pState = m_Devices.value( iDevice, NULL );
+
+    if ( ( pState == NULL ) || ( pState->bRequestActive == false ) )
+    {
+        return;
+    }
+
+    pState->bRequestActive = false;
+    pState->baRxBuffer.clear();
+
+    if ( !pState->activeRequest.bBreakerProbe )
+    {
+        emit signalTimeout( iDevice, pState->activeRequest.uiRequestID,
+                            tr("Wait read response timeout %1").arg( QTime::currentTime().toString() ) );
+    }
+
+    recordFailure( iDevice );
+
+    // let a late reply arrive and be thrown away before the next request goes out
+    pState->pQuietTimer->start( SERIAL_QUIET_INTERVAL_MS );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortIOWorker::handleQuietIntervalElapsed( void )
+{
+    QTimer * pTimer = qobject_cast<QTimer *>( sender() );
+    int iDevice = m_QuietTimerToDevice.value( pTimer, SERIAL_INVALID_DEVICE );
+    SerialDeviceState * pState = m_Devices.value( iDevice, NULL );
+
+    if ( ( pState == NULL ) || pState->bRequestActive )
+    {
+        return;
+    }
+
+    startNextRequest( iDevice );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortIOWorker::handlePortError( QSerialPort::SerialPortError error )
+{
+    QSerialPort * pPort = qobject_cast<QSerialPort *>( sender() );
+    int iDevice = m_PortToDevice.value( pPort, SERIAL_INVALID_DEVICE );
+
+    if ( ( iDevice == SERIAL_INVALID_DEVICE ) || ( error == QSerialPort::NoError ) )
+    {
+        return;
+    }
+
+    // a ResourceError means the device went away (unplugged USB adapter, etc.)
+    if ( error == QSerialPort::ResourceError )
+    {
+        detachPort( iDevice, pPort->errorString() );
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+QSerialPort * SerialPortIOWorker::openPort( const QString & sPortName, qint32 iBaudRate )
+{
+    QSerialPort * pPort = new QSerialPort( this );
+
+    pPort->setPortName( sPortName );
+
+    if ( !pPort->open( QIODevice::ReadWrite ) )
+    {
+        delete pPort;
+        return NULL;
+    }
+
+    pPort->setBaudRate( iBaudRate );
+
+    return pPort;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortIOWorker::attachPort( int iDevice, QSerialPort * pPort, const QString & sPortName )
+{
+    SerialDeviceState * pState = m_Devices.value( iDevice, NULL );
+
+    if ( pState == NULL )
+    {
+        pPort->close();
+        pPort->deleteLater();
+        return;
+    }
+
+    pPort->setParent( this );
+    pState->pPort = pPort;
+    pState->sPortName = sPortName;
+    pState->baRxBuffer.clear();
+
+    m_PortToDevice.insert( pPort, iDevice );
+    connect( pPort, SIGNAL(readyRead()), this, SLOT(handleReadyRead()) );
+    connect( pPort, SIGNAL(error(QSerialPort::SerialPortError)), this, SLOT(handlePortError(QSerialPort::SerialPortError)) );
+
+    qDebug() << pState->descriptor.sDeviceName << "using Serial Port: " << sPortName;
+
+    emit signalDeviceConnected( iDevice, sPortName );
+
+    // the device was either identified by its probe or is a fresh guess - either way give it a chance
+    recordSuccess( iDevice );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortIOWorker::detachPort( int iDevice, const QString & sReason )
+{
+    SerialDeviceState * pState = m_Devices.value( iDevice, NULL );
+
+    if ( ( pState == NULL ) || ( pState->pPort == NULL ) )
+    {
+        return;
+    }
+
+    QSerialPort * pPort = pState->pPort;
+
+    m_PortToDevice.remove( pPort );
+    pPort->disconnect( this );
+    pPort->close();
+    pPort->deleteLater();
+
+    pState->pPort = NULL;
+    pState->sPortName.clear();
+    pState->baRxBuffer.clear();
+    pState->pTimeoutTimer->stop();
+    pState->pQuietTimer->stop();
+
+    // nothing queued for this device can be delivered any more
+    if ( pState->bRequestActive )
+    {
+        pState->bRequestActive = false;
+        if ( !pState->activeRequest.bBreakerProbe )
+        {
+            emit signalError( iDevice, pState->activeRequest.uiRequestID, sReason );
+        }
+    }
+
+    failQueuedRequests( iDevice, sReason );
+
+    emit signalDeviceDisconnected( iDevice );
+
+    // keep looking for it every SERIAL_BREAKER_RETRY_MS
+    openCircuit( iDevice );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortIOWorker::failQueuedRequests( int iDevice, const QString & sReason )
+{
+    SerialDeviceState * pState = m_Devices.value( iDevice, NULL );
+
+    while ( !pState->requestQueue.isEmpty() )
+    {
+        SerialRequest request = pState->requestQueue.dequeue();
+        if ( !request.bBreakerProbe )
+        {
+            emit signalError( iDevice, request.uiRequestID, sReason );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+bool SerialPortIOWorker::isPortClaimed( const QString & sPortName )
+{
+    QHashIterator<int, SerialDeviceState *> i( m_Devices );
+
+    while ( i.hasNext() )
+    {
+        i.next();
+        if ( ( i.value()->pPort != NULL ) && ( i.value()->sPortName == sPortName ) )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// Builds the list of (device, port) pairs to probe.  A device's preferred port is tried first.
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortIOWorker::discoverDevices( void )
+{
+    if ( m_bDiscoveryRunning )
+    {
+        m_bDiscoveryPending = true;
+        return;
+    }
+
+    QStringList slPortNames;
+    QList<QSerialPortInfo> infos = QSerialPortInfo::availablePorts();
+    QListIterator<QSerialPortInfo> p( infos );
+    while ( p.hasNext() )
+    {
+        slPortNames.append( p.next().portName() );
+    }
+
+    m_ProbeQueue.clear();
+
+    QHashIterator<int, SerialDeviceState *> i( m_Devices );
+    while ( i.hasNext() )
+    {
+        i.next();
+        SerialDeviceState * pState = i.value();
+
+        if ( ( pState->pPort != NULL ) || pState->descriptor.baProbeRequest.isEmpty() )
+        {
+            continue;
+        }
+
+        SerialProbeCandidate candidate;
+        candidate.iDevice = i.key();
+
+        // the preferred port is tried even if it is not enumerated (ptys, /dev/serial/by-id links, ...)
+        if ( !pState->descriptor.sPreferredPortName.isEmpty() )
+        {
+            candidate.sPortName = pState->descriptor.sPreferredPortName;
+            m_ProbeQueue.enqueue( candidate );
+        }
+
+        foreach ( const QString & sPortName, slPortNames )
+        {
+            if ( sPortName != pState->descriptor.sPreferredPortName )
+            {
+                candidate.sPortName = sPortName;
+                m_ProbeQueue.enqueue( candidate );
+            }
+        }
+    }
+
+    m_bDiscoveryRunning = true;
+    probeNextCandidate();
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortIOWorker::rediscoverDevice( int iDevice )
+{
+    detachPort( iDevice, tr("Serial device is being rediscovered") );
+    discoverDevices();
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortIOWorker::probeNextCandidate( void )
+{
+    while ( !m_ProbeQueue.isEmpty() )
+    {
+        m_ActiveProbe = m_ProbeQueue.dequeue();
+
+        SerialDeviceState * pState = m_Devices.value( m_ActiveProbe.iDevice, NULL );
+
+        // skip devices that were placed by an earlier probe and ports that are already taken
+        if ( ( pState == NULL ) || ( pState->pPort != NULL ) || isPortClaimed( m_ActiveProbe.sPortName ) )
+        {
+            continue;
+        }
+
+        m_pProbePort = openPort( m_ActiveProbe.sPortName, pState->descriptor.iBaudRate );
+        if ( m_pProbePort == NULL )
+        {
+            continue;
+        }
+
+        if ( m_pProbeTimer == NULL )
+        {
+            m_pProbeTimer = new QTimer( this );
+            m_pProbeTimer->setSingleShot( true );
+            connect( m_pProbeTimer, SIGNAL(timeout()), this, SLOT(handleProbeTimeout()) );
+        }
+
+        m_baProbeBuffer.clear();
+        connect( m_pProbePort, SIGNAL(readyRead()), this, SLOT(handleProbeReadyRead()) );
+        m_pProbePort->write( pState->descriptor.baProbeRequest );
+        m_pProbeTimer->start( SERIAL_PROBE_TIMEOUT_MS );
+        return;
+    }
+
+    m_ActiveProbe.iDevice = SERIAL_INVALID_DEVICE;
+    assignUnprobedDevices();
+
+    // anything still without a port is retried by its circuit breaker
+    QHashIterator<int, SerialDeviceState *> i( m_Devices );
+    while ( i.hasNext() )
+    {
+        i.next();
+        if ( ( i.value()->pPort == NULL ) && ( i.value()->eCircuitState != eCIRCUIT_OPEN ) )
+        {
+            openCircuit( i.key() );
+        }
+    }
+
+    m_bDiscoveryRunning = false;
+    emit signalDiscoveryFinished();
+
+    if ( m_bDiscoveryPending )
+    {
+        m_bDiscoveryPending = false;
+        discoverDevices();
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortIOWorker::handleProbeReadyRead( void )
+{
+    SerialDeviceState * pState = m_Devices.value( m_ActiveProbe.iDevice, NULL );
+
+    if ( ( m_pProbePort == NULL ) || ( pState == NULL ) )
+    {
+        return;
+    }
+
+    m_baProbeBuffer.append( m_pProbePort->readAll() );
+
+    forever
+    {
+        int iFrameLength = pState->descriptor.pFrameExtractor->extractFrame( m_baProbeBuffer );
+
+        if ( iFrameLength == 0 )
+        {
+            return;
+        }
+
+        if ( iFrameLength < 0 )
+        {
+            m_baProbeBuffer.remove( 0, -iFrameLength );
+            continue;
+        }
+
+        finishProbe( m_baProbeBuffer.left( iFrameLength ).contains( pState->descriptor.baProbeSignature ) );
+        return;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortIOWorker::handleProbeTimeout( void )
+{
+    finishProbe( false );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortIOWorker::finishProbe( bool bMatched )
+{
+    QSerialPort * pPort = m_pProbePort;
+
+    m_pProbeTimer->stop();
+    m_pProbePort = NULL;
+
+    if ( pPort == NULL )
+    {
+        return;
+    }
+
+    pPort->disconnect( this );
+
+    if ( bMatched )
+    {
+        attachPort( m_ActiveProbe.iDevice, pPort, m_ActiveProbe.sPortName );
+    }
+    else
+    {
+        pPort->close();
+        pPort->deleteLater();
+    }
+
+    probeNextCandidate();
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// Devices without a probe request can not be recognised, so they are only ever given their preferred port.  Handing
+// them whatever port is left over would give the door controller the Fluke's port whenever the Fluke is unplugged.
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortIOWorker::assignUnprobedDevices( void )
+{
+    QHashIterator<int, SerialDeviceState *> i( m_Devices );
+    while ( i.hasNext() )
+    {
+        i.next();
+        SerialDeviceState * pState = i.value();
+        QString sPortName = pState->descriptor.sPreferredPortName;
+
+        if ( ( pState->pPort != NULL ) || !pState->descriptor.baProbeRequest.isEmpty() )
+        {
+            continue;
+        }
+
+        if ( sPortName.isEmpty() )
+        {
+            qDebug() << pState->descriptor.sDeviceName << "has no serial port configured";
+            continue;
+        }
+
+        if ( isPortClaimed( sPortName ) )
+        {
+            qDebug() << pState->descriptor.sDeviceName << "Serial Port: " << sPortName << "is in use by another device";
+            continue;
+        }
+
+        QSerialPort * pPort = openPort( sPortName, pState->descriptor.iBaudRate );
+        if ( pPort != NULL )
+        {
+            attachPort( i.key(), pPort, sPortName );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortIOWorker::shutdown( void )
+{
+    if ( m_pProbePort != NULL )
+    {
+        m_pProbePort->close();
+        delete m_pProbePort;
+        m_pProbePort = NULL;
+    }
+
+    QList<int> devices = m_Devices.keys();
+    foreach ( int iDevice, devices )
+    {
+        detachPort( iDevice, tr("Serial port broker is shutting down") );
+        m_Devices.value( iDevice )->pBreakerTimer->stop();
+    }
+}
+
+//=================================================================================================================
+// SerialPortBroker
+//=================================================================================================================
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+SerialPortBroker::SerialPortBroker( QObject *parent ) :
+    QObject( parent ),
+    m_pWorker( NULL ),
+    m_NextDeviceHandle( 0 ),
+    m_NextRequestID( 0 )
+{
+    qRegisterMetaType<SerialDeviceDescriptor>("SerialDeviceDescriptor");
+
+    m_pWorker = new SerialPortIOWorker;
+    m_pWorker->moveToThread( &m_IOThread );
+    connect( &m_IOThread, SIGNAL(finished()), m_pWorker, SLOT(deleteLater()) );
+
+    connect( m_pWorker, SIGNAL(signalResponse(int,uint,QByteArray)), this, SIGNAL(signalResponse(int,uint,QByteArray)) );
+    connect( m_pWorker, SIGNAL(signalUnsolicitedFrame(int,QByteArray)), this, SIGNAL(signalUnsolicitedFrame(int,QByteArray)) );
+    connect( m_pWorker, SIGNAL(signalTimeout(int,uint,QString)), this, SIGNAL(signalTimeout(int,uint,QString)) );
+    connect( m_pWorker, SIGNAL(signalError(int,uint,QString)), this, SIGNAL(signalError(int,uint,QString)) );
+    connect( m_pWorker, SIGNAL(signalDeviceConnected(int,QString)), this, SLOT(handleDeviceConnected(int,QString)) );
+    connect( m_pWorker, SIGNAL(signalDeviceDisconnected(int)), this, SLOT(handleDeviceDisconnected(int)) );
+    connect( m_pWorker, SIGNAL(signalDiscoveryFinished()), this, SIGNAL(signalDiscoveryFinished()) );
+    connect( m_pWorker, SIGNAL(signalCircuitOpened(int)), this, SIGNAL(signalCircuitOpened(int)) );
+    connect( m_pWorker, SIGNAL(signalCircuitClosed(int)), this, SIGNAL(signalCircuitClosed(int)) );
+
+    m_IOThread.start();
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+SerialPortBroker::~SerialPortBroker()
+{
+    QMetaObject::invokeMethod( m_pWorker, "shutdown", Qt::BlockingQueuedConnection );
+    m_IOThread.quit();
+    m_IOThread.wait();
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+int SerialPortBroker::registerDevice( const SerialDeviceDescriptor & descriptor )
+{
+    int iDevice = m_NextDeviceHandle.fetchAndAddOrdered( 1 );
+
+    QMetaObject::invokeMethod( m_pWorker, "addDevice", Qt::QueuedConnection,
+                               Q_ARG( int, iDevice ),
+                               Q_ARG( SerialDeviceDescriptor, descriptor ) );
+    return iDevice;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortBroker::setPreferredPortName( int iDevice, QString sPortName )
+{
+    QMetaObject::invokeMethod( m_pWorker, "setPreferredPortName", Qt::QueuedConnection,
+                               Q_ARG( int, iDevice ),
+                               Q_ARG( QString, sPortName ) );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// Queues a request for the device and returns the ID that will accompany its response, timeout or error signal.
+// iCommandType groups requests with similar response times (e.g. a quick query vs. a slow measurement) so each
+// group gets its own latency distribution and adaptive timeout.
+//-----------------------------------------------------------------------------------------------------------------
+uint SerialPortBroker::submitRequest( int iDevice, const QByteArray & baRequest, int iCommandType, int iTimeoutMS )
+{
+    uint uiRequestID = (uint) m_NextRequestID.fetchAndAddOrdered( 1 );
+
+    QMetaObject::invokeMethod( m_pWorker, "queueRequest", Qt::QueuedConnection,
+                               Q_ARG( int, iDevice ),
+                               Q_ARG( uint, uiRequestID ),
+                               Q_ARG( QByteArray, baRequest ),
+                               Q_ARG( int, iTimeoutMS ),
+                               Q_ARG( int, iCommandType ) );
+    return uiRequestID;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortBroker::discoverDevices( void )
+{
+    QMetaObject::invokeMethod( m_pWorker, "discoverDevices", Qt::QueuedConnection );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortBroker::rediscoverDevice( int iDevice )
+{
+    QMetaObject::invokeMethod( m_pWorker, "rediscoverDevice", Qt::QueuedConnection, Q_ARG( int, iDevice ) );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+bool SerialPortBroker::isDeviceConnected( int iDevice )
+{
+    QMutexLocker locker( &m_PortNameMutex );
+    return m_ConnectedPortNames.contains( iDevice );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+QString SerialPortBroker::getDevicePortName( int iDevice )
+{
+    QMutexLocker locker( &m_PortNameMutex );
+    return m_ConnectedPortNames.value( iDevice );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortBroker::handleDeviceConnected( int iDevice, QString sPortName )
+{
+    {
+        QMutexLocker locker( &m_PortNameMutex );
+        m_ConnectedPortNames.insert( iDevice, sPortName );
+    }
+
+    emit signalDeviceConnected( iDevice, sPortName );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialPortBroker::handleDeviceDisconnected( int iDevice )
+{
+    {
+        QMutexLocker locker( &m_PortNameMutex );
+        m_ConnectedPortNames.remove( iDevice );
+    }
+
+    emit signalDeviceDisconnected( iDevice );
+}
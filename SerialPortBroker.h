@@ -0,0 +1,275 @@
+#ifndef SERIALPORTBROKER_H
+#define SERIALPORTBROKER_H
+
+#include <QObject>
+#include <QThread>
+#include <QMutex>
+#include <QAtomicInt>
+#include <QHash>
+#include <QQueue>
+#include <QStringList>
+#include <QSharedPointer>
+#include <QElapsedTimer>
+#include <QMetaType>
+#include <QtSerialPort/QSerialPort>
+
+#include "SerialLatencyHistogram.h"
+
+class QTimer;
+
+static const int SERIAL_DEFAULT_TIMEOUT_MS = 3000;
+static const int SERIAL_PROBE_TIMEOUT_MS   = 500;
+static const int SERIAL_INVALID_DEVICE     = -1;
+static const int SERIAL_ADAPTIVE_TIMEOUT   = -1;
+static const int SERIAL_DEFAULT_COMMAND    = 0;
+
+// after a timeout the port is left alone this long so a late reply is dropped instead of answering the next request
+static const int SERIAL_QUIET_INTERVAL_MS  = 250;
+
+// adaptive timeout = p99 latency * safety factor, clamped to the descriptor's min/max timeout
+static const double  SERIAL_TIMEOUT_PERCENTILE      = 0.99;
+static const double  SERIAL_TIMEOUT_SAFETY_FACTOR   = 3.0;
+static const quint32 SERIAL_MIN_LATENCY_SAMPLES     = 20;
+
+// default iMinTimeoutMS, the floor of the adaptive timeout.  It covers the slowest legitimate reply on the
+// 9600 - 19200 baud links: a Fluke MEAS? reply only comes after the measurement itself, which takes far longer than
+// moving the ~20 byte reply (~20 ms at 9600), and a p99 collected while the instrument happened to answer quickly
+// must not pull the timeout below that.  Devices with a short, fixed turnaround (the door controller) set a lower
+// iMinTimeoutMS.
+static const int     SERIAL_MIN_TIMEOUT_MS          = 1000;
+
+// circuit breaker
+static const int SERIAL_BREAKER_FAILURE_THRESHOLD = 3;
+static const int SERIAL_BREAKER_RETRY_MS          = 5000;
+
+//-----------------------------------------------------------------------------------------------------------------
+// A frame extractor tells the broker where a complete response ends in the bytes received so far.
+//   extractFrame() returns  > 0 : length of a complete frame at the front of baBuffer
+//                           = 0 : more bytes are needed
+//                           < 0 : -(number of leading bytes to discard as noise)
+// Extractors are called from the serial I/O thread and must not keep state between calls.
+//-----------------------------------------------------------------------------------------------------------------
+class SerialFrameExtractor
+{
+public:
+    virtual ~SerialFrameExtractor() {}
+    virtual int extractFrame( const QByteArray & baBuffer ) const = 0;
+};
+
+class SerialLineFrameExtractor : public SerialFrameExtractor
+{
+public:
+    explicit SerialLineFrameExtractor( char cTerminator = '\n' );
+    int extractFrame( const QByteArray & baBuffer ) const;
+
+private:
+    char m_cTerminator;
+};
+
+class SerialFixedLengthFrameExtractor : public SerialFrameExtractor
+{
+public:
+    explicit SerialFixedLengthFrameExtractor( int iFrameLength );
+    int extractFrame( const QByteArray & baBuffer ) const;
+
+private:
+    int m_iFrameLength;
+};
+
+//-----------------------------------------------------------------------------------------------------------------
+// Describes a logical device (reference thermometer, door/light controller, ...) that shares the broker.
+// Devices with a probe request are matched to a port by the probe response.  Devices without a probe are
+// only opened on their preferred port, once every probed device has been placed, and stay disconnected if it
+// is not set or already taken.  The probe request is also what the circuit breaker sends to find out whether
+// a device that stopped answering is back.
+//-----------------------------------------------------------------------------------------------------------------
+struct SerialDeviceDescriptor
+{
+    SerialDeviceDescriptor();
+
+    QString    sDeviceName;
+    QString    sPreferredPortName;
+    qint32     iBaudRate;
+    int        iDefaultTimeoutMS;      // used until enough latency samples have been collected
+    int        iMinTimeoutMS;
+    int        iMaxTimeoutMS;
+    QByteArray baProbeRequest;
+    QByteArray baProbeSignature;
+    QSharedPointer<SerialFrameExtractor> pFrameExtractor;
+};
+
+Q_DECLARE_METATYPE(SerialDeviceDescriptor)
+
+//-----------------------------------------------------------------------------------------------------------------
+// SerialPortIOWorker - lives in the broker's I/O thread and owns every QSerialPort.  All I/O is event driven;
+// nothing in here blocks.  Only SerialPortBroker talks to it, always through queued invocations.
+//-----------------------------------------------------------------------------------------------------------------
+class SerialPortIOWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SerialPortIOWorker( QObject *parent = 0 );
+    ~SerialPortIOWorker();
+
+public slots:
+    void addDevice( int iDevice, SerialDeviceDescriptor descriptor );
+    void setPreferredPortName( int iDevice, QString sPortName );
+    void queueRequest( int iDevice, uint uiRequestID, QByteArray baRequest, int iTimeoutMS, int iCommandType );
+    void discoverDevices( void );
+    void rediscoverDevice( int iDevice );
+    void shutdown( void );
+
+signals:
+    void signalResponse( int iDevice, uint uiRequestID, QByteArray baResponse );
+    void signalUnsolicitedFrame( int iDevice, QByteArray baFrame );
+    void signalTimeout( int iDevice, uint uiRequestID, QString sMessage );
+    void signalError( int iDevice, uint uiRequestID, QString sError );
+    void signalDeviceConnected( int iDevice, QString sPortName );
+    void signalDeviceDisconnected( int iDevice );
+    void signalDiscoveryFinished( void );
+    void signalCircuitOpened( int iDevice );
+    void signalCircuitClosed( int iDevice );
+
+private slots:
+    void handleReadyRead( void );
+    void handleBreakerTimeout( void );
+    void handlePortError( QSerialPort::SerialPortError error );
+    void handleRequestTimeout( void );
+    void handleQuietIntervalElapsed( void );
+    void handleProbeReadyRead( void );
+    void handleProbeTimeout( void );
+
+private:
+
+    enum eCircuitStates
+    {
+        eCIRCUIT_CLOSED    = 0,     // normal operation
+        eCIRCUIT_OPEN      = 1,     // device is not answering - requests fail immediately
+        eCIRCUIT_HALF_OPEN = 2      // a trial exchange is in flight
+    };
+
+    struct SerialRequest
+    {
+        uint       uiRequestID;
+        QByteArray baRequest;
+        int        iTimeoutMS;
+        int        iCommandType;
+        bool       bBreakerProbe;
+    };
+
+    struct SerialDeviceState
+    {
+        SerialDeviceDescriptor descriptor;
+        QSerialPort *          pPort;
+        QString                sPortName;
+        QByteArray             baRxBuffer;
+        QQueue<SerialRequest>  requestQueue;
+        SerialRequest          activeRequest;
+        bool                   bRequestActive;
+        QTimer *               pTimeoutTimer;
+        QTimer *               pQuietTimer;            // running while late bytes are being discarded
+        QElapsedTimer          requestTimer;
+
+        QHash<int, SerialLatencyHistogram> latencyHistograms;  // keyed by command type
+        eCircuitStates         eCircuitState;
+        int                    iConsecutiveFailures;
+        QTimer *               pBreakerTimer;
+    };
+
+    struct SerialProbeCandidate
+    {
+        int     iDevice;
+        QString sPortName;
+    };
+
+    //------------------------------------------
+    // Private Functions
+    //------------------------------------------
+    QSerialPort * openPort( const QString & sPortName, qint32 iBaudRate );
+    void attachPort( int iDevice, QSerialPort * pPort, const QString & sPortName );
+    void detachPort( int iDevice, const QString & sReason );
+    void startNextRequest( int iDevice );
+    void completeActiveRequest( int iDevice, const QByteArray & baResponse );
+    int  getRequestTimeoutMS( SerialDeviceState * pState, int iCommandType );
+    void recordSuccess( int iDevice );
+    void recordFailure( int iDevice );
+    void openCircuit( int iDevice );
+    void failQueuedRequests( int iDevice, const QString & sReason );
+    bool isPortClaimed( const QString & sPortName );
+    void probeNextCandidate( void );
+    void finishProbe( bool bMatched );
+    void assignUnprobedDevices( void );
+
+    //------------------------------------------
+    // Private Data
+    //------------------------------------------
+    QHash<int, SerialDeviceState *> m_Devices;
+    QHash<QSerialPort *, int>       m_PortToDevice;
+    QHash<QTimer *, int>            m_TimerToDevice;
+    QHash<QTimer *, int>            m_BreakerTimerToDevice;
+    QHash<QTimer *, int>            m_QuietTimerToDevice;
+
+    QQueue<SerialProbeCandidate> m_ProbeQueue;
+    SerialProbeCandidate         m_ActiveProbe;
+    QSerialPort *                m_pProbePort;
+    QTimer *                     m_pProbeTimer;
+    QByteArray                   m_baProbeBuffer;
+    bool                         m_bDiscoveryRunning;
+    bool                         m_bDiscoveryPending;
+};
+
+//-----------------------------------------------------------------------------------------------------------------
+// SerialPortBroker - the one owner of all serial ports in the application.  Logical device clients register a
+// SerialDeviceDescriptor and get a device handle back; requests for a device are queued and sent one at a time
+// on that device's port, while different devices proceed in parallel on the single I/O thread.
+// Unless a request carries an explicit timeout, its timeout comes from the latency measured for that device and
+// command type.  A device that keeps timing out has its circuit opened: requests fail at once until a probe
+// (or, for devices without a probe, the next request) gets an answer again.
+// All public functions are safe to call from any thread.
+//-----------------------------------------------------------------------------------------------------------------
+class SerialPortBroker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SerialPortBroker( QObject *parent = 0 );
+    ~SerialPortBroker();
+
+    int  registerDevice( const SerialDeviceDescriptor & descriptor );
+    void setPreferredPortName( int iDevice, QString sPortName );
+    uint submitRequest( int iDevice, const QByteArray & baRequest, int iCommandType = SERIAL_DEFAULT_COMMAND,
+                        int iTimeoutMS = SERIAL_ADAPTIVE_TIMEOUT );
+    void discoverDevices( void );
+    void rediscoverDevice( int iDevice );
+
+    bool    isDeviceConnected( int iDevice );
+    QString getDevicePortName( int iDevice );
+
+signals:
+    void signalResponse( int iDevice, uint uiRequestID, QByteArray baResponse );
+    void signalUnsolicitedFrame( int iDevice, QByteArray baFrame );
+    void signalTimeout( int iDevice, uint uiRequestID, QString sMessage );
+    void signalError( int iDevice, uint uiRequestID, QString sError );
+    void signalDeviceConnected( int iDevice, QString sPortName );
+    void signalDeviceDisconnected( int iDevice );
+    void signalDiscoveryFinished( void );
+    void signalCircuitOpened( int iDevice );
+    void signalCircuitClosed( int iDevice );
+
+private slots:
+    void handleDeviceConnected( int iDevice, QString sPortName );
+    void handleDeviceDisconnected( int iDevice );
+
+private:
+    QThread              m_IOThread;
+    SerialPortIOWorker * m_pWorker;
+
+    QAtomicInt m_NextDeviceHandle;
+    QAtomicInt m_NextRequestID;
+
+    QMutex                 m_PortNameMutex;
+    QHash<int, QString>    m_ConnectedPortNames;
+};
+
+#endif // SERIALPORTBROKER_H
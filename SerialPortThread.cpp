@@ -1,155 +0,0 @@
-#include "SerialPortThread.h"
-
-/****************************************************************************
-**
-** Copyright (C) 2012 Denis Shienkov <denis.shienkov@gmail.com>
-** Contact: https://www.qt.io/licensing/
-**
-** This file is part of the QtSerialPort module of the Qt Toolkit.
-**
-** $QT_BEGIN_LICENSE:BSD$
-** Commercial License Usage
-** Licensees holding valid commercial Qt licenses may use this file in
-** accordance with the commercial license agreement provided with the
-** Software or, alternatively, in accordance with the terms contained in
-** a written agreement between you and The Qt Company. For licensing terms
-** and conditions see https://www.qt.io/terms-conditions. For further
-** information use the contact form at https://www.qt.io/contact-us.
-**
-** BSD License Usage
-** Alternatively, you may use this file under the terms of the BSD license
-** as follows:
-**
-** "Redistribution and use in source and binary forms, with or without
-** modification, are permitted provided that the following conditions are
-** met:
-**   * Redistributions of source code must retain the above copyright
-**     notice, this list of conditions and the following disclaimer.
-**   * Redistributions in binary form must reproduce the above copyright
-**     notice, this list of conditions and the following disclaimer in
-**     the documentation and/or other materials provided with the
-**     distribution.
-**   * Neither the name of The Qt Company Ltd nor the names of its
-**     contributors may be used to endorse or promote products derived
-**     from this software without specific prior written permission.
-**
-**
-** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
-** "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
-** LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
-** A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
-** OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
-** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
-** LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
-** DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
-** THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
-** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
-** OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE."
-**
-** $QT_END_LICENSE$
-**
-****************************************************************************/
-
-#include "SerialPortThread.h"
-
-#include <QtSerialPort/QSerialPort>
-
-#include <QTime>
-
-QT_USE_NAMESPACE
-
-//-----------------------------------------------------------------------------------------------------------------
-//-----------------------------------------------------------------------------------------------------------------
-SerialPortThread::SerialPortThread(QObject *parent)
-    : QThread(parent), waitTimeout(0), quit(false)
-{
-}
-
-//-----------------------------------------------------------------------------------------------------------------
-//-----------------------------------------------------------------------------------------------------------------
-SerialPortThread::~SerialPortThread()
-{
-    mutex.lock();
-    quit = true;
-    cond.wakeOne();
-    mutex.unlock();
-    wait();
-}
-
-//-----------------------------------------------------------------------------------------------------------------
-//-----------------------------------------------------------------------------------------------------------------
-void SerialPortThread::transaction(const QString &portName, int waitTimeout, const QByteArray &request)
-{
-    QMutexLocker locker(&mutex);
-    this->portName = portName;
-    this->waitTimeout = waitTimeout;
-    this->request = request;
-    if (!isRunning())
-        start();
-    else
-        cond.wakeOne();
-}
-
-//-----------------------------------------------------------------------------------------------------------------
-//-----------------------------------------------------------------------------------------------------------------
-void SerialPortThread::run()
-{
-    bool currentPortNameChanged = false;
-
-    mutex.lock();
-    QString currentPortName;
-    if (currentPortName != portName) {
-        currentPortName = portName;
-        currentPortNameChanged = true;
-    }
-
-    int currentWaitTimeout = waitTimeout;
-    QByteArray currentRequest = request;
-    mutex.unlock();
-    QSerialPort serial;
-    serial.setBaudRate(QSerialPort::Baud19200);
-
-    while (!quit) {
-        if (currentPortNameChanged) {
-            serial.close();
-            serial.setPortName(currentPortName);
-
-            if (!serial.open(QIODevice::ReadWrite)) {
-                emit error(tr("Can't open %1, error code %2")
-                           .arg(portName).arg(serial.error()));
-                return;
-            }
-        }
-        // write request
-        //QByteArray requestData = currentRequest.toLocal8Bit();
-        serial.write(currentRequest);
-        if (serial.waitForBytesWritten(waitTimeout)) {
-            // read response
-            if (serial.waitForReadyRead(currentWaitTimeout)) {
-                QByteArray responseData = serial.readAll();
-                while (serial.waitForReadyRead(10))
-                    responseData += serial.readAll();
-
-                //QString response(responseData);
-                emit this->response(responseData);
-            } else {
-                emit timeout(tr("Wait read response timeout %1")
-                             .arg(QTime::currentTime().toString()));
-            }
-        } else {
-            emit timeout(tr("Wait write request timeout %1")
-                         .arg(QTime::currentTime().toString()));
-        }
-        mutex.lock();
-        cond.wait(&mutex);
-        if (currentPortName != portName) {
-            currentPortName = portName;
-            currentPortNameChanged = true;
-        } else {
-            currentPortNameChanged = false;
-        }
-        currentWaitTimeout = waitTimeout;
-        currentRequest = request;
-        mutex.unlock();
-    }
-}
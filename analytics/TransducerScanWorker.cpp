@@ -0,0 +1,549 @@
+#include "TransducerScanWorker.h"
+#include "iC3_DatabaseReadConnection.h"
+#include "ScpiReplyDecoder.h"
+
+#include <QDateTime>
+#include <algorithm>
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+TransducerAnalysisConfig::TransducerAnalysisConfig() :
+    sDatabaseFileName( "./database/LOG.db" ),
+    iDeviceID( TRANSDUCER_LOCAL_DEVICE_ID ),
+    firstDay( QDate::currentDate().addDays( -30 ) ),
+    lastDay( QDate::currentDate() ),
+    iThreads( QThread::idealThreadCount() ),
+    iControlProbe( 0 ),
+    dSetpointC( 4.0 ),
+    dBandC( 1.0 ),
+    dCycleSwingC( 0.5 ),
+    llMaxGapMS( 60 * 1000 ),
+    llWarmupMS( 2 * 60 * 60 * 1000 )
+{
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+TransducerDayStats::TransducerDayStats() :
+    llDayLengthMS( 0 ),
+    llCoveredMS( 0 ),
+    llCoolingMS( 0 ),
+    iCycles( 0 ),
+    iPulldowns( 0 ),
+    llPulldownTotalMS( 0 ),
+    llPulldownMaxMS( 0 ),
+    llInBandMS( 0 ),
+    llLongestStableMS( 0 )
+{
+    for ( int iProbe = 0; iProbe < TRANSDUCER_NUMBER_OF_RTDS; iProbe++ )
+    {
+        allSamples[iProbe] = 0;
+        adMin[iProbe] = 0.0;
+        adMax[iProbe] = 0.0;
+        adSum[iProbe] = 0.0;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+TransducerScanWorker::TransducerScanWorker( const TransducerAnalysisConfig & config, int iWorker,
+                                            QDate firstDay, QDate lastDay, QObject *parent ) :
+    QThread( parent ),
+    m_Config( config ),
+    m_sConnectionName( QString("iC3Analytics_%1").arg( iWorker ) ),
+    m_llSampleCount( 0 ),
+    m_bSucceeded( false ),
+    m_pPrevious( NULL ),
+    m_bHavePrevious( false ),
+    m_llPreviousTimeMS( 0 ),
+    m_eDirection( eCYCLE_UNKNOWN ),
+    m_llPhaseStartMS( 0 ),
+    m_llExtremeTimeMS( 0 ),
+    m_dExtreme( 0.0 ),
+    m_llLowTimeMS( 0 ),
+    m_dLow( 0.0 ),
+    m_bPulldown( false ),
+    m_llPulldownStartMS( 0 ),
+    m_bStable( false ),
+    m_llStableStartMS( 0 )
+{
+    for ( QDate date = firstDay; date <= lastDay; date = date.addDays( 1 ) )
+    {
+        TransducerDayStats day;
+        day.date = date;
+        m_Days.append( day );
+
+        // local midnight, so a day is 23 or 25 hours across a DST change
+        m_DayStartMS.append( QDateTime( date ).toMSecsSinceEpoch() );
+    }
+
+    m_DayStartMS.append( QDateTime( lastDay.addDays( 1 ) ).toMSecsSinceEpoch() );
+
+    for ( int iDay = 0; iDay < m_Days.size(); iDay++ )
+    {
+        m_Days[iDay].llDayLengthMS = m_DayStartMS[iDay + 1] - m_DayStartMS[iDay];
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+const QVector<TransducerDayStats> & TransducerScanWorker::getDays( void ) const
+{
+    return m_Days;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+qint64 TransducerScanWorker::getSampleCount( void ) const
+{
+    return m_llSampleCount;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+bool TransducerScanWorker::succeeded( void ) const
+{
+    return m_bSucceeded;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+QString TransducerScanWorker::getLastError( void ) const
+{
+    return m_sLastError;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// isValidReading - false for NaN and the Fluke's overload / open thermocouple readings (+/-9.9E37, 9.91E37)
+//-----------------------------------------------------------------------------------------------------------------
+bool TransducerScanWorker::isValidReading( double dValue )
+{
+    return ( dValue == dValue ) && ( dValue > -SCPI_OVERLOAD_VALUE ) && ( dValue < SCPI_OVERLOAD_VALUE );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// aggregateColumn - min, max and sum of a column of doubles.  Four independent lanes with no branches, so the
+// compiler keeps them in vector registers; a single accumulator would serialise every add on the one before.
+//-----------------------------------------------------------------------------------------------------------------
+void TransducerScanWorker::aggregateColumn( const double * pValues, int iCount, double & dMin, double & dMax, double & dSum )
+{
+    static const int LANES = 4;
+
+    double adMin[LANES];
+    double adMax[LANES];
+    double adSum[LANES];
+
+    for ( int iLane = 0; iLane < LANES; iLane++ )
+    {
+        adMin[iLane] = pValues[0];
+        adMax[iLane] = pValues[0];
+        adSum[iLane] = 0.0;
+    }
+
+    int iIndex = 0;
+
+    for ( ; iIndex + LANES <= iCount; iIndex += LANES )
+    {
+        for ( int iLane = 0; iLane < LANES; iLane++ )
+        {
+            double dValue = pValues[iIndex + iLane];
+
+            adMin[iLane] = ( dValue < adMin[iLane] ) ? dValue : adMin[iLane];
+            adMax[iLane] = ( dValue > adMax[iLane] ) ? dValue : adMax[iLane];
+            adSum[iLane] += dValue;
+        }
+    }
+
+    for ( ; iIndex < iCount; iIndex++ )
+    {
+        adMin[0] = qMin( adMin[0], pValues[iIndex] );
+        adMax[0] = qMax( adMax[0], pValues[iIndex] );
+        adSum[0] += pValues[iIndex];
+    }
+
+    dMin = qMin( qMin( adMin[0], adMin[1] ), qMin( adMin[2], adMin[3] ) );
+    dMax = qMax( qMax( adMax[0], adMax[1] ), qMax( adMax[2], adMax[3] ) );
+    dSum = ( adSum[0] + adSum[1] ) + ( adSum[2] + adSum[3] );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void TransducerScanWorker::run()
+{
+    iC3_DatabaseReadConnection connection;
+
+    if ( !connection.open( m_Config.sDatabaseFileName, m_sConnectionName, 0, m_Config.sSegmentStorePath ) )
+    {
+        m_sLastError = connection.GetLastError();
+        return;
+    }
+
+    QVector<iC3_TransducerSample> samples;
+
+    for ( int iDay = 0; iDay < m_Days.size(); iDay++ )
+    {
+        // the later workers pick up the detection state from the one before
+        bool bWarmup = ( iDay == 0 ) && ( m_Days[0].date == m_Config.firstDay );
+        qint64 llReadFromMS = bWarmup ? ( m_DayStartMS[0] - m_Config.llWarmupMS ) : m_DayStartMS[iDay];
+
+        samples.clear();
+
+        if ( !connection.getTransducerHistory( m_Config.iDeviceID, llReadFromMS, m_DayStartMS[iDay + 1], samples ) )
+        {
+            m_sLastError = connection.GetLastError();
+            connection.close();
+            return;
+        }
+
+        // the warm-up only feeds the control probe detection
+        int iFirstSample = 0;
+        while ( ( iFirstSample < samples.size() ) && ( samples.at( iFirstSample ).llSampleTimeMS < m_DayStartMS[iDay] ) )
+        {
+            iFirstSample++;
+        }
+
+        aggregateDay( m_Days[iDay], samples, iFirstSample );
+
+        for ( int iSample = 0; iSample < samples.size(); iSample++ )
+        {
+            const iC3_TransducerSample & sample = samples.at( iSample );
+            double dValue = sample.adRTDValues[m_Config.iControlProbe];
+
+            // a bad reading is skipped; the gap it leaves is handled with the next good one
+            if ( isValidReading( dValue ) )
+            {
+                ControlReading reading;
+                reading.llTimeMS = sample.llSampleTimeMS;
+                reading.dValue = dValue;
+                m_ControlReadings.append( reading );
+            }
+        }
+
+        m_llSampleCount += samples.size() - iFirstSample;
+    }
+
+    connection.close();
+
+    m_bSucceeded = true;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// detectControlProbe - runs the readings run() collected through the cycle, pulldown and stability detection,
+// starting from the state pPrevious ended in (NULL for the first worker).  Called from one thread, in day order,
+// after every worker has finished.
+//-----------------------------------------------------------------------------------------------------------------
+void TransducerScanWorker::detectControlProbe( TransducerScanWorker * pPrevious )
+{
+    m_pPrevious = pPrevious;
+
+    if ( pPrevious != NULL )
+    {
+        m_bHavePrevious     = pPrevious->m_bHavePrevious;
+        m_llPreviousTimeMS  = pPrevious->m_llPreviousTimeMS;
+        m_eDirection        = pPrevious->m_eDirection;
+        m_llPhaseStartMS    = pPrevious->m_llPhaseStartMS;
+        m_llExtremeTimeMS   = pPrevious->m_llExtremeTimeMS;
+        m_dExtreme          = pPrevious->m_dExtreme;
+        m_llLowTimeMS       = pPrevious->m_llLowTimeMS;
+        m_dLow              = pPrevious->m_dLow;
+        m_bPulldown         = pPrevious->m_bPulldown;
+        m_llPulldownStartMS = pPrevious->m_llPulldownStartMS;
+        m_bStable           = pPrevious->m_bStable;
+        m_llStableStartMS   = pPrevious->m_llStableStartMS;
+    }
+
+    for ( int iReading = 0; iReading < m_ControlReadings.size(); iReading++ )
+    {
+        scanControlProbe( m_ControlReadings.at( iReading ).llTimeMS, m_ControlReadings.at( iReading ).dValue );
+    }
+
+    m_ControlReadings.clear();
+    m_ControlReadings.squeeze();
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// finishControlProbe - on the last worker, counts the cooling phase and stable run still open at the end
+//-----------------------------------------------------------------------------------------------------------------
+void TransducerScanWorker::finishControlProbe( void )
+{
+    closeOpenIntervals();
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// aggregateDay - copies each probe's valid readings into one contiguous column and aggregates it
+//-----------------------------------------------------------------------------------------------------------------
+void TransducerScanWorker::aggregateDay( TransducerDayStats & day, const QVector<iC3_TransducerSample> & samples,
+                                         int iFirstSample )
+{
+    int iCount = samples.size() - iFirstSample;
+
+    if ( iCount <= 0 )
+    {
+        return;
+    }
+
+    QVector<double> column( iCount );
+    double * pColumn = column.data();
+    const iC3_TransducerSample * pSamples = samples.constData() + iFirstSample;
+
+    for ( int iProbe = 0; iProbe < TRANSDUCER_NUMBER_OF_RTDS; iProbe++ )
+    {
+        int iValues = 0;
+
+        for ( int iSample = 0; iSample < iCount; iSample++ )
+        {
+            double dValue = pSamples[iSample].adRTDValues[iProbe];
+
+            if ( isValidReading( dValue ) )
+            {
+                pColumn[iValues++] = dValue;
+            }
+        }
+
+        if ( iValues > 0 )
+        {
+            aggregateColumn( pColumn, iValues, day.adMin[iProbe], day.adMax[iProbe], day.adSum[iProbe] );
+            day.allSamples[iProbe] = iValues;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// scanControlProbe - advances the cycle, pulldown and stability detection by one valid reading.
+//
+// Cycles: the compressor is taken to be running while the probe falls from a peak to the following trough.  A peak
+// (trough) is confirmed once the probe is dCycleSwingC below (above) it, so noise smaller than the swing is not
+// counted as a cycle.
+// Pulldowns: from the first sample above the band to the first one back at or below its top.  Gaps do not end a
+// pulldown - a power cut is exactly when one is wanted.
+// Stability: runs of samples in the band with no gap between them.
+//-----------------------------------------------------------------------------------------------------------------
+void TransducerScanWorker::scanControlProbe( qint64 llTimeMS, double dValue )
+{
+    double dBandTopC = m_Config.dSetpointC + m_Config.dBandC;
+    bool bInBand = ( qAbs( dValue - m_Config.dSetpointC ) <= m_Config.dBandC );
+    bool bCovered = m_bHavePrevious && ( llTimeMS - m_llPreviousTimeMS <= m_Config.llMaxGapMS );
+
+    if ( bCovered )
+    {
+        addToDays( m_llPreviousTimeMS, llTimeMS, &TransducerDayStats::llCoveredMS );
+
+        if ( bInBand && m_bStable )
+        {
+            addToDays( m_llPreviousTimeMS, llTimeMS, &TransducerDayStats::llInBandMS );
+        }
+        else if ( !bInBand && m_bStable )
+        {
+            addStableRun( m_llStableStartMS, m_llPreviousTimeMS );
+            m_bStable = false;
+        }
+
+        switch ( m_eDirection )
+        {
+        case eCYCLE_UNKNOWN:
+            if ( dValue > m_dExtreme )
+            {
+                m_dExtreme = dValue;
+                m_llExtremeTimeMS = llTimeMS;
+            }
+            if ( dValue < m_dLow )
+            {
+                m_dLow = dValue;
+                m_llLowTimeMS = llTimeMS;
+            }
+
+            if ( dValue <= m_dExtreme - m_Config.dCycleSwingC )
+            {
+                m_eDirection = eCYCLE_FALLING;
+                m_llPhaseStartMS = m_llExtremeTimeMS;
+                m_dExtreme = dValue;
+                m_llExtremeTimeMS = llTimeMS;
+            }
+            else if ( dValue >= m_dLow + m_Config.dCycleSwingC )
+            {
+                m_eDirection = eCYCLE_RISING;
+                m_llPhaseStartMS = m_llLowTimeMS;
+                m_dExtreme = dValue;
+                m_llExtremeTimeMS = llTimeMS;
+            }
+            break;
+
+        case eCYCLE_FALLING:
+            if ( dValue < m_dExtreme )
+            {
+                m_dExtreme = dValue;
+                m_llExtremeTimeMS = llTimeMS;
+            }
+            else if ( dValue >= m_dExtreme + m_Config.dCycleSwingC )
+            {
+                // the trough is confirmed - cooling ran from the last peak to it
+                addToDays( m_llPhaseStartMS, m_llExtremeTimeMS, &TransducerDayStats::llCoolingMS );
+
+                TransducerDayStats * pDay = findDay( m_llExtremeTimeMS );
+                if ( pDay != NULL )
+                {
+                    pDay->iCycles++;
+                }
+
+                m_eDirection = eCYCLE_RISING;
+                m_llPhaseStartMS = m_llExtremeTimeMS;
+                m_dExtreme = dValue;
+                m_llExtremeTimeMS = llTimeMS;
+            }
+            break;
+
+        case eCYCLE_RISING:
+            if ( dValue > m_dExtreme )
+            {
+                m_dExtreme = dValue;
+                m_llExtremeTimeMS = llTimeMS;
+            }
+            else if ( dValue <= m_dExtreme - m_Config.dCycleSwingC )
+            {
+                m_eDirection = eCYCLE_FALLING;
+                m_llPhaseStartMS = m_llExtremeTimeMS;
+                m_dExtreme = dValue;
+                m_llExtremeTimeMS = llTimeMS;
+            }
+            break;
+        }
+    }
+    else
+    {
+        // first sample, or nothing is known about the time since the previous one
+        if ( m_bHavePrevious )
+        {
+            closeOpenIntervals();
+        }
+
+        startCycleDetection( llTimeMS, dValue );
+    }
+
+    if ( bInBand && !m_bStable )
+    {
+        m_bStable = true;
+        m_llStableStartMS = llTimeMS;
+    }
+
+    if ( ( dValue > dBandTopC ) && !m_bPulldown )
+    {
+        m_bPulldown = true;
+        m_llPulldownStartMS = llTimeMS;
+    }
+    else if ( ( dValue <= dBandTopC ) && m_bPulldown )
+    {
+        m_bPulldown = false;
+
+        TransducerDayStats * pDay = findDay( llTimeMS );
+        if ( pDay != NULL )
+        {
+            qint64 llDurationMS = llTimeMS - m_llPulldownStartMS;
+
+            pDay->iPulldowns++;
+            pDay->llPulldownTotalMS += llDurationMS;
+            pDay->llPulldownMaxMS = qMax( pDay->llPulldownMaxMS, llDurationMS );
+        }
+    }
+
+    m_bHavePrevious = true;
+    m_llPreviousTimeMS = llTimeMS;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void TransducerScanWorker::startCycleDetection( qint64 llTimeMS, double dValue )
+{
+    m_eDirection = eCYCLE_UNKNOWN;
+    m_llPhaseStartMS = llTimeMS;
+    m_dExtreme = dValue;
+    m_llExtremeTimeMS = llTimeMS;
+    m_dLow = dValue;
+    m_llLowTimeMS = llTimeMS;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// closeOpenIntervals - at a gap or the end of the scan, counts the part of a cooling phase and of a stable run seen
+// so far.  A pulldown stays open.
+//-----------------------------------------------------------------------------------------------------------------
+void TransducerScanWorker::closeOpenIntervals( void )
+{
+    if ( m_eDirection == eCYCLE_FALLING )
+    {
+        addToDays( m_llPhaseStartMS, m_llExtremeTimeMS, &TransducerDayStats::llCoolingMS );
+    }
+    m_eDirection = eCYCLE_UNKNOWN;
+
+    if ( m_bStable )
+    {
+        addStableRun( m_llStableStartMS, m_llPreviousTimeMS );
+        m_bStable = false;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// addToDays - adds [llStartMS, llEndMS) to a field of each day it covers; the part before this worker's days goes
+// to the workers before it
+//-----------------------------------------------------------------------------------------------------------------
+void TransducerScanWorker::addToDays( qint64 llStartMS, qint64 llEndMS, qint64 TransducerDayStats::*pField )
+{
+    if ( ( m_pPrevious != NULL ) && ( llStartMS < m_DayStartMS.first() ) )
+    {
+        m_pPrevious->addToDays( llStartMS, qMin( llEndMS, m_DayStartMS.first() ), pField );
+    }
+
+    llStartMS = qMax( llStartMS, m_DayStartMS.first() );
+    llEndMS = qMin( llEndMS, m_DayStartMS.last() );
+
+    while ( llStartMS < llEndMS )
+    {
+        int iDay = int( std::upper_bound( m_DayStartMS.constBegin(), m_DayStartMS.constEnd(), llStartMS ) - m_DayStartMS.constBegin() ) - 1;
+        qint64 llSliceEndMS = qMin( llEndMS, m_DayStartMS[iDay + 1] );
+
+        m_Days[iDay].*pField += llSliceEndMS - llStartMS;
+        llStartMS = llSliceEndMS;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// addStableRun - records a stable run, split at midnight, against each day's longest
+//-----------------------------------------------------------------------------------------------------------------
+void TransducerScanWorker::addStableRun( qint64 llStartMS, qint64 llEndMS )
+{
+    if ( ( m_pPrevious != NULL ) && ( llStartMS < m_DayStartMS.first() ) )
+    {
+        m_pPrevious->addStableRun( llStartMS, qMin( llEndMS, m_DayStartMS.first() ) );
+    }
+
+    llStartMS = qMax( llStartMS, m_DayStartMS.first() );
+    llEndMS = qMin( llEndMS, m_DayStartMS.last() );
+
+    while ( llStartMS < llEndMS )
+    {
+        int iDay = int( std::upper_bound( m_DayStartMS.constBegin(), m_DayStartMS.constEnd(), llStartMS ) - m_DayStartMS.constBegin() ) - 1;
+        qint64 llSliceEndMS = qMin( llEndMS, m_DayStartMS[iDay + 1] );
+
+        m_Days[iDay].llLongestStableMS = qMax( m_Days[iDay].llLongestStableMS, llSliceEndMS - llStartMS );
+        llStartMS = llSliceEndMS;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// findDay - the day holding a time, looked up in the workers before this one for earlier times; NULL outside the
+// scanned days
+//-----------------------------------------------------------------------------------------------------------------
+TransducerDayStats * TransducerScanWorker::findDay( qint64 llTimeMS )
+{
+    if ( ( m_pPrevious != NULL ) && ( llTimeMS < m_DayStartMS.first() ) )
+    {
+        return m_pPrevious->findDay( llTimeMS );
+    }
+
+    if ( ( llTimeMS < m_DayStartMS.first() ) || ( llTimeMS >= m_DayStartMS.last() ) )
+    {
+        return NULL;
+    }
+
+    int iDay = int( std::upper_bound( m_DayStartMS.constBegin(), m_DayStartMS.constEnd(), llTimeMS ) - m_DayStartMS.constBegin() ) - 1;
+
+    return &m_Days[iDay];
+}
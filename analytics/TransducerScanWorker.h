@@ -0,0 +1,142 @@
+#ifndef TRANSDUCERSCANWORKER_H
+#define TRANSDUCERSCANWORKER_H
+
+#include <QThread>
+#include <QString>
+#include <QDate>
+#include <QVector>
+
+#include "iC3_TransducerSample.h"
+
+struct TransducerAnalysisConfig
+{
+    TransducerAnalysisConfig();
+
+    QString sDatabaseFileName;  // the LOG.db (shard) holding the device
+    QString sSegmentStorePath;  // empty: raw samples are only in the database
+    int     iDeviceID;
+    QDate   firstDay;           // local days, inclusive
+    QDate   lastDay;
+    int     iThreads;
+    int     iControlProbe;      // RTD index (0 based) for duty cycle, pulldowns and stability
+    double  dSetpointC;
+    double  dBandC;             // in band: setpoint +/- band
+    double  dCycleSwingC;       // a cooling cycle turns once the probe moves this far back
+    qint64  llMaxGapMS;         // samples further apart leave the time between them uncovered
+    qint64  llWarmupMS;         // read before the first day to pick up the state the range starts in; a pulldown or
+                                // cycle that began earlier than this is measured from the start of the warm-up
+};
+
+//-----------------------------------------------------------------------------------------------------------------
+// One local day of one device.  The probe statistics skip SCPI overload / open readings.  The times are in ms and
+// only count intervals between samples no more than llMaxGapMS apart.
+//-----------------------------------------------------------------------------------------------------------------
+struct TransducerDayStats
+{
+    TransducerDayStats();
+
+    QDate  date;
+    qint64 llDayLengthMS;       // 23 or 25 hours across a DST change
+    qint64 allSamples[TRANSDUCER_NUMBER_OF_RTDS];
+    double adMin[TRANSDUCER_NUMBER_OF_RTDS];
+    double adMax[TRANSDUCER_NUMBER_OF_RTDS];
+    double adSum[TRANSDUCER_NUMBER_OF_RTDS];
+
+    qint64 llCoveredMS;
+    qint64 llCoolingMS;         // control probe falling between a peak and the following trough
+    int    iCycles;             // cooling phases ending this day
+    int    iPulldowns;          // returns into the band from above ending this day
+    qint64 llPulldownTotalMS;
+    qint64 llPulldownMaxMS;
+    qint64 llInBandMS;
+    qint64 llLongestStableMS;   // longest unbroken in band run within the day
+};
+
+//-----------------------------------------------------------------------------------------------------------------
+// TransducerScanWorker - scans a contiguous range of whole days on its own read connection.  The days are read one
+// at a time through iC3_DatabaseReadConnection::getTransducerHistory(), so compacted blocks, raw rows and segment
+// files are all included, and each day's probe columns are aggregated in one pass.
+//
+// Pulldowns, cycles and stable runs can last longer than a worker's days, so the control probe readings are only
+// collected by run().  Once every worker has finished, detectControlProbe() is called on each in day order: it
+// carries on from the state the previous worker ended in and credits the part of an interval before its own first
+// day to the earlier workers' days.  finishControlProbe() closes what is still open at the end of the last day.
+// The first worker also reads llWarmupMS ahead of the first day; that only sets up the detection state.
+//-----------------------------------------------------------------------------------------------------------------
+class TransducerScanWorker : public QThread
+{
+    Q_OBJECT
+
+public:
+    TransducerScanWorker( const TransducerAnalysisConfig & config, int iWorker, QDate firstDay, QDate lastDay,
+                          QObject *parent = 0 );
+
+    const QVector<TransducerDayStats> & getDays( void ) const;
+    qint64  getSampleCount( void ) const;
+    bool    succeeded( void ) const;
+    QString getLastError( void ) const;
+
+    void    detectControlProbe( TransducerScanWorker * pPrevious );
+    void    finishControlProbe( void );
+
+    static bool isValidReading( double dValue );
+    static void aggregateColumn( const double * pValues, int iCount, double & dMin, double & dMax, double & dSum );
+
+protected:
+    void run();
+
+private:
+
+    enum eCycleDirection
+    {
+        eCYCLE_UNKNOWN = 0,
+        eCYCLE_RISING  = 1,
+        eCYCLE_FALLING = 2
+    };
+
+    struct ControlReading
+    {
+        qint64 llTimeMS;
+        double dValue;
+    };
+
+    void aggregateDay( TransducerDayStats & day, const QVector<iC3_TransducerSample> & samples, int iFirstSample );
+    void scanControlProbe( qint64 llTimeMS, double dValue );
+    void startCycleDetection( qint64 llTimeMS, double dValue );
+    void closeOpenIntervals( void );
+
+    void addToDays( qint64 llStartMS, qint64 llEndMS, qint64 TransducerDayStats::*pField );
+    void addStableRun( qint64 llStartMS, qint64 llEndMS );
+    TransducerDayStats * findDay( qint64 llTimeMS );
+
+    TransducerAnalysisConfig m_Config;
+    QString m_sConnectionName;
+
+    QVector<TransducerDayStats> m_Days;
+    QVector<qint64> m_DayStartMS;   // local midnight starting each day, plus the end of the last
+    qint64  m_llSampleCount;
+    bool    m_bSucceeded;
+    QString m_sLastError;
+
+    QVector<ControlReading> m_ControlReadings;  // valid control probe readings, warm-up included, until detection
+    TransducerScanWorker * m_pPrevious;         // the worker holding the days before this one's, NULL for the first
+
+    // control probe state, carried from one day to the next and from one worker to the next
+    bool    m_bHavePrevious;
+    qint64  m_llPreviousTimeMS;
+
+    eCycleDirection m_eDirection;
+    qint64  m_llPhaseStartMS;       // the last turn, or where detection (re)started
+    qint64  m_llExtremeTimeMS;      // the peak while rising, the trough while falling
+    double  m_dExtreme;
+    qint64  m_llLowTimeMS;          // before the first turn both extremes are tracked
+    double  m_dLow;
+
+    bool    m_bPulldown;
+    qint64  m_llPulldownStartMS;
+
+    bool    m_bStable;
+    qint64  m_llStableStartMS;
+};
+
+#endif // TRANSDUCERSCANWORKER_H
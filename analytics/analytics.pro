@@ -0,0 +1,59 @@
+#-------------------------------------------------
+#
+# Offline transducer analytics for iC3SSLClient
+#
+# Reads a copy of LOG.db (and the segment store, if used) with the
+# application's own read connection and reports per day probe
+# statistics, compressor duty cycle, pulldowns and time in band.
+# Headless; the days are scanned in parallel, one connection per thread.
+#
+#-------------------------------------------------
+
+QT       += core sql
+QT       -= gui
+
+TARGET = iC3Analytics
+CONFIG   += console
+CONFIG   -= app_bundle
+TEMPLATE = app
+
+# the per day column aggregation is written to be auto-vectorized
+QMAKE_CXXFLAGS_RELEASE -= -O2
+QMAKE_CXXFLAGS_RELEASE += -O3
+
+INCLUDEPATH += .. ../database
+
+SOURCES += main.cpp \
+        TransducerScanWorker.cpp \
+        ../database/iC3_DatabaseReadConnection.cpp \
+        ../database/iC3_DatabaseTable.cpp \
+        ../database/iC3_DatabaseColumnDef.cpp \
+        ../database/iC3_DMM_UtilityFunctions.cpp \
+        ../database/iC3_ExportFormatter.cpp \
+        ../database/iC3_TransducerTable.cpp \
+        ../database/iC3_TransducerBlockTable.cpp \
+        ../database/iC3_TransducerBlockCodec.cpp \
+        ../database/iC3_TransducerRollupTable.cpp \
+        ../database/iC3_StatusJournalTable.cpp \
+        ../database/iC3_DeviceEventTable.cpp \
+        ../database/iC3_DeviceEventCountTable.cpp \
+        ../database/iC3_TransducerSegment.cpp \
+        ../database/iC3_TransducerSegmentReader.cpp
+
+HEADERS  += TransducerScanWorker.h \
+            ../database/iC3_DatabaseReadConnection.h \
+            ../database/iC3_DatabaseTable.h \
+            ../database/iC3_DatabaseColumnDef.h \
+            ../database/iC3_DMM_UtilityFunctions.h \
+            ../database/iC3_ExportFormatter.h \
+            ../database/iC3_TransducerTable.h \
+            ../database/iC3_TransducerBlockTable.h \
+            ../database/iC3_TransducerBlockCodec.h \
+            ../database/iC3_TransducerRollupTable.h \
+            ../database/iC3_StatusJournalTable.h \
+            ../database/iC3_DeviceEventTable.h \
+            ../database/iC3_DeviceEventCountTable.h \
+            ../database/iC3_TransducerSegment.h \
+            ../database/iC3_TransducerSegmentReader.h \
+            ../database/iC3_TransducerSample.h \
+            ../ScpiReplyDecoder.h
@@ -0,0 +1,282 @@
+#include <QCoreApplication>
+#include <QStringList>
+#include <QElapsedTimer>
+#include <QList>
+
+#include <stdio.h>
+
+#include "TransducerScanWorker.h"
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+static void printUsage( void )
+{
+    fprintf( stderr,
+             "Usage: iC3Analytics [options]\n"
+             "\n"
+             "Reads a device's transducer history (blocks, raw rows and segment files) and reports per local day:\n"
+             "min / max / mean of every probe, and for the control probe the compressor duty cycle, pulldowns and\n"
+             "time in band.  The compressor is taken to be running while the control probe falls from a peak to a\n"
+             "trough.  The days are split across threads, each with its own read-only connection.\n"
+             "\n"
+             "  --database <file>       database (shard) holding the device    (default ./database/LOG.db)\n"
+             "  --segments <path>       segment store root, if enabled          (default none)\n"
+             "  --device <id>           device ID                               (default 0, the unit's own)\n"
+             "  --begin <yyyy-MM-dd>    first day                               (default 30 days ago)\n"
+             "  --end <yyyy-MM-dd>      last day, inclusive                     (default today)\n"
+             "  --threads <n>           scan threads                            (default one per core)\n"
+             "  --probe <n>             control probe, 1..%d                     (default 1)\n"
+             "  --setpoint <C>          setpoint                                (default 4.0)\n"
+             "  --band <C>              in band: setpoint +/- band              (default 1.0)\n"
+             "  --swing <C>             smallest rise / fall that turns a cycle (default 0.5)\n"
+             "  --max-gap <s>           longer gaps between samples are not counted (default 60)\n",
+             TRANSDUCER_NUMBER_OF_RTDS );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+static double percent( qint64 llPart, qint64 llWhole )
+{
+    return ( llWhole > 0 ) ? ( 100.0 * llPart / llWhole ) : 0.0;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+static double minutes( qint64 llMS )
+{
+    return llMS / 60000.0;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+static void printProbeReport( const QVector<TransducerDayStats> & days )
+{
+    TransducerDayStats total;
+
+    printf( "\n%-10s %5s %9s %8s %8s %8s\n", "date", "probe", "samples", "min C", "max C", "mean C" );
+
+    for ( int iDay = 0; iDay < days.size(); iDay++ )
+    {
+        const TransducerDayStats & day = days.at( iDay );
+
+        for ( int iProbe = 0; iProbe < TRANSDUCER_NUMBER_OF_RTDS; iProbe++ )
+        {
+            if ( day.allSamples[iProbe] == 0 )
+            {
+                continue;
+            }
+
+            printf( "%-10s %5d %9lld %8.2f %8.2f %8.2f\n",
+                    qPrintable( day.date.toString( "yyyy-MM-dd" ) ),
+                    iProbe + 1,
+                    (long long) day.allSamples[iProbe],
+                    day.adMin[iProbe],
+                    day.adMax[iProbe],
+                    day.adSum[iProbe] / day.allSamples[iProbe] );
+
+            if ( total.allSamples[iProbe] == 0 )
+            {
+                total.adMin[iProbe] = day.adMin[iProbe];
+                total.adMax[iProbe] = day.adMax[iProbe];
+            }
+            total.allSamples[iProbe] += day.allSamples[iProbe];
+            total.adMin[iProbe] = qMin( total.adMin[iProbe], day.adMin[iProbe] );
+            total.adMax[iProbe] = qMax( total.adMax[iProbe], day.adMax[iProbe] );
+            total.adSum[iProbe] += day.adSum[iProbe];
+        }
+    }
+
+    for ( int iProbe = 0; iProbe < TRANSDUCER_NUMBER_OF_RTDS; iProbe++ )
+    {
+        if ( total.allSamples[iProbe] > 0 )
+        {
+            printf( "%-10s %5d %9lld %8.2f %8.2f %8.2f\n",
+                    "all",
+                    iProbe + 1,
+                    (long long) total.allSamples[iProbe],
+                    total.adMin[iProbe],
+                    total.adMax[iProbe],
+                    total.adSum[iProbe] / total.allSamples[iProbe] );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+static void printControlReport( const QVector<TransducerDayStats> & days, const TransducerAnalysisConfig & config )
+{
+    TransducerDayStats total;
+
+    printf( "\ncontrol probe %d, setpoint %.2f C +/- %.2f C, cycle swing %.2f C\n",
+            config.iControlProbe + 1, config.dSetpointC, config.dBandC, config.dCycleSwingC );
+    printf( "%-10s %9s %7s %7s %10s %12s %11s %9s %14s\n",
+            "date", "covered %", "duty %", "cycles", "pulldowns", "mean pd min", "max pd min", "in band %", "stable max min" );
+
+    for ( int iDay = 0; iDay < days.size(); iDay++ )
+    {
+        const TransducerDayStats & day = days.at( iDay );
+
+        printf( "%-10s %9.1f %7.1f %7d %10d %12.1f %11.1f %9.1f %14.1f\n",
+                qPrintable( day.date.toString( "yyyy-MM-dd" ) ),
+                percent( day.llCoveredMS, day.llDayLengthMS ),
+                percent( day.llCoolingMS, day.llCoveredMS ),
+                day.iCycles,
+                day.iPulldowns,
+                ( day.iPulldowns > 0 ) ? minutes( day.llPulldownTotalMS ) / day.iPulldowns : 0.0,
+                minutes( day.llPulldownMaxMS ),
+                percent( day.llInBandMS, day.llCoveredMS ),
+                minutes( day.llLongestStableMS ) );
+
+        total.llDayLengthMS += day.llDayLengthMS;
+        total.llCoveredMS += day.llCoveredMS;
+        total.llCoolingMS += day.llCoolingMS;
+        total.iCycles += day.iCycles;
+        total.iPulldowns += day.iPulldowns;
+        total.llPulldownTotalMS += day.llPulldownTotalMS;
+        total.llPulldownMaxMS = qMax( total.llPulldownMaxMS, day.llPulldownMaxMS );
+        total.llInBandMS += day.llInBandMS;
+        total.llLongestStableMS = qMax( total.llLongestStableMS, day.llLongestStableMS );
+    }
+
+    printf( "%-10s %9.1f %7.1f %7d %10d %12.1f %11.1f %9.1f %14.1f\n",
+            "all",
+            percent( total.llCoveredMS, total.llDayLengthMS ),
+            percent( total.llCoolingMS, total.llCoveredMS ),
+            total.iCycles,
+            total.iPulldowns,
+            ( total.iPulldowns > 0 ) ? minutes( total.llPulldownTotalMS ) / total.iPulldowns : 0.0,
+            minutes( total.llPulldownMaxMS ),
+            percent( total.llInBandMS, total.llCoveredMS ),
+            minutes( total.llLongestStableMS ) );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+
+    TransducerAnalysisConfig config;
+
+    QStringList args = a.arguments();
+    for ( int iIndex = 1; iIndex < args.size(); iIndex++ )
+    {
+        QString sOption = args.at( iIndex );
+
+        if ( ( sOption == "-h" ) || ( sOption == "--help" ) || ( iIndex + 1 >= args.size() ) )
+        {
+            printUsage();
+            return ( sOption == "-h" || sOption == "--help" ) ? 0 : 1;
+        }
+
+        QString sValue = args.at( ++iIndex );
+
+        if ( sOption == "--database" )              config.sDatabaseFileName = sValue;
+        else if ( sOption == "--segments" )         config.sSegmentStorePath = sValue;
+        else if ( sOption == "--device" )           config.iDeviceID = sValue.toInt();
+        else if ( sOption == "--begin" )            config.firstDay = QDate::fromString( sValue, "yyyy-MM-dd" );
+        else if ( sOption == "--end" )              config.lastDay = QDate::fromString( sValue, "yyyy-MM-dd" );
+        else if ( sOption == "--threads" )          config.iThreads = sValue.toInt();
+        else if ( sOption == "--probe" )            config.iControlProbe = sValue.toInt() - 1;
+        else if ( sOption == "--setpoint" )         config.dSetpointC = sValue.toDouble();
+        else if ( sOption == "--band" )             config.dBandC = sValue.toDouble();
+        else if ( sOption == "--swing" )            config.dCycleSwingC = sValue.toDouble();
+        else if ( sOption == "--max-gap" )          config.llMaxGapMS = sValue.toLongLong() * 1000;
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    if ( !config.firstDay.isValid() || !config.lastDay.isValid() || ( config.firstDay > config.lastDay ) ||
+         ( config.iControlProbe < 0 ) || ( config.iControlProbe >= TRANSDUCER_NUMBER_OF_RTDS ) ||
+         ( config.dCycleSwingC <= 0.0 ) || ( config.llMaxGapMS <= 0 ) )
+    {
+        printUsage();
+        return 1;
+    }
+
+    // contiguous runs of whole days, so every day is scanned by exactly one thread
+    int iDays = config.firstDay.daysTo( config.lastDay ) + 1;
+    int iThreads = qBound( 1, config.iThreads, iDays );
+    QList<TransducerScanWorker *> workers;
+    QDate firstDay = config.firstDay;
+
+    for ( int iWorker = 0; iWorker < iThreads; iWorker++ )
+    {
+        int iWorkerDays = iDays / iThreads + ( ( iWorker < iDays % iThreads ) ? 1 : 0 );
+        QDate lastDay = firstDay.addDays( iWorkerDays - 1 );
+
+        workers.append( new TransducerScanWorker( config, iWorker, firstDay, lastDay ) );
+        firstDay = lastDay.addDays( 1 );
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    foreach ( TransducerScanWorker * pWorker, workers )
+    {
+        pWorker->start();
+    }
+
+    QVector<TransducerDayStats> days;
+    qint64 llSamples = 0;
+    int iExitCode = 0;
+
+    foreach ( TransducerScanWorker * pWorker, workers )
+    {
+        pWorker->wait();
+
+        if ( !pWorker->succeeded() )
+        {
+            fprintf( stderr, "%s\n", qPrintable( pWorker->getLastError() ) );
+            iExitCode = 1;
+        }
+
+        llSamples += pWorker->getSampleCount();
+    }
+
+    // the detection runs across the thread splits in day order; a later worker can still add to earlier days
+    if ( iExitCode == 0 )
+    {
+        TransducerScanWorker * pPrevious = NULL;
+
+        foreach ( TransducerScanWorker * pWorker, workers )
+        {
+            pWorker->detectControlProbe( pPrevious );
+            pPrevious = pWorker;
+        }
+
+        pPrevious->finishControlProbe();
+
+        foreach ( TransducerScanWorker * pWorker, workers )
+        {
+            days += pWorker->getDays();
+        }
+    }
+
+    double dElapsedS = timer.elapsed() / 1000.0;
+
+    qDeleteAll( workers );
+
+    if ( iExitCode != 0 )
+    {
+        return iExitCode;
+    }
+
+    printf( "device %d, %s .. %s, %s\n",
+            config.iDeviceID,
+            qPrintable( config.firstDay.toString( "yyyy-MM-dd" ) ),
+            qPrintable( config.lastDay.toString( "yyyy-MM-dd" ) ),
+            qPrintable( config.sDatabaseFileName ) );
+
+    printProbeReport( days );
+    printControlReport( days, config );
+
+    printf( "\nscanned %lld samples in %.2f s on %d threads (%.0f samples/s)\n",
+            (long long) llSamples, dElapsedS, iThreads, ( dElapsedS > 0.0 ) ? llSamples / dElapsedS : 0.0 );
+    fflush( stdout );
+
+    return 0;
+}
@@ -5,8 +5,6 @@
 #include <QList>
 #include "qcustomplot.h"
 
-#include <QtSerialPort>
-#include <QtSerialPort/QSerialPortInfo>
 
 
 Client::Client(QWidget *parent) :
@@ -33,15 +31,25 @@ Client::Client(QWidget *parent) :
     m_dCompressor(0.0),
     m_dFlukeChannel1(0.0),
     m_dFlukeChannel2(0.0),
-    m_sComPort("COM5"),
-    m_iWaitTimeoutMS(3000),
+    m_iFlukeDevice(SERIAL_INVALID_DEVICE),
+    m_iWaitTimeoutMS(SERIAL_ADAPTIVE_TIMEOUT),
     m_bWaitingForTimeout(false),
+    m_bSerialPortFound(false),
     m_eLastFlukeMsgSent(eFLUKE_TC_UNKNOWN),
+    m_bDrainingFlukeErrors(false),
+    m_uiFlukeErrorRequestID(0),
+    m_iFlukeErrorReads(0),
+    m_iFlukeLastErrorCode(0),
+    m_ulFlukeOverloadCount(0),
+    m_ulFlukeOpenCount(0),
+    m_ulFlukeBadReplyCount(0),
+    m_ulFlukeInstrumentErrorCount(0),
     m_dRTD4_OffsetValue(0.0),
     m_dRTD5_OffsetValue(0.0),
     m_bCompressorState(false),
     m_sDeviceType(""),
-    m_pCalibrationManager(NULL)
+    m_pCalibrationManager(NULL),
+    m_pDoorManager(NULL)
 {
   ui->setupUi(this);
 
@@ -207,12 +215,32 @@ Client::Client(QWidget *parent) :
 
   connect(&flukeTimer, SIGNAL(timeout()), this, SLOT(flukeTempTimeout()));
 
-  m_bSerialPortFound = findSerialPort();
-
   // ---------------------------------------------------------
-  connect(&m_SerialPort, SIGNAL(response(QByteArray)), this, SLOT(handleResponse(QByteArray)));
-  connect(&m_SerialPort, SIGNAL(error(QString)), this, SLOT(handleSerialPortError(QString)));
-  connect(&m_SerialPort, SIGNAL(timeout(QString)), this, SLOT(handleTimeout(QString)));
+  // The Fluke answers *IDN? with its manufacturer name, which is how the broker tells it apart from the
+  // door controller (or anything else) sharing the serial ports.
+  SerialDeviceDescriptor flukeDescriptor;
+  flukeDescriptor.sDeviceName        = "Fluke";
+  flukeDescriptor.sPreferredPortName = FLUKE_SERIAL_PORT_NAME;
+  flukeDescriptor.iBaudRate          = QSerialPort::Baud19200;
+  flukeDescriptor.iDefaultTimeoutMS  = SERIAL_DEFAULT_TIMEOUT_MS;
+  flukeDescriptor.iMaxTimeoutMS      = SERIAL_DEFAULT_TIMEOUT_MS;
+  flukeDescriptor.baProbeRequest     = "*IDN?\r\n";
+  flukeDescriptor.baProbeSignature   = "FLUKE";
+  flukeDescriptor.pFrameExtractor    = QSharedPointer<SerialFrameExtractor>( new SerialLineFrameExtractor('\n') );
+
+  m_iFlukeDevice = m_SerialBroker.registerDevice( flukeDescriptor );
+
+  connect(&m_SerialBroker, SIGNAL(signalResponse(int,uint,QByteArray)), this, SLOT(handleResponse(int,uint,QByteArray)));
+  connect(&m_SerialBroker, SIGNAL(signalError(int,uint,QString)), this, SLOT(handleSerialPortError(int,uint,QString)));
+  connect(&m_SerialBroker, SIGNAL(signalTimeout(int,uint,QString)), this, SLOT(handleTimeout(int,uint,QString)));
+  connect(&m_SerialBroker, SIGNAL(signalDeviceConnected(int,QString)), this, SLOT(handleSerialDeviceConnected(int,QString)));
+  connect(&m_SerialBroker, SIGNAL(signalDeviceDisconnected(int)), this, SLOT(handleSerialDeviceDisconnected(int)));
+
+  // the door/light controller shares the broker (and its I/O thread) with the Fluke
+  m_pDoorManager = new DoorManager(&m_SerialBroker, this);
+  m_pDoorManager->setSerialPortName(DOOR_CONTROLLER_SERIAL_PORT_NAME);
+
+  m_SerialBroker.discoverDevices();
 
 }
 
@@ -518,6 +546,16 @@ void Client::receiveMessage()
                                  m_dControl,
                                  m_dPrimary);
 
+        // the rest of the poll goes to the status journal, which only keeps what changed
+        iC3_DeviceStatus status;
+        status.iDeviceID = TRANSDUCER_LOCAL_DEVICE_ID;
+        status.llStatusTimeMS = 0;
+        for ( int iField = 0; iField < eDEVICE_STATUS_FIELD_COUNT; iField++ )
+        {
+            status.asFields[iField] = result[DEVICE_STATUS_FIELD_KEYS[iField]].toString();
+        }
+        db.insertDeviceStatus(status);
+
         if ( m_pCalibrationManager != NULL )
         {
             eCalibrationStates eState = m_pCalibrationManager->getCalibrationState();
@@ -793,65 +831,137 @@ void Client::realtimeDataSlot()
 
 //-----------------------------------------------------------------------------------------------------------------
 //-----------------------------------------------------------------------------------------------------------------
-void Client::sendSerialRequest( QString sPortName, int iWaitTimeoutMS, QByteArray baRequest )
+uint Client::sendSerialRequest( eFlukeSerialCommands eCommand, QByteArray baRequest )
 {
-    m_SerialPort.transaction( sPortName, iWaitTimeoutMS, baRequest );
+    return m_SerialBroker.submitRequest( m_iFlukeDevice, baRequest, eCommand, m_iWaitTimeoutMS );
 }
 
 //-------------------------------------------------------------------------------------------------------------------
 //-----------------------------------------------------------------------------------------------------------------
-void Client::handleResponse( QByteArray baResponse )
+void Client::handleResponse( int iDevice, uint uiRequestID, QByteArray baResponse )
 {
+    if ( iDevice != m_iFlukeDevice )
+    {
+        return;
+    }
+
+    if ( m_bDrainingFlukeErrors && ( uiRequestID == m_uiFlukeErrorRequestID ) )
+    {
+        handleFlukeErrorReply( baResponse );
+        return;
+    }
+
     m_bWaitingForTimeout = false;
 
-//    qDebug() << "+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++";
-//    qDebug() << "   Serial Port Response";
-//    qDebug() << "+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++";
-    QString sResponse = QString(baResponse);
-    sResponse.replace("\r", "");
-    sResponse.replace("\n", "");
-//    qDebug() << sResponse;
-//    qDebug() << "+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++";
+    ScpiNumericList readings;
 
-    float fTemp;
+    if ( !ScpiReplyDecoder::decodeNumericList( baResponse.constData(), baResponse.size(), readings ) )
+    {
+        // not a number - most likely the instrument rejected the command, so find out why in the background
+        m_ulFlukeBadReplyCount++;
+        displayFlukeReading( 0.0, false );
+        drainFlukeErrorQueue();
+        return;
+    }
 
-    if( sResponse.contains("e+") )
+    if ( readings.aeStatus[0] == eSCPI_VALUE_OVERLOAD )
     {
-//        qDebug() << "HAS -> e+";
-        fTemp = sResponse.toFloat();
+        m_ulFlukeOverloadCount++;
+        displayFlukeReading( 0.0, false );
+        return;
     }
-    else
+
+    if ( readings.aeStatus[0] == eSCPI_VALUE_OPEN )
     {
-        qWarning() << "Serial Port Response Error: " << sResponse;
-        if (m_eLastFlukeMsgSent == eFLUKE_TC_1)
+        m_ulFlukeOpenCount++;
+        displayFlukeReading( 0.0, false );
+        return;
+    }
+
+    displayFlukeReading( readings.adValues[0], true );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void Client::displayFlukeReading( double dTemp, bool bValid )
+{
+    if (m_eLastFlukeMsgSent == eFLUKE_TC_1)
+    {
+        if ( bValid )
+        {
+            m_dFlukeChannel1 = dTemp;
+            ui->lcd_fluke_1->display(QString::number(dTemp,'f',1));
+        }
+        else
         {
             ui->lcd_fluke_1->display(QString("---"));
         }
-        else if (m_eLastFlukeMsgSent == eFLUKE_TC_2)
+    }
+    else if (m_eLastFlukeMsgSent == eFLUKE_TC_2)
+    {
+        if ( bValid )
+        {
+            m_dFlukeChannel2 = dTemp;
+            ui->lcd_fluke_2->display(QString::number(dTemp,'f',1));
+        }
+        else
         {
             ui->lcd_fluke_2->display(QString("---"));
         }
-        return;
     }
+}
 
-//    qDebug() << "TEMP: " << fTemp;
-
-    if (m_eLastFlukeMsgSent == eFLUKE_TC_1)
+//-----------------------------------------------------------------------------------------------------------------
+// Reads SYST:ERR? one entry at a time until the instrument reports +0 (or we give up), counting each error.
+//-----------------------------------------------------------------------------------------------------------------
+void Client::drainFlukeErrorQueue( void )
+{
+    if ( m_bDrainingFlukeErrors )
     {
-        m_dFlukeChannel1 = fTemp;
-        ui->lcd_fluke_1->display(QString::number(fTemp,'f',1));
+        return;
     }
-    else if (m_eLastFlukeMsgSent == eFLUKE_TC_2)
+
+    m_bDrainingFlukeErrors = true;
+    m_iFlukeErrorReads = 0;
+    m_uiFlukeErrorRequestID = sendSerialRequest( eFLUKE_SERIAL_ERROR_QUERY, QByteArray("SYST:ERR?\r\n") );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void Client::handleFlukeErrorReply( const QByteArray & baResponse )
+{
+    int iErrorCode;
+
+    m_iFlukeErrorReads++;
+
+    if ( !ScpiReplyDecoder::decodeErrorReply( baResponse.constData(), baResponse.size(), iErrorCode ) ||
+         ( iErrorCode == 0 ) ||
+         ( m_iFlukeErrorReads >= FLUKE_MAX_ERROR_QUEUE_READS ) )
     {
-        m_dFlukeChannel2 = fTemp;
-        ui->lcd_fluke_2->display(QString::number(fTemp,'f',1));
+        m_bDrainingFlukeErrors = false;
+        return;
     }
+
+    m_ulFlukeInstrumentErrorCount++;
+    m_iFlukeLastErrorCode = iErrorCode;
+    m_uiFlukeErrorRequestID = sendSerialRequest( eFLUKE_SERIAL_ERROR_QUERY, QByteArray("SYST:ERR?\r\n") );
 }
 
 //-------------------------------------------------------------------------------------------------------------------
 //-----------------------------------------------------------------------------------------------------------------
-void Client::handleSerialPortError( QString sError )
+void Client::handleSerialPortError( int iDevice, uint uiRequestID, QString sError )
 {
+    if ( iDevice != m_iFlukeDevice )
+    {
+        return;
+    }
+
+    if ( m_bDrainingFlukeErrors && ( uiRequestID == m_uiFlukeErrorRequestID ) )
+    {
+        m_bDrainingFlukeErrors = false;
+        return;
+    }
+
     qWarning() << sError;
     qDebug() << "Serial Port Error: " << sError;
     m_bWaitingForTimeout = false;
@@ -859,26 +969,48 @@ void Client::handleSerialPortError( QString sError )
 
 //-------------------------------------------------------------------------------------------------------------------
 //-----------------------------------------------------------------------------------------------------------------
-void Client::handleTimeout( QString sMessage )
+void Client::handleTimeout( int iDevice, uint uiRequestID, QString sMessage )
 {
+    if ( iDevice != m_iFlukeDevice )
+    {
+        return;
+    }
+
+    if ( m_bDrainingFlukeErrors && ( uiRequestID == m_uiFlukeErrorRequestID ) )
+    {
+        m_bDrainingFlukeErrors = false;
+        return;
+    }
+
     qDebug() << "Serial Port Timeout: " << sMessage;
     m_bWaitingForTimeout = false;
 
     ui->lcd_fluke_1->display("---");
     ui->lcd_fluke_2->display("---");
 
-    // ---------------------------------------------------------
-    disconnect(&m_SerialPort, SIGNAL(response(QByteArray)), this, SLOT(handleResponse(QByteArray)));
-    disconnect(&m_SerialPort, SIGNAL(error(QString)), this, SLOT(handleSerialPortError(QString)));
-    disconnect(&m_SerialPort, SIGNAL(timeout(QString)), this, SLOT(handleTimeout(QString)));
-
-    m_bSerialPortFound = findSerialPort();
-
-    connect(&m_SerialPort, SIGNAL(response(QByteArray)), this, SLOT(handleResponse(QByteArray)));
-    connect(&m_SerialPort, SIGNAL(error(QString)), this, SLOT(handleSerialPortError(QString)));
-    connect(&m_SerialPort, SIGNAL(timeout(QString)), this, SLOT(handleTimeout(QString)));
+    // no rescan here - if the Fluke keeps timing out the broker's circuit breaker stops sending to it and
+    // probes it (or searches for it again if its port went away) until it answers
+}
 
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void Client::handleSerialDeviceConnected( int iDevice, QString sPortName )
+{
+    if ( iDevice == m_iFlukeDevice )
+    {
+        qDebug() << "Fluke found on Serial Port: " << sPortName;
+        m_bSerialPortFound = true;
+    }
+}
 
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void Client::handleSerialDeviceDisconnected( int iDevice )
+{
+    if ( iDevice == m_iFlukeDevice )
+    {
+        m_bSerialPortFound = false;
+    }
 }
 
 
@@ -917,7 +1049,7 @@ void Client::readFlukeTemp1( void )
 //        qDebug() << baFlukeTempReq ;
 //        qDebug() << "===========================================================";
 
-        sendSerialRequest(m_sComPort, m_iWaitTimeoutMS, baFlukeTempReq );
+        sendSerialRequest(eFLUKE_SERIAL_MEASURE, baFlukeTempReq );
         m_bWaitingForTimeout = true;
     }
     else
@@ -938,7 +1070,7 @@ void Client::readFlukeTemp2( void )
 //        baFlukeTempReq.clear();
 //        baFlukeTempReq.append( FLUKE_TEMP_2_COMMAND, strlen(FLUKE_TEMP_2_COMMAND) );
 
-//        sendSerialRequest(m_sComPort, m_iWaitTimeoutMS, baFlukeTempReq );
+//        sendSerialRequest(eFLUKE_SERIAL_MEASURE, baFlukeTempReq );
 //        m_bWaitingForTimeout = true;
 //    }
 //    else
@@ -950,52 +1082,16 @@ void Client::readFlukeTemp2( void )
 
 //-----------------------------------------------------------------------------------------------------------------
 //-----------------------------------------------------------------------------------------------------------------
-void Client::turnLightOn(void)
-{
-    if ( m_bWaitingForTimeout == false )
-    {
-        qDebug() << "===========================================================";
-        qDebug() << "  Sending Light On";
-        qDebug() << "===========================================================";
-        qDebug() << byteArrayToHexString( m_baLightOn );
-        qDebug() << "===========================================================";
-
-        sendSerialRequest(m_sComPort, m_iWaitTimeoutMS, m_baLightOn );
-        m_bWaitingForTimeout = true;
-    }
-    else
-    {
-        qWarning() << "Can not send the light on command - waiting for previous serial port command response";
-    }
-}
-
-
-//-----------------------------------------------------------------------------------------------------------------
-//-----------------------------------------------------------------------------------------------------------------
-void Client::turnLightOff( void )
+void Client::setSerialPortName( QString sSerialPortName )
 {
-    if ( m_bWaitingForTimeout == false )
-    {
-        qDebug() << "===========================================================";
-        qDebug() << "  Sending Light Off";
-        qDebug() << "===========================================================";
-        qDebug() << byteArrayToHexString( m_baLightOff );
-        qDebug() << "===========================================================";
-
-        sendSerialRequest(m_sComPort, m_iWaitTimeoutMS, m_baLightOff );
-        m_bWaitingForTimeout = true;
-    }
-    else
-    {
-        qWarning() << "Can not send the light off command - waiting for previous serial port command response";
-    }
+    m_SerialBroker.setPreferredPortName( m_iFlukeDevice, sSerialPortName );
 }
 
 //-----------------------------------------------------------------------------------------------------------------
 //-----------------------------------------------------------------------------------------------------------------
-void Client::setSerialPortName( QString sSerialPortName )
+void Client::setDoorSerialPortName( QString sSerialPortName )
 {
-    m_sComPort = sSerialPortName;
+    m_pDoorManager->setSerialPortName( sSerialPortName );
 }
 
 //-----------------------------------------------------------------------------------------------------------------
@@ -1005,45 +1101,6 @@ void Client::setWaitTimeoutMS( int iTimeoutMS )
     m_iWaitTimeoutMS = iTimeoutMS;
 }
 
-//-----------------------------------------------------------------------------------------------------------------
-//-----------------------------------------------------------------------------------------------------------------
-bool Client::findSerialPort( void )
-{
-    bool bRC = false;
-    QSerialPort serial;
-    QString sPortName;
-    QSerialPortInfo info;
-
-    QList<QSerialPortInfo> infos = QSerialPortInfo::availablePorts();
-    QListIterator<QSerialPortInfo> i(infos);
-    while (i.hasNext())
-    {
-        info = i.next();
-        sPortName = info.portName();
-//        qDebug() << "Trying Serial Port: " << sPortName;
-        serial.close();
-        serial.setPortName(sPortName);
-
-        bRC = serial.open(QIODevice::ReadWrite);
-
-        if ( bRC == true )
-        {
-            setSerialPortName( sPortName );
-            qDebug() << "Using Serial Port: " << sPortName;
-            serial.close();
-            break;
-        }
-        else
-        {
-//            qDebug() << "Serial Port: " << sPortName << " not connected: " << serial.errorString();
-        }
-    }
-
-    serial.close();
-
-    return bRC;
-}
-
 //-----------------------------------------------------------------------------------------------------------------
 //-----------------------------------------------------------------------------------------------------------------
 bool Client::isSerialPortFound( void )
@@ -1051,25 +1108,6 @@ bool Client::isSerialPortFound( void )
     return m_bSerialPortFound;
 }
 
-//-----------------------------------------------------------------------------------------------------------------
-//-----------------------------------------------------------------------------------------------------------------
-QString Client::byteArrayToHexString( QByteArray & buffer )
-{
-    int iIndex;
-    QString sReturnString;
-    QString sTempString = buffer.toHex().toUpper();
-    int iBuffSize = sTempString.size();
-
-    for ( iIndex = 0; iIndex < iBuffSize; iIndex+=2 )
-    {
-        //sReturnString.append("0x");
-        sReturnString.append( sTempString.mid(iIndex, 2) );
-        sReturnString.append(" ");
-    }
-
-    return sReturnString;
-}
-
 void Client::sendCalibrationRequest(eRTDNumber eRTDNum , double dRTDOffsetVal)
 {
     QString sOffset = QString::number(dRTDOffsetVal,'f',1);
@@ -1240,6 +1278,26 @@ bool Client::getCompressorState()
     return m_bCompressorState;
 }
 
+quint32 Client::getFlukeOverloadCount()
+{
+    return m_ulFlukeOverloadCount;
+}
+
+quint32 Client::getFlukeOpenCount()
+{
+    return m_ulFlukeOpenCount;
+}
+
+quint32 Client::getFlukeBadReplyCount()
+{
+    return m_ulFlukeBadReplyCount;
+}
+
+quint32 Client::getFlukeInstrumentErrorCount()
+{
+    return m_ulFlukeInstrumentErrorCount;
+}
+
 QString Client::getDeviceType()
 {
     return m_sDeviceType;
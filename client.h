@@ -9,8 +9,10 @@
 #include "QtJson.h"
 #include "qcustomplot.h"
 #include "iC3_Database.h"
-#include "SerialPortThread.h"
+#include "SerialPortBroker.h"
+#include "ScpiReplyDecoder.h"
 #include "CalibrationManager.h"
+#include "DoorManager.h"
 
 using QtJson::JsonObject;
 using QtJson::JsonArray;
@@ -27,12 +29,15 @@ static const QString REQUEST_PELTIER_LOW_FILE ("./requests/peltierlow");
 static const QString REQUEST_PELTIER_OFF_FILE ("./requests/peltieroff");
 static const QString IMAGE_LED_OFF ("./images/led-off.png");
 static const QString IMAGE_LED_ON ("./images/led-on.png");
+static const QString FLUKE_SERIAL_PORT_NAME ("COM5");
+static const QString DOOR_CONTROLLER_SERIAL_PORT_NAME ("COM6");   // the door controller has no probe - it is only looked for here
 
 
 static const double UNUSED_PROBE_VALUE       = 99.9;
 static const int    TIMEOUT_GRAPH_UPDATE_SEC = 10;
 static const int    GRAPH_X_AXIS_MINUTES     = 60;
 static const int    TIMEOUT_FLUKE_TEMP_UPDATE_SEC = 3;
+static const int    FLUKE_MAX_ERROR_QUEUE_READS   = 10;
 
 
 enum eFlukeTcCommands
@@ -42,22 +47,18 @@ enum eFlukeTcCommands
     eFLUKE_TC_2            = 1
 };
 
-enum eRTDNumber
+// command types for the broker's per command latency tracking
+enum eFlukeSerialCommands
 {
-    eRTD_UNKNOWN =-1,
-    eRTD1        = 0,
-    eRTD2        = 1,
-    eRTD3        = 2,
-    eRTD4        = 3,
-    eRTD5        = 4,
+    eFLUKE_SERIAL_MEASURE     = 0,
+    eFLUKE_SERIAL_ERROR_QUERY = 1
 };
 
-
 namespace Ui {
   class Client;
 }
 
-class Client : public QMainWindow
+class Client : public QMainWindow, public CalibrationDataSource
 {
   Q_OBJECT
 
@@ -65,9 +66,8 @@ public:
     explicit Client(QWidget *parent = 0);
     ~Client();
 
-    void turnLightOff( void );
-    void turnLightOn( void );
     void setSerialPortName( QString sSerialPortName );
+    void setDoorSerialPortName( QString sSerialPortName );
     void setWaitTimeoutMS( int iTimeoutMS );
     bool isSerialPortFound( void );
     void sendCalibrationRequest(eRTDNumber eRTDNum , double dRTDOffsetVal);
@@ -78,6 +78,10 @@ public:
     double getPrimaryOffset();
     double getControlOffset();
     bool getCompressorState();
+    quint32 getFlukeOverloadCount();
+    quint32 getFlukeOpenCount();
+    quint32 getFlukeBadReplyCount();
+    quint32 getFlukeInstrumentErrorCount();
     QString getDeviceType();
 
 protected slots:
@@ -107,9 +111,11 @@ private slots:
     void on_button_peltier_high_clicked();
     void on_button_peltier_low_clicked();
     void on_button_peltier_stop_clicked();
-    void handleResponse(QByteArray baResponse);
-    void handleSerialPortError(QString sError);
-    void handleTimeout(QString sMessage);
+    void handleResponse(int iDevice, uint uiRequestID, QByteArray baResponse);
+    void handleSerialPortError(int iDevice, uint uiRequestID, QString sError);
+    void handleTimeout(int iDevice, uint uiRequestID, QString sMessage);
+    void handleSerialDeviceConnected(int iDevice, QString sPortName);
+    void handleSerialDeviceDisconnected(int iDevice);
     void on_button_match_primary_clicked();
     void on_button_primary_up_clicked();
     void on_button_primary_down_clicked();
@@ -150,31 +156,33 @@ private:
     double m_dFlukeChannel1;
     double m_dFlukeChannel2;
     iC3_Database db;
-    SerialPortThread m_SerialPort;
-    QString m_sComPort;
-    int     m_iWaitTimeoutMS;
-    QByteArray m_baUnlockDoor;
-    QByteArray m_baUnlockDoorAck;
-    QByteArray m_baLockDoor;
-    QByteArray m_baLockDoorAck;
-    QByteArray m_baLightOn;
-    QByteArray m_baLightOnAck;
-    QByteArray m_baLightOff;
-    QByteArray m_baLightOffAck;
+    SerialPortBroker m_SerialBroker;
+    int     m_iFlukeDevice;
+    int     m_iWaitTimeoutMS;      // SERIAL_ADAPTIVE_TIMEOUT unless setWaitTimeoutMS() forces one
     bool m_bWaitingForTimeout;
     bool m_bSerialPortFound;
     eFlukeTcCommands m_eLastFlukeMsgSent;
+    bool    m_bDrainingFlukeErrors;
+    uint    m_uiFlukeErrorRequestID;
+    int     m_iFlukeErrorReads;
+    int     m_iFlukeLastErrorCode;
+    quint32 m_ulFlukeOverloadCount;
+    quint32 m_ulFlukeOpenCount;
+    quint32 m_ulFlukeBadReplyCount;
+    quint32 m_ulFlukeInstrumentErrorCount;
     double m_dRTD4_OffsetValue;
     double m_dRTD5_OffsetValue;
     bool m_bCompressorState;
     QString m_sDeviceType;
 
 
-    bool findSerialPort( void );
-    void sendSerialRequest(QString sPortName, int iWaitTimeoutMS, QByteArray baRequest );
-    QString byteArrayToHexString( QByteArray & buffer );
+    uint sendSerialRequest( eFlukeSerialCommands eCommand, QByteArray baRequest );
+    void drainFlukeErrorQueue( void );
+    void handleFlukeErrorReply( const QByteArray & baResponse );
+    void displayFlukeReading( double dTemp, bool bValid );
 
     CalibrationManager * m_pCalibrationManager;
+    DoorManager * m_pDoorManager;
 };
 
 #endif // CLIENT_H
@@ -4,7 +4,8 @@
 enum eDateFormats
 {
     eDATE_FORMAT_DDMMYY            = 0,
-    eDATE_FORMAT_MMDDYY            = 1
+    eDATE_FORMAT_MMDDYY            = 1,
+    eDATE_FORMAT_YYYYMMDD          = 2         // ISO 8601, used by exports
 };
 
 enum eTimeFormats
@@ -16,11 +17,31 @@ enum eTimeFormats
 
 static const char HELMER_DB_CONNECTION_NAME[] = "HelmerDB_Connection";
 static const char HELMER_DATABASE_FILE_NAME[] = "./database/LOG.db";
+static const char HELMER_DB_EXPORT_CONNECTION_NAME[] = "HelmerDB_Export";
+static const char HELMER_DB_READ_CONNECTION_NAME[] = "HelmerDB_Read";      // numbered per reader thread
+
+// which database file (shard) holds each device's data; shard n > 0 is LOG_n.db beside LOG.db.
+// iC3_Database::setShardCount() overrides the shard count before opening.
+static const char HELMER_DB_SHARD_CATALOG_FILE_NAME[] = "./database/CATALOG.db";
+static const int HELMER_DB_SHARD_COUNT = 1;
+
+// transducer samples the database could not take wait here until they are replayed into it;
+// preallocated, so it still has room when the disk is full
+static const char HELMER_TRANSDUCER_SPILL_FILE_NAME[] = "./database/SPILL.jnl";
+
+// stored in PRAGMA user_version - bump when a table's layout changes and add the upgrade step
+//   1 - Transducers table with sequenceIndex key, deviceID and sampleTimeMS
+//   2 - file converted to auto_vacuum=INCREMENTAL
+static const int HELMER_DB_SCHEMA_VERSION = 2;
 
 static const char CONFIG_FILE_PATH[] = "../data/config/app_config.xml";
 
 static const char HELMER_DATA_FILE_PATH[] = "../data/";
 static const char HELMER_TRANSDUCER_DATA_FILE_PATH[] = "../data/transducer_logs/";
+
+// raw samples go to segment files under HELMER_TRANSDUCER_DATA_FILE_PATH instead of the
+// Transducers table; iC3_Database::setTransducerSegmentStore() overrides this before opening
+static const bool HELMER_TRANSDUCER_SEGMENT_STORE_ENABLED = false;
 static const char GRAPH_ERROR_LOG_PATH[] = "../data/Graph_Error_Log.txt";
 static const char COMM_ERROR_LOG_PATH[] = "../data/DMM_Error_Log.txt";
 
@@ -124,7 +145,19 @@ enum eIC3_DatabaseRequestTypes
     eDB_REQUEST_GET_GRAPH_DOOR_OPEN_DATA     =  33,
     eDB_REQUEST_GET_GRAPH_EVENT_DATA         =  34,
     eDB_REQUEST_GET_ESIN_RANGE_FOR_CSV_FILES =  35,
-    eDB_REQUEST_PERFORM_INTEGRITY_CHECK      =  36
+    eDB_REQUEST_PERFORM_INTEGRITY_CHECK      =  36,
+    eDB_REQUEST_INSERT_TRANSDUCER_SAMPLE     =  37,
+    eDB_REQUEST_GET_TRANSDUCER_SAMPLES       =  38,
+    eDB_REQUEST_STOP_PROCESSING              =  39,
+    eDB_REQUEST_GET_LAST_N_TRANSDUCER_SAMPLES=  40,
+    eDB_REQUEST_COMPACT_TRANSDUCER_HISTORY   =  41,
+    eDB_REQUEST_GET_TRANSDUCER_HISTORY       =  42,
+    eDB_REQUEST_GET_TRANSDUCER_ROLLUPS       =  43,
+    eDB_REQUEST_INSERT_DEVICE_STATUS         =  44,
+    eDB_REQUEST_GET_DEVICE_STATUS_AT_TIME    =  45,
+    eDB_REQUEST_GET_DEVICE_EVENT_COUNT       =  46,
+    eDB_REQUEST_GET_DEVICE_EVENTS            =  47,
+    eDB_REQUEST_REPLAY_TRANSDUCER_SAMPLE     =  48
 };
 
 enum eIC3_TransducerRequestTypes
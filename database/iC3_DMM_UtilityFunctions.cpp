@@ -146,6 +146,9 @@ QString iC3_DMM_UtilityFunctions::convertToDateFormatString( eDateFormats dateFo
     case eDATE_FORMAT_DDMMYY:
         sDateFormatString = "dd/MM/yyyy";
         break;
+    case eDATE_FORMAT_YYYYMMDD:
+        sDateFormatString = "yyyy-MM-dd";
+        break;
     }
 
     return sDateFormatString;
@@ -201,6 +204,9 @@ QString iC3_DMM_UtilityFunctions::convertToFilePathDateFormatString( eDateFormat
     case eDATE_FORMAT_DDMMYY:
         sDateFormatString = "dd-MM-yyyy";
         break;
+    case eDATE_FORMAT_YYYYMMDD:
+        sDateFormatString = "yyyy-MM-dd";
+        break;
     }
 
     return sDateFormatString;
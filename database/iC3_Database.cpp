@@ -24,11 +24,32 @@
 //-----------------------------------------------------------------------------------------------
 iC3_Database::iC3_Database(QObject *parent) :
     QObject(parent),
+    m_iGroupCommitWindowMS( DB_GROUP_COMMIT_WINDOW_MS ),
+    m_iGroupCommitMaxRows( DB_GROUP_COMMIT_MAX_ROWS ),
+    m_iRawRetentionHours( DB_RAW_RETENTION_HOURS ),
+    m_iMinuteRollupRetentionHours( DB_MINUTE_ROLLUP_RETENTION_HOURS ),
+    m_bArchiveRawData( DB_ARCHIVE_EXPIRED_RAW_DATA ),
     m_bDatabaseOpen(false),
+    m_iLostSamples(0),
 //    m_pInterfacePtr( NULL ),
-    m_uiTransactionID(0)
+    m_TransactionID(0)
 {
     m_sDatabaseFileName = QString(HELMER_DATABASE_FILE_NAME);
+    setTransducerSegmentStore( HELMER_TRANSDUCER_SEGMENT_STORE_ENABLED );
+    createShards( HELMER_DB_SHARD_COUNT );
+
+    // retried by openDatabase() if the file cannot be opened yet
+    m_SpillJournal.open( HELMER_TRANSDUCER_SPILL_FILE_NAME );
+
+    connect( &m_TransducerExporter, SIGNAL(signalExportProgress(uint,qint64,int)), this, SIGNAL(signalExportProgress(uint,qint64,int)));
+    connect( &m_TransducerExporter, SIGNAL(signalExportComplete(uint,qint64)), this, SIGNAL(signalExportComplete(uint,qint64)));
+    connect( &m_TransducerExporter, SIGNAL(signalExportCancelled(uint)), this, SIGNAL(signalExportCancelled(uint)));
+    connect( &m_TransducerExporter, SIGNAL(signalExportFailed(uint,QString)), this, SIGNAL(signalExportFailed(uint,QString)));
+
+    connect( &m_DatabaseSnapshot, SIGNAL(signalSnapshotProgress(uint,int,qint64)), this, SIGNAL(signalSnapshotProgress(uint,int,qint64)));
+    connect( &m_DatabaseSnapshot, SIGNAL(signalSnapshotComplete(uint,qint64,qint64)), this, SIGNAL(signalSnapshotComplete(uint,qint64,qint64)));
+    connect( &m_DatabaseSnapshot, SIGNAL(signalSnapshotCancelled(uint)), this, SIGNAL(signalSnapshotCancelled(uint)));
+    connect( &m_DatabaseSnapshot, SIGNAL(signalSnapshotFailed(uint,QString)), this, SIGNAL(signalSnapshotFailed(uint,QString)));
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -44,47 +65,88 @@ iC3_Database::~iC3_Database( )
     {
         closeDatabase();
     }
+
+    deleteShards();
+    m_SpillJournal.close();
 }
 
 //-----------------------------------------------------------------------------------------------
-/** openDatabase() - Used to open the Helmer Database
+/** openDatabase() - Used to open the Helmer Database.  Each shard is opened by its own request
+*                     processor thread, which owns the shard's writer connection from then on.
+*                     Reads use the shard's read connection pool.  Samples spilled while the
+*                     database was unavailable are then replayed into it.
 *   @retval true - the database was opened
-*   @retval false - the database open failed - signalError is emitted
+*   @retval false - the database open failed
 *   @author  Doug Sanqunetti
 *   @date 09/01/2013
 */
 //-----------------------------------------------------------------------------------------------
 bool iC3_Database::openDatabase( )
 {
-//    iC3_DatabaseRequest * pRequest;
-
-    // make sure our request is protected until we are able to add the request to the queue
-//    QMutexLocker locker( & m_DB_RequestMutex );
-
-    m_db = QSqlDatabase::addDatabase("QSQLITE", HELMER_DB_CONNECTION_NAME );
-    m_db.setHostName("localhost");
-    m_db.setDatabaseName( m_sDatabaseFileName );
-    m_db.setUserName("root");
-    m_db.setPassword("");
+    if ( !m_SpillJournal.isOpen() )
+    {
+        m_SpillJournal.open( HELMER_TRANSDUCER_SPILL_FILE_NAME );
+    }
 
-    if ( !m_db.open() )
+    if ( !m_ShardCatalog.open( HELMER_DB_SHARD_CATALOG_FILE_NAME, m_Shards.size() ) )
     {
-        QString sDBError = m_db.lastError().text();
-        QString sErrorMsg = QString("Unable to open the database: %1").arg( sDBError );
-        qDebug() << sErrorMsg;
         return false;
     }
 
+    qint64 llLastSequenceIndex = 0;
 
-    /////////////////////////////////////////////////////////////////////////////// TRANSDUCER TABLE
-    bool bRC;
-    bRC = m_TransducerTable.CreateTable( m_db );
-    if ( bRC == false )
+    for ( int i = 0; i < m_Shards.size(); i++ )
     {
-        qDebug() << m_TransducerTable.GetLastError();
+        iC3_DatabaseShard * pShard = m_Shards[i];
+
+        // the first shard keeps the unsharded connection name
+        QString sConnectionName = ( i == 0 ) ? QString(HELMER_DB_CONNECTION_NAME)
+                                             : QString("%1_%2").arg( HELMER_DB_CONNECTION_NAME ).arg( i );
+
+        if ( !pShard->RequestProcessor.startProcessingDbRequests( pShard->sDatabaseFileName, sConnectionName, pShard->sSegmentStorePath ) )
+        {
+            qDebug() << pShard->RequestProcessor.GetLastError();
+
+            for ( int j = 0; j < i; j++ )
+            {
+                m_Shards[j]->RequestProcessor.stopProcessingDbRequests();
+            }
+
+            m_ShardCatalog.close();
+            return false;
+        }
+
+        llLastSequenceIndex = qMax( llLastSequenceIndex, pShard->RequestProcessor.getLastSequenceIndex() );
+    }
+
+    // samples get their sequence index as they are queued, on whichever thread queues them.  The
+    // shards share one sequence, so an index is unique across the fleet.
+    if ( !m_SequenceAllocator.open( QString(HELMER_DATA_FILE_PATH) + DEFAULT_EVENT_SEQUENCE_INDEX_FILE,
+                                    llLastSequenceIndex ) )
+    {
+        for ( int i = 0; i < m_Shards.size(); i++ )
+        {
+            m_Shards[i]->RequestProcessor.stopProcessingDbRequests();
+        }
+
+        m_ShardCatalog.close();
         return false;
     }
 
+    // the processors have created the tables and switched the files to WAL, so readers can start
+    for ( int i = 0; i < m_Shards.size(); i++ )
+    {
+        iC3_DatabaseShard * pShard = m_Shards[i];
+        QString sConnectionName = ( i == 0 ) ? QString(HELMER_DB_READ_CONNECTION_NAME)
+                                             : QString("%1_Shard%2").arg( HELMER_DB_READ_CONNECTION_NAME ).arg( i );
+
+        pShard->ReadConnectionPool.open( pShard->sDatabaseFileName, pShard->sSegmentStorePath, sConnectionName );
+    }
+
+    m_bDatabaseOpen = true;
+
+    replaySpilledSamples();
+
     return true;
 }
 
@@ -96,8 +158,24 @@ bool iC3_Database::openDatabase( )
 //-----------------------------------------------------------------------------------------------
 void iC3_Database::closeDatabase( void )
 {
-//    m_RequestProcessor.stopProcessingDbRequests();
-    m_db.close();
+    m_TransducerExporter.cancelExport();
+    m_TransducerExporter.wait();
+    m_DatabaseSnapshot.cancelSnapshot();
+    m_DatabaseSnapshot.wait();
+
+    for ( int i = 0; i < m_Shards.size(); i++ )
+    {
+        m_Shards[i]->ReadConnectionPool.close();
+    }
+
+    // everything already queued is written before the processors close their connections
+    for ( int i = 0; i < m_Shards.size(); i++ )
+    {
+        m_Shards[i]->RequestProcessor.stopProcessingDbRequests();
+    }
+
+    m_SequenceAllocator.close();
+    m_ShardCatalog.close();
 
     m_bDatabaseOpen = false;
 
@@ -106,42 +184,934 @@ void iC3_Database::closeDatabase( void )
 //    disconnect( &m_RequestProcessor, SIGNAL(signalGraphDoorOpenData(uint)), this, SLOT(handleGraphDoorOpenData(uint)));
 }
 
+//-----------------------------------------------------------------------------------------------
+/** setTransducerSegmentStore() - chooses where raw samples are kept: in segment files under
+*                                 HELMER_TRANSDUCER_DATA_FILE_PATH, with only rollups, the status
+*                                 journal and export marks in SQLite, or in the Transducers
+*                                 table.  Rows already in the table stay there and are still
+*                                 read; nothing is moved between the two.
+*   @param bEnabled - true: append raw samples to segment files
+*   @retval true - the setting applies from the next openDatabase()
+*   @retval false - the database is open
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_Database::setTransducerSegmentStore( bool bEnabled )
+{
+    if ( m_bDatabaseOpen )
+    {
+        return false;
+    }
+
+    m_sSegmentStorePath = bEnabled ? QString(HELMER_TRANSDUCER_DATA_FILE_PATH) : QString();
+
+    for ( int i = 0; i < m_Shards.size(); i++ )
+    {
+        m_Shards[i]->sSegmentStorePath = iC3_DatabaseShardCatalog::getShardSegmentStorePath( m_sSegmentStorePath, i );
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** setShardCount() - sets how many database files (shards) the devices' data is spread over.
+*                     Each shard has its own writer thread, so inserts for devices on different
+*                     shards are committed in parallel; put the files on separate disks to scale
+*                     further.  Shard 0 is HELMER_DATABASE_FILE_NAME.  A device stays on the shard
+*                     it was first logged to (see iC3_DatabaseShardCatalog), so the count may be
+*                     raised later but not lowered below a shard in use.  Data logged before the
+*                     catalog existed is in shard 0, so raise the count only once every device
+*                     has been logged with it.
+*   @param iShardCount - the number of shards (at least 1)
+*   @retval true - the setting applies from the next openDatabase()
+*   @retval false - the database is open
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_Database::setShardCount( int iShardCount )
+{
+    if ( m_bDatabaseOpen )
+    {
+        return false;
+    }
+
+    createShards( qMax( iShardCount, 1 ) );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getShardCount() - returns the number of shards set by setShardCount()
+*   @retval int - the shard count
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+int iC3_Database::getShardCount( void ) const
+{
+    return m_Shards.size();
+}
+
+//-----------------------------------------------------------------------------------------------
+/** createShards() - replaces the shards with iShardCount new, closed ones and connects their
+*                    signals.  Only called while the database is closed.
+*   @param iShardCount - the number of shards
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_Database::createShards( int iShardCount )
+{
+    deleteShards();
+
+    for ( int i = 0; i < iShardCount; i++ )
+    {
+        iC3_DatabaseShard * pShard = new iC3_DatabaseShard;
+
+        pShard->sDatabaseFileName = iC3_DatabaseShardCatalog::getShardFileName( m_sDatabaseFileName, i );
+        pShard->sSegmentStorePath = iC3_DatabaseShardCatalog::getShardSegmentStorePath( m_sSegmentStorePath, i );
+        pShard->RequestProcessor.setGroupCommitLimits( m_iGroupCommitWindowMS, m_iGroupCommitMaxRows );
+        pShard->RequestProcessor.setRetentionLimits( m_iRawRetentionHours, m_iMinuteRollupRetentionHours, m_bArchiveRawData );
+        pShard->RequestProcessor.setSpillJournal( &m_SpillJournal );
+
+        // results are emitted on the processor thread and queued to this object's thread.  A
+        // request sent to every shard is answered once, by finishFanOutReply().
+        connect( &pShard->RequestProcessor, SIGNAL(signalSuccess(uint)), this, SLOT(handleShardSuccess(uint)));
+        connect( &pShard->RequestProcessor, SIGNAL(signalRequestFailed(uint,QString)), this, SLOT(handleShardRequestFailed(uint,QString)));
+        connect( &pShard->RequestProcessor, SIGNAL(signalMaintenanceSlice(int,qint64,bool,QString)), this, SIGNAL(signalMaintenanceSlice(int,qint64,bool,QString)));
+
+        // reads run on the pool threads and are signaled the same way
+        connect( &pShard->ReadConnectionPool, SIGNAL(signalSuccess(uint)), this, SLOT(handleShardSuccess(uint)));
+        connect( &pShard->ReadConnectionPool, SIGNAL(signalRequestFailed(uint,QString)), this, SLOT(handleShardRequestFailed(uint,QString)));
+        connect( &pShard->ReadConnectionPool, SIGNAL(signalTransducerSamples(uint,QVector<iC3_TransducerSample>)), this, SIGNAL(signalTransducerSamples(uint,QVector<iC3_TransducerSample>)));
+        connect( &pShard->ReadConnectionPool, SIGNAL(signalTransducerRollups(uint,QVector<iC3_TransducerRollup>)), this, SIGNAL(signalTransducerRollups(uint,QVector<iC3_TransducerRollup>)));
+        connect( &pShard->ReadConnectionPool, SIGNAL(signalDeviceStatus(uint,iC3_DeviceStatus)), this, SIGNAL(signalDeviceStatus(uint,iC3_DeviceStatus)));
+        connect( &pShard->ReadConnectionPool, SIGNAL(signalDeviceEventCount(uint,iC3_DeviceEventCount)), this, SLOT(handleShardDeviceEventCount(uint,iC3_DeviceEventCount)));
+        connect( &pShard->ReadConnectionPool, SIGNAL(signalDeviceEvents(uint,QVector<iC3_DeviceEvent>)), this, SIGNAL(signalDeviceEvents(uint,QVector<iC3_DeviceEvent>)));
+
+        m_Shards.append( pShard );
+    }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** deleteShards() - deletes the shards.  Only called while the database is closed.
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_Database::deleteShards( void )
+{
+    for ( int i = 0; i < m_Shards.size(); i++ )
+    {
+        delete m_Shards[i];
+    }
+
+    m_Shards.clear();
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getShard() - returns the shard that holds a device's data
+*   @param iDeviceID - the device
+*   @param bPlaceNewDevice - true (writes): a device not seen before is placed on a shard;
+*                            false (reads): it is looked for in shard 0, which has nothing for it
+*   @retval pointer to the shard
+*   @retval NULL - the catalog is closed or could not be written
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_DatabaseShard * iC3_Database::getShard( int iDeviceID, bool bPlaceNewDevice )
+{
+    int iShardIndex = 0;
+
+    if ( bPlaceNewDevice )
+    {
+        if ( !m_ShardCatalog.getShardIndex( iDeviceID, iShardIndex ) )
+        {
+            return NULL;
+        }
+    }
+    else if ( !m_ShardCatalog.findShardIndex( iDeviceID, iShardIndex ) )
+    {
+        iShardIndex = 0;
+    }
+
+    return m_Shards[iShardIndex];
+}
+
+//-----------------------------------------------------------------------------------------------
+/** insertTransducerEntry() - SLOT that queues a transducer sample from the unit's own Fluke,
+*                             time stamped now, for the request processor.  Returns without
+*                             waiting for the write.
+*   @param fRTD1Val..fRTD5Val - RTD temperatures
+*   @retval true - the sample was queued, or spilled, see insertTransducerSample()
+*   @retval false - the sample was lost: the database could not take it and the spill journal
+*                   is full or could not be written
+*   @author  Doug Sanqunetti
+*   @date 09/01/2013
+*/
+//-----------------------------------------------------------------------------------------------
 bool iC3_Database::insertTransducerEntry( double fRTD1Val,
                                           double fRTD2Val,
                                           double fRTD3Val,
                                           double fRTD4Val,
                                           double fRTD5Val )
 {
-    return m_TransducerTable.insertNewEntry( m_db, fRTD1Val, fRTD2Val, fRTD3Val, fRTD4Val, fRTD5Val);
+    iC3_TransducerSample sample;
+
+    sample.iDeviceID = TRANSDUCER_LOCAL_DEVICE_ID;
+    sample.llSampleTimeMS = QDateTime::currentMSecsSinceEpoch();
+    sample.adRTDValues[0] = fRTD1Val;
+    sample.adRTDValues[1] = fRTD2Val;
+    sample.adRTDValues[2] = fRTD3Val;
+    sample.adRTDValues[3] = fRTD4Val;
+    sample.adRTDValues[4] = fRTD5Val;
+
+    return insertTransducerSample( sample );
 }
 
+//-----------------------------------------------------------------------------------------------
+/** insertTransducerSample() - SLOT that queues a sample from any device of the fleet for the
+*                              writer of the device's shard.  The sample gets the next sequence
+*                              index; one with no time is time stamped now.  Returns without
+*                              waiting for the write.
+*
+*                              A sample the database cannot take - it is closed, or the device
+*                              cannot be placed on a shard, or the write or its commit fails - is
+*                              appended to the spill journal and replayed once the database is
+*                              open and writing again.  The processor reports a sample it spilled
+*                              with signalSuccess().
+*   @param sample - iDeviceID, llSampleTimeMS and the RTD values are used
+*   @retval true - the sample was queued; signalSuccess() or signalRequestFailed() follows.  Or
+*                  it was spilled straight away, and nothing follows.
+*   @retval false - the sample was lost: the database could not take it and the spill journal
+*                   is full or could not be written
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_Database::insertTransducerSample( const iC3_TransducerSample & sample )
+{
+    iC3_TransducerSample stampedSample = sample;
 
-////-----------------------------------------------------------------------------------------------
-///** getTransactionID() - get a unique transaction ID and pass it back to the calling function.
-//*                        This is used to identify the request when the a transducer log request
-//*                        returns a response.
-//*   @retval - transaction ID (uint) value between 0 and 32767
-//*   @author Doug Sanqunetti
-//*   @date 12/13/2013
-//*/
-////-----------------------------------------------------------------------------------------------
-//uint iC3_Database::getTransactionID( void )
-//{
-//    uint returnID;
-//    m_TransactionIDMutex.lock();
+    // spilled without an index if none can be reserved; the replay assigns one
+    stampedSample.llSequenceIndex = 0;
+
+    if ( stampedSample.llSampleTimeMS == 0 )
+    {
+        stampedSample.llSampleTimeMS = QDateTime::currentMSecsSinceEpoch();
+    }
+
+    iC3_DatabaseShard * pShard = getShard( stampedSample.iDeviceID, true );
+
+    if ( ( pShard == NULL ) || !m_SequenceAllocator.allocate( stampedSample.llSequenceIndex ) )
+    {
+        return spillTransducerSample( stampedSample );
+    }
+
+    iC3_DatabaseRequest * pRequest = new iC3_DatabaseRequest( eDB_REQUEST_INSERT_TRANSDUCER_SAMPLE );
+    pRequest->setTransactionID( getTransactionID() );
+    pRequest->setTransducerSample( stampedSample );
+
+    if ( !pShard->RequestProcessor.AddRequestToQueue( pRequest ) )
+    {
+        return spillTransducerSample( stampedSample );
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** spillTransducerSample() - appends a sample the database cannot take to the spill journal
+*   @param sample - the sample; a sequence index of 0 is assigned when it is replayed
+*   @retval true - the sample is in the journal
+*   @retval false - the journal is closed, full or could not be written; the sample is lost.
+*                   The first loss is logged, and the count once the journal takes a sample
+*                   again.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_Database::spillTransducerSample( const iC3_TransducerSample & sample )
+{
+    if ( !m_SpillJournal.append( sample ) )
+    {
+        if ( m_iLostSamples.fetchAndAddOrdered( 1 ) == 0 )
+        {
+            qDebug() << "iC3_Database - losing samples, starting with device" << sample.iDeviceID << ":" << m_SpillJournal.GetLastError();
+        }
+        return false;
+    }
+
+    int iLostSamples = m_iLostSamples.fetchAndStoreOrdered( 0 );
+
+    if ( iLostSamples > 0 )
+    {
+        qDebug() << "iC3_Database -" << iLostSamples << "samples were lost";
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** insertDeviceStatus() - SLOT that queues a status poll, time stamped now, for the status
+*                          journal.  Only the fields that changed since the device's previous
+*                          poll are written, with every field written once per keyframe interval.
+*   @param status - the polled fields; iDeviceID identifies the device
+*   @retval true - the status was queued; signalSuccess() or signalRequestFailed() follows
+*   @retval false - the database is not open
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_Database::insertDeviceStatus( const iC3_DeviceStatus & status )
+{
+    iC3_DatabaseShard * pShard = getShard( status.iDeviceID, true );
+
+    if ( pShard == NULL )
+    {
+        return false;
+    }
+
+    iC3_DeviceStatus stampedStatus = status;
+    stampedStatus.llStatusTimeMS = QDateTime::currentMSecsSinceEpoch();
+
+    iC3_DatabaseRequest * pRequest = new iC3_DatabaseRequest( eDB_REQUEST_INSERT_DEVICE_STATUS );
+    pRequest->setTransactionID( getTransactionID() );
+    pRequest->setDeviceStatus( stampedStatus );
+
+    return pShard->RequestProcessor.AddRequestToQueue( pRequest );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getTransducerEntriesInRange() - queues a read of a device's transducer samples between two
+*                                   times, oldest first.  The samples are delivered by
+*                                   signalTransducerSamples().  To page through a long range,
+*                                   pass the last sample delivered to getNextTransducerEntries().
+*   @param uiTransactionID - a unique identifier that is used when signaling the result
+*   @param iDeviceID - the device whose samples are wanted
+*   @param llBeginTimeMS - start of the range, ms since the epoch (inclusive)
+*   @param llEndTimeMS - end of the range, ms since the epoch (exclusive)
+*   @param iMaxEntries - maximum number of samples to return
+*   @retval true - the request was queued
+*   @retval false - the database is not open, or uiTransactionID is reserved
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_Database::getTransducerEntriesInRange( uint uiTransactionID, int iDeviceID, qint64 llBeginTimeMS, qint64 llEndTimeMS, int iMaxEntries )
+{
+    iC3_TransducerSample cursor;
+
+    // positioned just before the first possible sample at llBeginTimeMS
+    cursor.llSequenceIndex = -1;
+    cursor.iDeviceID = iDeviceID;
+    cursor.llSampleTimeMS = llBeginTimeMS;
+
+    return getNextTransducerEntries( uiTransactionID, cursor, llEndTimeMS, iMaxEntries );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getNextTransducerEntries() - queues a read of the page of samples that follows lastSample
+*                                (same device, before llEndTimeMS), delivered oldest first by
+*                                signalTransducerSamples().  A page shorter than iMaxEntries
+*                                ends the range.
+*   @param uiTransactionID - a unique identifier that is used when signaling the result
+*   @param lastSample - the last sample of the previous page
+*   @param llEndTimeMS - end of the range, ms since the epoch (exclusive)
+*   @param iMaxEntries - maximum number of samples to return
+*   @retval true - the request was queued
+*   @retval false - the database is not open, or uiTransactionID is reserved
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_Database::getNextTransducerEntries( uint uiTransactionID, const iC3_TransducerSample & lastSample, qint64 llEndTimeMS, int iMaxEntries )
+{
+    if ( isReservedTransactionID( uiTransactionID ) )
+    {
+        return false;
+    }
+
+    iC3_DatabaseRequest * pRequest = new iC3_DatabaseRequest( eDB_REQUEST_GET_TRANSDUCER_SAMPLES );
+    pRequest->setTransactionID( uiTransactionID );
+    pRequest->setTransducerSample( lastSample );
+    pRequest->setEndTimeMS( llEndTimeMS );
+    pRequest->setMaxEntries( iMaxEntries );
+
+    return getShard( lastSample.iDeviceID, false )->ReadConnectionPool.AddRequestToQueue( pRequest );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getLastTransducerEntries() - queues a read of a device's most recent transducer samples,
+*                                delivered oldest first by signalTransducerSamples().  Reads
+*                                see committed samples only, so inserts still inside the
+*                                group commit window (setGroupCommitLimits()) are not included.
+*   @param uiTransactionID - a unique identifier that is used when signaling the result
+*   @param iDeviceID - the device whose samples are wanted
+*   @param iNumberOfEntries - the number of samples to return
+*   @retval true - the request was queued
+*   @retval false - the database is not open, or uiTransactionID is reserved
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_Database::getLastTransducerEntries( uint uiTransactionID, int iDeviceID, int iNumberOfEntries )
+{
+    if ( isReservedTransactionID( uiTransactionID ) )
+    {
+        return false;
+    }
+
+    iC3_DatabaseRequest * pRequest = new iC3_DatabaseRequest( eDB_REQUEST_GET_LAST_N_TRANSDUCER_SAMPLES );
+    pRequest->setTransactionID( uiTransactionID );
+    pRequest->setDeviceID( iDeviceID );
+    pRequest->setMaxEntries( iNumberOfEntries );
+
+    return getShard( iDeviceID, false )->ReadConnectionPool.AddRequestToQueue( pRequest );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getTransducerHistory() - queues a read of a device's samples between two times from both the
+*                            compacted blocks and the raw table.  The samples are delivered,
+*                            oldest first, by signalTransducerSamples().  Compacted samples have
+*                            a sequence index of 0 and 0.01 degree resolution.
+*   @param uiTransactionID - a unique identifier that is used when signaling the result
+*   @param iDeviceID - the device whose samples are wanted
+*   @param llBeginTimeMS - start of the range, ms since the epoch (inclusive)
+*   @param llEndTimeMS - end of the range, ms since the epoch (exclusive)
+*   @retval true - the request was queued
+*   @retval false - the database is not open, or uiTransactionID is reserved
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_Database::getTransducerHistory( uint uiTransactionID, int iDeviceID, qint64 llBeginTimeMS, qint64 llEndTimeMS )
+{
+    if ( isReservedTransactionID( uiTransactionID ) )
+    {
+        return false;
+    }
+
+    iC3_DatabaseRequest * pRequest = new iC3_DatabaseRequest( eDB_REQUEST_GET_TRANSDUCER_HISTORY );
+    pRequest->setTransactionID( uiTransactionID );
+    pRequest->setDeviceID( iDeviceID );
+    pRequest->setBeginTimeMS( llBeginTimeMS );
+    pRequest->setEndTimeMS( llEndTimeMS );
+
+    return getShard( iDeviceID, false )->ReadConnectionPool.AddRequestToQueue( pRequest );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** compactTransducerHistory() - queues the conversion of raw transducer rows into compact hourly
+*                                blocks.  Every complete hour before llBeforeTimeMS is packed;
+*                                run it once to migrate an existing database, then periodically.
+*                                Each device-hour is its own transaction, but each shard's
+*                                processor runs the whole request in one go, so writes queued
+*                                meanwhile wait.  The shards compact in parallel and one
+*                                signalSuccess() or signalRequestFailed() reports them all.
+*   @param uiTransactionID - identifies the signalSuccess()/signalRequestFailed() that follows
+*   @param llBeforeTimeMS - rows before the start of this time's hour are compacted
+*   @retval true - the request was queued
+*   @retval false - the database is not open, or uiTransactionID is reserved
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_Database::compactTransducerHistory( uint uiTransactionID, qint64 llBeforeTimeMS )
+{
+    iC3_DatabaseRequest request( eDB_REQUEST_COMPACT_TRANSDUCER_HISTORY );
+    request.setTransactionID( uiTransactionID );
+    request.setEndTimeMS( llBeforeTimeMS );
+
+    return queueOnEveryShard( request, true );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getTransducerRollups() - queues a read of a device's 1 minute or 1 hour summaries (count,
+*                            min, max and sum per RTD) between two times.  The buckets are
+*                            delivered, oldest first, by signalTransducerRollups().  Rollups
+*                            are kept after the raw samples have expired, so this is the query
+*                            to use for long trends.
+*   @param uiTransactionID - a unique identifier that is used when signaling the result
+*   @param iDeviceID - the device whose rollups are wanted
+*   @param eLevel - bucket size
+*   @param llBeginTimeMS - start of the range, ms since the epoch (inclusive)
+*   @param llEndTimeMS - end of the range, ms since the epoch (exclusive)
+*   @retval true - the request was queued
+*   @retval false - the database is not open, or uiTransactionID is reserved
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_Database::getTransducerRollups( uint uiTransactionID, int iDeviceID, eTransducerRollupLevels eLevel, qint64 llBeginTimeMS, qint64 llEndTimeMS )
+{
+    if ( isReservedTransactionID( uiTransactionID ) )
+    {
+        return false;
+    }
+
+    iC3_DatabaseRequest * pRequest = new iC3_DatabaseRequest( eDB_REQUEST_GET_TRANSDUCER_ROLLUPS );
+    pRequest->setTransactionID( uiTransactionID );
+    pRequest->setDeviceID( iDeviceID );
+    pRequest->setRollupLevel( eLevel );
+    pRequest->setBeginTimeMS( llBeginTimeMS );
+    pRequest->setEndTimeMS( llEndTimeMS );
+
+    return getShard( iDeviceID, false )->ReadConnectionPool.AddRequestToQueue( pRequest );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getDeviceStatusAtTime() - queues a rebuild of a device's status fields as they were at
+*                             llTimeMS, from the last keyframe before it and the changes since.
+*                             The status is delivered by signalDeviceStatus(); its
+*                             llStatusTimeMS is the time of the last change at or before
+*                             llTimeMS, or 0 if nothing had been journaled by then.
+*   @param uiTransactionID - a unique identifier that is used when signaling the result
+*   @param iDeviceID - the device whose status is wanted
+*   @param llTimeMS - ms since the epoch
+*   @retval true - the request was queued
+*   @retval false - the database is not open, or uiTransactionID is reserved
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_Database::getDeviceStatusAtTime( uint uiTransactionID, int iDeviceID, qint64 llTimeMS )
+{
+    if ( isReservedTransactionID( uiTransactionID ) )
+    {
+        return false;
+    }
+
+    iC3_DatabaseRequest * pRequest = new iC3_DatabaseRequest( eDB_REQUEST_GET_DEVICE_STATUS_AT_TIME );
+    pRequest->setTransactionID( uiTransactionID );
+    pRequest->setDeviceID( iDeviceID );
+    pRequest->setEndTimeMS( llTimeMS );
+
+    return getShard( iDeviceID, false )->ReadConnectionPool.AddRequestToQueue( pRequest );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getDeviceEventCount() - queues a read of how many of a device's events of one type started
+*                           on the local days from beginDate to endDate, and their total
+*                           duration.  The counts are kept per day as the events are recorded,
+*                           so this reads one row per day.  The result is delivered by
+*                           signalDeviceEventCount().
+*   @param uiTransactionID - a unique identifier that is used when signaling the result
+*   @param iDeviceID - the device whose events are counted
+*   @param eEventType - the kind of event
+*   @param beginDate - the first day counted
+*   @param endDate - the last day counted (inclusive)
+*   @retval true - the request was queued
+*   @retval false - the database is not open, or uiTransactionID is reserved
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_Database::getDeviceEventCount( uint uiTransactionID,
+                                        int iDeviceID,
+                                        eDeviceEventTypes eEventType,
+                                        QDate beginDate,
+                                        QDate endDate )
+{
+    return queueDeviceEventCount( uiTransactionID, iDeviceID, eEventType,
+                                  QDateTime( beginDate ).toMSecsSinceEpoch(),
+                                  QDateTime( endDate.addDays( 1 ) ).toMSecsSinceEpoch() );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getDeviceEvents() - queues a read of a device's events of one type that were active at any
+*                       time between two times, oldest first.  An event still active has an
+*                       llEndTimeMS of 0.  The events are delivered by signalDeviceEvents().
+*   @param uiTransactionID - a unique identifier that is used when signaling the result
+*   @param iDeviceID - the device whose events are wanted
+*   @param eEventType - the kind of event
+*   @param llBeginTimeMS - start of the range, ms since the epoch (inclusive)
+*   @param llEndTimeMS - end of the range, ms since the epoch (exclusive)
+*   @retval true - the request was queued
+*   @retval false - the database is not open, or uiTransactionID is reserved
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_Database::getDeviceEvents( uint uiTransactionID,
+                                    int iDeviceID,
+                                    eDeviceEventTypes eEventType,
+                                    qint64 llBeginTimeMS,
+                                    qint64 llEndTimeMS )
+{
+    if ( isReservedTransactionID( uiTransactionID ) )
+    {
+        return false;
+    }
+
+    iC3_DatabaseRequest * pRequest = new iC3_DatabaseRequest( eDB_REQUEST_GET_DEVICE_EVENTS );
+    pRequest->setTransactionID( uiTransactionID );
+    pRequest->setDeviceID( iDeviceID );
+    pRequest->setEventType( eEventType );
+    pRequest->setBeginTimeMS( llBeginTimeMS );
+    pRequest->setEndTimeMS( llEndTimeMS );
+
+    return getShard( iDeviceID, false )->ReadConnectionPool.AddRequestToQueue( pRequest );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getDoorOpeningsToday() - queues a read of the number of door openings since local midnight.
+*                            The result is delivered by signalDeviceEventCount().
+*   @param uiTransactionID - a unique identifier that is used when signaling the result
+*   @param iDeviceID - the device whose door openings are counted
+*   @retval true - the request was queued
+*   @retval false - the database is not open, or uiTransactionID is reserved
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_Database::getDoorOpeningsToday( uint uiTransactionID, int iDeviceID )
+{
+    QDate today = QDate::currentDate();
+
+    return getDeviceEventCount( uiTransactionID, iDeviceID, eDEVICE_EVENT_DOOR_OPEN, today, today );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getDoorOpeningsForDateRange() - queues a read of the number of door openings on the local
+*                                   days in a date range.  The result is delivered by
+*                                   signalDeviceEventCount().
+*   @param uiTransactionID - a unique identifier that is used when signaling the result
+*   @param iDeviceID - the device whose door openings are counted
+*   @param beginDateRange - the first day counted
+*   @param endDateRange - the last day counted (inclusive)
+*   @retval true - the request was queued
+*   @retval false - the database is not open, or uiTransactionID is reserved
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_Database::getDoorOpeningsForDateRange( uint uiTransactionID,
+                                                int iDeviceID,
+                                                QDate beginDateRange,
+                                                QDate endDateRange )
+{
+    return getDeviceEventCount( uiTransactionID, iDeviceID, eDEVICE_EVENT_DOOR_OPEN, beginDateRange, endDateRange );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getTotalDoorOpenings() - queues a read of the number of door openings ever recorded.  This
+*                            sums one row per day with door openings.  The result is delivered
+*                            by signalDeviceEventCount().
+*   @param uiTransactionID - a unique identifier that is used when signaling the result
+*   @param iDeviceID - the device whose door openings are counted
+*   @retval true - the request was queued
+*   @retval false - the database is not open, or uiTransactionID is reserved
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_Database::getTotalDoorOpenings( uint uiTransactionID, int iDeviceID )
+{
+    return queueDeviceEventCount( uiTransactionID, iDeviceID, eDEVICE_EVENT_DOOR_OPEN,
+                                  std::numeric_limits<qint64>::min(), std::numeric_limits<qint64>::max() );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getFleetEventCount() - queues a read of how many events of one type started on the local
+*                          days from beginDate to endDate across every device in the shard
+*                          catalog, and their total duration.  Each device is read on its own
+*                          shard, in parallel; the sum is delivered by one
+*                          signalDeviceEventCount() with an iDeviceID of DEVICE_ID_ALL_DEVICES.
+*   @param uiTransactionID - a unique identifier that is used when signaling the result
+*   @param eEventType - the kind of event
+*   @param beginDate - the first day counted
+*   @param endDate - the last day counted (inclusive)
+*   @retval true - the request was queued
+*   @retval false - the database is not open, no device has been logged yet, or
+*                   uiTransactionID is reserved
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_Database::getFleetEventCount( uint uiTransactionID, eDeviceEventTypes eEventType, QDate beginDate, QDate endDate )
+{
+    QList<int> deviceIDs = m_ShardCatalog.getDeviceIDs();
+
+    if ( !m_bDatabaseOpen || deviceIDs.isEmpty() || isReservedTransactionID( uiTransactionID ) )
+    {
+        return false;
+    }
+
+    FanOut fanOut;
+    fanOut.iPendingReplies = deviceIDs.size();
+    fanOut.bEventCount = true;
+    fanOut.EventCount.iDeviceID = DEVICE_ID_ALL_DEVICES;
+    fanOut.EventCount.iEventType = eEventType;
+    fanOut.EventCount.llBeginTimeMS = QDateTime( beginDate ).toMSecsSinceEpoch();
+    fanOut.EventCount.llEndTimeMS = QDateTime( endDate.addDays( 1 ) ).toMSecsSinceEpoch();
+    fanOut.EventCount.llCount = 0;
+    fanOut.EventCount.llTotalDurationMS = 0;
+    fanOut.iReplayedRecords = 0;
+
+    {
+        QMutexLocker locker( &m_FanOutMutex );
+        m_FanOuts.insert( uiTransactionID, fanOut );
+    }
+
+    int iNotQueued = 0;
+
+    for ( int i = 0; i < deviceIDs.size(); i++ )
+    {
+        iC3_DatabaseRequest * pRequest = new iC3_DatabaseRequest( eDB_REQUEST_GET_DEVICE_EVENT_COUNT );
+        pRequest->setTransactionID( uiTransactionID );
+        pRequest->setDeviceID( deviceIDs[i] );
+        pRequest->setEventType( eEventType );
+        pRequest->setBeginTimeMS( fanOut.EventCount.llBeginTimeMS );
+        pRequest->setEndTimeMS( fanOut.EventCount.llEndTimeMS );
+
+        if ( !getShard( deviceIDs[i], false )->ReadConnectionPool.AddRequestToQueue( pRequest ) )
+        {
+            iNotQueued++;
+        }
+    }
+
+    if ( iNotQueued == deviceIDs.size() )
+    {
+        QMutexLocker locker( &m_FanOutMutex );
+        m_FanOuts.remove( uiTransactionID );
+        return false;
+    }
+
+    for ( int i = 0; i < iNotQueued; i++ )
+    {
+        finishFanOutReply( uiTransactionID, false, "iC3_Database - a shard is not open", NULL );
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** queueDeviceEventCount() - queues a read of a device's per-day event counts
+*   @param uiTransactionID - a unique identifier that is used when signaling the result
+*   @param iDeviceID - the device whose events are counted
+*   @param eEventType - the kind of event
+*   @param llBeginTimeMS - local midnight starting the first day (inclusive)
+*   @param llEndTimeMS - local midnight ending the last day (exclusive)
+*   @retval true - the request was queued
+*   @retval false - the database is not open
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_Database::queueDeviceEventCount( uint uiTransactionID,
+                                          int iDeviceID,
+                                          eDeviceEventTypes eEventType,
+                                          qint64 llBeginTimeMS,
+                                          qint64 llEndTimeMS )
+{
+    if ( isReservedTransactionID( uiTransactionID ) )
+    {
+        return false;
+    }
+
+    iC3_DatabaseRequest * pRequest = new iC3_DatabaseRequest( eDB_REQUEST_GET_DEVICE_EVENT_COUNT );
+    pRequest->setTransactionID( uiTransactionID );
+    pRequest->setDeviceID( iDeviceID );
+    pRequest->setEventType( eEventType );
+    pRequest->setBeginTimeMS( llBeginTimeMS );
+    pRequest->setEndTimeMS( llEndTimeMS );
+
+    return getShard( iDeviceID, false )->ReadConnectionPool.AddRequestToQueue( pRequest );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** setGroupCommitLimits() - sets how long, and for how many samples, transducer inserts may
+*                            accumulate before each shard's request processor commits them.
+*                            This is the amount of data at risk if the application dies.
+*   @param iWindowMS - maximum age of the oldest uncommitted sample
+*   @param iMaxRows - maximum number of samples per transaction
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_Database::setGroupCommitLimits( int iWindowMS, int iMaxRows )
+{
+    m_iGroupCommitWindowMS = iWindowMS;
+    m_iGroupCommitMaxRows = iMaxRows;
+
+    for ( int i = 0; i < m_Shards.size(); i++ )
+    {
+        m_Shards[i]->RequestProcessor.setGroupCommitLimits( iWindowMS, iMaxRows );
+    }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** setRetentionLimits() - sets how long raw samples and 1 minute rollups are kept.  Expired
+*                          data is removed in small batches while the database is idle.
+*   @param iRawRetentionHours - age after which raw samples expire (0 = never)
+*   @param iMinuteRollupRetentionHours - age after which 1 minute rollups are deleted (0 = never)
+*   @param bArchiveRawData - true: expired raw samples are compacted into hourly blocks;
+*                            false: they are deleted
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_Database::setRetentionLimits( int iRawRetentionHours, int iMinuteRollupRetentionHours, bool bArchiveRawData )
+{
+    m_iRawRetentionHours = iRawRetentionHours;
+    m_iMinuteRollupRetentionHours = iMinuteRollupRetentionHours;
+    m_bArchiveRawData = bArchiveRawData;
+
+    for ( int i = 0; i < m_Shards.size(); i++ )
+    {
+        m_Shards[i]->RequestProcessor.setRetentionLimits( iRawRetentionHours, iMinuteRollupRetentionHours, bArchiveRawData );
+    }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** exportTransducerCSV() - starts writing a device's samples between two times to a CSV file
+*                           on a separate thread with its own read-only connection.  Progress
+*                           is reported by signalExportProgress() and the outcome by
+*                           signalExportComplete(), signalExportCancelled() or
+*                           signalExportFailed().  Only one export runs at a time.
+*   @param uiTransactionID - identifies the signals that follow
+*   @param sCSVFileName - the file to create (replaced if it exists)
+*   @param iDeviceID - the device whose samples are exported
+*   @param llBeginTimeMS - start of the range, ms since the epoch (inclusive)
+*   @param llEndTimeMS - end of the range, ms since the epoch (exclusive)
+*   @retval true - the export was started
+*   @retval false - the database is not open or an export is already running
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_Database::exportTransducerCSV( uint uiTransactionID, const QString & sCSVFileName, int iDeviceID, qint64 llBeginTimeMS, qint64 llEndTimeMS )
+{
+    if ( !m_bDatabaseOpen )
+    {
+        return false;
+    }
+
+    iC3_DatabaseShard * pShard = getShard( iDeviceID, false );
+
+    if ( !m_TransducerExporter.setSegmentStorePath( pShard->sSegmentStorePath ) )
+    {
+        return false;
+    }
+
+    return m_TransducerExporter.startExport( uiTransactionID, pShard->sDatabaseFileName, sCSVFileName,
+                                             iDeviceID, llBeginTimeMS, llEndTimeMS );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** exportNewTransducerCSV() - starts an incremental export: only the device's samples that have
+*                              not been exported to sDestination before are written, and the
+*                              destination's mark moves on once the file is in place.  Safe to
+*                              interrupt at any point - the next export to the destination
+*                              neither repeats nor misses a row.  The export stops short of
+*                              the oldest sample that may still be committed - queued or
+*                              uncommitted in the device's shard, or waiting in the spill
+*                              journal - so a sample stored late is picked up by a later export
+*                              rather than left behind the mark.  Signals as
+*                              exportTransducerCSV().
+*   @param uiTransactionID - identifies the signals that follow
+*   @param sDestination - names the consumer (e.g. "nightly"); each keeps its own mark
+*   @param sCSVFileName - the file to create; use a new name for each export
+*   @param iDeviceID - the device whose samples are exported
+*   @retval true - the export was started
+*   @retval false - the database is not open or an export is already running
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_Database::exportNewTransducerCSV( uint uiTransactionID, const QString & sDestination, const QString & sCSVFileName, int iDeviceID )
+{
+    if ( !m_bDatabaseOpen )
+    {
+        return false;
+    }
+
+    iC3_DatabaseShard * pShard = getShard( iDeviceID, false );
+
+    if ( !m_TransducerExporter.setSegmentStorePath( pShard->sSegmentStorePath ) )
+    {
+        return false;
+    }
+
+    // the mark only moves forward, so nothing that is still to be committed may end up behind
+    // it.  The shard is asked first: its writer spills a sample before settling it.
+    qint64 llEndLimitMS = std::numeric_limits<qint64>::max();
+    qint64 llPendingTimeMS = pShard->RequestProcessor.getOldestPendingSampleTimeMS();
+    qint64 llSpilledTimeMS = m_SpillJournal.getOldestSampleTimeMS( iDeviceID );
+
+    if ( llPendingTimeMS >= 0 )
+    {
+        llEndLimitMS = llPendingTimeMS;
+    }
+
+    if ( llSpilledTimeMS >= 0 )
+    {
+        llEndLimitMS = qMin( llEndLimitMS, llSpilledTimeMS );
+    }
+
+    return m_TransducerExporter.startIncrementalExport( uiTransactionID, pShard->sDatabaseFileName, sDestination,
+                                                        sCSVFileName, iDeviceID, llEndLimitMS );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** cancelTransducerExport() - stops a running export; signalExportCancelled() follows and the
+*                              partial file is removed
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_Database::cancelTransducerExport( void )
+{
+    m_TransducerExporter.cancelExport();
+}
+
+//-----------------------------------------------------------------------------------------------
+/** setTransducerExportFormat() - sets how later transducer exports write the sample time.  The
+*                                 default is yyyy-MM-dd hh:mm:ss.zzz in UTC.
+*   @param dateFormat - date field order
+*   @param timeFormat - 12 or 24 hour
+*   @param bLocalTime - true: local time; false: UTC
+*   @retval true - the format was set
+*   @retval false - an export is running
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_Database::setTransducerExportFormat( eDateFormats dateFormat, eTimeFormats timeFormat, bool bLocalTime )
+{
+    return m_TransducerExporter.setExportFormat( dateFormat, timeFormat, bLocalTime );
+}
 
-//    m_uiTransactionID++;
-//    if( m_uiTransactionID > 32767 )
-//    {
-//        m_uiTransactionID = 0;
-//    }
+//-----------------------------------------------------------------------------------------------
+/** snapshotDatabase() - starts copying the live database to sSnapshotFileName while logging
+*                        continues.  The copy is consistent as of the moment it starts.
+*                        Progress and throughput are reported by signalSnapshotProgress() and
+*                        the outcome by signalSnapshotComplete(), signalSnapshotCancelled() or
+*                        signalSnapshotFailed().
+*   @param uiTransactionID - identifies the signals that follow
+*   @param sSnapshotFileName - the file to create (replaced if it exists)
+*   @param iShardIndex - the shard to copy; snapshot each shard to back up the whole fleet
+*   @retval true - the snapshot was started
+*   @retval false - the database is not open, there is no such shard or a snapshot is already
+*                   running
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_Database::snapshotDatabase( uint uiTransactionID, const QString & sSnapshotFileName, int iShardIndex )
+{
+    if ( !m_bDatabaseOpen || ( iShardIndex < 0 ) || ( iShardIndex >= m_Shards.size() ) )
+    {
+        return false;
+    }
 
-//    returnID = m_uiTransactionID;
+    return m_DatabaseSnapshot.startSnapshot( uiTransactionID, m_Shards[iShardIndex]->sDatabaseFileName, sSnapshotFileName );
+}
 
-//    m_TransactionIDMutex.unlock();
+//-----------------------------------------------------------------------------------------------
+/** cancelDatabaseSnapshot() - stops a running snapshot; signalSnapshotCancelled() follows and
+*                              the partial copy is removed
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_Database::cancelDatabaseSnapshot( void )
+{
+    m_DatabaseSnapshot.cancelSnapshot();
+}
 
-//    return returnID;
-//}
+//-----------------------------------------------------------------------------------------------
+/** getTransactionID() - get a unique transaction ID and pass it back to the calling function.
+*                        This is used to identify the request when the a transducer log request
+*                        returns a response.  Safe to call from any thread.
+*   @retval - transaction ID (uint) value between 0 and 32767
+*   @author Doug Sanqunetti
+*   @date 12/13/2013
+*/
+//-----------------------------------------------------------------------------------------------
+uint iC3_Database::getTransactionID( void )
+{
+    return (uint) ( m_TransactionID.fetchAndAddOrdered( 1 ) + 1 ) & 0x7FFF;
+}
 
 ////-----------------------------------------------------------------------------------------------
 ///** setInterfacePointer() - Setting this pointer allows the connection of a SIGNAL emitted from
@@ -210,32 +1180,349 @@ bool iC3_Database::insertTransducerEntry( double fRTD1Val,
 //    disconnect( &m_RequestProcessor, SIGNAL(signalESIN_RangeForCSV_Generation(uint,quint32,quint32)), pCSV_FileGenerator, SLOT(handleESIN_RangeForCSV_Generation(uint,quint32,quint32)));
 //}
 
-////-----------------------------------------------------------------------------------------------
-///** performDB_IntegrityCheck() - Add a request to perform a database integrity check to the
-//*                                database request processing queue
-//*   @retval true - the request was added to the database request queue
-//*   @retval false - the request was not successfully added to the database request queue
-//*   @author Doug Sanqunetti
-//*   @date 04/01/2014
-//*/
-////-----------------------------------------------------------------------------------------------
-//bool iC3_Database::performDB_IntegrityCheck( void )
-//{
-//    bool bRC = false;
-//    iC3_DatabaseRequest * pRequest;
+//-----------------------------------------------------------------------------------------------
+/** performDB_IntegrityCheck() - Add a request to perform a database integrity check.  The check
+*                                runs on a read connection of every shard, so logging carries on
+*                                meanwhile; one signalSuccess() or signalRequestFailed() reports
+*                                them all.
+*   @param  uiTransactionID - a unique identifier that is used when signaling the result
+*   @retval true - the request was queued
+*   @retval false - the database is not open, or uiTransactionID is reserved
+*   @author Doug Sanqunetti
+*   @date 04/01/2014
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_Database::performDB_IntegrityCheck( uint uiTransactionID )
+{
+    iC3_DatabaseRequest request( eDB_REQUEST_PERFORM_INTEGRITY_CHECK );
+    request.setTransactionID( uiTransactionID );
 
-//    // make sure our request is protected until we are able to add the request to the queue
-//    QMutexLocker locker( & m_DB_RequestMutex );
+    return queueOnEveryShard( request, false );
+}
 
-//    pRequest = new iC3_DatabaseRequest( eDB_REQUEST_PERFORM_INTEGRITY_CHECK );
+//-----------------------------------------------------------------------------------------------
+/** queueOnEveryShard() - queues a copy of a request for every shard.  With more than one shard
+*                         the replies are collected by finishFanOutReply(), which answers once.
+*                         The transaction ID must not be in use by another request meanwhile.
+*   @param request - the request to copy
+*   @param bWrite - true: queue for the shards' request processors; false: for their readers
+*   @retval true - the request was queued on at least one shard; a shard that refused it is
+*                  reported as failed
+*   @retval false - the database is not open, or the transaction ID is reserved
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_Database::queueOnEveryShard( const iC3_DatabaseRequest & request, bool bWrite )
+{
+    uint uiTransactionID = request.getTransactionID();
+    bool bFanOut = ( m_Shards.size() > 1 );
 
-//    if ( pRequest != NULL )
-//    {
-//        bRC = m_RequestProcessor.AddRequestToQueue(pRequest);
-//    }
+    if ( isReservedTransactionID( uiTransactionID ) )
+    {
+        return false;
+    }
 
-//    return bRC;
-//}
+    if ( bFanOut )
+    {
+        FanOut fanOut;
+        fanOut.iPendingReplies = m_Shards.size();
+        fanOut.bEventCount = false;
+        fanOut.iReplayedRecords = 0;
+
+        QMutexLocker locker( &m_FanOutMutex );
+        m_FanOuts.insert( uiTransactionID, fanOut );
+    }
+
+    int iNotQueued = 0;
+
+    for ( int i = 0; i < m_Shards.size(); i++ )
+    {
+        iC3_DatabaseRequest * pRequest = new iC3_DatabaseRequest( request );
+        pRequest->setNext( NULL );
+
+        bool bQueued = bWrite ? m_Shards[i]->RequestProcessor.AddRequestToQueue( pRequest )
+                              : m_Shards[i]->ReadConnectionPool.AddRequestToQueue( pRequest );
+
+        if ( !bQueued )
+        {
+            iNotQueued++;
+        }
+    }
+
+    if ( iNotQueued == m_Shards.size() )
+    {
+        QMutexLocker locker( &m_FanOutMutex );
+        m_FanOuts.remove( uiTransactionID );
+        return false;
+    }
+
+    for ( int i = 0; bFanOut && ( i < iNotQueued ); i++ )
+    {
+        finishFanOutReply( uiTransactionID, false, "iC3_Database - a shard is not open", NULL );
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** handleShardSuccess() - SLOT that receives a shard's signalSuccess().  A shard that is
+*                          writing again may take the samples waiting in the spill journal.
+*   @param uiTransactionID - the request that succeeded
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_Database::handleShardSuccess( uint uiTransactionID )
+{
+    finishFanOutReply( uiTransactionID, true, QString(), NULL );
+
+    replaySpilledSamples();
+}
+
+//-----------------------------------------------------------------------------------------------
+/** handleShardRequestFailed() - SLOT that receives a shard's signalRequestFailed()
+*   @param uiTransactionID - the request that failed
+*   @param sErrorMessage - why
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_Database::handleShardRequestFailed( uint uiTransactionID, QString sErrorMessage )
+{
+    finishFanOutReply( uiTransactionID, false, sErrorMessage, NULL );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** handleShardDeviceEventCount() - SLOT that receives a shard's signalDeviceEventCount()
+*   @param uiTransactionID - the request answered
+*   @param count - one device's count
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_Database::handleShardDeviceEventCount( uint uiTransactionID, iC3_DeviceEventCount count )
+{
+    finishFanOutReply( uiTransactionID, true, QString(), &count );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** isReservedTransactionID() - true for the IDs from SPILL_REPLAY_TRANSACTION_ID up.  Replies
+*                               are matched to requests by transaction ID alone, so a caller's
+*                               request under one of them would be counted as part of a replay.
+*   @param uiTransactionID - the caller's transaction ID
+*   @retval true - the ID is reserved; the request must be refused
+*   @retval false - the ID can be used
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_Database::isReservedTransactionID( uint uiTransactionID )
+{
+    if ( uiTransactionID < SPILL_REPLAY_TRANSACTION_ID )
+    {
+        return false;
+    }
+
+    qDebug() << "iC3_Database - transaction ID" << uiTransactionID << "is reserved for the spill replay";
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** finishFanOutReply() - passes a shard's reply on, or, for a request sent to several shards or
+*                         devices, adds it to the others and signals the combined result once
+*                         the last one is in: signalRequestFailed() with every error if any
+*                         failed, otherwise signalDeviceEventCount() with the summed counts or
+*                         signalSuccess().
+*   @param uiTransactionID - the request answered
+*   @param bSucceeded - false: the reply was signalRequestFailed()
+*   @param sErrorMessage - the failure's message
+*   @param pCount - the reply's event count, NULL for any other reply
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_Database::finishFanOutReply( uint uiTransactionID, bool bSucceeded, const QString & sErrorMessage, const iC3_DeviceEventCount * pCount )
+{
+    QMutexLocker locker( &m_FanOutMutex );
+    QHash<uint, FanOut>::iterator it = m_FanOuts.find( uiTransactionID );
+
+    if ( it == m_FanOuts.end() )
+    {
+        locker.unlock();
+
+        if ( !bSucceeded )
+        {
+            emit signalRequestFailed( uiTransactionID, sErrorMessage );
+        }
+        else if ( pCount != NULL )
+        {
+            emit signalDeviceEventCount( uiTransactionID, *pCount );
+        }
+        else
+        {
+            emit signalSuccess( uiTransactionID );
+        }
+        return;
+    }
+
+    if ( !bSucceeded )
+    {
+        it->Errors.append( sErrorMessage );
+    }
+    else if ( pCount != NULL )
+    {
+        it->EventCount.llCount += pCount->llCount;
+        it->EventCount.llTotalDurationMS += pCount->llTotalDurationMS;
+    }
+
+    if ( --it->iPendingReplies > 0 )
+    {
+        return;
+    }
+
+    FanOut fanOut = it.value();
+    m_FanOuts.erase( it );
+    locker.unlock();
+
+    if ( fanOut.iReplayedRecords > 0 )
+    {
+        finishSpillReplay( fanOut );
+    }
+    else if ( !fanOut.Errors.isEmpty() )
+    {
+        emit signalRequestFailed( uiTransactionID, fanOut.Errors.join( "; " ) );
+    }
+    else if ( fanOut.bEventCount )
+    {
+        emit signalDeviceEventCount( uiTransactionID, fanOut.EventCount );
+    }
+    else
+    {
+        emit signalSuccess( uiTransactionID );
+    }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** replaySpilledSamples() - queues the oldest batch of spilled samples for their shards' writers,
+*                            unless a batch is already being replayed, the database is closed,
+*                            or the last batch failed less than SPILL_REPLAY_RETRY_MS ago.  The
+*                            replies are collected under SPILL_REPLAY_TRANSACTION_ID and the
+*                            batch leaves the journal once every sample in it is stored, see
+*                            finishSpillReplay().  Samples spilled before a sequence index could
+*                            be reserved get one here, written back and synced to the journal
+*                            before the batch is queued, so a repeated replay - even after a
+*                            power loss - uses the same.  Called on this object's thread.
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_Database::replaySpilledSamples( void )
+{
+    if ( !m_bDatabaseOpen || ( m_SpillJournal.getCount() == 0 ) )
+    {
+        return;
+    }
+
+    if ( m_SpillReplayRetryTimer.isValid() && ( m_SpillReplayRetryTimer.elapsed() < SPILL_REPLAY_RETRY_MS ) )
+    {
+        return;
+    }
+
+    {
+        QMutexLocker locker( &m_FanOutMutex );
+        if ( m_FanOuts.contains( SPILL_REPLAY_TRANSACTION_ID ) )
+        {
+            return;
+        }
+    }
+
+    QVector<iC3_TransducerSample> samples;
+    QVector<iC3_DatabaseShard *> shards;
+    bool bIndexAssigned = false;
+    int iRecords = m_SpillJournal.peek( SPILL_REPLAY_BATCH_RECORDS, samples );
+
+    for ( int i = 0; i < iRecords; i++ )
+    {
+        iC3_DatabaseShard * pShard = getShard( samples[i].iDeviceID, true );
+
+        if ( pShard == NULL )
+        {
+            m_SpillReplayRetryTimer.start();
+            return;
+        }
+
+        if ( samples[i].llSequenceIndex <= 0 )
+        {
+            if ( !m_SequenceAllocator.allocate( samples[i].llSequenceIndex ) )
+            {
+                m_SpillReplayRetryTimer.start();
+                return;
+            }
+
+            m_SpillJournal.setSequenceIndex( i, samples[i].llSequenceIndex );
+            bIndexAssigned = true;
+        }
+
+        shards.append( pShard );
+    }
+
+    if ( bIndexAssigned && !m_SpillJournal.sync() )
+    {
+        m_SpillReplayRetryTimer.start();
+        return;
+    }
+
+    FanOut fanOut;
+    fanOut.iPendingReplies = iRecords;
+    fanOut.bEventCount = false;
+    fanOut.iReplayedRecords = iRecords;
+
+    {
+        QMutexLocker locker( &m_FanOutMutex );
+        m_FanOuts.insert( SPILL_REPLAY_TRANSACTION_ID, fanOut );
+    }
+
+    qDebug() << "iC3_Database - replaying" << iRecords << "of" << m_SpillJournal.getCount() << "spilled samples";
+
+    // each shard's writer takes its requests in the order queued, so every device's samples are
+    // stored oldest first
+    for ( int i = 0; i < iRecords; i++ )
+    {
+        iC3_DatabaseRequest * pRequest = new iC3_DatabaseRequest( eDB_REQUEST_REPLAY_TRANSDUCER_SAMPLE );
+        pRequest->setTransactionID( SPILL_REPLAY_TRANSACTION_ID );
+        pRequest->setTransducerSample( samples[i] );
+
+        if ( !shards[i]->RequestProcessor.AddRequestToQueue( pRequest ) )
+        {
+            finishFanOutReply( SPILL_REPLAY_TRANSACTION_ID, false, "iC3_Database - a shard is not open", NULL );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** finishSpillReplay() - removes a replayed batch from the spill journal once every sample in it
+*                         is stored, and starts the next.  A batch with a failure stays in the
+*                         journal to be replayed whole after SPILL_REPLAY_RETRY_MS; the samples
+*                         already stored are not stored twice, see iC3_TransducerTable::
+*                         insertReplayedEntry().
+*   @param fanOut - the batch's collected replies
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_Database::finishSpillReplay( const FanOut & fanOut )
+{
+    if ( !fanOut.Errors.isEmpty() )
+    {
+        qDebug() << "iC3_Database - spill replay failed, retrying later:" << fanOut.Errors.first();
+        m_SpillReplayRetryTimer.start();
+        return;
+    }
+
+    m_SpillJournal.consume( fanOut.iReplayedRecords );
+    m_SpillReplayRetryTimer.invalidate();
+
+    replaySpilledSamples();
+}
 
 ////-----------------------------------------------------------------------------------------------
 ///** LogEventData() - creates a database request to log an Event
@@ -478,108 +1765,6 @@ bool iC3_Database::insertTransducerEntry( double fRTD1Val,
 //    return bRC;
 //}
 
-////-----------------------------------------------------------------------------------------------
-///** getDoorOpeningsToday() - Used to retrieve the number of door openings today.
-//*   @param  uiTransactionID - a unique identifier that is used when signaling success or failure
-//*                             to identify which operation failed or succeeded
-//*   @retval true - the request was added to the database request queue
-//*   @retval false - the request was not successfully added to the database request queue
-//*   @author Doug Sanqunetti
-//*   @date 09/01/2013
-//*/
-////-----------------------------------------------------------------------------------------------
-//bool iC3_Database::getDoorOpeningsToday( unsigned int uiTransactionID )
-//{
-//    bool bRC = false;
-
-//    iC3_DatabaseRequest * pRequest;
-
-//    // make sure our request is protected until we are able to add the request to the queue
-//    QMutexLocker locker( & m_DB_RequestMutex );
-
-//    pRequest = new iC3_DatabaseRequest( eDB_REQUEST_DOOR_OPENINGS_TODAY );
-
-//    if ( pRequest != NULL )
-//    {
-//        pRequest->setTransactionID(uiTransactionID);
-//        QDateTime nowTime = QDateTime::currentDateTime();
-//        QDate Today = nowTime.date();
-//        pRequest->setRequestDate( Today );
-
-//        bRC = m_RequestProcessor.AddRequestToQueue( pRequest );
-//    }
-
-//    return bRC;
-//}
-
-////-----------------------------------------------------------------------------------------------
-///** getDoorOpeningsForDateRange() - Used to retrieve the number of door openings that occurred
-//*                                   within a date ranged.
-//*   @param  uiTransactionID - a unique identifier that is used when signaling success or failure
-//*                             to identify which operation failed or succeeded.
-//*   @param  beginDateRange - the beginning date in the requested date range
-//*   @param  endDateRange - the ending date in the requested date range
-//*   @retval true - the request was added to the database request queue
-//*   @retval false - the request was not successfully added to the database request queue
-//*   @author Doug Sanqunetti
-//*   @date 09/01/2013
-//*/
-////-----------------------------------------------------------------------------------------------
-//bool iC3_Database::getDoorOpeningsForDateRange( unsigned int uiTransactionID,
-//                                                QDate beginDateRange,
-//                                                QDate endDateRange )
-//{
-//    bool bRC = false;
-
-//    iC3_DatabaseRequest * pRequest;
-
-//    // make sure our request is protected until we are able to add the request to the queue
-//    QMutexLocker locker( & m_DB_RequestMutex );
-
-//    pRequest = new iC3_DatabaseRequest( eDB_REQUEST_DOOR_OPENINGS_DATE_RANGE );
-
-//    if ( pRequest != NULL )
-//    {
-//        pRequest->setTransactionID(uiTransactionID);
-//        pRequest->setBeginDate(beginDateRange);
-//        pRequest->setEndDate(endDateRange);
-
-//        bRC = m_RequestProcessor.AddRequestToQueue(pRequest);
-//    }
-
-//    return bRC;
-//}
-
-////-----------------------------------------------------------------------------------------------
-///** getTotalDoorOpenings() - Used to retrieve the total number of door openings
-//*   @param  uiTransactionID - a unique identifier that is used when signaling success or failure
-//*                             to identify which operation failed or succeeded.
-//*   @retval true - the request was added to the database request queue
-//*   @retval false - the request was not successfully added to the database request queue
-//*   @author Doug Sanqunetti
-//*   @date 09/01/2013
-//*/
-////-----------------------------------------------------------------------------------------------
-//bool iC3_Database::getTotalDoorOpenings( unsigned int uiTransactionID )
-//{
-//    bool bRC = false;
-
-//    iC3_DatabaseRequest * pRequest;
-
-//    // make sure our request is protected until we are able to add the request to the queue
-//    QMutexLocker locker( & m_DB_RequestMutex );
-
-//    pRequest = new iC3_DatabaseRequest( eDB_REQUEST_TOTAL_DOOR_OPENINGS);
-
-//    if ( pRequest != NULL )
-//    {
-//        pRequest->setTransactionID(uiTransactionID);
-//        bRC = m_RequestProcessor.AddRequestToQueue(pRequest);
-//    }
-
-//    return bRC;
-//}
-
 ////-----------------------------------------------------------------------------------------------
 ///** write_CSV_Files() - Used to generate CSV files from the database tables
 //*   @param  uiTransactionID - a unique identifier that is used when signaling success or failure
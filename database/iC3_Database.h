@@ -12,12 +12,47 @@
 *           iC3_DatabaseRequestProcessor which runs in a separate thread.
 */
 
-#include <QSqlDatabase>
 #include <QObject>
+#include <QAtomicInt>
+#include <QVector>
+#include <QHash>
+#include <QMutex>
+#include <QStringList>
+#include <QDate>
+#include <QElapsedTimer>
 
 #include "iC3_DMM_Constants.h"
-#include "iC3_TransducerTable.h"
-
+#include "iC3_TransducerSample.h"
+#include "iC3_TransducerRollup.h"
+#include "iC3_DeviceStatus.h"
+#include "iC3_DeviceEvent.h"
+#include "iC3_DatabaseRequestProcessor.h"
+#include "iC3_DatabaseConnectionPool.h"
+#include "iC3_DatabaseShardCatalog.h"
+#include "iC3_DatabaseSnapshot.h"
+#include "iC3_SequenceAllocator.h"
+#include "iC3_TransducerSpillJournal.h"
+#include "iC3_TransducerCSV_Exporter.h"
+
+// getFleetEventCount() reports its total with this device ID
+static const int DEVICE_ID_ALL_DEVICES = -1;
+
+// samples spilled while the database could not take them are replayed this many at a time,
+// under a transaction ID getTransactionID() never returns.  Requests with an ID from it up are
+// refused, see isReservedTransactionID().  After a failed batch the replay waits
+// SPILL_REPLAY_RETRY_MS before trying again.
+static const uint SPILL_REPLAY_TRANSACTION_ID   = 0x8000;
+static const int SPILL_REPLAY_BATCH_RECORDS     = 500;
+static const int SPILL_REPLAY_RETRY_MS          = 10 * 1000;
+
+// one database file with its own writer thread and readers.  Each device's data is in one shard.
+struct iC3_DatabaseShard
+{
+    QString sDatabaseFileName;
+    QString sSegmentStorePath;                      // empty: raw samples are kept in the database
+    iC3_DatabaseRequestProcessor RequestProcessor;
+    iC3_DatabaseConnectionPool ReadConnectionPool;
+};
 
 class iC3_Database : public QObject
 {
@@ -26,7 +61,7 @@ public:
     explicit iC3_Database(QObject *parent = 0);
     ~iC3_Database( );
 
-//    bool performDB_IntegrityCheck( void );
+    bool performDB_IntegrityCheck( uint uiTransactionID );
 //    bool LogEventData( uint uiTransactionID, iC3_EventLogData * pEventData );
 //    bool getEventData( uint uiTransactionID, quint32 ulEventSequenceIndex );
 //    bool getLastMultiEvents(  uint uiTransactionID, unsigned int uiNumberOfEvents );
@@ -34,9 +69,6 @@ public:
 //    bool getEventsInRange( uint uiTransactionID, quint32 ulBeginEventSequenceIndex, quint32 ulEndEventSequenceIndex);
 //    bool getGraphAlarmData( iC3_GraphAlarmFrame * pAlarmFrame, eEventLogTypes eEventLogType );
 //    bool modifyEventLogEntry( uint uiTransactionID, iC3_EventLogData * pEventData );
-//    bool getDoorOpeningsToday( uint uiTransactionID );
-//    bool getDoorOpeningsForDateRange( uint uiTransactionID, QDate beginDateRange, QDate endDateRange );
-//    bool getTotalDoorOpenings( uint uiTransactionID );
 //    bool InsertTransSyncEntry( uint uiTransactionID, iC3_DatabaseTransSyncEntry * pEntry );
 //    bool getTransducerSyncData( uint uiTransactionID, quint32 ulBeginSequenceIndex, quint32 ulEndSequenceIndex );
 //    bool insertNewAccessControlEntry( uint uiTransactionID, iC3_AccessControlData * pData);
@@ -70,6 +102,32 @@ public:
 
     bool openDatabase( void );
     void closeDatabase( void );
+    bool setTransducerSegmentStore( bool bEnabled );
+    bool setShardCount( int iShardCount );
+    int getShardCount( void ) const;
+
+    bool getTransducerEntriesInRange( uint uiTransactionID, int iDeviceID, qint64 llBeginTimeMS, qint64 llEndTimeMS, int iMaxEntries );
+    bool getNextTransducerEntries( uint uiTransactionID, const iC3_TransducerSample & lastSample, qint64 llEndTimeMS, int iMaxEntries );
+    bool getLastTransducerEntries( uint uiTransactionID, int iDeviceID, int iNumberOfEntries );
+    bool getTransducerHistory( uint uiTransactionID, int iDeviceID, qint64 llBeginTimeMS, qint64 llEndTimeMS );
+    bool compactTransducerHistory( uint uiTransactionID, qint64 llBeforeTimeMS );
+    bool getTransducerRollups( uint uiTransactionID, int iDeviceID, eTransducerRollupLevels eLevel, qint64 llBeginTimeMS, qint64 llEndTimeMS );
+    bool getDeviceStatusAtTime( uint uiTransactionID, int iDeviceID, qint64 llTimeMS );
+    bool getDeviceEventCount( uint uiTransactionID, int iDeviceID, eDeviceEventTypes eEventType, QDate beginDate, QDate endDate );
+    bool getDeviceEvents( uint uiTransactionID, int iDeviceID, eDeviceEventTypes eEventType, qint64 llBeginTimeMS, qint64 llEndTimeMS );
+    bool getDoorOpeningsToday( uint uiTransactionID, int iDeviceID );
+    bool getDoorOpeningsForDateRange( uint uiTransactionID, int iDeviceID, QDate beginDateRange, QDate endDateRange );
+    bool getTotalDoorOpenings( uint uiTransactionID, int iDeviceID );
+    bool getFleetEventCount( uint uiTransactionID, eDeviceEventTypes eEventType, QDate beginDate, QDate endDate );
+    void setGroupCommitLimits( int iWindowMS, int iMaxRows );
+    void setRetentionLimits( int iRawRetentionHours, int iMinuteRollupRetentionHours, bool bArchiveRawData );
+    bool exportTransducerCSV( uint uiTransactionID, const QString & sCSVFileName, int iDeviceID, qint64 llBeginTimeMS, qint64 llEndTimeMS );
+    bool exportNewTransducerCSV( uint uiTransactionID, const QString & sDestination, const QString & sCSVFileName, int iDeviceID );
+    void cancelTransducerExport( void );
+    bool setTransducerExportFormat( eDateFormats dateFormat, eTimeFormats timeFormat, bool bLocalTime );
+    bool snapshotDatabase( uint uiTransactionID, const QString & sSnapshotFileName, int iShardIndex = 0 );
+    void cancelDatabaseSnapshot( void );
+    uint getTransactionID( void );
 //    bool commErrorMoveDatabase( void );
 
 //    void setInitialAlarmLimits( uint uiTransducerID, float fLowerAlarmLimit, float fUpperAlarmLimit );
@@ -83,34 +141,96 @@ signals:
 //    void signalGraphEpochData( uint uiTransactionID );
 //    void signalGraphDoorOpenData( uint uiTransactionID );
 
+    void signalSuccess( uint uiTransactionID );
+    void signalRequestFailed( uint uiTransactionID, QString sErrorMessage );
+    void signalMaintenanceSlice( int iTask, qint64 llElapsedMS, bool bSucceeded, QString sResult );
+    void signalTransducerSamples( uint uiTransactionID, QVector<iC3_TransducerSample> samples );
+    void signalTransducerRollups( uint uiTransactionID, QVector<iC3_TransducerRollup> rollups );
+    void signalDeviceStatus( uint uiTransactionID, iC3_DeviceStatus status );
+    void signalDeviceEventCount( uint uiTransactionID, iC3_DeviceEventCount count );
+    void signalDeviceEvents( uint uiTransactionID, QVector<iC3_DeviceEvent> events );
+
+    void signalExportProgress( uint uiTransactionID, qint64 llRowsWritten, int iPercentComplete );
+    void signalExportComplete( uint uiTransactionID, qint64 llRowsWritten );
+    void signalExportCancelled( uint uiTransactionID );
+    void signalExportFailed( uint uiTransactionID, QString sErrorMessage );
+
+    void signalSnapshotProgress( uint uiTransactionID, int iPercentComplete, qint64 llBytesPerSecond );
+    void signalSnapshotComplete( uint uiTransactionID, qint64 llBytesCopied, qint64 llElapsedMS );
+    void signalSnapshotCancelled( uint uiTransactionID );
+    void signalSnapshotFailed( uint uiTransactionID, QString sErrorMessage );
+
 public slots:
     bool insertTransducerEntry( double fRTD1Val,
                                 double fRTD2Val,
                                 double fRTD3Val,
                                 double fRTD4Val,
                                 double fRTD5Val );
+    bool insertTransducerSample( const iC3_TransducerSample & sample );
+    bool insertDeviceStatus( const iC3_DeviceStatus & status );
 
 //    void handleCommError( eDMM_CommErrorLevels eCommErrorLevel );
 //    void handleGraphEpochData( uint uiTransactionID );
 //    void handleGraphDoorOpenData( uint uiTransactionID );
 
+private slots:
+    void handleShardSuccess( uint uiTransactionID );
+    void handleShardRequestFailed( uint uiTransactionID, QString sErrorMessage );
+    void handleShardDeviceEventCount( uint uiTransactionID, iC3_DeviceEventCount count );
+
 private:
 
+    // the replies still expected for a request sent to several shards or devices
+    struct FanOut
+    {
+        int iPendingReplies;
+        bool bEventCount;                           // reply with EventCount rather than signalSuccess()
+        iC3_DeviceEventCount EventCount;            // summed over the replies
+        int iReplayedRecords;                       // > 0: a spill replay batch, consumed once stored
+        QStringList Errors;
+    };
+
+    bool queueDeviceEventCount( uint uiTransactionID, int iDeviceID, eDeviceEventTypes eEventType, qint64 llBeginTimeMS, qint64 llEndTimeMS );
+    iC3_DatabaseShard * getShard( int iDeviceID, bool bPlaceNewDevice );
+    void createShards( int iShardCount );
+    void deleteShards( void );
+    bool queueOnEveryShard( const iC3_DatabaseRequest & request, bool bWrite );
+    bool isReservedTransactionID( uint uiTransactionID );
+    void finishFanOutReply( uint uiTransactionID, bool bSucceeded, const QString & sErrorMessage, const iC3_DeviceEventCount * pCount );
+    bool spillTransducerSample( const iC3_TransducerSample & sample );
+    void replaySpilledSamples( void );
+    void finishSpillReplay( const FanOut & fanOut );
+
     QString m_sDatabaseFileName;
+    QString m_sSegmentStorePath;                    // empty: raw samples are kept in the database
 
-    uint getTransactionID( void );
+    // created by setShardCount() while the database is closed
+    QVector<iC3_DatabaseShard *> m_Shards;
+    iC3_DatabaseShardCatalog m_ShardCatalog;
+
+    // applied to every shard, including shards added later
+    int m_iGroupCommitWindowMS;
+    int m_iGroupCommitMaxRows;
+    int m_iRawRetentionHours;
+    int m_iMinuteRollupRetentionHours;
+    bool m_bArchiveRawData;
 
-//    iC3_DatabaseRequestProcessor m_RequestProcessor;
-    QSqlDatabase m_db;
+    QHash<uint, FanOut> m_FanOuts;                  // by transaction ID
+    QMutex m_FanOutMutex;
+
+    iC3_TransducerCSV_Exporter m_TransducerExporter;
+    iC3_DatabaseSnapshot m_DatabaseSnapshot;
+    iC3_SequenceAllocator m_SequenceAllocator;
+
+    // open for the life of this object, so samples are kept while the database is closed
+    iC3_TransducerSpillJournal m_SpillJournal;
+    QElapsedTimer m_SpillReplayRetryTimer;          // valid after a failed replay batch
     bool m_bDatabaseOpen;
+    QAtomicInt m_iLostSamples;                      // refused by the journal since the last it took
 
 //    iC3_DMM_Interface * m_pInterfacePtr;
 
-//    QMutex m_DB_RequestMutex;
-//    QMutex m_TransactionIDMutex;
-    uint m_uiTransactionID;
-
-    iC3_TransducerTable m_TransducerTable;
+    QAtomicInt m_TransactionID;
 
 };
 
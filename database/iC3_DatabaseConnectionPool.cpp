@@ -0,0 +1,316 @@
+/**
+*     @file iC3_DatabaseConnectionPool.cpp
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief this cpp file implements the iC3_DatabaseConnectionPool class.
+*/
+
+#include <QDebug>
+#include <QRunnable>
+#include <QMetaType>
+
+#include "iC3_DatabaseConnectionPool.h"
+
+//-----------------------------------------------------------------------------------------------
+// runs one read request on a pool thread and deletes it
+//-----------------------------------------------------------------------------------------------
+class iC3_DatabaseReadTask : public QRunnable
+{
+public:
+    iC3_DatabaseReadTask( iC3_DatabaseConnectionPool * pPool, iC3_DatabaseRequest * pRequest ) :
+        m_pPool( pPool ),
+        m_pRequest( pRequest )
+    {
+    }
+
+    ~iC3_DatabaseReadTask()
+    {
+        delete m_pRequest;
+    }
+
+    void run()
+    {
+        m_pPool->processRequest( m_pRequest );
+    }
+
+private:
+
+    iC3_DatabaseConnectionPool * m_pPool;
+    iC3_DatabaseRequest * m_pRequest;
+};
+
+//-----------------------------------------------------------------------------------------------
+/** constructor
+*   @param parent - QObject pointer parent (unused)
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_DatabaseConnectionPool::iC3_DatabaseConnectionPool(QObject *parent) :
+    QObject(parent),
+    m_bOpen( 0 ),
+    m_bAcceptingRequests( 0 ),
+    m_iGeneration( 0 ),
+    m_iNextConnectionNumber( 0 )
+{
+    m_ThreadPool.setMaxThreadCount( DB_READ_POOL_MAX_THREADS );
+
+    qRegisterMetaType< QVector<iC3_TransducerSample> >("QVector<iC3_TransducerSample>");
+    qRegisterMetaType< QVector<iC3_TransducerRollup> >("QVector<iC3_TransducerRollup>");
+    qRegisterMetaType< iC3_DeviceStatus >("iC3_DeviceStatus");
+    qRegisterMetaType< iC3_DeviceEventCount >("iC3_DeviceEventCount");
+    qRegisterMetaType< QVector<iC3_DeviceEvent> >("QVector<iC3_DeviceEvent>");
+}
+
+//-----------------------------------------------------------------------------------------------
+/** destructor
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_DatabaseConnectionPool::~iC3_DatabaseConnectionPool()
+{
+    close();
+}
+
+//-----------------------------------------------------------------------------------------------
+/** open() - lets threads read sDatabaseFileName.  No connection is opened until a thread
+*            reads.  Call after the request processor has created the database.
+*   @param sDatabaseFileName - the SQLite database file
+*   @param sSegmentStorePath - the transducer segment store, empty if it is not used
+*   @param sConnectionName - prefix of the connections' names; each pool open at the same time
+*                            needs its own
+*   @retval true - the pool is open
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseConnectionPool::open( const QString & sDatabaseFileName,
+                                       const QString & sSegmentStorePath,
+                                       const QString & sConnectionName )
+{
+    close();
+
+    m_sDatabaseFileName = sDatabaseFileName;
+    m_sSegmentStorePath = sSegmentStorePath;
+    m_sConnectionName = sConnectionName;
+    m_iGeneration.fetchAndAddOrdered( 1 );
+    m_bOpen.storeRelease( 1 );
+    m_bAcceptingRequests.storeRelease( 1 );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** close() - finishes the read requests already queued, then closes every pool thread's
+*            connection and the calling thread's.  Any other thread that read through
+*            getReadConnection() closes its connection when it exits or next reads.
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseConnectionPool::close( void )
+{
+    m_bAcceptingRequests.storeRelease( 0 );
+
+    // waitForDone() also ends the idle pool threads, which deletes their connections
+    m_ThreadPool.waitForDone();
+
+    m_bOpen.storeRelease( 0 );
+    m_iGeneration.fetchAndAddOrdered( 1 );
+
+    releaseReadConnection();
+}
+
+//-----------------------------------------------------------------------------------------------
+/** AddRequestToQueue() - queues a read request for the pool threads.  Requests run
+*                         concurrently, so results may arrive in a different order than the
+*                         requests; match them by transaction ID.  Safe to call from any
+*                         thread.  The pool takes ownership of the request.
+*   @param pRequest - the request to execute
+*   @retval true - the request was queued
+*   @retval false - the pool is closed, the request was deleted
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseConnectionPool::AddRequestToQueue( iC3_DatabaseRequest * pRequest )
+{
+    if ( pRequest == NULL )
+    {
+        return false;
+    }
+
+    if ( m_bAcceptingRequests.loadAcquire() == 0 )
+    {
+        delete pRequest;
+        return false;
+    }
+
+    m_ThreadPool.start( new iC3_DatabaseReadTask( this, pRequest ) );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getReadConnection() - returns the calling thread's read-only connection, opening it on
+*                         first use.  Only use the connection on the calling thread.
+*   @retval pointer to the connection; check isOpen(), GetLastError() says why it is not
+*   @retval NULL - the pool is closed
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_DatabaseReadConnection * iC3_DatabaseConnectionPool::getReadConnection( void )
+{
+    if ( m_bOpen.loadAcquire() == 0 )
+    {
+        return NULL;
+    }
+
+    if ( !m_ReadConnections.hasLocalData() )
+    {
+        m_ReadConnections.setLocalData( new iC3_DatabaseReadConnection() );
+    }
+
+    iC3_DatabaseReadConnection * pConnection = m_ReadConnections.localData();
+    int iGeneration = m_iGeneration.loadAcquire();
+
+    if ( !pConnection->isOpen() || ( pConnection->getGeneration() != iGeneration ) )
+    {
+        QString sConnectionName = QString("%1_%2").arg( m_sConnectionName )
+                                                  .arg( m_iNextConnectionNumber.fetchAndAddOrdered( 1 ) );
+
+        pConnection->open( m_sDatabaseFileName, sConnectionName, iGeneration, m_sSegmentStorePath );
+    }
+
+    return pConnection;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** releaseReadConnection() - closes the calling thread's connection now rather than when the
+*                             thread exits
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseConnectionPool::releaseReadConnection( void )
+{
+    if ( m_ReadConnections.hasLocalData() )
+    {
+        // QThreadStorage deletes the connection it held
+        m_ReadConnections.setLocalData( NULL );
+    }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** processRequest() - executes one read request on a pool thread and signals the result.  The
+*                      signals are queued to receivers on other threads.
+*   @param pRequest - the request to execute
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseConnectionPool::processRequest( iC3_DatabaseRequest * pRequest )
+{
+    uint uiTransactionID = pRequest->getTransactionID();
+    iC3_DatabaseReadConnection * pConnection = getReadConnection();
+
+    if ( pConnection == NULL )
+    {
+        emit signalRequestFailed( uiTransactionID, "iC3_DatabaseConnectionPool - the database is not open" );
+        return;
+    }
+
+    if ( !pConnection->isOpen() )
+    {
+        emit signalRequestFailed( uiTransactionID, pConnection->GetLastError() );
+        return;
+    }
+
+    bool bRC = false;
+    QVector<iC3_TransducerSample> samples;
+    QVector<iC3_TransducerRollup> rollups;
+    iC3_DeviceStatus status;
+    iC3_DeviceEventCount count;
+    QVector<iC3_DeviceEvent> events;
+
+    switch ( pRequest->getRequestType() )
+    {
+    case eDB_REQUEST_GET_TRANSDUCER_SAMPLES:
+        // the request's sample is the keyset cursor - the last sample of the previous page
+        bRC = pConnection->getNextTransducerEntries( pRequest->getTransducerSample(), pRequest->getEndTimeMS(),
+                                                     pRequest->getMaxEntries(), samples );
+        if ( bRC )
+        {
+            emit signalTransducerSamples( uiTransactionID, samples );
+        }
+        break;
+
+    case eDB_REQUEST_GET_LAST_N_TRANSDUCER_SAMPLES:
+        bRC = pConnection->getLastTransducerEntries( pRequest->getDeviceID(), pRequest->getMaxEntries(), samples );
+        if ( bRC )
+        {
+            emit signalTransducerSamples( uiTransactionID, samples );
+        }
+        break;
+
+    case eDB_REQUEST_GET_TRANSDUCER_HISTORY:
+        bRC = pConnection->getTransducerHistory( pRequest->getDeviceID(), pRequest->getBeginTimeMS(),
+                                                 pRequest->getEndTimeMS(), samples );
+        if ( bRC )
+        {
+            emit signalTransducerSamples( uiTransactionID, samples );
+        }
+        break;
+
+    case eDB_REQUEST_GET_TRANSDUCER_ROLLUPS:
+        bRC = pConnection->getTransducerRollups( pRequest->getDeviceID(), pRequest->getRollupLevel(),
+                                                 pRequest->getBeginTimeMS(), pRequest->getEndTimeMS(), rollups );
+        if ( bRC )
+        {
+            emit signalTransducerRollups( uiTransactionID, rollups );
+        }
+        break;
+
+    case eDB_REQUEST_GET_DEVICE_STATUS_AT_TIME:
+        bRC = pConnection->getDeviceStatusAtTime( pRequest->getDeviceID(), pRequest->getEndTimeMS(), status );
+        if ( bRC )
+        {
+            emit signalDeviceStatus( uiTransactionID, status );
+        }
+        break;
+
+    case eDB_REQUEST_GET_DEVICE_EVENT_COUNT:
+        bRC = pConnection->getDeviceEventCount( pRequest->getDeviceID(), pRequest->getEventType(),
+                                                pRequest->getBeginTimeMS(), pRequest->getEndTimeMS(), count );
+        if ( bRC )
+        {
+            emit signalDeviceEventCount( uiTransactionID, count );
+        }
+        break;
+
+    case eDB_REQUEST_GET_DEVICE_EVENTS:
+        bRC = pConnection->getDeviceEvents( pRequest->getDeviceID(), pRequest->getEventType(),
+                                            pRequest->getBeginTimeMS(), pRequest->getEndTimeMS(), events );
+        if ( bRC )
+        {
+            emit signalDeviceEvents( uiTransactionID, events );
+        }
+        break;
+
+    case eDB_REQUEST_PERFORM_INTEGRITY_CHECK:
+        bRC = pConnection->checkIntegrity();
+        if ( bRC )
+        {
+            emit signalSuccess( uiTransactionID );
+        }
+        break;
+
+    default:
+        emit signalRequestFailed( uiTransactionID, QString("iC3_DatabaseConnectionPool - unsupported request type %1").arg( pRequest->getRequestType() ) );
+        return;
+    }
+
+    if ( !bRC )
+    {
+        emit signalRequestFailed( uiTransactionID, pConnection->GetLastError() );
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef IC3_DATABASECONNECTIONPOOL_H
+#define IC3_DATABASECONNECTIONPOOL_H
+
+/**
+*     @file iC3_DatabaseConnectionPool.h
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief This header file defines the iC3_DatabaseConnectionPool class.  Qt SQL connections
+*            may only be used on the thread that opened them, so the pool keeps one read-only
+*            connection per thread, opened the first time that thread reads.  Read requests
+*            run on the pool's own threads; in WAL mode they see the last commit and never wait
+*            for, or hold up, the request processor's writer connection.
+*/
+
+#include <QObject>
+#include <QAtomicInt>
+#include <QThreadPool>
+#include <QThreadStorage>
+#include <QVector>
+
+#include "iC3_DatabaseRequest.h"
+#include "iC3_DatabaseReadConnection.h"
+
+// threads (and so connections) that run read requests.  Idle threads exit after the thread
+// pool's expiry timeout, closing their connection.
+static const int DB_READ_POOL_MAX_THREADS = 2;
+
+class iC3_DatabaseConnectionPool : public QObject
+{
+    Q_OBJECT
+    friend class iC3_DatabaseReadTask;
+public:
+    explicit iC3_DatabaseConnectionPool(QObject *parent = 0);
+    ~iC3_DatabaseConnectionPool();
+
+    bool open( const QString & sDatabaseFileName,
+               const QString & sSegmentStorePath = QString(),
+               const QString & sConnectionName = QString(HELMER_DB_READ_CONNECTION_NAME) );
+    void close( void );
+
+    bool AddRequestToQueue( iC3_DatabaseRequest * pRequest );
+
+    iC3_DatabaseReadConnection * getReadConnection( void );
+    void releaseReadConnection( void );
+
+signals:
+
+    void signalSuccess( uint uiTransactionID );
+    void signalRequestFailed( uint uiTransactionID, QString sErrorMessage );
+    void signalTransducerSamples( uint uiTransactionID, QVector<iC3_TransducerSample> samples );
+    void signalTransducerRollups( uint uiTransactionID, QVector<iC3_TransducerRollup> rollups );
+    void signalDeviceStatus( uint uiTransactionID, iC3_DeviceStatus status );
+    void signalDeviceEventCount( uint uiTransactionID, iC3_DeviceEventCount count );
+    void signalDeviceEvents( uint uiTransactionID, QVector<iC3_DeviceEvent> events );
+
+private:
+
+    void processRequest( iC3_DatabaseRequest * pRequest );
+
+    // set by open() while no reader is running
+    QString m_sDatabaseFileName;
+    QString m_sSegmentStorePath;
+    QString m_sConnectionName;                      // numbered per thread
+
+    QAtomicInt m_bOpen;
+    QAtomicInt m_bAcceptingRequests;
+
+    // bumped by open() and close(); a thread's connection from an older generation is reopened
+    QAtomicInt m_iGeneration;
+    QAtomicInt m_iNextConnectionNumber;
+
+    QThreadPool m_ThreadPool;
+    QThreadStorage<iC3_DatabaseReadConnection *> m_ReadConnections;
+};
+
+#endif // IC3_DATABASECONNECTIONPOOL_H
@@ -0,0 +1,490 @@
+/**
+*     @file iC3_DatabaseMaintenance.cpp
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief this cpp file implements the iC3_DatabaseMaintenance class.
+*/
+
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QVariant>
+#include <QDebug>
+#include <limits>
+
+#include "iC3_DatabaseMaintenance.h"
+
+//-----------------------------------------------------------------------------------------------
+/** constructor
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_DatabaseMaintenance::iC3_DatabaseMaintenance() :
+    m_llNextCheckpointMS( std::numeric_limits<qint64>::max() ),
+    m_llNextTruncateMS( std::numeric_limits<qint64>::max() ),
+    m_llNextVacuumMS( std::numeric_limits<qint64>::max() ),
+    m_llNextIntegrityMS( std::numeric_limits<qint64>::max() ),
+    m_llNextSliceMS( 0 ),
+    m_bIncrementalVacuum( false ),
+    m_bTableQuickCheck( false ),
+    m_llBusyTimeoutMS( 0 ),
+    m_iIntegrityProblems( 0 ),
+    m_dCommitLatencyMS( 0.0 ),
+    m_iBackoffFactor( 1 ),
+    m_llLastBackoffChangeMS( 0 )
+{
+}
+
+//-----------------------------------------------------------------------------------------------
+/** open() - reads what the connection supports and schedules every task from now
+*   @param database - the request processor's connection, already open
+*   @retval true - maintenance is scheduled
+*   @retval false - the connection could not be queried.  Use GetLastError() to retrieve
+*                   error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseMaintenance::open( QSqlDatabase & database )
+{
+    qint64 llAutoVacuum;
+
+    if ( !readPragma( database, "PRAGMA auto_vacuum", llAutoVacuum ) ||
+         !readPragma( database, "PRAGMA busy_timeout", m_llBusyTimeoutMS ) )
+    {
+        return false;
+    }
+
+    QSqlQuery query( database );
+
+    if ( !query.exec( "SELECT sqlite_version()" ) || !query.next() )
+    {
+        m_sLastError = QString("iC3_DatabaseMaintenance::open() - Query Error: %1").arg( query.lastError().text() );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    QStringList version = query.value( 0 ).toString().split( '.' );
+    int iVersion = 0;
+
+    for ( int iIndex = 0; iIndex < 3; iIndex++ )
+    {
+        iVersion = iVersion * 1000 + ( ( iIndex < version.size() ) ? version.at( iIndex ).toInt() : 0 );
+    }
+
+    // a file created before auto_vacuum was set is rebuilt into INCREMENTAL mode by the
+    // request processor's schema upgrade; until that has succeeded there is nothing to vacuum
+    m_bIncrementalVacuum = ( llAutoVacuum == 2 );
+    m_bTableQuickCheck = ( iVersion >= DB_MAINTENANCE_TABLE_CHECK_SQLITE_VERSION );
+
+    m_Clock.start();
+
+    m_llNextCheckpointMS = DB_MAINTENANCE_CHECKPOINT_INTERVAL_MS;
+    m_llNextTruncateMS = DB_MAINTENANCE_TRUNCATE_INTERVAL_MS;
+    m_llNextVacuumMS = m_bIncrementalVacuum ? DB_MAINTENANCE_VACUUM_INTERVAL_MS : std::numeric_limits<qint64>::max();
+
+    // the application may not run for a whole interval, so the first pass starts soon after opening
+    m_llNextIntegrityMS = DB_MAINTENANCE_VACUUM_INTERVAL_MS;
+    m_llNextSliceMS = 0;
+
+    m_IntegrityTables.clear();
+    m_iIntegrityProblems = 0;
+    m_dCommitLatencyMS = 0.0;
+    m_iBackoffFactor = 1;
+    m_llLastBackoffChangeMS = 0;
+
+    if ( !m_bIncrementalVacuum )
+    {
+        qDebug() << "iC3_DatabaseMaintenance - auto_vacuum is not INCREMENTAL, free pages will not be released";
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getWaitMS() - the time until the next slice is due
+*   @retval ms to wait, 0 if a slice is due now
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+qint64 iC3_DatabaseMaintenance::getWaitMS( void ) const
+{
+    if ( !m_Clock.isValid() )
+    {
+        return std::numeric_limits<qint64>::max();
+    }
+
+    // a truncating checkpoint is only ever run by a checkpoint slice
+    qint64 llDueMS = qMin( qMin( m_llNextCheckpointMS, m_llNextVacuumMS ), m_llNextIntegrityMS );
+
+    return qMax( qMax( llDueMS, m_llNextSliceMS ) - m_Clock.elapsed(), Q_INT64_C(0) );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** runSlice() - runs the task that is most overdue, in the order checkpoint, vacuum, integrity
+*                check.  Must be called with no transaction open.
+*   @param database - the request processor's connection
+*   @param eTask - set to the task run, eDB_MAINTENANCE_NONE if none was due
+*   @param llElapsedMS - set to how long the slice took
+*   @param sResult - set to a summary of what the slice did
+*   @retval true - the slice succeeded, or nothing was due
+*   @retval false - the task failed or the integrity check found a problem.  Use
+*                   GetLastError() to retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseMaintenance::runSlice( QSqlDatabase & database,
+                                        eDatabaseMaintenanceTasks & eTask,
+                                        qint64 & llElapsedMS,
+                                        QString & sResult )
+{
+    qint64 llNowMS = m_Clock.elapsed();
+    QElapsedTimer timer;
+    bool bRC = true;
+
+    eTask = eDB_MAINTENANCE_NONE;
+    llElapsedMS = 0;
+    sResult.clear();
+    m_sLastError.clear();
+
+    if ( !m_Clock.isValid() || ( llNowMS < m_llNextSliceMS ) )
+    {
+        return true;
+    }
+
+    timer.start();
+
+    if ( llNowMS >= m_llNextCheckpointMS )
+    {
+        eTask = eDB_MAINTENANCE_CHECKPOINT;
+        bRC = checkpoint( database, eTask, sResult );
+        m_llNextCheckpointMS = llNowMS + DB_MAINTENANCE_CHECKPOINT_INTERVAL_MS * m_iBackoffFactor;
+    }
+    else if ( llNowMS >= m_llNextVacuumMS )
+    {
+        eTask = eDB_MAINTENANCE_INCREMENTAL_VACUUM;
+        bRC = vacuumSlice( database, sResult );
+    }
+    else if ( llNowMS >= m_llNextIntegrityMS )
+    {
+        eTask = eDB_MAINTENANCE_INTEGRITY_CHECK;
+        bRC = integritySlice( database, sResult );
+    }
+    else
+    {
+        return true;
+    }
+
+    llElapsedMS = timer.elapsed();
+    m_llNextSliceMS = m_Clock.elapsed() + DB_MAINTENANCE_SLICE_GAP_MS * m_iBackoffFactor;
+
+    return bRC;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** recordCommitLatency() - adds the time a commit took to the moving average, and spaces the
+*                           slices out, or back in, when the average crosses the limit
+*   @param llLatencyMS - time taken by one commit
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseMaintenance::recordCommitLatency( qint64 llLatencyMS )
+{
+    if ( !m_Clock.isValid() )
+    {
+        return;
+    }
+
+    m_dCommitLatencyMS += ( llLatencyMS - m_dCommitLatencyMS ) / 8.0;
+
+    qint64 llNowMS = m_Clock.elapsed();
+
+    if ( llNowMS - m_llLastBackoffChangeMS < DB_MAINTENANCE_BACKOFF_ADJUST_MS )
+    {
+        return;
+    }
+
+    if ( ( m_dCommitLatencyMS > DB_MAINTENANCE_LATENCY_LIMIT_MS ) && ( m_iBackoffFactor < DB_MAINTENANCE_MAX_BACKOFF ) )
+    {
+        m_iBackoffFactor *= 2;
+        m_llLastBackoffChangeMS = llNowMS;
+        m_llNextSliceMS = qMax( m_llNextSliceMS, llNowMS + DB_MAINTENANCE_SLICE_GAP_MS * m_iBackoffFactor );
+
+        qDebug() << "iC3_DatabaseMaintenance - commits averaging" << m_dCommitLatencyMS << "ms, maintenance backed off x" << m_iBackoffFactor;
+    }
+    else if ( ( m_dCommitLatencyMS < DB_MAINTENANCE_LATENCY_LIMIT_MS / 2 ) && ( m_iBackoffFactor > 1 ) )
+    {
+        m_iBackoffFactor /= 2;
+        m_llLastBackoffChangeMS = llNowMS;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+int iC3_DatabaseMaintenance::getBackoffFactor( void ) const
+{
+    return m_iBackoffFactor;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** GetLastError() - returns the error from the last slice that failed
+*   @retval QString - error description
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+QString iC3_DatabaseMaintenance::GetLastError( void )
+{
+    return m_sLastError;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** checkpoint() - copies what it can of the WAL into the database without waiting for anyone.
+*                  When that leaves nothing in the WAL and a truncate is due, the WAL file is
+*                  also reset to zero length, waiting no more than DB_MAINTENANCE_TRUNCATE_BUSY_MS
+*                  for readers.
+*   @param database - the request processor's connection
+*   @param eTask - set to eDB_MAINTENANCE_TRUNCATE_CHECKPOINT if a truncate was attempted
+*   @param sResult - set to the frames checkpointed
+*   @retval true - the checkpoint ran; a truncate held up by a reader is retried later
+*   @retval false - a PRAGMA failed, see m_sLastError
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseMaintenance::checkpoint( QSqlDatabase & database, eDatabaseMaintenanceTasks & eTask, QString & sResult )
+{
+    QSqlQuery query( database );
+
+    // one row: busy, frames in the WAL, frames checkpointed
+    if ( !query.exec( "PRAGMA wal_checkpoint(PASSIVE)" ) || !query.next() )
+    {
+        m_sLastError = QString("iC3_DatabaseMaintenance::checkpoint() - Query Error: %1").arg( query.lastError().text() );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    qint64 llLogFrames = query.value( 1 ).toLongLong();
+    qint64 llCheckpointedFrames = query.value( 2 ).toLongLong();
+    query.finish();
+
+    sResult = QString("%1 of %2 WAL frames checkpointed").arg( llCheckpointedFrames ).arg( llLogFrames );
+
+    qint64 llNowMS = m_Clock.elapsed();
+
+    if ( ( llLogFrames <= 0 ) || ( llCheckpointedFrames < llLogFrames ) || ( llNowMS < m_llNextTruncateMS ) )
+    {
+        return true;
+    }
+
+    eTask = eDB_MAINTENANCE_TRUNCATE_CHECKPOINT;
+
+    // every frame is already in the database, so the truncate only waits for readers to move off
+    // the WAL - briefly, as the writer's queue is held up meanwhile
+    bool bRC = query.exec( QString("PRAGMA busy_timeout=%1").arg( DB_MAINTENANCE_TRUNCATE_BUSY_MS ) ) &&
+               query.exec( "PRAGMA wal_checkpoint(TRUNCATE)" ) && query.next();
+    bool bBusy = bRC && ( query.value( 0 ).toInt() != 0 );
+
+    if ( !bRC )
+    {
+        m_sLastError = QString("iC3_DatabaseMaintenance::checkpoint() - Query Error: %1").arg( query.lastError().text() );
+        qDebug() << m_sLastError;
+    }
+    query.finish();
+
+    if ( !query.exec( QString("PRAGMA busy_timeout=%1").arg( m_llBusyTimeoutMS ) ) && bRC )
+    {
+        m_sLastError = QString("iC3_DatabaseMaintenance::checkpoint() - Query Error: %1").arg( query.lastError().text() );
+        qDebug() << m_sLastError;
+        bRC = false;
+    }
+
+    if ( bBusy )
+    {
+        // retried with the next checkpoint
+        sResult.append( ", WAL in use by a reader, not truncated" );
+    }
+    else if ( bRC )
+    {
+        sResult.append( ", WAL truncated" );
+        m_llNextTruncateMS = llNowMS + DB_MAINTENANCE_TRUNCATE_INTERVAL_MS * m_iBackoffFactor;
+    }
+
+    return bRC;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** vacuumSlice() - returns up to DB_MAINTENANCE_VACUUM_PAGES free pages to the file system.
+*                   Another slice follows as soon as the queue allows while free pages remain.
+*   @param database - the request processor's connection
+*   @param sResult - set to the pages released and still free
+*   @retval true - the vacuum step ran
+*   @retval false - a PRAGMA failed, see m_sLastError
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseMaintenance::vacuumSlice( QSqlDatabase & database, QString & sResult )
+{
+    qint64 llNowMS = m_Clock.elapsed();
+    qint64 llFreePages;
+
+    m_llNextVacuumMS = llNowMS + DB_MAINTENANCE_VACUUM_INTERVAL_MS * m_iBackoffFactor;
+
+    if ( !readPragma( database, "PRAGMA freelist_count", llFreePages ) )
+    {
+        return false;
+    }
+
+    if ( llFreePages == 0 )
+    {
+        sResult = "no free pages";
+        return true;
+    }
+
+    qint64 llReleased = qMin( llFreePages, (qint64) DB_MAINTENANCE_VACUUM_PAGES );
+    QSqlQuery query( database );
+
+    // the pragma stops after releasing a page and returning its empty result row, and Qt only
+    // steps a statement without columns once, so it is run once per page in one transaction
+    bool bRC = database.transaction() && query.prepare( "PRAGMA incremental_vacuum(1)" );
+
+    for ( qint64 llPage = 0; bRC && ( llPage < llReleased ); llPage++ )
+    {
+        bRC = query.exec();
+    }
+    query.finish();
+
+    if ( !bRC || !database.commit() )
+    {
+        m_sLastError = QString("iC3_DatabaseMaintenance::vacuumSlice() - Query Error: %1 %2").arg( query.lastError().text() ).arg( database.lastError().text() );
+        qDebug() << m_sLastError;
+        database.rollback();
+        return false;
+    }
+
+    sResult = QString("%1 pages released, %2 still free").arg( llReleased ).arg( llFreePages - llReleased );
+
+    if ( llFreePages > llReleased )
+    {
+        m_llNextVacuumMS = llNowMS;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** integritySlice() - runs quick_check over the next table of the pass (with its indexes), or
+*                      over the whole file where SQLite cannot check one table.  The table
+*                      list is read when a pass starts.
+*   @param database - the request processor's connection
+*   @param sResult - set to the table checked and its result
+*   @retval true - the table is sound
+*   @retval false - the check failed or found a problem, see m_sLastError
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseMaintenance::integritySlice( QSqlDatabase & database, QString & sResult )
+{
+    qint64 llNowMS = m_Clock.elapsed();
+    QSqlQuery query( database );
+
+    if ( m_IntegrityTables.isEmpty() )
+    {
+        m_iIntegrityProblems = 0;
+
+        if ( !m_bTableQuickCheck )
+        {
+            m_IntegrityTables.append( QString() );
+        }
+        else if ( query.exec( "SELECT name FROM sqlite_master WHERE type = 'table' AND name NOT LIKE 'sqlite_%' ORDER BY name" ) )
+        {
+            while ( query.next() )
+            {
+                m_IntegrityTables.append( query.value( 0 ).toString() );
+            }
+            query.finish();
+        }
+        else
+        {
+            m_sLastError = QString("iC3_DatabaseMaintenance::integritySlice() - Query Error: %1").arg( query.lastError().text() );
+            qDebug() << m_sLastError;
+            m_llNextIntegrityMS = llNowMS + DB_MAINTENANCE_INTEGRITY_INTERVAL_MS;
+            return false;
+        }
+    }
+
+    if ( m_IntegrityTables.isEmpty() )
+    {
+        m_llNextIntegrityMS = llNowMS + DB_MAINTENANCE_INTEGRITY_INTERVAL_MS;
+        return true;
+    }
+
+    QString sTable = m_IntegrityTables.takeFirst();
+    QString sTarget = sTable.isEmpty() ? QString("database") : sTable;
+    QString sPragma = sTable.isEmpty() ? QString("PRAGMA quick_check")
+                                       : QString("PRAGMA quick_check(\"%1\")").arg( QString( sTable ).replace( '"', "\"\"" ) );
+
+    // the rest of the pass follows as soon as the queue allows
+    m_llNextIntegrityMS = m_IntegrityTables.isEmpty() ? llNowMS + DB_MAINTENANCE_INTEGRITY_INTERVAL_MS : llNowMS;
+
+    if ( !query.exec( sPragma ) )
+    {
+        m_sLastError = QString("iC3_DatabaseMaintenance::integritySlice() - %1: Query Error: %2").arg( sTarget ).arg( query.lastError().text() );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    // a sound table returns the single row "ok", otherwise one row per problem
+    QStringList problems;
+
+    while ( query.next() )
+    {
+        QString sRow = query.value( 0 ).toString();
+
+        if ( ( sRow.compare( "ok", Qt::CaseInsensitive ) != 0 ) && ( problems.size() < DB_MAINTENANCE_MAX_PROBLEMS ) )
+        {
+            problems.append( sRow );
+        }
+    }
+    query.finish();
+
+    if ( !problems.isEmpty() )
+    {
+        m_iIntegrityProblems += problems.size();
+        m_sLastError = QString("quick_check(%1): %2").arg( sTarget ).arg( problems.join( "; " ) );
+        qDebug() << "iC3_DatabaseMaintenance -" << m_sLastError;
+    }
+
+    sResult = QString("quick_check(%1): %2").arg( sTarget ).arg( problems.isEmpty() ? QString("ok") : problems.join( "; " ) );
+
+    if ( m_IntegrityTables.isEmpty() )
+    {
+        sResult.append( QString(", pass complete with %1 problems").arg( m_iIntegrityProblems ) );
+    }
+
+    return problems.isEmpty();
+}
+
+//-----------------------------------------------------------------------------------------------
+/** readPragma() - runs a PRAGMA that returns a single integer
+*   @param database - the connection
+*   @param sPragma - the full PRAGMA statement
+*   @param llValue - set to the value returned
+*   @retval true - the PRAGMA returned a value
+*   @retval false - an error occurred, see m_sLastError
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseMaintenance::readPragma( QSqlDatabase & database, const QString & sPragma, qint64 & llValue )
+{
+    QSqlQuery query( database );
+
+    if ( !query.exec( sPragma ) || !query.next() )
+    {
+        m_sLastError = QString("iC3_DatabaseMaintenance - %1 failed: %2").arg( sPragma ).arg( query.lastError().text() );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    llValue = query.value( 0 ).toLongLong();
+
+    return true;
+}
@@ -0,0 +1,104 @@
+#ifndef IC3_DATABASEMAINTENANCE_H
+#define IC3_DATABASEMAINTENANCE_H
+
+/**
+*     @file iC3_DatabaseMaintenance.h
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief This header file defines the iC3_DatabaseMaintenance class, which schedules the
+*            request processor's housekeeping: WAL checkpoints, incremental vacuum and a
+*            table-by-table quick_check.  The processor runs one slice at a time while its
+*            queue is idle and reports each one.  The slices are spaced out further while
+*            commits are slow, and come back to their normal spacing once commits are fast again.
+*            Used on the processor thread only.
+*/
+
+#include <QSqlDatabase>
+#include <QElapsedTimer>
+#include <QStringList>
+
+enum eDatabaseMaintenanceTasks
+{
+    eDB_MAINTENANCE_NONE                    = -1,
+    eDB_MAINTENANCE_CHECKPOINT              =  0,   // PASSIVE - copies what it can, never waits
+    eDB_MAINTENANCE_TRUNCATE_CHECKPOINT     =  1,   // resets the WAL file to zero length
+    eDB_MAINTENANCE_INCREMENTAL_VACUUM      =  2,
+    eDB_MAINTENANCE_INTEGRITY_CHECK         =  3,   // one table per slice
+    eDB_MAINTENANCE_RETENTION               =  4    // reported by the request processor when a retention batch fails
+};
+
+// how often each task is due while commits are fast
+static const qint64 DB_MAINTENANCE_CHECKPOINT_INTERVAL_MS   = 30 * 1000;
+static const qint64 DB_MAINTENANCE_TRUNCATE_INTERVAL_MS     = 15 * 60 * 1000;
+static const qint64 DB_MAINTENANCE_VACUUM_INTERVAL_MS       = 5 * 60 * 1000;
+static const qint64 DB_MAINTENANCE_INTEGRITY_INTERVAL_MS    = 24 * 60 * 60 * 1000;
+
+// the least time between two slices, so queued writes get the connection in between
+static const qint64 DB_MAINTENANCE_SLICE_GAP_MS             = 250;
+
+// free pages returned to the file system per incremental vacuum slice
+static const int DB_MAINTENANCE_VACUUM_PAGES                = 256;
+
+// a truncating checkpoint waits at most this long for readers to finish with the WAL
+static const int DB_MAINTENANCE_TRUNCATE_BUSY_MS            = 50;
+
+// once the average commit takes longer than this the intervals are doubled, up to
+// DB_MAINTENANCE_MAX_BACKOFF times, at most once per DB_MAINTENANCE_BACKOFF_ADJUST_MS; they
+// are halved again while it stays under half of it
+static const qint64 DB_MAINTENANCE_LATENCY_LIMIT_MS         = 50;
+static const int DB_MAINTENANCE_MAX_BACKOFF                 = 64;
+static const qint64 DB_MAINTENANCE_BACKOFF_ADJUST_MS        = 10 * 1000;
+
+// PRAGMA quick_check(table) needs SQLite 3.33.0; older versions check the whole file at once
+static const int DB_MAINTENANCE_TABLE_CHECK_SQLITE_VERSION  = 3033000;
+
+// problems reported per integrity check slice
+static const int DB_MAINTENANCE_MAX_PROBLEMS                = 10;
+
+class iC3_DatabaseMaintenance
+{
+public:
+    iC3_DatabaseMaintenance();
+
+    bool open( QSqlDatabase & database );
+
+    qint64 getWaitMS( void ) const;
+    bool runSlice( QSqlDatabase & database,
+                   eDatabaseMaintenanceTasks & eTask,
+                   qint64 & llElapsedMS,
+                   QString & sResult );
+
+    void recordCommitLatency( qint64 llLatencyMS );
+    int getBackoffFactor( void ) const;
+
+    QString GetLastError( void );
+
+private:
+
+    bool checkpoint( QSqlDatabase & database, eDatabaseMaintenanceTasks & eTask, QString & sResult );
+    bool vacuumSlice( QSqlDatabase & database, QString & sResult );
+    bool integritySlice( QSqlDatabase & database, QString & sResult );
+    bool readPragma( QSqlDatabase & database, const QString & sPragma, qint64 & llValue );
+
+    QElapsedTimer m_Clock;                          // all times below are m_Clock.elapsed() values
+
+    qint64 m_llNextCheckpointMS;
+    qint64 m_llNextTruncateMS;
+    qint64 m_llNextVacuumMS;
+    qint64 m_llNextIntegrityMS;
+    qint64 m_llNextSliceMS;
+
+    bool m_bIncrementalVacuum;                      // the file was created with auto_vacuum=INCREMENTAL
+    bool m_bTableQuickCheck;
+    qint64 m_llBusyTimeoutMS;                       // the connection's own, restored after a truncate
+    QStringList m_IntegrityTables;                  // still to check in this pass
+    int m_iIntegrityProblems;                       // found so far in this pass
+
+    double m_dCommitLatencyMS;                      // moving average
+    int m_iBackoffFactor;
+    qint64 m_llLastBackoffChangeMS;
+
+    QString m_sLastError;
+};
+
+#endif // IC3_DATABASEMAINTENANCE_H
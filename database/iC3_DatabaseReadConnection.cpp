@@ -0,0 +1,514 @@
+/**
+*     @file iC3_DatabaseReadConnection.cpp
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief this cpp file implements the iC3_DatabaseReadConnection class.  Queries that need
+*            more than one statement run in a read transaction, so they see a single snapshot
+*            even while the request processor commits or compacts.
+*/
+
+#include <QDebug>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QStringList>
+#include <limits>
+#include <algorithm>
+
+#include "iC3_DatabaseReadConnection.h"
+
+// a WAL reader is only kept waiting while a checkpoint restarts the log
+static const int DB_READ_BUSY_TIMEOUT_MS = 1000;
+
+namespace
+{
+    bool sampleTimeLessThan( const iC3_TransducerSample & first, const iC3_TransducerSample & second )
+    {
+        return first.llSampleTimeMS < second.llSampleTimeMS;
+    }
+
+    bool sampleKeyLessThan( const iC3_TransducerSample & first, const iC3_TransducerSample & second )
+    {
+        return ( first.llSampleTimeMS < second.llSampleTimeMS ) ||
+               ( ( first.llSampleTimeMS == second.llSampleTimeMS ) && ( first.llSequenceIndex < second.llSequenceIndex ) );
+    }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** constructor
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_DatabaseReadConnection::iC3_DatabaseReadConnection() :
+    m_iGeneration( 0 ),
+    m_MinuteRollupTable( TRANSDUCER_ROLLUP_1_MINUTE_TABLE_NAME, TRANSDUCER_ROLLUP_1_MINUTE_MS ),
+    m_HourRollupTable( TRANSDUCER_ROLLUP_1_HOUR_TABLE_NAME, TRANSDUCER_ROLLUP_1_HOUR_MS )
+{
+    m_apRollupTables[eTRANSDUCER_ROLLUP_1_MINUTE] = &m_MinuteRollupTable;
+    m_apRollupTables[eTRANSDUCER_ROLLUP_1_HOUR] = &m_HourRollupTable;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** destructor - runs on the owning thread as it exits, which closes the connection there
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_DatabaseReadConnection::~iC3_DatabaseReadConnection()
+{
+    close();
+}
+
+//-----------------------------------------------------------------------------------------------
+/** open() - opens a read-only connection to the database.  The request processor has already
+*            created the tables and put the database in WAL mode.
+*   @param sDatabaseFileName - the SQLite database file
+*   @param sConnectionName - unique Qt connection name for this connection
+*   @param iGeneration - the pool generation this connection belongs to
+*   @param sSegmentStorePath - the transducer segment store, empty if it is not used
+*   @retval true - the connection is open
+*   @retval false - an error occurred, see GetLastError()
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseReadConnection::open( const QString & sDatabaseFileName,
+                                       const QString & sConnectionName,
+                                       int iGeneration,
+                                       const QString & sSegmentStorePath )
+{
+    close();
+
+    m_sConnectionName = sConnectionName;
+    m_iGeneration = iGeneration;
+    m_SegmentReader.setRootPath( sSegmentStorePath );
+
+    m_db = QSqlDatabase::addDatabase( "QSQLITE", m_sConnectionName );
+    m_db.setDatabaseName( sDatabaseFileName );
+    m_db.setConnectOptions( QString("QSQLITE_OPEN_READONLY;QSQLITE_BUSY_TIMEOUT=%1").arg( DB_READ_BUSY_TIMEOUT_MS ) );
+
+    if ( !m_db.open() )
+    {
+        m_sLastError = QString("iC3_DatabaseReadConnection::open() - Unable to open the database: %1").arg( m_db.lastError().text() );
+        qDebug() << m_sLastError;
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** close() - releases the prepared statements and segment mappings, closes and removes the
+*            connection
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseReadConnection::close( void )
+{
+    m_SegmentReader.setRootPath( QString() );
+
+    if ( m_sConnectionName.isEmpty() )
+    {
+        return;
+    }
+
+    m_TransducerTable.clearPreparedQueries( m_db );
+    m_TransducerBlockTable.clearPreparedQueries( m_db );
+    m_StatusJournalTable.clearPreparedQueries( m_db );
+    m_DeviceEventTable.clearPreparedQueries( m_db );
+    m_DeviceEventCountTable.clearPreparedQueries( m_db );
+    for ( int iLevel = 0; iLevel < eTRANSDUCER_ROLLUP_LEVEL_COUNT; iLevel++ )
+    {
+        m_apRollupTables[iLevel]->clearPreparedQueries( m_db );
+    }
+    m_db.close();
+    m_db = QSqlDatabase();
+
+    QSqlDatabase::removeDatabase( m_sConnectionName );
+    m_sConnectionName.clear();
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseReadConnection::isOpen( void ) const
+{
+    return m_db.isOpen();
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+int iC3_DatabaseReadConnection::getGeneration( void ) const
+{
+    return m_iGeneration;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** GetLastError() - returns the last error encountered on this connection
+*   @retval QString - error description
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+QString iC3_DatabaseReadConnection::GetLastError( void )
+{
+    return m_sLastError;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getNextTransducerEntries() - the page of raw samples that follows lastSample.  With the
+*                              segment store, rows left in the Transducers table from before it
+*                              was enabled are merged in.
+*   @param lastSample - keyset cursor, the last sample of the previous page
+*   @param llEndTimeMS - end of the range (exclusive)
+*   @param iMaxEntries - page size
+*   @param samples - the samples are appended here, oldest first
+*   @retval true - the query succeeded
+*   @retval false - an error occurred, see GetLastError()
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseReadConnection::getNextTransducerEntries( const iC3_TransducerSample & lastSample,
+                                                           qint64 llEndTimeMS,
+                                                           int iMaxEntries,
+                                                           QVector<iC3_TransducerSample> & samples )
+{
+    int iFirstSample = samples.size();
+
+    if ( !m_TransducerTable.getNextEntriesInRange( m_db, lastSample, llEndTimeMS, iMaxEntries, samples ) )
+    {
+        m_sLastError = m_TransducerTable.GetLastError();
+        return false;
+    }
+
+    if ( !m_SegmentReader.isEnabled() )
+    {
+        return true;
+    }
+
+    int iFirstSegmentSample = samples.size();
+
+    if ( !m_SegmentReader.getNextEntriesInRange( lastSample, llEndTimeMS, iMaxEntries, samples ) )
+    {
+        m_sLastError = m_SegmentReader.GetLastError();
+        return false;
+    }
+
+    if ( ( iFirstSegmentSample > iFirstSample ) && ( iFirstSegmentSample < samples.size() ) )
+    {
+        std::sort( samples.begin() + iFirstSample, samples.end(), sampleKeyLessThan );
+        if ( samples.size() - iFirstSample > iMaxEntries )
+        {
+            samples.resize( iFirstSample + iMaxEntries );
+        }
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getLastTransducerEntries() - a device's most recent raw samples
+*   @param iDeviceID - the device
+*   @param iNumberOfEntries - how many samples
+*   @param samples - the samples are appended here, oldest first
+*   @retval true - the query succeeded
+*   @retval false - an error occurred, see GetLastError()
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseReadConnection::getLastTransducerEntries( int iDeviceID, int iNumberOfEntries, QVector<iC3_TransducerSample> & samples )
+{
+    int iFirstSample = samples.size();
+
+    if ( !m_TransducerTable.getLastEntries( m_db, iDeviceID, iNumberOfEntries, samples ) )
+    {
+        m_sLastError = m_TransducerTable.GetLastError();
+        return false;
+    }
+
+    if ( !m_SegmentReader.isEnabled() )
+    {
+        return true;
+    }
+
+    int iFirstSegmentSample = samples.size();
+
+    if ( !m_SegmentReader.getLastEntries( iDeviceID, iNumberOfEntries, samples ) )
+    {
+        m_sLastError = m_SegmentReader.GetLastError();
+        return false;
+    }
+
+    if ( ( iFirstSegmentSample > iFirstSample ) && ( iFirstSegmentSample < samples.size() ) )
+    {
+        std::sort( samples.begin() + iFirstSample, samples.end(), sampleKeyLessThan );
+        samples.remove( iFirstSample, qMax( 0, samples.size() - iFirstSample - iNumberOfEntries ) );
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getTransducerHistory() - a device's samples in a time range from both the compacted blocks
+*                            and the raw table.  Both are read in one transaction, so an hour
+*                            being compacted meanwhile is seen either as rows or as a block.
+*                            With the segment store its samples for the range are added.
+*   @param iDeviceID - the device
+*   @param llBeginTimeMS - start of the range (inclusive)
+*   @param llEndTimeMS - end of the range (exclusive)
+*   @param samples - the samples are appended here, oldest first
+*   @retval true - the query succeeded
+*   @retval false - an error occurred, see GetLastError()
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseReadConnection::getTransducerHistory( int iDeviceID,
+                                                       qint64 llBeginTimeMS,
+                                                       qint64 llEndTimeMS,
+                                                       QVector<iC3_TransducerSample> & samples )
+{
+    if ( !m_db.transaction() )
+    {
+        m_sLastError = QString("iC3_DatabaseReadConnection::getTransducerHistory() - Unable to begin a read: %1").arg( m_db.lastError().text() );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    int iFirstSample = samples.size();
+    bool bRC = m_TransducerBlockTable.getEntriesInRange( m_db, iDeviceID, llBeginTimeMS, llEndTimeMS, samples );
+    int iCompactedSamples = samples.size() - iFirstSample;
+
+    if ( !bRC )
+    {
+        m_sLastError = m_TransducerBlockTable.GetLastError();
+    }
+    else if ( !m_TransducerTable.getEntriesInRange( m_db, iDeviceID, llBeginTimeMS, llEndTimeMS,
+                                                    std::numeric_limits<int>::max(), samples ) )
+    {
+        m_sLastError = m_TransducerTable.GetLastError();
+        bRC = false;
+    }
+
+    // nothing was written - ending the read just releases the snapshot
+    m_db.commit();
+
+    if ( !bRC )
+    {
+        return false;
+    }
+
+    // raw rows normally all follow the blocks; only late rows for a compacted hour need a sort
+    int iBoundary = iFirstSample + iCompactedSamples;
+
+    if ( ( iCompactedSamples > 0 ) && ( iBoundary < samples.size() ) &&
+         ( samples.at( iBoundary ).llSampleTimeMS < samples.at( iBoundary - 1 ).llSampleTimeMS ) )
+    {
+        std::stable_sort( samples.begin() + iFirstSample, samples.end(), sampleTimeLessThan );
+    }
+
+    if ( !m_SegmentReader.isEnabled() )
+    {
+        return true;
+    }
+
+    iBoundary = samples.size();
+
+    if ( !m_SegmentReader.getEntriesInRange( iDeviceID, llBeginTimeMS, llEndTimeMS, std::numeric_limits<int>::max(), samples ) )
+    {
+        m_sLastError = m_SegmentReader.GetLastError();
+        return false;
+    }
+
+    // the segments normally hold only samples newer than anything left in the database
+    if ( ( iBoundary > iFirstSample ) && ( iBoundary < samples.size() ) &&
+         ( samples.at( iBoundary ).llSampleTimeMS < samples.at( iBoundary - 1 ).llSampleTimeMS ) )
+    {
+        std::stable_sort( samples.begin() + iFirstSample, samples.end(), sampleTimeLessThan );
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getTransducerRollups() - a device's rollup buckets in a time range
+*   @param iDeviceID - the device
+*   @param eLevel - bucket size
+*   @param llBeginTimeMS - start of the range (inclusive)
+*   @param llEndTimeMS - end of the range (exclusive)
+*   @param rollups - the buckets are appended here, oldest first
+*   @retval true - the query succeeded
+*   @retval false - an error occurred, see GetLastError()
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseReadConnection::getTransducerRollups( int iDeviceID,
+                                                       eTransducerRollupLevels eLevel,
+                                                       qint64 llBeginTimeMS,
+                                                       qint64 llEndTimeMS,
+                                                       QVector<iC3_TransducerRollup> & rollups )
+{
+    iC3_TransducerRollupTable * pTable = m_apRollupTables[eLevel];
+
+    if ( !pTable->getRollupsInRange( m_db, iDeviceID, llBeginTimeMS, llEndTimeMS, rollups ) )
+    {
+        m_sLastError = pTable->GetLastError();
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getDeviceStatusAtTime() - a device's status fields as they were at a given time, rebuilt
+*                             from the StatusJournal in one read transaction
+*   @param iDeviceID - the device
+*   @param llTimeMS - ms since the epoch
+*   @param status - set to the status; llStatusTimeMS is 0 if nothing was journaled by llTimeMS
+*   @retval true - the query succeeded
+*   @retval false - an error occurred, see GetLastError()
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseReadConnection::getDeviceStatusAtTime( int iDeviceID, qint64 llTimeMS, iC3_DeviceStatus & status )
+{
+    if ( !m_db.transaction() )
+    {
+        m_sLastError = QString("iC3_DatabaseReadConnection::getDeviceStatusAtTime() - Unable to begin a read: %1").arg( m_db.lastError().text() );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    bool bRC = m_StatusJournalTable.getStatusAtTime( m_db, iDeviceID, llTimeMS, status );
+
+    if ( !bRC )
+    {
+        m_sLastError = m_StatusJournalTable.GetLastError();
+    }
+
+    // nothing was written - ending the read just releases the snapshot
+    m_db.commit();
+
+    return bRC;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getDeviceEventCount() - the number of a device's events of one type that started on the
+*                           days in a range, and their total duration, from the per-day counts
+*   @param iDeviceID - the device
+*   @param eEventType - the kind of event
+*   @param llBeginTimeMS - local midnight starting the first day (inclusive)
+*   @param llEndTimeMS - local midnight ending the last day (exclusive)
+*   @param count - set to the totals
+*   @retval true - the query succeeded
+*   @retval false - an error occurred, see GetLastError()
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseReadConnection::getDeviceEventCount( int iDeviceID,
+                                                      eDeviceEventTypes eEventType,
+                                                      qint64 llBeginTimeMS,
+                                                      qint64 llEndTimeMS,
+                                                      iC3_DeviceEventCount & count )
+{
+    if ( !m_DeviceEventCountTable.getCount( m_db, iDeviceID, eEventType, llBeginTimeMS, llEndTimeMS, count ) )
+    {
+        m_sLastError = m_DeviceEventCountTable.GetLastError();
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getDeviceEvents() - a device's events of one type that were active at any time in a range,
+*                       read in one read transaction
+*   @param iDeviceID - the device
+*   @param eEventType - the kind of event
+*   @param llBeginTimeMS - start of the range, ms since the epoch (inclusive)
+*   @param llEndTimeMS - end of the range, ms since the epoch (exclusive)
+*   @param events - set to the events, oldest first
+*   @retval true - the query succeeded
+*   @retval false - an error occurred, see GetLastError()
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseReadConnection::getDeviceEvents( int iDeviceID,
+                                                  eDeviceEventTypes eEventType,
+                                                  qint64 llBeginTimeMS,
+                                                  qint64 llEndTimeMS,
+                                                  QVector<iC3_DeviceEvent> & events )
+{
+    if ( !m_db.transaction() )
+    {
+        m_sLastError = QString("iC3_DatabaseReadConnection::getDeviceEvents() - Unable to begin a read: %1").arg( m_db.lastError().text() );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    bool bRC = m_DeviceEventTable.getEventsInRange( m_db, iDeviceID, eEventType, llBeginTimeMS, llEndTimeMS, events );
+
+    if ( !bRC )
+    {
+        m_sLastError = m_DeviceEventTable.GetLastError();
+    }
+
+    // nothing was written - ending the read just releases the snapshot
+    m_db.commit();
+
+    return bRC;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** checkIntegrity() - checks that every transducer table can be read and runs SQLite's
+*                      quick_check over the whole file.  This reads every page, which is why
+*                      it runs here rather than on the request processor.
+*   @retval true - no problem was found
+*   @retval false - a table could not be read or the check reported a problem, see
+*                   GetLastError()
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseReadConnection::checkIntegrity( void )
+{
+    iC3_DatabaseTable * apTables[] = { &m_TransducerTable, &m_TransducerBlockTable, &m_MinuteRollupTable, &m_HourRollupTable,
+                                     &m_StatusJournalTable, &m_DeviceEventTable, &m_DeviceEventCountTable };
+
+    for ( unsigned int uiIndex = 0; uiIndex < sizeof( apTables ) / sizeof( apTables[0] ); uiIndex++ )
+    {
+        if ( !apTables[uiIndex]->CheckTableIntegrity( m_db ) )
+        {
+            m_sLastError = apTables[uiIndex]->GetLastError();
+            return false;
+        }
+    }
+
+    QSqlQuery query( m_db );
+
+    if ( !query.exec( "PRAGMA quick_check" ) )
+    {
+        m_sLastError = QString("iC3_DatabaseReadConnection::checkIntegrity() - Query Error: %1").arg( query.lastError().text() );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    // a sound database returns the single row "ok", otherwise one row per problem
+    QStringList problems;
+
+    while ( query.next() )
+    {
+        QString sResult = query.value( 0 ).toString();
+
+        if ( sResult.compare( "ok", Qt::CaseInsensitive ) != 0 )
+        {
+            problems.append( sResult );
+        }
+    }
+
+    if ( !problems.isEmpty() )
+    {
+        m_sLastError = QString("iC3_DatabaseReadConnection::checkIntegrity() - %1").arg( problems.join( "; " ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    return true;
+}
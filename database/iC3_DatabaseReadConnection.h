@@ -0,0 +1,88 @@
+#ifndef IC3_DATABASEREADCONNECTION_H
+#define IC3_DATABASEREADCONNECTION_H
+
+/**
+*     @file iC3_DatabaseReadConnection.h
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief This header file defines the iC3_DatabaseReadConnection class.  A read connection
+*            is one read-only SQLite connection with its own table objects (and so its own
+*            prepared statements).  iC3_DatabaseConnectionPool gives each thread that reads
+*            its own; it must only be used on the thread that opened it.
+*/
+
+#include <QSqlDatabase>
+#include <QVector>
+
+#include "iC3_TransducerSample.h"
+#include "iC3_TransducerRollup.h"
+#include "iC3_TransducerTable.h"
+#include "iC3_TransducerBlockTable.h"
+#include "iC3_TransducerRollupTable.h"
+#include "iC3_StatusJournalTable.h"
+#include "iC3_DeviceEventTable.h"
+#include "iC3_DeviceEventCountTable.h"
+#include "iC3_TransducerSegmentReader.h"
+
+class iC3_DatabaseReadConnection
+{
+public:
+    iC3_DatabaseReadConnection();
+    ~iC3_DatabaseReadConnection();
+
+    bool open( const QString & sDatabaseFileName,
+               const QString & sConnectionName,
+               int iGeneration,
+               const QString & sSegmentStorePath = QString() );
+    void close( void );
+
+    bool isOpen( void ) const;
+    int getGeneration( void ) const;
+    QString GetLastError( void );
+
+    bool getNextTransducerEntries( const iC3_TransducerSample & lastSample,
+                                   qint64 llEndTimeMS,
+                                   int iMaxEntries,
+                                   QVector<iC3_TransducerSample> & samples );
+    bool getLastTransducerEntries( int iDeviceID, int iNumberOfEntries, QVector<iC3_TransducerSample> & samples );
+    bool getTransducerHistory( int iDeviceID,
+                               qint64 llBeginTimeMS,
+                               qint64 llEndTimeMS,
+                               QVector<iC3_TransducerSample> & samples );
+    bool getTransducerRollups( int iDeviceID,
+                               eTransducerRollupLevels eLevel,
+                               qint64 llBeginTimeMS,
+                               qint64 llEndTimeMS,
+                               QVector<iC3_TransducerRollup> & rollups );
+    bool getDeviceStatusAtTime( int iDeviceID, qint64 llTimeMS, iC3_DeviceStatus & status );
+    bool getDeviceEventCount( int iDeviceID,
+                              eDeviceEventTypes eEventType,
+                              qint64 llBeginTimeMS,
+                              qint64 llEndTimeMS,
+                              iC3_DeviceEventCount & count );
+    bool getDeviceEvents( int iDeviceID,
+                          eDeviceEventTypes eEventType,
+                          qint64 llBeginTimeMS,
+                          qint64 llEndTimeMS,
+                          QVector<iC3_DeviceEvent> & events );
+    bool checkIntegrity( void );
+
+private:
+
+    QString m_sConnectionName;
+    int m_iGeneration;
+    QString m_sLastError;
+
+    QSqlDatabase m_db;
+    iC3_TransducerTable m_TransducerTable;
+    iC3_TransducerBlockTable m_TransducerBlockTable;
+    iC3_TransducerRollupTable m_MinuteRollupTable;
+    iC3_TransducerRollupTable m_HourRollupTable;
+    iC3_TransducerRollupTable * m_apRollupTables[eTRANSDUCER_ROLLUP_LEVEL_COUNT];
+    iC3_StatusJournalTable m_StatusJournalTable;
+    iC3_DeviceEventTable m_DeviceEventTable;
+    iC3_DeviceEventCountTable m_DeviceEventCountTable;
+    iC3_TransducerSegmentReader m_SegmentReader;
+};
+
+#endif // IC3_DATABASEREADCONNECTION_H
@@ -0,0 +1,185 @@
+/**
+*     @file iC3_DatabaseRequest.cpp
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief this cpp file implements the iC3_DatabaseRequest class.
+*/
+
+#include "iC3_DatabaseRequest.h"
+
+//-----------------------------------------------------------------------------------------------
+/** constructor
+*   @param eRequestType - the operation the request processor is to perform
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_DatabaseRequest::iC3_DatabaseRequest( eIC3_DatabaseRequestTypes eRequestType ) :
+    m_eRequestType( eRequestType ),
+    m_uiTransactionID( 0 ),
+    m_llBeginTimeMS( 0 ),
+    m_llEndTimeMS( 0 ),
+    m_iDeviceID( TRANSDUCER_LOCAL_DEVICE_ID ),
+    m_iMaxEntries( 0 ),
+    m_eRollupLevel( eTRANSDUCER_ROLLUP_1_MINUTE ),
+    m_eEventType( eDEVICE_EVENT_DOOR_OPEN ),
+    m_pNext( NULL )
+{
+    m_TransducerSample.llSequenceIndex = 0;
+    m_TransducerSample.iDeviceID = TRANSDUCER_LOCAL_DEVICE_ID;
+    m_TransducerSample.llSampleTimeMS = 0;
+    for ( int iIndex = 0; iIndex < TRANSDUCER_NUMBER_OF_RTDS; iIndex++ )
+    {
+        m_TransducerSample.adRTDValues[iIndex] = 0.0;
+    }
+
+    m_DeviceStatus.iDeviceID = TRANSDUCER_LOCAL_DEVICE_ID;
+    m_DeviceStatus.llStatusTimeMS = 0;
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+eIC3_DatabaseRequestTypes iC3_DatabaseRequest::getRequestType( void ) const
+{
+    return m_eRequestType;
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseRequest::setTransactionID( uint uiTransactionID )
+{
+    m_uiTransactionID = uiTransactionID;
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+uint iC3_DatabaseRequest::getTransactionID( void ) const
+{
+    return m_uiTransactionID;
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseRequest::setTransducerSample( const iC3_TransducerSample & sample )
+{
+    m_TransducerSample = sample;
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+const iC3_TransducerSample & iC3_DatabaseRequest::getTransducerSample( void ) const
+{
+    return m_TransducerSample;
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseRequest::setBeginTimeMS( qint64 llBeginTimeMS )
+{
+    m_llBeginTimeMS = llBeginTimeMS;
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+qint64 iC3_DatabaseRequest::getBeginTimeMS( void ) const
+{
+    return m_llBeginTimeMS;
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseRequest::setEndTimeMS( qint64 llEndTimeMS )
+{
+    m_llEndTimeMS = llEndTimeMS;
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+qint64 iC3_DatabaseRequest::getEndTimeMS( void ) const
+{
+    return m_llEndTimeMS;
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseRequest::setDeviceID( int iDeviceID )
+{
+    m_iDeviceID = iDeviceID;
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+int iC3_DatabaseRequest::getDeviceID( void ) const
+{
+    return m_iDeviceID;
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseRequest::setMaxEntries( int iMaxEntries )
+{
+    m_iMaxEntries = iMaxEntries;
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+int iC3_DatabaseRequest::getMaxEntries( void ) const
+{
+    return m_iMaxEntries;
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseRequest::setRollupLevel( eTransducerRollupLevels eRollupLevel )
+{
+    m_eRollupLevel = eRollupLevel;
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+eTransducerRollupLevels iC3_DatabaseRequest::getRollupLevel( void ) const
+{
+    return m_eRollupLevel;
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseRequest::setDeviceStatus( const iC3_DeviceStatus & status )
+{
+    m_DeviceStatus = status;
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+const iC3_DeviceStatus & iC3_DatabaseRequest::getDeviceStatus( void ) const
+{
+    return m_DeviceStatus;
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseRequest::setEventType( eDeviceEventTypes eEventType )
+{
+    m_eEventType = eEventType;
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+eDeviceEventTypes iC3_DatabaseRequest::getEventType( void ) const
+{
+    return m_eEventType;
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseRequest::setNext( iC3_DatabaseRequest * pNext )
+{
+    m_pNext = pNext;
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+iC3_DatabaseRequest * iC3_DatabaseRequest::getNext( void ) const
+{
+    return m_pNext;
+}
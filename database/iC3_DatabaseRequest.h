@@ -0,0 +1,76 @@
+#ifndef IC3_DATABASEREQUEST_H
+#define IC3_DATABASEREQUEST_H
+
+/**
+*     @file iC3_DatabaseRequest.h
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief This header file defines the iC3_DatabaseRequest class.  A request is built by
+*            iC3_Database, queued to the iC3_DatabaseRequestProcessor and deleted by the
+*            processor once it has been executed.
+*/
+
+#include <QtGlobal>
+
+#include "iC3_DMM_Constants.h"
+#include "iC3_TransducerSample.h"
+#include "iC3_TransducerRollup.h"
+#include "iC3_DeviceStatus.h"
+#include "iC3_DeviceEvent.h"
+
+class iC3_DatabaseRequest
+{
+public:
+    explicit iC3_DatabaseRequest( eIC3_DatabaseRequestTypes eRequestType );
+
+    eIC3_DatabaseRequestTypes getRequestType( void ) const;
+
+    void setTransactionID( uint uiTransactionID );
+    uint getTransactionID( void ) const;
+
+    void setTransducerSample( const iC3_TransducerSample & sample );
+    const iC3_TransducerSample & getTransducerSample( void ) const;
+
+    void setBeginTimeMS( qint64 llBeginTimeMS );
+    qint64 getBeginTimeMS( void ) const;
+
+    void setEndTimeMS( qint64 llEndTimeMS );
+    qint64 getEndTimeMS( void ) const;
+
+    void setDeviceID( int iDeviceID );
+    int getDeviceID( void ) const;
+
+    void setMaxEntries( int iMaxEntries );
+    int getMaxEntries( void ) const;
+
+    void setRollupLevel( eTransducerRollupLevels eRollupLevel );
+    eTransducerRollupLevels getRollupLevel( void ) const;
+
+    void setDeviceStatus( const iC3_DeviceStatus & status );
+    const iC3_DeviceStatus & getDeviceStatus( void ) const;
+
+    void setEventType( eDeviceEventTypes eEventType );
+    eDeviceEventTypes getEventType( void ) const;
+
+    // link used by the request processor's queue - not part of the request data
+    void setNext( iC3_DatabaseRequest * pNext );
+    iC3_DatabaseRequest * getNext( void ) const;
+
+private:
+
+    eIC3_DatabaseRequestTypes m_eRequestType;
+    uint m_uiTransactionID;
+
+    iC3_TransducerSample m_TransducerSample;
+    qint64 m_llBeginTimeMS;
+    qint64 m_llEndTimeMS;
+    int m_iDeviceID;
+    int m_iMaxEntries;
+    eTransducerRollupLevels m_eRollupLevel;
+    iC3_DeviceStatus m_DeviceStatus;
+    eDeviceEventTypes m_eEventType;
+
+    iC3_DatabaseRequest * m_pNext;
+};
+
+#endif // IC3_DATABASEREQUEST_H
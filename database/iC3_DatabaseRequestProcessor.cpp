@@ -0,0 +1,1662 @@
+/**
+*     @file iC3_DatabaseRequestProcessor.cpp
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief this cpp file implements the iC3_DatabaseRequestProcessor class.  Requests are
+*            queued from any thread on a lock-free list; the processor thread sleeps on a
+*            semaphore until there is work, then executes everything that is pending.
+*            Transducer inserts are group committed: they accumulate in one open transaction
+*            that is committed after a time window or row count, whichever comes first.
+*            A transducer sample that cannot be written, or whose commit fails, goes to the
+*            spill journal, if one is set, and is replayed later by iC3_Database.
+*/
+
+#include <QDebug>
+#include <QMutexLocker>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QDateTime>
+#include <limits>
+#include <algorithm>
+
+#include "iC3_DatabaseRequestProcessor.h"
+
+namespace
+{
+    bool sampleTimeLessThan( const iC3_TransducerSample & first, const iC3_TransducerSample & second )
+    {
+        return first.llSampleTimeMS < second.llSampleTimeMS;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** constructor
+*   @param parent - QObject pointer parent (unused)
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_DatabaseRequestProcessor::iC3_DatabaseRequestProcessor(QObject *parent) :
+    QThread(parent),
+    m_pSpillJournal( NULL ),
+    m_iSpilledSamples( 0 ),
+    m_pPendingRequests( NULL ),
+    m_bAcceptingRequests( 0 ),
+    m_bStartupSucceeded( false ),
+    m_llLastSequenceIndex( 0 ),
+    m_iGroupCommitWindowMS( DB_GROUP_COMMIT_WINDOW_MS ),
+    m_iGroupCommitMaxRows( DB_GROUP_COMMIT_MAX_ROWS ),
+    m_bTransactionOpen( false ),
+    m_MinuteRollupTable( TRANSDUCER_ROLLUP_1_MINUTE_TABLE_NAME, TRANSDUCER_ROLLUP_1_MINUTE_MS ),
+    m_HourRollupTable( TRANSDUCER_ROLLUP_1_HOUR_TABLE_NAME, TRANSDUCER_ROLLUP_1_HOUR_MS ),
+    m_bActiveDeviceEventsLoaded( false ),
+    m_iRawRetentionHours( DB_RAW_RETENTION_HOURS ),
+    m_iMinuteRollupRetentionHours( DB_MINUTE_ROLLUP_RETENTION_HOURS ),
+    m_bArchiveRawData( DB_ARCHIVE_EXPIRED_RAW_DATA ? 1 : 0 ),
+    m_bRetentionWorkPending( true )
+{
+    m_apRollupTables[eTRANSDUCER_ROLLUP_1_MINUTE] = &m_MinuteRollupTable;
+    m_apRollupTables[eTRANSDUCER_ROLLUP_1_HOUR] = &m_HourRollupTable;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** destructor
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_DatabaseRequestProcessor::~iC3_DatabaseRequestProcessor()
+{
+    stopProcessingDbRequests();
+
+    int iNumberOfRequests;
+    deleteRequests( takeAllRequests( iNumberOfRequests ) );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** startProcessingDbRequests() - starts the processor thread, which opens its own connection
+*                                 to the database and creates the tables.  Blocks until the
+*                                 thread has either opened the database or failed to.
+*   @param sDatabaseFileName - the SQLite database file
+*   @param sConnectionName - name for the processor's connection, unique in the application
+*   @param sSegmentStorePath - if not empty, raw samples are appended to segment files under
+*                              this directory instead of the Transducers table
+*   @retval true - the database is open and requests are being accepted
+*   @retval false - the database could not be opened.  Use GetLastError() to retrieve error
+*                   information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseRequestProcessor::startProcessingDbRequests( const QString & sDatabaseFileName,
+                                                              const QString & sConnectionName,
+                                                              const QString & sSegmentStorePath )
+{
+    if ( isRunning() )
+    {
+        return true;
+    }
+
+    m_sDatabaseFileName = sDatabaseFileName;
+    m_sConnectionName = sConnectionName;
+    m_sSegmentStorePath = sSegmentStorePath;
+    m_bStartupSucceeded = false;
+
+    {
+        QMutexLocker locker( &m_PendingSampleMutex );
+        m_PendingSampleTimes.clear();
+    }
+    m_TakenSampleTimes.clear();
+
+    start();
+    m_StartupComplete.acquire();
+
+    if ( !m_bStartupSucceeded )
+    {
+        wait();
+        return false;
+    }
+
+    m_bAcceptingRequests.storeRelease( 1 );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** stopProcessingDbRequests() - stops accepting requests, lets the thread finish everything
+*                                already queued and waits for it to close the database.
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseRequestProcessor::stopProcessingDbRequests( void )
+{
+    if ( !m_bAcceptingRequests.testAndSetOrdered( 1, 0 ) )
+    {
+        return;
+    }
+
+    iC3_DatabaseRequest * pStopRequest = new iC3_DatabaseRequest( eDB_REQUEST_STOP_PROCESSING );
+    iC3_DatabaseRequest * pHead;
+
+    do
+    {
+        pHead = m_pPendingRequests.loadAcquire();
+        pStopRequest->setNext( pHead );
+    } while ( !m_pPendingRequests.testAndSetRelease( pHead, pStopRequest ) );
+
+    m_PendingRequestCount.release();
+
+    wait();
+}
+
+//-----------------------------------------------------------------------------------------------
+/** AddRequestToQueue() - queues a request for the processor thread.  Safe to call from any
+*                         thread; never blocks.  The processor takes ownership of the request.
+*   @param pRequest - the request to execute
+*   @retval true - the request was queued
+*   @retval false - the processor is not running, the request was deleted
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseRequestProcessor::AddRequestToQueue( iC3_DatabaseRequest * pRequest )
+{
+    if ( pRequest == NULL )
+    {
+        return false;
+    }
+
+    if ( m_bAcceptingRequests.loadAcquire() == 0 )
+    {
+        delete pRequest;
+        return false;
+    }
+
+    if ( ( pRequest->getRequestType() == eDB_REQUEST_INSERT_TRANSDUCER_SAMPLE ) ||
+         ( pRequest->getRequestType() == eDB_REQUEST_REPLAY_TRANSDUCER_SAMPLE ) )
+    {
+        QMutexLocker locker( &m_PendingSampleMutex );
+        m_PendingSampleTimes[pRequest->getTransducerSample().llSampleTimeMS]++;
+    }
+
+    // only the processor ever removes from the list, and it always takes all of it, so a
+    // plain compare-and-swap push cannot suffer from ABA
+    iC3_DatabaseRequest * pHead;
+    do
+    {
+        pHead = m_pPendingRequests.loadAcquire();
+        pRequest->setNext( pHead );
+    } while ( !m_pPendingRequests.testAndSetRelease( pHead, pRequest ) );
+
+    m_PendingRequestCount.release();
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** setGroupCommitLimits() - sets how long and how many inserts may accumulate before they are
+*                            committed.  Safe to call from any thread; applies to the next
+*                            transaction.
+*   @param iWindowMS - maximum age of the oldest uncommitted insert (0 commits every insert)
+*   @param iMaxRows - maximum number of inserts per transaction
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseRequestProcessor::setGroupCommitLimits( int iWindowMS, int iMaxRows )
+{
+    m_iGroupCommitWindowMS.storeRelease( qMax( iWindowMS, 0 ) );
+    m_iGroupCommitMaxRows.storeRelease( qMax( iMaxRows, 1 ) );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** setRetentionLimits() - sets how long raw samples and 1 minute rollups are kept.  1 hour
+*                          rollups are kept forever.  Safe to call from any thread; applies
+*                          from the next retention pass.
+*   @param iRawRetentionHours - age after which raw samples expire (0 = never)
+*   @param iMinuteRollupRetentionHours - age after which 1 minute rollups are deleted (0 = never)
+*   @param bArchiveRawData - true: expired raw samples are compacted into TransducerBlocks;
+*                            false: they are deleted
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseRequestProcessor::setRetentionLimits( int iRawRetentionHours, int iMinuteRollupRetentionHours, bool bArchiveRawData )
+{
+    m_iRawRetentionHours.storeRelease( qMax( iRawRetentionHours, 0 ) );
+    m_iMinuteRollupRetentionHours.storeRelease( qMax( iMinuteRollupRetentionHours, 0 ) );
+    m_bArchiveRawData.storeRelease( bArchiveRawData ? 1 : 0 );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** setSpillJournal() - sets the journal that takes the transducer samples the database could
+*                       not store.  Call before startProcessingDbRequests().
+*   @param pSpillJournal - the journal, owned by the caller; NULL: failed inserts are reported
+*                          as failures
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseRequestProcessor::setSpillJournal( iC3_TransducerSpillJournal * pSpillJournal )
+{
+    m_pSpillJournal = pSpillJournal;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getLastSequenceIndex() - the highest sample sequence index stored in the Transducers table
+*                            or the segment store when the processor started.  Valid once
+*                            startProcessingDbRequests() has succeeded.
+*   @retval the sequence index, 0 if nothing is stored
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+qint64 iC3_DatabaseRequestProcessor::getLastSequenceIndex( void ) const
+{
+    return m_llLastSequenceIndex;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getOldestPendingSampleTimeMS() - the earliest sample time of the transducer samples queued
+*                                    or written in the open transaction.  Samples from this time
+*                                    on may still be committed.  Safe to call from any thread.
+*   @retval ms since the epoch, -1 if no sample is pending
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+qint64 iC3_DatabaseRequestProcessor::getOldestPendingSampleTimeMS( void )
+{
+    QMutexLocker locker( &m_PendingSampleMutex );
+
+    return m_PendingSampleTimes.isEmpty() ? -1 : m_PendingSampleTimes.constBegin().key();
+}
+
+//-----------------------------------------------------------------------------------------------
+/** GetLastError() - returns the last error encountered while opening the database
+*   @retval QString - error description
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+QString iC3_DatabaseRequestProcessor::GetLastError( void )
+{
+    return m_sLastError;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** run() - processor thread.  The connection is opened, used and closed on this thread only.
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseRequestProcessor::run()
+{
+    m_bStartupSucceeded = openConnection();
+    m_StartupComplete.release();
+
+    if ( !m_bStartupSucceeded )
+    {
+        return;
+    }
+
+    bool bStopRequested = false;
+
+    m_RetentionTimer.start();
+
+    while ( !bStopRequested )
+    {
+        if ( m_bTransactionOpen )
+        {
+            // wait for more work, but no longer than the open transaction may stay uncommitted
+            qint64 llRemainingMS = m_iGroupCommitWindowMS.loadAcquire() - m_TransactionTimer.elapsed();
+
+            if ( ( llRemainingMS <= 0 ) || !m_PendingRequestCount.tryAcquire( 1, (int) llRemainingMS ) )
+            {
+                commitTransaction();
+                settlePendingSamples();
+                continue;
+            }
+        }
+        else
+        {
+            // idle: sleep until there is work, or run a retention batch or maintenance slice
+            // when one is due.  Both wait for the queue to have been idle a moment first.
+            qint64 llRetentionWaitMS = m_bRetentionWorkPending ? DB_RETENTION_IDLE_WAIT_MS
+                                                               : DB_RETENTION_INTERVAL_MS - m_RetentionTimer.elapsed();
+            qint64 llWaitMS = qMin( llRetentionWaitMS, qMax( m_Maintenance.getWaitMS(), (qint64) DB_RETENTION_IDLE_WAIT_MS ) );
+
+            if ( ( llWaitMS <= 0 ) || !m_PendingRequestCount.tryAcquire( 1, (int) llWaitMS ) )
+            {
+                if ( m_bRetentionWorkPending || ( m_RetentionTimer.elapsed() >= DB_RETENTION_INTERVAL_MS ) )
+                {
+                    m_bRetentionWorkPending = runRetentionBatch();
+                    if ( !m_bRetentionWorkPending )
+                    {
+                        m_RetentionTimer.restart();
+                    }
+                }
+                else
+                {
+                    runMaintenanceSlice();
+                }
+                continue;
+            }
+        }
+
+        int iNumberOfRequests;
+        iC3_DatabaseRequest * pRequest = takeAllRequests( iNumberOfRequests );
+
+        // one count was consumed above, the producers release one per request pushed
+        if ( iNumberOfRequests > 1 )
+        {
+            m_PendingRequestCount.acquire( iNumberOfRequests - 1 );
+        }
+
+        while ( pRequest != NULL )
+        {
+            iC3_DatabaseRequest * pNext = pRequest->getNext();
+
+            if ( pRequest->getRequestType() == eDB_REQUEST_STOP_PROCESSING )
+            {
+                bStopRequested = true;
+            }
+            else
+            {
+                if ( ( pRequest->getRequestType() == eDB_REQUEST_INSERT_TRANSDUCER_SAMPLE ) ||
+                     ( pRequest->getRequestType() == eDB_REQUEST_REPLAY_TRANSDUCER_SAMPLE ) )
+                {
+                    m_TakenSampleTimes.append( pRequest->getTransducerSample().llSampleTimeMS );
+                }
+
+                processRequest( pRequest );
+
+                // committed, spilled or failed unless it is in the open transaction
+                if ( !m_bTransactionOpen )
+                {
+                    settlePendingSamples();
+                }
+            }
+
+            delete pRequest;
+            pRequest = pNext;
+        }
+    }
+
+    commitTransaction();
+    settlePendingSamples();
+    closeConnection();
+}
+
+//-----------------------------------------------------------------------------------------------
+/** openConnection() - opens the processor's connection and creates the tables
+*   @retval true - the database is ready
+*   @retval false - an error occurred, see GetLastError()
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseRequestProcessor::openConnection( void )
+{
+    m_db = QSqlDatabase::addDatabase( "QSQLITE", m_sConnectionName );
+    m_db.setHostName( "localhost" );
+    m_db.setDatabaseName( m_sDatabaseFileName );
+    m_db.setUserName( "root" );
+    m_db.setPassword( "" );
+
+    if ( !m_db.open() )
+    {
+        m_sLastError = QString("Unable to open the database: %1").arg( m_db.lastError().text() );
+        qDebug() << m_sLastError;
+        closeConnection();
+        return false;
+    }
+
+    // lets maintenance return free pages to the file system a few at a time.  It only takes
+    // effect on a new file, before the first table is created; upgradeSchema() converts an
+    // existing one.
+    if ( !execPragma( "PRAGMA auto_vacuum=INCREMENTAL" ) )
+    {
+        closeConnection();
+        return false;
+    }
+
+    // WAL lets readers run alongside the writer and turns each commit into a sequential append.
+    // With synchronous=NORMAL the WAL is only synced at checkpoints: a power loss can drop the
+    // most recent commits but never corrupts the database.
+    if ( !execPragma( "PRAGMA journal_mode=WAL", "wal" ) ||
+         !execPragma( "PRAGMA synchronous=NORMAL" ) ||
+         !execPragma( QString("PRAGMA wal_autocheckpoint=%1").arg( DB_WAL_AUTOCHECKPOINT_PAGES ) ) )
+    {
+        closeConnection();
+        return false;
+    }
+
+    if ( !upgradeSchema() || !m_TransducerTable.CreateTable( m_db ) )
+    {
+        m_sLastError = m_TransducerTable.GetLastError();
+        qDebug() << m_sLastError;
+        closeConnection();
+        return false;
+    }
+
+    if ( !m_TransducerBlockTable.CreateTable( m_db ) )
+    {
+        m_sLastError = m_TransducerBlockTable.GetLastError();
+        qDebug() << m_sLastError;
+        closeConnection();
+        return false;
+    }
+
+    if ( !m_ExportMarkTable.CreateTable( m_db ) )
+    {
+        m_sLastError = m_ExportMarkTable.GetLastError();
+        qDebug() << m_sLastError;
+        closeConnection();
+        return false;
+    }
+
+    if ( !m_StatusJournalTable.CreateTable( m_db ) )
+    {
+        m_sLastError = m_StatusJournalTable.GetLastError();
+        qDebug() << m_sLastError;
+        closeConnection();
+        return false;
+    }
+
+    if ( !m_DeviceEventTable.CreateTable( m_db ) || !m_DeviceEventCountTable.CreateTable( m_db ) )
+    {
+        m_sLastError = m_DeviceEventTable.GetLastError() + m_DeviceEventCountTable.GetLastError();
+        qDebug() << m_sLastError;
+        closeConnection();
+        return false;
+    }
+
+    // the events left active when the process stopped are read back with the first status
+    m_bActiveDeviceEventsLoaded = false;
+
+    for ( int iLevel = 0; iLevel < eTRANSDUCER_ROLLUP_LEVEL_COUNT; iLevel++ )
+    {
+        if ( !m_apRollupTables[iLevel]->CreateTable( m_db ) )
+        {
+            m_sLastError = m_apRollupTables[iLevel]->GetLastError();
+            qDebug() << m_sLastError;
+            closeConnection();
+            return false;
+        }
+    }
+
+    if ( !m_sSegmentStorePath.isEmpty() && !m_SegmentWriter.open( m_sSegmentStorePath ) )
+    {
+        m_sLastError = m_SegmentWriter.GetLastError();
+        closeConnection();
+        return false;
+    }
+
+    // sequence indices are allocated as samples are queued, continuing after the highest stored
+    qint64 llSegmentSequenceIndex = 0;
+
+    if ( !m_TransducerTable.getLastSequenceIndex( m_db, m_llLastSequenceIndex ) )
+    {
+        m_sLastError = m_TransducerTable.GetLastError();
+        closeConnection();
+        return false;
+    }
+
+    if ( !m_SegmentWriter.getLastSequenceIndex( llSegmentSequenceIndex ) )
+    {
+        m_sLastError = m_SegmentWriter.GetLastError();
+        closeConnection();
+        return false;
+    }
+
+    m_llLastSequenceIndex = qMax( m_llLastSequenceIndex, llSegmentSequenceIndex );
+
+    if ( !m_Maintenance.open( m_db ) )
+    {
+        m_sLastError = m_Maintenance.GetLastError();
+        closeConnection();
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** closeConnection() - releases the prepared statements, closes and removes the connection
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseRequestProcessor::closeConnection( void )
+{
+    m_SegmentWriter.close();
+    m_TransducerTable.clearPreparedQueries( m_db );
+    m_TransducerBlockTable.clearPreparedQueries( m_db );
+    m_StatusJournalTable.clearPreparedQueries( m_db );
+    m_DeviceEventTable.clearPreparedQueries( m_db );
+    m_DeviceEventCountTable.clearPreparedQueries( m_db );
+    for ( int iLevel = 0; iLevel < eTRANSDUCER_ROLLUP_LEVEL_COUNT; iLevel++ )
+    {
+        m_apRollupTables[iLevel]->clearPreparedQueries( m_db );
+    }
+    m_db.close();
+    m_db = QSqlDatabase();
+
+    QSqlDatabase::removeDatabase( m_sConnectionName );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** execPragma() - runs a PRAGMA on the processor's connection
+*   @param sPragma - the full PRAGMA statement
+*   @param sExpectedResult - if not empty, the value the PRAGMA must return (case insensitive)
+*   @retval true - the PRAGMA succeeded
+*   @retval false - an error occurred, see GetLastError()
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseRequestProcessor::execPragma( const QString & sPragma, const QString & sExpectedResult )
+{
+    QSqlQuery query( m_db );
+
+    if ( !query.exec( sPragma ) )
+    {
+        m_sLastError = QString("%1 failed: %2").arg( sPragma ).arg( query.lastError().text() );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    if ( !sExpectedResult.isEmpty() )
+    {
+        QString sResult = query.next() ? query.value( 0 ).toString() : QString();
+
+        if ( sResult.compare( sExpectedResult, Qt::CaseInsensitive ) != 0 )
+        {
+            m_sLastError = QString("%1 returned '%2'").arg( sPragma ).arg( sResult );
+            qDebug() << m_sLastError;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** upgradeSchema() - compares PRAGMA user_version with HELMER_DB_SCHEMA_VERSION and, if the
+*                     file is older, has every table convert itself in one transaction.
+*                     Version 2 converts the file to incremental auto_vacuum first, as VACUUM
+*                     cannot run inside a transaction.  If that fails (VACUUM needs about the
+*                     file's size in free space) the file is only brought up to version 1, and
+*                     the conversion is tried again the next time the database is opened.
+*   @retval true - the database is at the current schema version (or is new), or at version 1
+*                  if the conversion failed
+*   @retval false - the upgrade failed and was rolled back, see GetLastError()
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseRequestProcessor::upgradeSchema( void )
+{
+    QSqlQuery query( m_db );
+
+    if ( !query.exec( "PRAGMA user_version" ) || !query.next() )
+    {
+        m_sLastError = QString("Unable to read the schema version: %1").arg( query.lastError().text() );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    int iVersion = query.value( 0 ).toInt();
+    int iNewVersion = HELMER_DB_SCHEMA_VERSION;
+    query.finish();
+
+    if ( ( iVersion < 2 ) && !convertToIncrementalVacuum() )
+    {
+        iNewVersion = 1;
+    }
+
+    if ( iVersion >= iNewVersion )
+    {
+        return true;
+    }
+
+    if ( !m_db.transaction() )
+    {
+        m_sLastError = QString("Unable to begin the schema upgrade: %1").arg( m_db.lastError().text() );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    if ( !m_TransducerTable.upgradeSchema( m_db, iVersion ) ||
+         !m_TransducerTable.CreateTable( m_db ) )
+    {
+        m_sLastError = m_TransducerTable.GetLastError();
+        m_db.rollback();
+        return false;
+    }
+
+    if ( !execPragma( QString("PRAGMA user_version=%1").arg( iNewVersion ) ) || !m_db.commit() )
+    {
+        m_db.rollback();
+        return false;
+    }
+
+    qDebug() << "iC3_DatabaseRequestProcessor - schema upgraded from version" << iVersion << "to" << iNewVersion;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** convertToIncrementalVacuum() - switches a file created without auto_vacuum to INCREMENTAL.
+*                                  The mode of a file that already has tables only changes
+*                                  when VACUUM rebuilds it, which rewrites the whole file once.
+*   @retval true - the file is in incremental auto_vacuum mode
+*   @retval false - the rebuild failed and the file is unchanged, see GetLastError()
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseRequestProcessor::convertToIncrementalVacuum( void )
+{
+    QSqlQuery query( m_db );
+
+    // 2 - INCREMENTAL
+    if ( query.exec( "PRAGMA auto_vacuum" ) && query.next() && ( query.value( 0 ).toInt() == 2 ) )
+    {
+        return true;
+    }
+    query.finish();
+
+    QElapsedTimer vacuumTimer;
+    vacuumTimer.start();
+
+    qDebug() << "iC3_DatabaseRequestProcessor - converting" << m_sDatabaseFileName << "to incremental auto_vacuum";
+
+    if ( !execPragma( "PRAGMA auto_vacuum=INCREMENTAL" ) || !execPragma( "VACUUM" ) ||
+         !execPragma( "PRAGMA auto_vacuum", "2" ) )
+    {
+        qDebug() << "iC3_DatabaseRequestProcessor - auto_vacuum conversion failed, will retry at the next start:" << m_sLastError;
+        return false;
+    }
+
+    qDebug() << "iC3_DatabaseRequestProcessor - auto_vacuum converted in" << vacuumTimer.elapsed() << "ms";
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** insertTransducerSample() - adds a sample to the open transaction, opening one if needed, and
+*                              commits once the row limit is reached.  Success is signalled
+*                              when the transaction commits.  With the segment store the raw
+*                              sample is appended to its device's segment instead, and only
+*                              the rollups go into the transaction; the segment is flushed as
+*                              the transaction commits.
+*
+*                              A sample replayed from the spill journal that is already in the
+*                              Transducers table is left as it is, and not counted again in the
+*                              rollups.  The segment store cannot tell, so a replay repeated
+*                              after a crash can store a sample twice there.
+*   @param pRequest - the insert or replay request
+*   @retval true - the sample was inserted (not yet committed)
+*   @retval false - the insert failed, see m_sLastError
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseRequestProcessor::insertTransducerSample( iC3_DatabaseRequest * pRequest )
+{
+    iC3_TransducerSample sample = pRequest->getTransducerSample();
+    bool bReplay = ( pRequest->getRequestType() == eDB_REQUEST_REPLAY_TRANSDUCER_SAMPLE );
+    bool bInserted = true;
+
+    beginTransaction();
+
+    if ( m_SegmentWriter.isOpen() )
+    {
+        if ( !m_SegmentWriter.append( sample ) )
+        {
+            m_sLastError = m_SegmentWriter.GetLastError();
+            return false;
+        }
+    }
+    else if ( bReplay )
+    {
+        if ( !m_TransducerTable.insertReplayedEntry( m_db, sample, bInserted ) )
+        {
+            m_sLastError = m_TransducerTable.GetLastError();
+            return false;
+        }
+    }
+    else if ( !m_TransducerTable.insertNewEntry( m_db, sample ) )
+    {
+        m_sLastError = m_TransducerTable.GetLastError();
+        return false;
+    }
+
+    if ( bInserted && !addSampleToRollups( sample ) )
+    {
+        if ( !m_bTransactionOpen )
+        {
+            return false;
+        }
+
+        // the row is in the transaction but its rollups are not - the whole group goes back,
+        // this sample included, as if the commit had failed
+        UncommittedWrite write;
+        write.uiTransactionID = pRequest->getTransactionID();
+        write.bSpillOnFailure = !bReplay;
+        write.Sample = sample;
+        m_uncommittedWrites.append( write );
+
+        m_bTransactionOpen = false;
+        rollBackTransaction( m_sLastError );
+        return true;
+    }
+
+    if ( !m_bTransactionOpen )
+    {
+        // could not open a transaction - the insert was committed on its own
+        if ( !flushRollups() )
+        {
+            return false;
+        }
+        if ( m_SegmentWriter.isOpen() && !m_SegmentWriter.flush() )
+        {
+            m_sLastError = m_SegmentWriter.GetLastError();
+            return false;
+        }
+        emit signalSuccess( pRequest->getTransactionID() );
+        return true;
+    }
+
+    // a replay that fails stays in the journal, so only live samples are spilled
+    addToTransaction( pRequest->getTransactionID(), bReplay ? NULL : &sample );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** journalDeviceStatus() - adds the fields of a status poll that changed since the device's
+*                           previous poll to the open transaction, or all of them when a
+*                           keyframe is due, and records the door openings and alarms it starts
+*                           or ends.  Success is signalled when the transaction commits.
+*   @param pRequest - the insert request
+*   @retval true - the changes were written (not yet committed)
+*   @retval false - the insert failed, see m_sLastError
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseRequestProcessor::journalDeviceStatus( iC3_DatabaseRequest * pRequest )
+{
+    const iC3_DeviceStatus & status = pRequest->getDeviceStatus();
+    const iC3_DeviceStatus * pPreviousStatus = NULL;
+
+    QHash<int, iC3_DeviceStatus>::const_iterator previous = m_JournaledStatus.constFind( status.iDeviceID );
+
+    if ( previous != m_JournaledStatus.constEnd() )
+    {
+        qint64 llSinceKeyframeMS = status.llStatusTimeMS - m_StatusKeyframeTimeMS.value( status.iDeviceID );
+
+        // a clock set back also starts a new keyframe
+        if ( ( llSinceKeyframeMS >= 0 ) && ( llSinceKeyframeMS < DB_STATUS_KEYFRAME_INTERVAL_MS ) )
+        {
+            pPreviousStatus = &previous.value();
+        }
+    }
+
+    beginTransaction();
+
+    int iRowsWritten;
+
+    if ( !m_StatusJournalTable.journalStatus( m_db, status, pPreviousStatus, iRowsWritten ) )
+    {
+        // some of the changes may have been written - start over from a keyframe
+        m_JournaledStatus.remove( status.iDeviceID );
+        m_sLastError = m_StatusJournalTable.GetLastError();
+        return false;
+    }
+
+    if ( !recordDeviceEvents( status ) )
+    {
+        m_JournaledStatus.remove( status.iDeviceID );
+        return false;
+    }
+
+    if ( pPreviousStatus == NULL )
+    {
+        m_StatusKeyframeTimeMS.insert( status.iDeviceID, status.llStatusTimeMS );
+    }
+    m_JournaledStatus.insert( status.iDeviceID, status );
+
+    if ( !m_bTransactionOpen )
+    {
+        emit signalSuccess( pRequest->getTransactionID() );
+        return true;
+    }
+
+    addToTransaction( pRequest->getTransactionID() );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** recordDeviceEvents() - compares a status poll with each of the device's active events.  A
+*                          door or alarm field that turns active starts an event and counts it
+*                          on the local day it started; one that turns inactive ends the event
+*                          and adds its duration to that day.  A field the poll did not report
+*                          changes nothing.  Written in the open transaction.
+*   @param status - the status just polled
+*   @retval true - the events were written (not yet committed)
+*   @retval false - a write failed, see m_sLastError
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseRequestProcessor::recordDeviceEvents( const iC3_DeviceStatus & status )
+{
+    if ( !m_bActiveDeviceEventsLoaded && !loadActiveDeviceEvents() )
+    {
+        return false;
+    }
+
+    ActiveDeviceEvents & active = m_ActiveDeviceEvents[status.iDeviceID];
+
+    for ( int iEventType = 0; iEventType < eDEVICE_EVENT_TYPE_COUNT; iEventType++ )
+    {
+        const QString & sValue = status.asFields[DEVICE_EVENT_STATUS_FIELDS[iEventType]];
+
+        if ( sValue.isEmpty() )
+        {
+            continue;
+        }
+
+        bool bActive = ( sValue != DEVICE_EVENT_INACTIVE_VALUES[iEventType] );
+        qint64 llStartTimeMS = active.allStartTimeMS[iEventType];
+        bool bRC = true;
+
+        if ( bActive && ( llStartTimeMS == 0 ) )
+        {
+            bRC = m_DeviceEventTable.startEvent( m_db, status.iDeviceID, iEventType, status.llStatusTimeMS ) &&
+                  m_DeviceEventCountTable.addToDay( m_db, status.iDeviceID, iEventType,
+                                                    iC3_DeviceEventCountTable::getDayStartMS( status.llStatusTimeMS ), 1, 0 );
+            if ( bRC )
+            {
+                active.allStartTimeMS[iEventType] = status.llStatusTimeMS;
+            }
+        }
+        else if ( !bActive && ( llStartTimeMS != 0 ) )
+        {
+            qint64 llDurationMS;
+
+            // the duration is counted on the day the event started, with its opening
+            bRC = m_DeviceEventTable.endEvent( m_db, status.iDeviceID, iEventType, llStartTimeMS,
+                                               status.llStatusTimeMS, llDurationMS ) &&
+                  m_DeviceEventCountTable.addToDay( m_db, status.iDeviceID, iEventType,
+                                                    iC3_DeviceEventCountTable::getDayStartMS( llStartTimeMS ), 0, llDurationMS );
+            if ( bRC )
+            {
+                active.allStartTimeMS[iEventType] = 0;
+            }
+        }
+
+        if ( !bRC )
+        {
+            // one of the two writes may have gone in - read the state back before the next poll
+            m_sLastError = m_DeviceEventTable.GetLastError() + m_DeviceEventCountTable.GetLastError();
+            m_bActiveDeviceEventsLoaded = false;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** loadActiveDeviceEvents() - rebuilds m_ActiveDeviceEvents from the events in DeviceEvents
+*                              that have not ended, as this connection sees them
+*   @retval true - the active events were read
+*   @retval false - the query failed, see m_sLastError
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseRequestProcessor::loadActiveDeviceEvents( void )
+{
+    QVector<iC3_DeviceEvent> events;
+
+    m_ActiveDeviceEvents.clear();
+
+    if ( !m_DeviceEventTable.getActiveEvents( m_db, events ) )
+    {
+        m_sLastError = m_DeviceEventTable.GetLastError();
+        return false;
+    }
+
+    for ( int iIndex = 0; iIndex < events.size(); iIndex++ )
+    {
+        const iC3_DeviceEvent & event = events.at( iIndex );
+
+        // a type written by a newer build is skipped
+        if ( ( event.iEventType >= 0 ) && ( event.iEventType < eDEVICE_EVENT_TYPE_COUNT ) )
+        {
+            ActiveDeviceEvents & active = m_ActiveDeviceEvents[event.iDeviceID];
+            active.allStartTimeMS[event.iEventType] = event.llStartTimeMS;
+        }
+    }
+
+    m_bActiveDeviceEventsLoaded = true;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** beginTransaction() - opens the group commit transaction if none is open.  If one cannot be
+*                        opened the caller's writes are committed on their own.
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseRequestProcessor::beginTransaction( void )
+{
+    if ( m_bTransactionOpen )
+    {
+        return;
+    }
+
+    if ( !m_db.transaction() )
+    {
+        qDebug() << "iC3_DatabaseRequestProcessor - unable to begin transaction:" << m_db.lastError().text();
+    }
+    else
+    {
+        m_bTransactionOpen = true;
+        m_TransactionTimer.start();
+    }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** addToTransaction() - records a request written in the open transaction, to be signalled
+*                        when it commits, and commits once either group commit limit is reached
+*   @param uiTransactionID - the request's transaction ID
+*   @param pSpillSample - the sample to spill if the commit fails, NULL for none
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseRequestProcessor::addToTransaction( uint uiTransactionID, const iC3_TransducerSample * pSpillSample )
+{
+    UncommittedWrite write;
+
+    write.uiTransactionID = uiTransactionID;
+    write.bSpillOnFailure = ( pSpillSample != NULL );
+    if ( pSpillSample != NULL )
+    {
+        write.Sample = *pSpillSample;
+    }
+
+    m_uncommittedWrites.append( write );
+
+    if ( ( m_uncommittedWrites.size() >= m_iGroupCommitMaxRows.loadAcquire() ) ||
+         ( m_TransactionTimer.elapsed() >= m_iGroupCommitWindowMS.loadAcquire() ) )
+    {
+        commitTransaction();
+    }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** commitTransaction() - commits the open transaction, if any, and signals the result for every
+*                         insert it contained
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseRequestProcessor::commitTransaction( void )
+{
+    if ( !m_bTransactionOpen )
+    {
+        return;
+    }
+
+    m_bTransactionOpen = false;
+
+    // the rollups of the samples in this transaction commit (or roll back) with them
+    if ( !flushRollups() )
+    {
+        rollBackTransaction( m_sLastError );
+        return;
+    }
+
+    // segment records are not rolled back, but a sample is only reported as stored, and its
+    // rollups kept, once its record has reached the file
+    QString sError;
+
+    QElapsedTimer commitTimer;
+    commitTimer.start();
+
+    if ( m_SegmentWriter.isOpen() && !m_SegmentWriter.flush() )
+    {
+        sError = m_SegmentWriter.GetLastError();
+    }
+    else if ( !m_db.commit() )
+    {
+        sError = QString("iC3_DatabaseRequestProcessor - commit failed: %1").arg( m_db.lastError().text() );
+        qDebug() << sError;
+    }
+
+    // slow commits mean the disk is busy - maintenance backs off until they recover
+    m_Maintenance.recordCommitLatency( commitTimer.elapsed() );
+
+    if ( !sError.isEmpty() )
+    {
+        rollBackTransaction( sError );
+        return;
+    }
+
+    for ( int iIndex = 0; iIndex < m_uncommittedWrites.size(); iIndex++ )
+    {
+        emit signalSuccess( m_uncommittedWrites.at( iIndex ).uiTransactionID );
+    }
+
+    m_uncommittedWrites.clear();
+
+    if ( m_iSpilledSamples > 0 )
+    {
+        qDebug() << "iC3_DatabaseRequestProcessor - writes recovered," << m_iSpilledSamples << "samples were spilled";
+        m_iSpilledSamples = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** rollBackTransaction() - rolls back the transaction that failed to commit, spills the live
+*                           samples it contained and fails every other request in it
+*   @param sError - why the transaction failed, reported with the failed requests
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseRequestProcessor::rollBackTransaction( const QString & sError )
+{
+    m_db.rollback();
+
+    // the journaled changes went with it - every device's next status is a keyframe, and
+    // the active events are read back from what was committed
+    m_JournaledStatus.clear();
+    m_bActiveDeviceEventsLoaded = false;
+
+    // segment records already flushed are kept, so a spilled sample may be stored twice
+    for ( int iIndex = 0; iIndex < m_uncommittedWrites.size(); iIndex++ )
+    {
+        const UncommittedWrite & write = m_uncommittedWrites.at( iIndex );
+
+        if ( write.bSpillOnFailure && spillTransducerSample( write.Sample ) )
+        {
+            emit signalSuccess( write.uiTransactionID );
+        }
+        else
+        {
+            emit signalRequestFailed( write.uiTransactionID, sError );
+        }
+    }
+
+    m_uncommittedWrites.clear();
+}
+
+//-----------------------------------------------------------------------------------------------
+/** settlePendingSamples() - removes the samples taken from the queue from the pending sample
+*                            times.  Called once no transaction is open, so each of them has
+*                            been committed, spilled to the journal or reported as failed.
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseRequestProcessor::settlePendingSamples( void )
+{
+    if ( m_TakenSampleTimes.isEmpty() )
+    {
+        return;
+    }
+
+    QMutexLocker locker( &m_PendingSampleMutex );
+
+    for ( int iIndex = 0; iIndex < m_TakenSampleTimes.size(); iIndex++ )
+    {
+        QMap<qint64, int>::iterator it = m_PendingSampleTimes.find( m_TakenSampleTimes.at( iIndex ) );
+
+        if ( ( it != m_PendingSampleTimes.end() ) && ( --it.value() <= 0 ) )
+        {
+            m_PendingSampleTimes.erase( it );
+        }
+    }
+
+    m_TakenSampleTimes.clear();
+}
+
+//-----------------------------------------------------------------------------------------------
+/** spillTransducerSample() - appends a sample the database could not store to the spill journal
+*   @param sample - the sample, with its sequence index
+*   @retval true - the sample is in the journal and will be replayed.  The first spill is
+*                  logged, and the count once a commit succeeds again.
+*   @retval false - there is no journal, or it refused the sample
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseRequestProcessor::spillTransducerSample( const iC3_TransducerSample & sample )
+{
+    if ( ( m_pSpillJournal == NULL ) || !m_pSpillJournal->append( sample ) )
+    {
+        return false;
+    }
+
+    if ( m_iSpilledSamples++ == 0 )
+    {
+        qDebug() << "iC3_DatabaseRequestProcessor - writes failing, spilling samples starting with" << sample.llSequenceIndex
+                 << "of device" << sample.iDeviceID;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** compactTransducerHistory() - moves every device's raw samples older than the hour containing
+*                                llBeforeTimeMS into TransducerBlocks, one hour per transaction.
+*                                Blocks that already exist are merged with late raw samples.
+*   @param llBeforeTimeMS - samples before the start of this time's hour are compacted
+*   @retval true - compaction finished
+*   @retval false - an error occurred, see GetLastError().  Blocks already written are kept.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseRequestProcessor::compactTransducerHistory( qint64 llBeforeTimeMS )
+{
+    qint64 llCutoffMS = iC3_TransducerBlockTable::getBlockStartMS( llBeforeTimeMS );
+    int iDeviceID = -1;
+    bool bFound = true;
+
+    // compaction runs its own transactions
+    commitTransaction();
+
+    while ( true )
+    {
+        if ( !m_TransducerTable.getNextDeviceID( m_db, iDeviceID, iDeviceID, bFound ) )
+        {
+            m_sLastError = m_TransducerTable.GetLastError();
+            return false;
+        }
+
+        if ( !bFound )
+        {
+            break;
+        }
+
+        while ( true )
+        {
+            QVector<iC3_TransducerSample> oldest;
+
+            if ( !m_TransducerTable.getEntriesInRange( m_db, iDeviceID, std::numeric_limits<qint64>::min(), llCutoffMS, 1, oldest ) )
+            {
+                m_sLastError = m_TransducerTable.GetLastError();
+                return false;
+            }
+
+            if ( oldest.isEmpty() )
+            {
+                break;
+            }
+
+            if ( !compactTransducerBlock( iDeviceID, iC3_TransducerBlockTable::getBlockStartMS( oldest.at( 0 ).llSampleTimeMS ) ) )
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** compactTransducerBlock() - packs one device-hour of raw samples (plus any existing block for
+*                              that hour) into a block and deletes the raw rows, atomically
+*   @param iDeviceID - the device
+*   @param llBlockStartMS - the hour boundary
+*   @retval true - the block was written and the raw rows removed
+*   @retval false - an error occurred and the transaction was rolled back, see GetLastError()
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseRequestProcessor::compactTransducerBlock( int iDeviceID, qint64 llBlockStartMS )
+{
+    qint64 llBlockEndMS = llBlockStartMS + TRANSDUCER_BLOCK_DURATION_MS;
+    QVector<iC3_TransducerSample> samples;
+
+    if ( !m_db.transaction() )
+    {
+        m_sLastError = QString("Unable to begin compaction: %1").arg( m_db.lastError().text() );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    bool bRC = m_TransducerBlockTable.readBlock( m_db, iDeviceID, llBlockStartMS, samples );
+    if ( bRC )
+    {
+        bool bMerging = !samples.isEmpty();
+
+        bRC = m_TransducerTable.getEntriesInRange( m_db, iDeviceID, llBlockStartMS, llBlockEndMS,
+                                                   std::numeric_limits<int>::max(), samples );
+        if ( bRC && bMerging )
+        {
+            std::stable_sort( samples.begin(), samples.end(), sampleTimeLessThan );
+        }
+    }
+
+    bRC = bRC &&
+          m_TransducerBlockTable.writeBlock( m_db, iDeviceID, llBlockStartMS, samples ) &&
+          m_TransducerTable.deleteEntriesInRange( m_db, iDeviceID, llBlockStartMS, llBlockEndMS );
+
+    if ( !bRC || !m_db.commit() )
+    {
+        m_sLastError = m_TransducerBlockTable.GetLastError();
+        if ( m_sLastError.isEmpty() )
+        {
+            m_sLastError = m_TransducerTable.GetLastError();
+        }
+        if ( m_sLastError.isEmpty() )
+        {
+            m_sLastError = QString("Compaction commit failed: %1").arg( m_db.lastError().text() );
+        }
+        qDebug() << m_sLastError;
+        m_db.rollback();
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** addSampleToRollups() - accumulates an inserted sample into each level's pending bucket for
+*                          its device.  A sample for a different bucket writes the pending one
+*                          out first.
+*   @param sample - the sample just inserted
+*   @retval true - the sample is accounted for in every level
+*   @retval false - writing out a bucket failed, see m_sLastError.  Every pending bucket is
+*                   dropped; the transaction they belong to must be rolled back.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseRequestProcessor::addSampleToRollups( const iC3_TransducerSample & sample )
+{
+    for ( int iLevel = 0; iLevel < eTRANSDUCER_ROLLUP_LEVEL_COUNT; iLevel++ )
+    {
+        iC3_TransducerRollupTable * pTable = m_apRollupTables[iLevel];
+        qint64 llBucketStartMS = pTable->getBucketStartMS( sample.llSampleTimeMS );
+
+        QHash<int, iC3_TransducerRollup>::iterator it = m_aPendingRollups[iLevel].find( sample.iDeviceID );
+
+        if ( it == m_aPendingRollups[iLevel].end() )
+        {
+            iC3_TransducerRollup rollup;
+            iC3_TransducerRollupTable::clearRollup( rollup, sample.iDeviceID, llBucketStartMS );
+            it = m_aPendingRollups[iLevel].insert( sample.iDeviceID, rollup );
+        }
+        else if ( it.value().llBucketStartMS != llBucketStartMS )
+        {
+            if ( !pTable->mergeIntoTable( m_db, it.value() ) )
+            {
+                m_sLastError = pTable->GetLastError();
+                clearPendingRollups();
+                return false;
+            }
+            iC3_TransducerRollupTable::clearRollup( it.value(), sample.iDeviceID, llBucketStartMS );
+        }
+
+        iC3_TransducerRollupTable::addSample( it.value(), sample );
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** flushRollups() - merges every pending bucket into its rollup table and empties it.  Called
+*                    inside the open transaction just before it commits.
+*   @retval true - every bucket was merged
+*   @retval false - a merge failed, see m_sLastError.  Every pending bucket is dropped; the
+*                   transaction they belong to must be rolled back.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseRequestProcessor::flushRollups( void )
+{
+    for ( int iLevel = 0; iLevel < eTRANSDUCER_ROLLUP_LEVEL_COUNT; iLevel++ )
+    {
+        QHash<int, iC3_TransducerRollup>::iterator it;
+
+        for ( it = m_aPendingRollups[iLevel].begin(); it != m_aPendingRollups[iLevel].end(); ++it )
+        {
+            if ( it.value().iSampleCount > 0 )
+            {
+                if ( !m_apRollupTables[iLevel]->mergeIntoTable( m_db, it.value() ) )
+                {
+                    m_sLastError = m_apRollupTables[iLevel]->GetLastError();
+                    clearPendingRollups();
+                    return false;
+                }
+                iC3_TransducerRollupTable::clearRollup( it.value(), it.value().iDeviceID, it.value().llBucketStartMS );
+            }
+        }
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** clearPendingRollups() - drops every pending bucket without writing it.  The samples in them
+*                           are rolled back with their transaction, and spilled samples are
+*                           counted again when they are replayed.
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseRequestProcessor::clearPendingRollups( void )
+{
+    for ( int iLevel = 0; iLevel < eTRANSDUCER_ROLLUP_LEVEL_COUNT; iLevel++ )
+    {
+        m_aPendingRollups[iLevel].clear();
+    }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** runRetentionBatch() - performs one bounded step of retention: archives one expired
+*                         device-hour of raw samples into blocks (or deletes up to
+*                         DB_RETENTION_BATCH_ROWS of them), or deletes up to
+*                         DB_RETENTION_BATCH_ROWS expired 1 minute rollups.  A failure is
+*                         reported through signalMaintenanceSlice() as eDB_MAINTENANCE_RETENTION
+*                         and retried at the next retention interval.
+*   @retval true - there may be more expired data, call again when idle
+*   @retval false - nothing left to do until the next retention interval
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseRequestProcessor::runRetentionBatch( void )
+{
+    qint64 llNowMS = QDateTime::currentMSecsSinceEpoch();
+    bool bMoreWork = false;
+
+    QElapsedTimer batchTimer;
+    batchTimer.start();
+
+    bool bRC = expireRawSamples( llNowMS, bMoreWork );
+
+    if ( bRC && !bMoreWork )
+    {
+        bRC = expireMinuteRollups( llNowMS, bMoreWork );
+    }
+
+    if ( !bRC )
+    {
+        qDebug() << "iC3_DatabaseRequestProcessor - retention failed:" << m_sLastError;
+        emit signalMaintenanceSlice( eDB_MAINTENANCE_RETENTION, batchTimer.elapsed(), false, m_sLastError );
+        return false;
+    }
+
+    return bMoreWork;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** expireRawSamples() - archives the oldest expired device-hour of raw samples into a block, or
+*                        deletes up to DB_RETENTION_BATCH_ROWS expired samples, device by device
+*                        through the (deviceID, sampleTimeMS) index
+*   @param llNowMS - the current time
+*   @param bMoreWork - set when the batch was used up and more may have expired
+*   @retval true - the batch ran
+*   @retval false - an error occurred, see m_sLastError
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseRequestProcessor::expireRawSamples( qint64 llNowMS, bool & bMoreWork )
+{
+    const qint64 llHourMS = Q_INT64_C(60) * 60 * 1000;
+    int iRawRetentionHours = m_iRawRetentionHours.loadAcquire();
+    bool bArchive = ( m_bArchiveRawData.loadAcquire() != 0 );
+    int iRemainingRows = DB_RETENTION_BATCH_ROWS;
+    int iDeviceID = -1;
+    bool bFound = true;
+
+    bMoreWork = false;
+
+    if ( iRawRetentionHours <= 0 )
+    {
+        return true;
+    }
+
+    qint64 llCutoffMS = llNowMS - iRawRetentionHours * llHourMS;
+
+    if ( bArchive )
+    {
+        // archive whole device-hours only
+        llCutoffMS = iC3_TransducerBlockTable::getBlockStartMS( llCutoffMS );
+    }
+
+    while ( true )
+    {
+        if ( !m_TransducerTable.getNextDeviceID( m_db, iDeviceID, iDeviceID, bFound ) )
+        {
+            m_sLastError = m_TransducerTable.GetLastError();
+            return false;
+        }
+
+        if ( !bFound )
+        {
+            break;
+        }
+
+        if ( bArchive )
+        {
+            QVector<iC3_TransducerSample> oldest;
+
+            if ( !m_TransducerTable.getEntriesInRange( m_db, iDeviceID, std::numeric_limits<qint64>::min(), llCutoffMS, 1, oldest ) )
+            {
+                m_sLastError = m_TransducerTable.GetLastError();
+                return false;
+            }
+
+            if ( !oldest.isEmpty() )
+            {
+                bMoreWork = true;
+                return compactTransducerBlock( iDeviceID, iC3_TransducerBlockTable::getBlockStartMS( oldest.at( 0 ).llSampleTimeMS ) );
+            }
+        }
+        else
+        {
+            int iDeleted = 0;
+
+            if ( !m_TransducerTable.deleteEntriesBefore( m_db, iDeviceID, llCutoffMS, iRemainingRows, iDeleted ) )
+            {
+                m_sLastError = m_TransducerTable.GetLastError();
+                return false;
+            }
+
+            iRemainingRows -= iDeleted;
+            if ( iRemainingRows <= 0 )
+            {
+                bMoreWork = true;
+                return true;
+            }
+        }
+    }
+
+    // whole files, each no more than a day; archiving keeps them, as they are already
+    // about as compact as a block
+    if ( !bArchive && m_SegmentWriter.isOpen() )
+    {
+        int iDeleted = 0;
+
+        if ( !m_SegmentWriter.deleteSegmentsBefore( llCutoffMS, iDeleted ) )
+        {
+            m_sLastError = m_SegmentWriter.GetLastError();
+            return false;
+        }
+
+        if ( iDeleted > 0 )
+        {
+            qDebug() << "iC3_DatabaseRequestProcessor - deleted" << iDeleted << "expired transducer segments";
+        }
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** expireMinuteRollups() - deletes up to DB_RETENTION_BATCH_ROWS expired 1 minute rollups
+*   @param llNowMS - the current time
+*   @param bMoreWork - set when the batch was used up and more may have expired
+*   @retval true - the batch ran
+*   @retval false - an error occurred, see m_sLastError
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseRequestProcessor::expireMinuteRollups( qint64 llNowMS, bool & bMoreWork )
+{
+    const qint64 llHourMS = Q_INT64_C(60) * 60 * 1000;
+    int iRollupRetentionHours = m_iMinuteRollupRetentionHours.loadAcquire();
+    int iDeleted = 0;
+
+    bMoreWork = false;
+
+    if ( iRollupRetentionHours <= 0 )
+    {
+        return true;
+    }
+
+    if ( !m_MinuteRollupTable.deleteRollupsBefore( m_db, llNowMS - iRollupRetentionHours * llHourMS, DB_RETENTION_BATCH_ROWS, iDeleted ) )
+    {
+        m_sLastError = m_MinuteRollupTable.GetLastError();
+        return false;
+    }
+
+    bMoreWork = ( iDeleted >= DB_RETENTION_BATCH_ROWS );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** runMaintenanceSlice() - runs the maintenance task that is due and reports it through
+*                           signalMaintenanceSlice()
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseRequestProcessor::runMaintenanceSlice( void )
+{
+    eDatabaseMaintenanceTasks eTask;
+    qint64 llElapsedMS;
+    QString sResult;
+
+    bool bRC = m_Maintenance.runSlice( m_db, eTask, llElapsedMS, sResult );
+
+    if ( eTask == eDB_MAINTENANCE_NONE )
+    {
+        return;
+    }
+
+    emit signalMaintenanceSlice( eTask, llElapsedMS, bRC, bRC ? sResult : m_Maintenance.GetLastError() );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** takeAllRequests() - atomically takes every pending request and returns them oldest first
+*   @param iNumberOfRequests - set to the number of requests returned
+*   @retval pointer to the first request in the list, NULL if nothing was pending
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_DatabaseRequest * iC3_DatabaseRequestProcessor::takeAllRequests( int & iNumberOfRequests )
+{
+    iC3_DatabaseRequest * pNewestFirst = m_pPendingRequests.fetchAndStoreAcquire( NULL );
+    iC3_DatabaseRequest * pOldestFirst = NULL;
+
+    iNumberOfRequests = 0;
+
+    while ( pNewestFirst != NULL )
+    {
+        iC3_DatabaseRequest * pNext = pNewestFirst->getNext();
+        pNewestFirst->setNext( pOldestFirst );
+        pOldestFirst = pNewestFirst;
+        pNewestFirst = pNext;
+        iNumberOfRequests++;
+    }
+
+    return pOldestFirst;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** processRequest() - executes one request and signals the result
+*   @param pRequest - the request to execute
+*   @retval true - the request succeeded
+*   @retval false - the request failed, signalRequestFailed() was emitted
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseRequestProcessor::processRequest( iC3_DatabaseRequest * pRequest )
+{
+    bool bRC = false;
+    uint uiTransactionID = pRequest->getTransactionID();
+
+    switch ( pRequest->getRequestType() )
+    {
+    case eDB_REQUEST_INSERT_TRANSDUCER_SAMPLE:
+        bRC = insertTransducerSample( pRequest );
+        if ( !bRC )
+        {
+            if ( spillTransducerSample( pRequest->getTransducerSample() ) )
+            {
+                emit signalSuccess( uiTransactionID );
+                return true;
+            }
+            emit signalRequestFailed( uiTransactionID, m_sLastError );
+            return false;
+        }
+        break;
+
+    case eDB_REQUEST_REPLAY_TRANSDUCER_SAMPLE:
+        bRC = insertTransducerSample( pRequest );
+        if ( !bRC )
+        {
+            emit signalRequestFailed( uiTransactionID, m_sLastError );
+            return false;
+        }
+        break;
+
+    case eDB_REQUEST_INSERT_DEVICE_STATUS:
+        bRC = journalDeviceStatus( pRequest );
+        if ( !bRC )
+        {
+            emit signalRequestFailed( uiTransactionID, m_sLastError );
+            return false;
+        }
+        break;
+
+    case eDB_REQUEST_COMPACT_TRANSDUCER_HISTORY:
+        bRC = compactTransducerHistory( pRequest->getEndTimeMS() );
+        if ( bRC )
+        {
+            emit signalSuccess( uiTransactionID );
+        }
+        else
+        {
+            emit signalRequestFailed( uiTransactionID, m_sLastError );
+            return false;
+        }
+        break;
+
+    default:
+        emit signalRequestFailed( uiTransactionID, QString("iC3_DatabaseRequestProcessor - unsupported request type %1").arg( pRequest->getRequestType() ) );
+        return false;
+    }
+
+    return bRC;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** deleteRequests() - deletes a list of requests that will not be executed
+*   @param pRequest - first request in the list
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseRequestProcessor::deleteRequests( iC3_DatabaseRequest * pRequest )
+{
+    while ( pRequest != NULL )
+    {
+        iC3_DatabaseRequest * pNext = pRequest->getNext();
+        delete pRequest;
+        pRequest = pNext;
+    }
+}
@@ -0,0 +1,212 @@
+#ifndef IC3_DATABASEREQUESTPROCESSOR_H
+#define IC3_DATABASEREQUESTPROCESSOR_H
+
+/**
+*     @file iC3_DatabaseRequestProcessor.h
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief This header file defines the iC3_DatabaseRequestProcessor class.  The processor
+*            is the only thread that writes the transducer tables; reads run on connections of
+*            their own (iC3_DatabaseConnectionPool, exports).  It owns the writer connection and
+*            executes the requests queued by iC3_Database in the order they were queued,
+*            reporting results back through signals.
+*/
+
+#include <QThread>
+#include <QAtomicPointer>
+#include <QAtomicInt>
+#include <QSemaphore>
+#include <QSqlDatabase>
+#include <QElapsedTimer>
+#include <QVector>
+#include <QHash>
+#include <QMap>
+#include <QMutex>
+
+#include "iC3_DatabaseRequest.h"
+#include "iC3_TransducerTable.h"
+#include "iC3_TransducerBlockTable.h"
+#include "iC3_TransducerRollupTable.h"
+#include "iC3_ExportMarkTable.h"
+#include "iC3_StatusJournalTable.h"
+#include "iC3_DeviceEventTable.h"
+#include "iC3_DeviceEventCountTable.h"
+#include "iC3_TransducerSegmentWriter.h"
+#include "iC3_DatabaseMaintenance.h"
+#include "iC3_TransducerSpillJournal.h"
+
+// Inserts are grouped into one transaction that is committed when either limit is reached, so
+// at most DB_GROUP_COMMIT_WINDOW_MS worth of samples is lost if the process dies.
+static const int DB_GROUP_COMMIT_WINDOW_MS      = 250;
+static const int DB_GROUP_COMMIT_MAX_ROWS       = 500;
+
+// WAL pages written before SQLite checkpoints back into the main database file
+static const int DB_WAL_AUTOCHECKPOINT_PAGES    = 1000;
+
+// Retention runs in small batches, each its own transaction, only after the queue has been idle
+// for DB_RETENTION_IDLE_WAIT_MS, so queued writes never wait behind more than one batch.
+static const int DB_RETENTION_INTERVAL_MS           = 60 * 1000;
+static const int DB_RETENTION_IDLE_WAIT_MS          = 20;
+static const int DB_RETENTION_BATCH_ROWS            = 500;
+static const int DB_RAW_RETENTION_HOURS             = 90 * 24;      // 0 keeps raw samples forever
+static const int DB_MINUTE_ROLLUP_RETENTION_HOURS   = 400 * 24;     // 0 keeps 1 minute rollups forever
+static const bool DB_ARCHIVE_EXPIRED_RAW_DATA       = true;         // compact into blocks instead of deleting
+
+// the StatusJournal writes every field of a device's status this often, and otherwise only the
+// fields that changed, so rebuilding the status at a time reads at most this much journal
+static const qint64 DB_STATUS_KEYFRAME_INTERVAL_MS  = 60 * 60 * 1000;
+
+class iC3_DatabaseRequestProcessor : public QThread
+{
+    Q_OBJECT
+public:
+    explicit iC3_DatabaseRequestProcessor(QObject *parent = 0);
+    ~iC3_DatabaseRequestProcessor();
+
+    bool startProcessingDbRequests( const QString & sDatabaseFileName,
+                                    const QString & sConnectionName,
+                                    const QString & sSegmentStorePath = QString() );
+    void stopProcessingDbRequests( void );
+
+    bool AddRequestToQueue( iC3_DatabaseRequest * pRequest );
+
+    void setGroupCommitLimits( int iWindowMS, int iMaxRows );
+    void setRetentionLimits( int iRawRetentionHours, int iMinuteRollupRetentionHours, bool bArchiveRawData );
+    void setSpillJournal( iC3_TransducerSpillJournal * pSpillJournal );
+
+    qint64 getLastSequenceIndex( void ) const;
+    qint64 getOldestPendingSampleTimeMS( void );
+    QString GetLastError( void );
+
+signals:
+
+    void signalSuccess( uint uiTransactionID );
+    void signalRequestFailed( uint uiTransactionID, QString sErrorMessage );
+    void signalMaintenanceSlice( int iTask, qint64 llElapsedMS, bool bSucceeded, QString sResult );
+
+protected:
+
+    void run();
+
+private:
+
+    bool openConnection( void );
+    void closeConnection( void );
+    bool execPragma( const QString & sPragma, const QString & sExpectedResult = QString() );
+    bool upgradeSchema( void );
+    bool convertToIncrementalVacuum( void );
+
+    bool insertTransducerSample( iC3_DatabaseRequest * pRequest );
+    bool journalDeviceStatus( iC3_DatabaseRequest * pRequest );
+    bool recordDeviceEvents( const iC3_DeviceStatus & status );
+    bool loadActiveDeviceEvents( void );
+    void beginTransaction( void );
+    void addToTransaction( uint uiTransactionID, const iC3_TransducerSample * pSpillSample = NULL );
+    bool spillTransducerSample( const iC3_TransducerSample & sample );
+    void commitTransaction( void );
+    void rollBackTransaction( const QString & sError );
+    void settlePendingSamples( void );
+
+    bool compactTransducerHistory( qint64 llBeforeTimeMS );
+    bool compactTransducerBlock( int iDeviceID, qint64 llBlockStartMS );
+
+    bool addSampleToRollups( const iC3_TransducerSample & sample );
+    bool flushRollups( void );
+    void clearPendingRollups( void );
+    bool runRetentionBatch( void );
+    bool expireRawSamples( qint64 llNowMS, bool & bMoreWork );
+    bool expireMinuteRollups( qint64 llNowMS, bool & bMoreWork );
+    void runMaintenanceSlice( void );
+
+    iC3_DatabaseRequest * takeAllRequests( int & iNumberOfRequests );
+    bool processRequest( iC3_DatabaseRequest * pRequest );
+    void deleteRequests( iC3_DatabaseRequest * pRequest );
+
+    QString m_sDatabaseFileName;
+    QString m_sConnectionName;
+    QString m_sSegmentStorePath;                    // empty: raw samples go to the Transducers table
+    QString m_sLastError;
+
+    QSqlDatabase m_db;
+    iC3_TransducerTable m_TransducerTable;
+    iC3_TransducerBlockTable m_TransducerBlockTable;
+    iC3_TransducerRollupTable m_MinuteRollupTable;
+    iC3_TransducerRollupTable m_HourRollupTable;
+    iC3_TransducerRollupTable * m_apRollupTables[eTRANSDUCER_ROLLUP_LEVEL_COUNT];
+    iC3_ExportMarkTable m_ExportMarkTable;         // created here, used by iC3_TransducerCSV_Exporter
+    iC3_StatusJournalTable m_StatusJournalTable;
+    iC3_DeviceEventTable m_DeviceEventTable;
+    iC3_DeviceEventCountTable m_DeviceEventCountTable;
+    iC3_TransducerSegmentWriter m_SegmentWriter;
+    iC3_TransducerSpillJournal * m_pSpillJournal;   // not owned; NULL: failed inserts are only reported
+    int m_iSpilledSamples;                          // since the last successful commit
+
+    // producers push onto this list without locking, the processor takes the whole list at once
+    QAtomicPointer<iC3_DatabaseRequest> m_pPendingRequests;
+    QSemaphore m_PendingRequestCount;
+    QAtomicInt m_bAcceptingRequests;
+
+    QSemaphore m_StartupComplete;
+    bool m_bStartupSucceeded;
+    qint64 m_llLastSequenceIndex;                   // highest stored at startup
+
+    // times of the transducer samples queued or in the open transaction, counted per time.  A
+    // sample is settled once it is committed, spilled or has failed; until then an incremental
+    // export must not move its mark past it.
+    QMap<qint64, int> m_PendingSampleTimes;
+    QMutex m_PendingSampleMutex;                    // guards m_PendingSampleTimes
+    QVector<qint64> m_TakenSampleTimes;             // taken from the queue, processor thread only
+
+    // group commit - limits may be changed from any thread, the rest is processor thread only
+    QAtomicInt m_iGroupCommitWindowMS;
+    QAtomicInt m_iGroupCommitMaxRows;
+    bool m_bTransactionOpen;
+    QElapsedTimer m_TransactionTimer;
+
+    // the requests written in the open transaction.  A live transducer sample that the commit
+    // loses is spilled to the journal and still reported as stored.
+    struct UncommittedWrite
+    {
+        uint uiTransactionID;
+        bool bSpillOnFailure;
+        iC3_TransducerSample Sample;                // set when bSpillOnFailure
+    };
+    QVector<UncommittedWrite> m_uncommittedWrites;
+
+    // rollup buckets accumulated since the last commit, per level and device
+    QHash<int, iC3_TransducerRollup> m_aPendingRollups[eTRANSDUCER_ROLLUP_LEVEL_COUNT];
+
+    // each device's last journaled status and the time of its last keyframe; a device missing
+    // here gets a keyframe next
+    QHash<int, iC3_DeviceStatus> m_JournaledStatus;
+    QHash<int, qint64> m_StatusKeyframeTimeMS;
+
+    // the start time of each device's active events, 0 where none is active.  Reloaded from
+    // DeviceEvents when a rollback or failed write may have left it out of step with the table.
+    struct ActiveDeviceEvents
+    {
+        ActiveDeviceEvents()
+        {
+            for ( int iEventType = 0; iEventType < eDEVICE_EVENT_TYPE_COUNT; iEventType++ )
+            {
+                allStartTimeMS[iEventType] = 0;
+            }
+        }
+
+        qint64 allStartTimeMS[eDEVICE_EVENT_TYPE_COUNT];
+    };
+    QHash<int, ActiveDeviceEvents> m_ActiveDeviceEvents;
+    bool m_bActiveDeviceEventsLoaded;
+
+    // retention - limits may be changed from any thread
+    QAtomicInt m_iRawRetentionHours;
+    QAtomicInt m_iMinuteRollupRetentionHours;
+    QAtomicInt m_bArchiveRawData;
+    QElapsedTimer m_RetentionTimer;
+    bool m_bRetentionWorkPending;
+
+    // checkpoints, vacuum and integrity checks, run in the idle time retention leaves
+    iC3_DatabaseMaintenance m_Maintenance;
+};
+
+#endif // IC3_DATABASEREQUESTPROCESSOR_H
@@ -0,0 +1,66 @@
+#ifndef IC3_DATABASESCHEMA_H
+#define IC3_DATABASESCHEMA_H
+
+/**
+*     @file iC3_DatabaseSchema.h
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief This header file defines the macros that turn a table's column list into its
+*            column enum, its CREATE / INSERT / SELECT statements and the code that binds a row
+*            struct to a statement or fills one in from a query.
+*
+*            A table declares its columns once, in its header, as a list macro taking two
+*            macro names: FIRST is applied to the first column and NEXT to every other one.
+*
+*                #define EXAMPLE_TABLE_COLUMNS( FIRST, NEXT ) \
+*                    FIRST( e_EXAMPLE_ID_COL,   exampleID, "INTEGER", "PRIMARY KEY", llID,   toLongLong ) \
+*                    NEXT(  e_EXAMPLE_NAME_COL, name,      "TEXT",    "",            sName,  toString )
+*
+*            Each entry is ( column enum, column name, SQL type, constraints, row struct
+*            field, QVariant conversion ).  Entries must be in column enum order.  All of the
+*            SQL comes out as string literals joined by the compiler, so nothing is built at
+*            run time, and the column list, the statements and the row mapping cannot drift
+*            apart.
+*/
+
+// column enum - enum { EXAMPLE_TABLE_COLUMNS( IC3_SCHEMA_ENUM, IC3_SCHEMA_ENUM ) e_NUMBER_OF... };
+#define IC3_SCHEMA_ENUM( COL, NAME, TYPE, CONSTRAINTS, FIELD, TO )              COL,
+
+#define IC3_SCHEMA_FIRST_NAME( COL, NAME, TYPE, CONSTRAINTS, FIELD, TO )        #NAME
+#define IC3_SCHEMA_NEXT_NAME( COL, NAME, TYPE, CONSTRAINTS, FIELD, TO )         ", " #NAME
+
+#define IC3_SCHEMA_FIRST_DEFINITION( COL, NAME, TYPE, CONSTRAINTS, FIELD, TO )  #NAME " " TYPE " " CONSTRAINTS
+#define IC3_SCHEMA_NEXT_DEFINITION( COL, NAME, TYPE, CONSTRAINTS, FIELD, TO )   ", " #NAME " " TYPE " " CONSTRAINTS
+
+#define IC3_SCHEMA_FIRST_PLACEHOLDER( COL, NAME, TYPE, CONSTRAINTS, FIELD, TO ) "?"
+#define IC3_SCHEMA_NEXT_PLACEHOLDER( COL, NAME, TYPE, CONSTRAINTS, FIELD, TO )  ", ?"
+
+// expanded inside a function with "QSqlQuery * pQuery" and the row struct "row" in scope.
+// Values are bound by column enum, so the statement must list the columns in enum order.
+#define IC3_SCHEMA_BIND( COL, NAME, TYPE, CONSTRAINTS, FIELD, TO )              pQuery->bindValue( COL, row.FIELD );
+
+// expanded inside a function with "QSqlQuery & query", positioned on a row selected with
+// IC3_SCHEMA_SELECT_SQL(), and the row struct "row" in scope
+#define IC3_SCHEMA_READ( COL, NAME, TYPE, CONSTRAINTS, FIELD, TO )              row.FIELD = query.value( COL ).TO();
+
+// "name, name, ..."
+#define IC3_SCHEMA_COLUMN_NAMES( COLUMNS ) \
+    COLUMNS( IC3_SCHEMA_FIRST_NAME, IC3_SCHEMA_NEXT_NAME )
+
+#define IC3_SCHEMA_CREATE_SQL( TABLE, COLUMNS ) \
+    "CREATE TABLE IF NOT EXISTS " TABLE " ( " COLUMNS( IC3_SCHEMA_FIRST_DEFINITION, IC3_SCHEMA_NEXT_DEFINITION ) " );"
+
+#define IC3_SCHEMA_INSERT_SQL( TABLE, COLUMNS ) \
+    "INSERT INTO " TABLE " ( " IC3_SCHEMA_COLUMN_NAMES( COLUMNS ) " ) " \
+    "VALUES ( " COLUMNS( IC3_SCHEMA_FIRST_PLACEHOLDER, IC3_SCHEMA_NEXT_PLACEHOLDER ) " )"
+
+// the same, leaving the existing row in place when the key is already taken
+#define IC3_SCHEMA_INSERT_OR_IGNORE_SQL( TABLE, COLUMNS ) \
+    "INSERT OR IGNORE INTO " TABLE " ( " IC3_SCHEMA_COLUMN_NAMES( COLUMNS ) " ) " \
+    "VALUES ( " COLUMNS( IC3_SCHEMA_FIRST_PLACEHOLDER, IC3_SCHEMA_NEXT_PLACEHOLDER ) " )"
+
+// every column, in enum order, so IC3_SCHEMA_READ can index the result by column enum
+#define IC3_SCHEMA_SELECT_SQL( TABLE, COLUMNS ) \
+    "SELECT " IC3_SCHEMA_COLUMN_NAMES( COLUMNS ) " FROM " TABLE
+
+#endif // IC3_DATABASESCHEMA_H
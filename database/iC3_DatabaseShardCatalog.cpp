@@ -0,0 +1,347 @@
+/**
+*     @file iC3_DatabaseShardCatalog.cpp
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief this cpp file implements the iC3_DatabaseShardCatalog class.
+*
+*            The catalog is a small SQLite file of its own, opened with the raw API so any
+*            thread can use it under m_Mutex.  Every assignment is read into memory by open(),
+*            so looking a device up costs one hash lookup; only a device's first sample
+*            writes to the file.
+*/
+
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QtAlgorithms>
+
+#include <sqlite3.h>
+
+#include "iC3_DatabaseShardCatalog.h"
+
+static const char SHARD_CATALOG_CREATE_SQL[] =
+    "CREATE TABLE IF NOT EXISTS ShardCatalog ( deviceID INTEGER PRIMARY KEY, shardIndex INTEGER NOT NULL );";
+static const char SHARD_CATALOG_SELECT_SQL[] = "SELECT deviceID, shardIndex FROM ShardCatalog";
+static const char SHARD_CATALOG_INSERT_SQL[] = "INSERT INTO ShardCatalog ( deviceID, shardIndex ) VALUES ( ?, ? )";
+
+//-----------------------------------------------------------------------------------------------
+/** constructor
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_DatabaseShardCatalog::iC3_DatabaseShardCatalog() :
+    m_pCatalog( NULL ),
+    m_pInsertStatement( NULL ),
+    m_iShardCount( 1 )
+{
+}
+
+//-----------------------------------------------------------------------------------------------
+/** destructor
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_DatabaseShardCatalog::~iC3_DatabaseShardCatalog()
+{
+    close();
+}
+
+//-----------------------------------------------------------------------------------------------
+/** open() - opens (creating if needed) the catalog and reads every device's assignment
+*   @param sCatalogFileName - the catalog's SQLite file
+*   @param iShardCount - the number of shards new devices are spread over (at least 1)
+*   @retval true - the catalog is open
+*   @retval false - the file could not be opened or read, or it places a device on a shard at
+*                   or beyond iShardCount.  Use GetLastError() to retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseShardCatalog::open( const QString & sCatalogFileName, int iShardCount )
+{
+    close();
+
+    QMutexLocker locker( &m_Mutex );
+    QByteArray baCatalogFileName = QFile::encodeName( sCatalogFileName );
+
+    m_iShardCount = qMax( iShardCount, 1 );
+    m_DevicesPerShard.fill( 0, m_iShardCount );
+
+    if ( sqlite3_open_v2( baCatalogFileName.constData(), &m_pCatalog, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, NULL ) != SQLITE_OK )
+    {
+        m_sLastError = QString("iC3_DatabaseShardCatalog::open() - Could not open %1: %2")
+                           .arg( sCatalogFileName ).arg( m_pCatalog ? sqlite3_errmsg( m_pCatalog ) : "out of memory" );
+        qDebug() << m_sLastError;
+        sqlite3_close( m_pCatalog );
+        m_pCatalog = NULL;
+        return false;
+    }
+
+    sqlite3_stmt * pSelect = NULL;
+    bool bRC = ( sqlite3_exec( m_pCatalog, SHARD_CATALOG_CREATE_SQL, NULL, NULL, NULL ) == SQLITE_OK ) &&
+               ( sqlite3_prepare_v2( m_pCatalog, SHARD_CATALOG_SELECT_SQL, -1, &pSelect, NULL ) == SQLITE_OK ) &&
+               ( sqlite3_prepare_v2( m_pCatalog, SHARD_CATALOG_INSERT_SQL, -1, &m_pInsertStatement, NULL ) == SQLITE_OK );
+
+    if ( !bRC )
+    {
+        m_sLastError = QString("iC3_DatabaseShardCatalog::open() - Could not read %1: %2")
+                           .arg( sCatalogFileName ).arg( sqlite3_errmsg( m_pCatalog ) );
+    }
+
+    int iStepRC = SQLITE_DONE;
+
+    while ( bRC && ( ( iStepRC = sqlite3_step( pSelect ) ) == SQLITE_ROW ) )
+    {
+        int iDeviceID = sqlite3_column_int( pSelect, 0 );
+        int iShardIndex = sqlite3_column_int( pSelect, 1 );
+
+        // shards can be added but not taken away - the devices' data is still in them
+        if ( ( iShardIndex < 0 ) || ( iShardIndex >= m_iShardCount ) )
+        {
+            m_sLastError = QString("iC3_DatabaseShardCatalog::open() - Device %1 is on shard %2 but only %3 shards are configured")
+                               .arg( iDeviceID ).arg( iShardIndex ).arg( m_iShardCount );
+            bRC = false;
+            break;
+        }
+
+        m_ShardByDevice.insert( iDeviceID, iShardIndex );
+        m_DevicesPerShard[iShardIndex]++;
+    }
+
+    if ( bRC && ( iStepRC != SQLITE_DONE ) )
+    {
+        m_sLastError = QString("iC3_DatabaseShardCatalog::open() - Could not read %1: %2")
+                           .arg( sCatalogFileName ).arg( sqlite3_errmsg( m_pCatalog ) );
+        bRC = false;
+    }
+
+    sqlite3_finalize( pSelect );
+
+    if ( !bRC )
+    {
+        qDebug() << m_sLastError;
+        locker.unlock();
+        close();
+    }
+
+    return bRC;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** close() - closes the catalog file
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseShardCatalog::close( void )
+{
+    QMutexLocker locker( &m_Mutex );
+
+    sqlite3_finalize( m_pInsertStatement );
+    m_pInsertStatement = NULL;
+
+    sqlite3_close( m_pCatalog );
+    m_pCatalog = NULL;
+
+    m_ShardByDevice.clear();
+    m_DevicesPerShard.clear();
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getShardIndex() - returns the shard that holds a device's data.  A device not seen before is
+*                     placed on the shard with the fewest devices (the lowest such shard on a
+*                     tie), and the placement is written to the catalog before it is returned.
+*   @param iDeviceID - the device
+*   @param iShardIndex - set to the device's shard, 0 to getShardCount() - 1
+*   @retval true - iShardIndex is set
+*   @retval false - the catalog is closed or the new placement could not be written.  Use
+*                   GetLastError() to retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseShardCatalog::getShardIndex( int iDeviceID, int & iShardIndex )
+{
+    QMutexLocker locker( &m_Mutex );
+
+    QHash<int, int>::const_iterator it = m_ShardByDevice.constFind( iDeviceID );
+
+    if ( it != m_ShardByDevice.constEnd() )
+    {
+        iShardIndex = it.value();
+        return true;
+    }
+
+    return assignDevice( iDeviceID, iShardIndex );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** findShardIndex() - returns the shard that holds a device's data without placing a device not
+*                      seen before, for reads
+*   @param iDeviceID - the device
+*   @param iShardIndex - set to the device's shard
+*   @retval true - iShardIndex is set
+*   @retval false - the device has no shard yet, so nothing is logged for it
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseShardCatalog::findShardIndex( int iDeviceID, int & iShardIndex )
+{
+    QMutexLocker locker( &m_Mutex );
+
+    QHash<int, int>::const_iterator it = m_ShardByDevice.constFind( iDeviceID );
+
+    if ( it == m_ShardByDevice.constEnd() )
+    {
+        return false;
+    }
+
+    iShardIndex = it.value();
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getDeviceIDs() - returns every device placed on a shard, for reports across the fleet
+*   @retval QList<int> - the devices, in ascending order
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+QList<int> iC3_DatabaseShardCatalog::getDeviceIDs( void )
+{
+    QMutexLocker locker( &m_Mutex );
+
+    QList<int> deviceIDs = m_ShardByDevice.keys();
+    qSort( deviceIDs );
+
+    return deviceIDs;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getShardCount() - returns the number of shards
+*   @retval int - the shard count given to open()
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+int iC3_DatabaseShardCatalog::getShardCount( void ) const
+{
+    return m_iShardCount;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** assignDevice() - places a new device on the least loaded shard and records it.  The caller
+*                    holds m_Mutex.
+*   @param iDeviceID - the device
+*   @param iShardIndex - set to the device's shard
+*   @retval true - the placement was written
+*   @retval false - the catalog is closed or could not be written
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseShardCatalog::assignDevice( int iDeviceID, int & iShardIndex )
+{
+    if ( m_pInsertStatement == NULL )
+    {
+        m_sLastError = QString("iC3_DatabaseShardCatalog::assignDevice() - The catalog is not open");
+        return false;
+    }
+
+    int iLeastLoaded = 0;
+
+    for ( int i = 1; i < m_DevicesPerShard.size(); i++ )
+    {
+        if ( m_DevicesPerShard[i] < m_DevicesPerShard[iLeastLoaded] )
+        {
+            iLeastLoaded = i;
+        }
+    }
+
+    sqlite3_bind_int( m_pInsertStatement, 1, iDeviceID );
+    sqlite3_bind_int( m_pInsertStatement, 2, iLeastLoaded );
+
+    int iStepRC = sqlite3_step( m_pInsertStatement );
+    sqlite3_reset( m_pInsertStatement );
+
+    if ( iStepRC != SQLITE_DONE )
+    {
+        m_sLastError = QString("iC3_DatabaseShardCatalog::assignDevice() - Could not record device %1: %2")
+                           .arg( iDeviceID ).arg( sqlite3_errmsg( m_pCatalog ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    m_ShardByDevice.insert( iDeviceID, iLeastLoaded );
+    m_DevicesPerShard[iLeastLoaded]++;
+    iShardIndex = iLeastLoaded;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** GetLastError() - returns the last error encountered by open() or a new placement
+*   @retval QString - error description
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+QString iC3_DatabaseShardCatalog::GetLastError( void )
+{
+    QMutexLocker locker( &m_Mutex );
+
+    return m_sLastError;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getShardFileName() - returns a shard's database file.  Shard 0 is sDatabaseFileName itself,
+*                        so a single shard database is the one logged before sharding; shard n
+*                        is the same name with "_n" before the suffix (LOG.db, LOG_1.db, ...).
+*   @param sDatabaseFileName - the main database file
+*   @param iShardIndex - the shard
+*   @retval QString - the shard's file name
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+QString iC3_DatabaseShardCatalog::getShardFileName( const QString & sDatabaseFileName, int iShardIndex )
+{
+    if ( iShardIndex == 0 )
+    {
+        return sDatabaseFileName;
+    }
+
+    QFileInfo fileInfo( sDatabaseFileName );
+    QString sFileName = QString("%1/%2_%3").arg( fileInfo.path() ).arg( fileInfo.completeBaseName() ).arg( iShardIndex );
+
+    if ( !fileInfo.suffix().isEmpty() )
+    {
+        sFileName += "." + fileInfo.suffix();
+    }
+
+    return sFileName;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getShardSegmentStorePath() - returns the directory of a shard's transducer segment store.
+*                                Shard 0 uses sSegmentStorePath itself and shard n its
+*                                "shard_n/" subdirectory, so no two writers share a segment.
+*   @param sSegmentStorePath - the segment store, empty if it is not used
+*   @param iShardIndex - the shard
+*   @retval QString - the shard's segment store, empty if sSegmentStorePath is
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+QString iC3_DatabaseShardCatalog::getShardSegmentStorePath( const QString & sSegmentStorePath, int iShardIndex )
+{
+    if ( ( iShardIndex == 0 ) || sSegmentStorePath.isEmpty() )
+    {
+        return sSegmentStorePath;
+    }
+
+    QString sPath = sSegmentStorePath;
+
+    if ( !sPath.endsWith( '/' ) )
+    {
+        sPath += '/';
+    }
+
+    return sPath + QString("shard_%1/").arg( iShardIndex );
+}
@@ -0,0 +1,58 @@
+#ifndef IC3_DATABASESHARDCATALOG_H
+#define IC3_DATABASESHARDCATALOG_H
+
+/**
+*     @file iC3_DatabaseShardCatalog.h
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief This header file defines the iC3_DatabaseShardCatalog class.  When a fleet of
+*            devices is logged, each device's data lives in one of several database files
+*            (shards), each with its own writer thread, so inserts for different devices are
+*            committed in parallel.  The catalog records which shard holds each device.  A
+*            device is placed on the shard holding the fewest devices the first time it is
+*            seen, and stays there.  Safe to use from any thread.
+*/
+
+#include <QString>
+#include <QHash>
+#include <QVector>
+#include <QMutex>
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+class iC3_DatabaseShardCatalog
+{
+public:
+    iC3_DatabaseShardCatalog();
+    ~iC3_DatabaseShardCatalog();
+
+    bool open( const QString & sCatalogFileName, int iShardCount );
+    void close( void );
+
+    bool getShardIndex( int iDeviceID, int & iShardIndex );
+    bool findShardIndex( int iDeviceID, int & iShardIndex );
+    QList<int> getDeviceIDs( void );
+    int getShardCount( void ) const;
+
+    QString GetLastError( void );
+
+    static QString getShardFileName( const QString & sDatabaseFileName, int iShardIndex );
+    static QString getShardSegmentStorePath( const QString & sSegmentStorePath, int iShardIndex );
+
+private:
+
+    bool assignDevice( int iDeviceID, int & iShardIndex );
+
+    sqlite3 * m_pCatalog;
+    sqlite3_stmt * m_pInsertStatement;
+
+    int m_iShardCount;                              // set by open() before any getShardIndex()
+    QHash<int, int> m_ShardByDevice;
+    QVector<int> m_DevicesPerShard;
+
+    QMutex m_Mutex;                                 // guards everything above once open
+    QString m_sLastError;
+};
+
+#endif // IC3_DATABASESHARDCATALOG_H
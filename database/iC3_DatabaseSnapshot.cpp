@@ -0,0 +1,333 @@
+/**
+*     @file iC3_DatabaseSnapshot.cpp
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief this cpp file implements the iC3_DatabaseSnapshot class.
+*
+*            sqlite3_backup_step() restarts from the first page whenever another connection
+*            commits between steps, which with continuous logging would be every step.  The
+*            source connection therefore holds one read transaction for the whole copy; in WAL
+*            mode that pins a snapshot the request processor keeps committing past.  The cost is
+*            that checkpoints cannot recycle the WAL until the copy ends, so the WAL grows by
+*            whatever is logged meanwhile.
+*
+*            The source is opened with sqlite3_open_v2() rather than borrowed from a QSQLITE
+*            connection: the backup API may only be used on connections of the library that
+*            runs it, and Qt's driver can be built on its own copy of SQLite.
+*/
+
+#include <QDebug>
+#include <QFile>
+#include <QElapsedTimer>
+
+#include <sqlite3.h>
+
+#include "iC3_DatabaseSnapshot.h"
+
+//-----------------------------------------------------------------------------------------------
+/** constructor
+*   @param parent - QObject pointer parent (unused)
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_DatabaseSnapshot::iC3_DatabaseSnapshot(QObject *parent) :
+    QThread(parent),
+    m_uiTransactionID( 0 ),
+    m_bCancelRequested( 0 ),
+    m_pSource( NULL ),
+    m_iPageSize( 0 )
+{
+}
+
+//-----------------------------------------------------------------------------------------------
+/** destructor - a snapshot still running is cancelled and waited for
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_DatabaseSnapshot::~iC3_DatabaseSnapshot()
+{
+    cancelSnapshot();
+    wait();
+}
+
+//-----------------------------------------------------------------------------------------------
+/** startSnapshot() - starts copying the database to sSnapshotFileName.  The copy is written as
+*                     sSnapshotFileName.part and only renamed once complete; it is a single
+*                     self-contained file (rollback journal mode) that can be opened anywhere.
+*                     Returns immediately; progress is reported by signalSnapshotProgress() and
+*                     the outcome by signalSnapshotComplete(), signalSnapshotCancelled() or
+*                     signalSnapshotFailed().
+*   @param uiTransactionID - identifies the signals that follow
+*   @param sDatabaseFileName - the live SQLite database file
+*   @param sSnapshotFileName - the file to create (replaced if it exists)
+*   @retval true - the snapshot was started
+*   @retval false - a snapshot is already running
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseSnapshot::startSnapshot( uint uiTransactionID, const QString & sDatabaseFileName, const QString & sSnapshotFileName )
+{
+    if ( isRunning() )
+    {
+        return false;
+    }
+
+    m_uiTransactionID = uiTransactionID;
+    m_sDatabaseFileName = sDatabaseFileName;
+    m_sSnapshotFileName = sSnapshotFileName;
+    m_bCancelRequested.storeRelease( 0 );
+
+    start( QThread::LowPriority );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** cancelSnapshot() - asks a running snapshot to stop after the current step.  Safe to call
+*                      from any thread.
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseSnapshot::cancelSnapshot( void )
+{
+    m_bCancelRequested.storeRelease( 1 );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** run() - snapshot thread
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseSnapshot::run()
+{
+    QString sPartFileName = m_sSnapshotFileName + ".part";
+    QElapsedTimer elapsedTimer;
+    qint64 llBytesCopied = 0;
+
+    m_sLastError.clear();
+    elapsedTimer.start();
+
+    QFile::remove( sPartFileName );
+
+    bool bRC = openSource() && copyPages( m_pSource, sPartFileName, llBytesCopied );
+
+    closeSource();
+
+    bool bCancelled = ( m_bCancelRequested.loadAcquire() != 0 );
+
+    if ( bRC && !bCancelled )
+    {
+        QFile::remove( m_sSnapshotFileName );
+
+        if ( !QFile::rename( sPartFileName, m_sSnapshotFileName ) )
+        {
+            m_sLastError = QString("iC3_DatabaseSnapshot::run() - Could not rename %1 to %2").arg( sPartFileName ).arg( m_sSnapshotFileName );
+            qDebug() << m_sLastError;
+            bRC = false;
+        }
+    }
+
+    // every path that did not put the copy in place leaves the .part behind
+    QFile::remove( sPartFileName );
+
+    if ( bCancelled )
+    {
+        emit signalSnapshotCancelled( m_uiTransactionID );
+    }
+    else if ( !bRC )
+    {
+        emit signalSnapshotFailed( m_uiTransactionID, m_sLastError );
+    }
+    else
+    {
+        emit signalSnapshotComplete( m_uiTransactionID, llBytesCopied, elapsedTimer.elapsed() );
+    }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** openSource() - opens a read-only connection to the live database and starts the read
+*                  transaction the whole copy is taken from
+*   @retval true - the snapshot is pinned
+*   @retval false - an error occurred, see m_sLastError
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseSnapshot::openSource( void )
+{
+    QByteArray baDatabaseFileName = QFile::encodeName( m_sDatabaseFileName );
+
+    if ( sqlite3_open_v2( baDatabaseFileName.constData(), &m_pSource, SQLITE_OPEN_READONLY, NULL ) != SQLITE_OK )
+    {
+        m_sLastError = QString("iC3_DatabaseSnapshot::openSource() - Unable to open the database: %1")
+                           .arg( m_pSource ? sqlite3_errmsg( m_pSource ) : "out of memory" );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    sqlite3_busy_timeout( m_pSource, DB_SNAPSHOT_BUSY_TIMEOUT_MS );
+
+    // BEGIN is deferred - the first read is what takes the WAL snapshot
+    int iTableCount = 0;
+
+    if ( !execSource( "BEGIN" ) ||
+         !execSource( "PRAGMA page_size", &m_iPageSize ) ||
+         !execSource( "SELECT COUNT(*) FROM sqlite_master", &iTableCount ) )
+    {
+        m_sLastError = QString("iC3_DatabaseSnapshot::openSource() - Unable to begin a read: %1").arg( sqlite3_errmsg( m_pSource ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** execSource() - runs one statement on the source connection
+*   @param pSQL - the statement
+*   @param piResult - if not NULL, set to the first column of the first row
+*   @retval true - the statement ran
+*   @retval false - an error occurred, see sqlite3_errmsg()
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseSnapshot::execSource( const char * pSQL, int * piResult )
+{
+    sqlite3_stmt * pStatement = NULL;
+
+    if ( sqlite3_prepare_v2( m_pSource, pSQL, -1, &pStatement, NULL ) != SQLITE_OK )
+    {
+        return false;
+    }
+
+    int iStepRC = sqlite3_step( pStatement );
+
+    if ( ( iStepRC == SQLITE_ROW ) && ( piResult != NULL ) )
+    {
+        *piResult = sqlite3_column_int( pStatement, 0 );
+    }
+
+    // finalize keeps the error of the step for sqlite3_errmsg()
+    sqlite3_finalize( pStatement );
+
+    return ( iStepRC == SQLITE_ROW ) || ( iStepRC == SQLITE_DONE );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** closeSource() - ends the read transaction and closes the source connection
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseSnapshot::closeSource( void )
+{
+    if ( m_pSource != NULL )
+    {
+        // nothing was written - ending the read just releases the snapshot
+        if ( !sqlite3_get_autocommit( m_pSource ) )
+        {
+            execSource( "COMMIT" );
+        }
+        sqlite3_close( m_pSource );
+        m_pSource = NULL;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** copyPages() - copies the pinned snapshot into sPartFileName DB_SNAPSHOT_PAGES_PER_STEP pages
+*                 at a time.  Each step only locks the new file; the live database is read
+*                 under the read transaction opened by openSource().
+*   @param pSource - the source connection's handle
+*   @param sPartFileName - the file to copy into (must not exist)
+*   @param llBytesCopied - set to the size of the copy
+*   @retval true - the copy is complete and synced
+*   @retval false - cancelled, or an error occurred, see m_sLastError
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DatabaseSnapshot::copyPages( sqlite3 * pSource, const QString & sPartFileName, qint64 & llBytesCopied )
+{
+    sqlite3 * pDestination = NULL;
+    QByteArray baPartFileName = QFile::encodeName( sPartFileName );
+
+    if ( sqlite3_open_v2( baPartFileName.constData(), &pDestination, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, NULL ) != SQLITE_OK )
+    {
+        m_sLastError = QString("iC3_DatabaseSnapshot::copyPages() - Could not create %1: %2")
+                           .arg( sPartFileName ).arg( pDestination ? sqlite3_errmsg( pDestination ) : "out of memory" );
+        qDebug() << m_sLastError;
+        sqlite3_close( pDestination );
+        return false;
+    }
+
+    sqlite3_backup * pBackup = sqlite3_backup_init( pDestination, "main", pSource, "main" );
+
+    if ( pBackup == NULL )
+    {
+        m_sLastError = QString("iC3_DatabaseSnapshot::copyPages() - Could not start the backup: %1").arg( sqlite3_errmsg( pDestination ) );
+        qDebug() << m_sLastError;
+        sqlite3_close( pDestination );
+        return false;
+    }
+
+    QElapsedTimer copyTimer;
+    QElapsedTimer progressTimer;
+    int iStepRC = SQLITE_OK;
+
+    copyTimer.start();
+    progressTimer.start();
+
+    while ( m_bCancelRequested.loadAcquire() == 0 )
+    {
+        iStepRC = sqlite3_backup_step( pBackup, DB_SNAPSHOT_PAGES_PER_STEP );
+
+        if ( ( iStepRC != SQLITE_OK ) && ( iStepRC != SQLITE_BUSY ) && ( iStepRC != SQLITE_LOCKED ) )
+        {
+            break;
+        }
+
+        if ( progressTimer.elapsed() >= DB_SNAPSHOT_PROGRESS_INTERVAL_MS )
+        {
+            int iTotalPages = sqlite3_backup_pagecount( pBackup );
+            int iPagesCopied = iTotalPages - sqlite3_backup_remaining( pBackup );
+            qint64 llBytesPerSecond = (qint64) iPagesCopied * m_iPageSize * 1000 / qMax( copyTimer.elapsed(), Q_INT64_C(1) );
+
+            emit signalSnapshotProgress( m_uiTransactionID, ( iTotalPages > 0 ) ? (int) ( (qint64) iPagesCopied * 100 / iTotalPages ) : 0,
+                                         llBytesPerSecond );
+            progressTimer.restart();
+        }
+
+        msleep( DB_SNAPSHOT_STEP_PAUSE_MS );
+    }
+
+    llBytesCopied = (qint64) sqlite3_backup_pagecount( pBackup ) * m_iPageSize;
+
+    // finish reports the first error of any step
+    int iFinishRC = sqlite3_backup_finish( pBackup );
+    bool bRC = ( iStepRC == SQLITE_DONE ) && ( iFinishRC == SQLITE_OK );
+
+    if ( !bRC && ( m_bCancelRequested.loadAcquire() == 0 ) )
+    {
+        m_sLastError = QString("iC3_DatabaseSnapshot::copyPages() - Backup failed: %1")
+                           .arg( sqlite3_errstr( ( iStepRC != SQLITE_DONE ) ? iStepRC : iFinishRC ) );
+        qDebug() << m_sLastError;
+    }
+    else if ( bRC && ( sqlite3_exec( pDestination, "PRAGMA journal_mode=DELETE", NULL, NULL, NULL ) != SQLITE_OK ) )
+    {
+        // the copy carries the live file's WAL flag; make it a single file again
+        m_sLastError = QString("iC3_DatabaseSnapshot::copyPages() - Could not leave WAL mode: %1").arg( sqlite3_errmsg( pDestination ) );
+        qDebug() << m_sLastError;
+        bRC = false;
+    }
+
+    if ( ( sqlite3_close( pDestination ) != SQLITE_OK ) && bRC )
+    {
+        m_sLastError = QString("iC3_DatabaseSnapshot::copyPages() - Could not close %1").arg( sPartFileName );
+        qDebug() << m_sLastError;
+        bRC = false;
+    }
+
+    return bRC;
+}
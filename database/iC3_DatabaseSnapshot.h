@@ -0,0 +1,67 @@
+#ifndef IC3_DATABASESNAPSHOT_H
+#define IC3_DATABASESNAPSHOT_H
+
+/**
+*     @file iC3_DatabaseSnapshot.h
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief This header file defines the iC3_DatabaseSnapshot class.  A snapshot is a
+*            consistent copy of the live database made with the SQLite online backup API on its
+*            own thread while logging carries on.  The copy is taken from one WAL read
+*            snapshot, a few pages per step, so it never takes the writer lock and is never
+*            restarted by the inserts committed meanwhile.
+*/
+
+#include <QThread>
+#include <QAtomicInt>
+
+// pages copied per backup step, and the pause between steps that leaves the disk to the writer
+static const int DB_SNAPSHOT_PAGES_PER_STEP         = 256;
+static const int DB_SNAPSHOT_STEP_PAUSE_MS          = 2;
+static const int DB_SNAPSHOT_PROGRESS_INTERVAL_MS   = 250;
+static const int DB_SNAPSHOT_BUSY_TIMEOUT_MS        = 5000;
+
+struct sqlite3;
+
+class iC3_DatabaseSnapshot : public QThread
+{
+    Q_OBJECT
+public:
+    explicit iC3_DatabaseSnapshot(QObject *parent = 0);
+    ~iC3_DatabaseSnapshot();
+
+    bool startSnapshot( uint uiTransactionID, const QString & sDatabaseFileName, const QString & sSnapshotFileName );
+    void cancelSnapshot( void );
+
+signals:
+
+    void signalSnapshotProgress( uint uiTransactionID, int iPercentComplete, qint64 llBytesPerSecond );
+    void signalSnapshotComplete( uint uiTransactionID, qint64 llBytesCopied, qint64 llElapsedMS );
+    void signalSnapshotCancelled( uint uiTransactionID );
+    void signalSnapshotFailed( uint uiTransactionID, QString sErrorMessage );
+
+protected:
+
+    void run();
+
+private:
+
+    bool openSource( void );
+    bool execSource( const char * pSQL, int * piResult = NULL );
+    void closeSource( void );
+    bool copyPages( sqlite3 * pSource, const QString & sPartFileName, qint64 & llBytesCopied );
+
+    // parameters of the snapshot in progress - written before start()
+    uint m_uiTransactionID;
+    QString m_sDatabaseFileName;
+    QString m_sSnapshotFileName;
+
+    QAtomicInt m_bCancelRequested;
+
+    // used on the snapshot thread only
+    sqlite3 * m_pSource;
+    int m_iPageSize;
+    QString m_sLastError;
+};
+
+#endif // IC3_DATABASESNAPSHOT_H
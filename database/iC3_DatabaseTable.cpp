@@ -20,7 +20,10 @@
 */
 //-----------------------------------------------------------------------------------------------
 iC3_DatabaseTable::iC3_DatabaseTable(QObject *parent) :
-    QObject(parent)
+    QObject(parent),
+    m_Formatter( eDATE_FORMAT_MMDDYY, eTIME_FORMAT_24_HOUR, eEXPORT_TIME_MINUTES, false ),
+    m_eFormatterDateFormat( eDATE_FORMAT_MMDDYY ),
+    m_eFormatterTimeFormat( eTIME_FORMAT_24_HOUR )
 {
 }
 
@@ -33,6 +36,8 @@ iC3_DatabaseTable::iC3_DatabaseTable(QObject *parent) :
 //-----------------------------------------------------------------------------------------------
 iC3_DatabaseTable::~iC3_DatabaseTable()
 {
+    clearPreparedQueries();
+
     if ( m_qlColumnDefinitions.isEmpty() == false )
     {
         qDeleteAll(m_qlColumnDefinitions.begin(), m_qlColumnDefinitions.end());
@@ -356,14 +361,17 @@ bool iC3_DatabaseTable::CheckTableIntegrity( QSqlDatabase &database )
 //-----------------------------------------------------------------------------------------------
 QString iC3_DatabaseTable::FormatDateString( QVariant variantDate, eDateFormats dateFormat )
 {
-    QString sReturnString;
-    QString sDateFormatString;
     QDate theDate = variantDate.toDate();
 
-    sDateFormatString = iC3_DMM_UtilityFunctions::convertToDateFormatString( dateFormat );
-    sReturnString = theDate.toString( sDateFormatString );
+    if ( !theDate.isValid() )
+    {
+        return QString();
+    }
 
-    return sReturnString;
+    char acText[EXPORT_FORMAT_MAX_FIELD_LENGTH];
+    char * pEnd = getFormatter( dateFormat, m_eFormatterTimeFormat ).formatDate( acText, theDate.year(), theDate.month(), theDate.day() );
+
+    return QString::fromLatin1( acText, (int) ( pEnd - acText ) );
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -379,15 +387,17 @@ QString iC3_DatabaseTable::FormatDateString( QVariant variantDate, eDateFormats
 //-----------------------------------------------------------------------------------------------
 QString iC3_DatabaseTable::FormatTimeString( QVariant variantTime, eTimeFormats timeFormat )
 {
-    QString sReturnString;
-    QString sTimeFormatString;
     QTime theTime = variantTime.toTime();
 
-    sTimeFormatString = iC3_DMM_UtilityFunctions::convertToTimeFormatString(timeFormat);
+    if ( !theTime.isValid() )
+    {
+        return QString();
+    }
 
-    sReturnString = theTime.toString( sTimeFormatString );
+    char acText[EXPORT_FORMAT_MAX_FIELD_LENGTH];
+    char * pEnd = getFormatter( m_eFormatterDateFormat, timeFormat ).formatTime( acText, QTime( 0, 0 ).msecsTo( theTime ) );
 
-    return sReturnString;
+    return QString::fromLatin1( acText, (int) ( pEnd - acText ) );
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -404,23 +414,152 @@ QString iC3_DatabaseTable::FormatTimeString( QVariant variantTime, eTimeFormats
 //-----------------------------------------------------------------------------------------------
 QString iC3_DatabaseTable::FormatDateTimeString( QVariant variantDateTime, eDateFormats dateFormat, eTimeFormats timeFormat )
 {
-    QString sReturnString;
-    QString sDateFormatString;
-    QString sTimeFormatString;
-    QString sDateString;
-    QString sTimeString;
+    QDateTime dateTime = variantDateTime.toDateTime();
+
+    if ( !dateTime.isValid() )
+    {
+        return QString(" ");
+    }
+
+    // the stored fields are written as they are - no time zone conversion
+    QDate theDate = dateTime.date();
+    iC3_ExportFormatter & formatter = getFormatter( dateFormat, timeFormat );
+    char acText[EXPORT_FORMAT_MAX_FIELD_LENGTH];
+
+    char * pEnd = formatter.formatDate( acText, theDate.year(), theDate.month(), theDate.day() );
+    *pEnd++ = ' ';
+    pEnd = formatter.formatTime( pEnd, QTime( 0, 0 ).msecsTo( dateTime.time() ) );
+
+    return QString::fromLatin1( acText, (int) ( pEnd - acText ) );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getFormatter() -  returns the table's formatter set up for a date and time format.  Access
+*                     log exports call the Format*String() functions once per cell with the
+*                     same formats, so it is only set up again when they change.
+*   @param  dateFormat - enumerated date format
+*   @param  timeFormat - enumerated time format
+*   @retval the formatter
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_ExportFormatter & iC3_DatabaseTable::getFormatter( eDateFormats dateFormat, eTimeFormats timeFormat )
+{
+    if ( ( dateFormat != m_eFormatterDateFormat ) || ( timeFormat != m_eFormatterTimeFormat ) )
+    {
+        m_Formatter.setFormat( dateFormat, timeFormat, eEXPORT_TIME_MINUTES, false );
+        m_eFormatterDateFormat = dateFormat;
+        m_eFormatterTimeFormat = timeFormat;
+    }
 
-    QDateTime dateTime;
+    return m_Formatter;
+}
 
-    dateTime = variantDateTime.toDateTime();
+//-----------------------------------------------------------------------------------------------
+/** getPreparedQuery() -  returns the prepared statement for sSQL on the given connection,
+*                         preparing it the first time it is requested.  Bind values and exec()
+*                         the returned query; it stays owned by the table.
+*   @param database - the open database (connection) the statement will run on
+*   @param iStatementID - derived table's ID for the statement
+*   @param sSQL - the statement with ? placeholders
+*   @retval pointer to the prepared QSqlQuery
+*   @retval NULL - the database is not open or the prepare failed.  Use GetLastError() to
+*                  retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+QSqlQuery * iC3_DatabaseTable::getPreparedQuery( QSqlDatabase & database, int iStatementID, const QString & sSQL )
+{
+    if ( !database.isOpen() )
+    {
+        SetLastError( QString("iC3_DatabaseTable::getPreparedQuery() - Database is not open") );
+        qDebug() << m_sLastError;
+        return NULL;
+    }
 
-    sTimeFormatString = iC3_DMM_UtilityFunctions::convertToTimeFormatString( timeFormat );
-    sDateFormatString = iC3_DMM_UtilityFunctions::convertToDateFormatString( dateFormat );
+    QHash<int, QSqlQuery *> & statements = m_PreparedQueries[database.connectionName()];
+    QSqlQuery * pQuery = statements.value( iStatementID, NULL );
+
+    if ( pQuery != NULL )
+    {
+        return pQuery;
+    }
 
-    sDateString = dateTime.toString( sDateFormatString );
-    sTimeString = dateTime.toString( sTimeFormatString );
+    pQuery = new QSqlQuery( database );
+    if ( !pQuery->prepare( sSQL ) )
+    {
+        SetLastError( QString("iC3_DatabaseTable::getPreparedQuery() - Prepare Error: %1").arg( pQuery->lastError().text() ) );
+        qDebug() << m_sLastError;
+        delete pQuery;
+        return NULL;
+    }
 
-    sReturnString = QString("%1 %2").arg(sDateString).arg(sTimeString);
+    statements.insert( iStatementID, pQuery );
+
+    return pQuery;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getPreparedQuery() -  as above, for a statement that is a string literal.  The SQL is only
+*                         converted to a QString the first time it is prepared on a connection.
+*   @param database - the open database (connection) the statement will run on
+*   @param iStatementID - derived table's ID for the statement
+*   @param pSQL - the statement with ? placeholders
+*   @retval pointer to the prepared QSqlQuery
+*   @retval NULL - the database is not open or the prepare failed.  Use GetLastError() to
+*                  retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+QSqlQuery * iC3_DatabaseTable::getPreparedQuery( QSqlDatabase & database, int iStatementID, const char * pSQL )
+{
+    if ( database.isOpen() )
+    {
+        QHash<QString, QHash<int, QSqlQuery *> >::const_iterator it = m_PreparedQueries.constFind( database.connectionName() );
+
+        if ( it != m_PreparedQueries.constEnd() )
+        {
+            QSqlQuery * pQuery = it.value().value( iStatementID, NULL );
+
+            if ( pQuery != NULL )
+            {
+                return pQuery;
+            }
+        }
+    }
+
+    return getPreparedQuery( database, iStatementID, QString::fromLatin1( pSQL ) );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** clearPreparedQueries() -  releases the prepared statements held for a connection.  Must be
+*                             called before the connection is closed or removed.
+*   @param database - the database (connection) whose statements are released
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseTable::clearPreparedQueries( QSqlDatabase & database )
+{
+    QHash<int, QSqlQuery *> statements = m_PreparedQueries.take( database.connectionName() );
+
+    qDeleteAll( statements );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** clearPreparedQueries() -  releases the prepared statements held for every connection
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_DatabaseTable::clearPreparedQueries( void )
+{
+    QHash<QString, QHash<int, QSqlQuery *> >::iterator it;
+
+    for ( it = m_PreparedQueries.begin(); it != m_PreparedQueries.end(); ++it )
+    {
+        qDeleteAll( it.value() );
+    }
 
-    return sReturnString;
+    m_PreparedQueries.clear();
 }
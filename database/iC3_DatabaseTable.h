@@ -18,10 +18,12 @@
 #include <QTime>
 #include <QDateTime>
 #include <QVariant>
+#include <QHash>
 
 #include "iC3_DatabaseColumnDef.h"
 #include "iC3_DMM_Constants.h"
 #include "iC3_DMM_UtilityFunctions.h"
+#include "iC3_ExportFormatter.h"
 
 class iC3_DatabaseTable : public QObject
 {
@@ -60,14 +62,30 @@ public:
     QString FormatTimeString( QVariant variantTime, eTimeFormats timeFormat );
     QString FormatDateTimeString( QVariant variantDateTime, eDateFormats dateFormat, eTimeFormats timeFormat );
 
+    void clearPreparedQueries( QSqlDatabase & database );
+    void clearPreparedQueries( void );
+
 
 protected:
 
+    QSqlQuery * getPreparedQuery( QSqlDatabase & database, int iStatementID, const QString & sSQL );
+    QSqlQuery * getPreparedQuery( QSqlDatabase & database, int iStatementID, const char * pSQL );
+
     QString m_sTableName;
     QString m_sLastError;
 
 private:
 
+    iC3_ExportFormatter & getFormatter( eDateFormats dateFormat, eTimeFormats timeFormat );
+
+    // formatter for the Format*String() functions, set up for the last format pair used
+    iC3_ExportFormatter m_Formatter;
+    eDateFormats m_eFormatterDateFormat;
+    eTimeFormats m_eFormatterTimeFormat;
+
+    // prepared statements, keyed by connection name and then by the derived table's statement ID
+    QHash<QString, QHash<int, QSqlQuery *> > m_PreparedQueries;
+
 };
 
 #endif // IC3_DATABASETABLE_H
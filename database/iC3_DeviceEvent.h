@@ -0,0 +1,78 @@
+#ifndef IC3_DEVICEEVENT_H
+#define IC3_DEVICEEVENT_H
+
+/**
+*     @file iC3_DeviceEvent.h
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief This header file defines iC3_DeviceEvent, one door opening or alarm detected from a
+*            device's status polls, and iC3_DeviceEventCount, the number and total duration of
+*            one kind of event over a range of days.
+*/
+
+#include <QtGlobal>
+#include <QMetaType>
+#include <QVector>
+
+#include "iC3_DeviceStatus.h"
+
+// the value of each type is stored in the DeviceEvents tables - append new types at the end and
+// never renumber
+enum eDeviceEventTypes
+{
+    eDEVICE_EVENT_DOOR_OPEN                      = 0,
+    eDEVICE_EVENT_DOOR_ALARM                     = 1,
+    eDEVICE_EVENT_PRIMARY_PROBE_ALARM            = 2,
+    eDEVICE_EVENT_SECONDARY_PROBE_ALARM          = 3,
+    eDEVICE_EVENT_CONTROL_PROBE_ALARM            = 4,
+    eDEVICE_EVENT_COMPRESSOR_PROBE_ALARM         = 5,
+
+    eDEVICE_EVENT_TYPE_COUNT
+};
+
+// the status field each event type follows, in eDeviceEventTypes order
+static const eDeviceStatusFields DEVICE_EVENT_STATUS_FIELDS[eDEVICE_EVENT_TYPE_COUNT] =
+{
+    eDEVICE_STATUS_DOOR_STATUS,
+    eDEVICE_STATUS_DOOR_ALARM_ACTIVE,
+    eDEVICE_STATUS_PRIMARY_PROBE_ALARM,
+    eDEVICE_STATUS_SECONDARY_PROBE_ALARM,
+    eDEVICE_STATUS_CONTROL_PROBE_ALARM,
+    eDEVICE_STATUS_COMPRESSOR_PROBE_ALARM
+};
+
+// the value of that field while the event is not happening; any other reported value starts one
+static const char * const DEVICE_EVENT_INACTIVE_VALUES[eDEVICE_EVENT_TYPE_COUNT] =
+{
+    "closed",
+    "no",
+    "normal",
+    "normal",
+    "normal",
+    "normal"
+};
+
+struct iC3_DeviceEvent
+{
+    int     iDeviceID;
+    int     iEventType;                             // an eDeviceEventTypes value
+    qint64  llStartTimeMS;                          // ms since 1970-01-01T00:00:00 UTC
+    qint64  llEndTimeMS;                            // 0 while the event is still active
+    qint64  llDurationMS;                           // 0 while the event is still active
+};
+
+struct iC3_DeviceEventCount
+{
+    int     iDeviceID;
+    int     iEventType;                             // an eDeviceEventTypes value
+    qint64  llBeginTimeMS;                          // local midnight starting the first day counted
+    qint64  llEndTimeMS;                            // local midnight ending the last day counted
+    qint64  llCount;                                // events that started in the range
+    qint64  llTotalDurationMS;                      // of those that have ended
+};
+
+Q_DECLARE_METATYPE(iC3_DeviceEvent)
+Q_DECLARE_METATYPE(QVector<iC3_DeviceEvent>)
+Q_DECLARE_METATYPE(iC3_DeviceEventCount)
+
+#endif // IC3_DEVICEEVENT_H
@@ -0,0 +1,265 @@
+/**
+*     @file iC3_DeviceEventCountTable.cpp
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief this cpp file implements the iC3_DeviceEventCountTable class.
+*/
+
+#include <QSqlError>
+#include <QDebug>
+#include <QVariant>
+#include <QDateTime>
+
+#include "iC3_DeviceEventCountTable.h"
+
+//-----------------------------------------------------------------------------------------------
+/** constructor
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_DeviceEventCountTable::iC3_DeviceEventCountTable()
+{
+    iC3_DatabaseColumnDef * pColumn;
+
+    m_sTableName = "DeviceEventCounts";
+
+    setNumberOfColumns( e_NUMBER_OF_EVENT_COUNT_TABLE_COLUMNS );
+
+    pColumn = new iC3_DatabaseColumnDef( tr("deviceID"), "INTEGER", "NOT NULL" );
+    AddColumnDef( e_EVENT_COUNT_TABLE_DEVICE_ID_COL, pColumn );
+
+    // an eDeviceEventTypes value
+    pColumn = new iC3_DatabaseColumnDef( tr("eventType"), "INTEGER", "NOT NULL" );
+    AddColumnDef( e_EVENT_COUNT_TABLE_EVENT_TYPE_COL, pColumn );
+
+    // local midnight, ms since the epoch
+    pColumn = new iC3_DatabaseColumnDef( tr("dayStartMS"), "INTEGER", "NOT NULL" );
+    AddColumnDef( e_EVENT_COUNT_TABLE_DAY_START_COL, pColumn );
+
+    pColumn = new iC3_DatabaseColumnDef( tr("eventCount"), "INTEGER", "NOT NULL" );
+    AddColumnDef( e_EVENT_COUNT_TABLE_EVENT_COUNT_COL, pColumn );
+
+    pColumn = new iC3_DatabaseColumnDef( tr("totalDurationMS"), "INTEGER", "NOT NULL" );
+    AddColumnDef( e_EVENT_COUNT_TABLE_TOTAL_DURATION_COL, pColumn );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** CreateTable() - creates the DeviceEventCounts table and its (deviceID, eventType,
+*                   dayStartMS) key if they do not exist.
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @retval true - the table exists
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DeviceEventCountTable::CreateTable( QSqlDatabase & database )
+{
+    QSqlQuery query( database );
+
+    ClearLastError();
+
+    if ( !database.isOpen() )
+    {
+        SetLastError( "iC3_DeviceEventCountTable::CreateTable() - Database is not open" );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    QString sIndexSQL = QString("CREATE UNIQUE INDEX IF NOT EXISTS %1_DeviceTypeDay ON %1 ( %2, %3, %4 )")
+                            .arg( m_sTableName )
+                            .arg( getColumnDef( e_EVENT_COUNT_TABLE_DEVICE_ID_COL )->getColumnName() )
+                            .arg( getColumnDef( e_EVENT_COUNT_TABLE_EVENT_TYPE_COL )->getColumnName() )
+                            .arg( getColumnDef( e_EVENT_COUNT_TABLE_DAY_START_COL )->getColumnName() );
+
+    if ( !query.exec( getTableCreationSQL( m_sTableName ) ) || !query.exec( sIndexSQL ) )
+    {
+        SetLastError( QString("iC3_DeviceEventCountTable::CreateTable() - Query Error: %1").arg( query.lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getDayStartMS() - returns the local midnight starting the day a time falls on
+*   @param llTimeMS - ms since the epoch
+*   @retval day start, ms since the epoch
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+qint64 iC3_DeviceEventCountTable::getDayStartMS( qint64 llTimeMS )
+{
+    return QDateTime( QDateTime::fromMSecsSinceEpoch( llTimeMS ).date() ).toMSecsSinceEpoch();
+}
+
+//-----------------------------------------------------------------------------------------------
+/** addToDay() - adds to the count and total duration stored for a day, creating the row if
+*                needed.  Run inside the writer's transaction.
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @param iDeviceID - the device
+*   @param iEventType - an eDeviceEventTypes value
+*   @param llDayStartMS - the day, as returned by getDayStartMS()
+*   @param llCount - events to add
+*   @param llDurationMS - duration to add
+*   @retval true - the day was updated
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DeviceEventCountTable::addToDay( QSqlDatabase & database,
+                                          int iDeviceID,
+                                          int iEventType,
+                                          qint64 llDayStartMS,
+                                          qint64 llCount,
+                                          qint64 llDurationMS )
+{
+    ClearLastError();
+
+    QString sCountColumn = getColumnDef( e_EVENT_COUNT_TABLE_EVENT_COUNT_COL )->getColumnName();
+    QString sDurationColumn = getColumnDef( e_EVENT_COUNT_TABLE_TOTAL_DURATION_COL )->getColumnName();
+
+    QSqlQuery * pUpdateQuery = getPreparedQuery( database, e_EVENT_COUNT_STMT_UPDATE,
+                                                 QString("UPDATE %1 SET %5 = %5 + ?, %6 = %6 + ? WHERE %2 = ? AND %3 = ? AND %4 = ?")
+                                                     .arg( m_sTableName )
+                                                     .arg( getColumnDef( e_EVENT_COUNT_TABLE_DEVICE_ID_COL )->getColumnName() )
+                                                     .arg( getColumnDef( e_EVENT_COUNT_TABLE_EVENT_TYPE_COL )->getColumnName() )
+                                                     .arg( getColumnDef( e_EVENT_COUNT_TABLE_DAY_START_COL )->getColumnName() )
+                                                     .arg( sCountColumn )
+                                                     .arg( sDurationColumn ) );
+
+    QSqlQuery * pInsertQuery = getPreparedQuery( database, e_EVENT_COUNT_STMT_INSERT,
+                                                 QString("INSERT INTO %1 %2 VALUES ( ?, ?, ?, ?, ? )")
+                                                     .arg( m_sTableName ).arg( getSQL_ColumnNames() ) );
+    if ( ( pUpdateQuery == NULL ) || ( pInsertQuery == NULL ) )
+    {
+        return false;
+    }
+
+    pUpdateQuery->bindValue( 0, llCount );
+    pUpdateQuery->bindValue( 1, llDurationMS );
+    pUpdateQuery->bindValue( 2, iDeviceID );
+    pUpdateQuery->bindValue( 3, iEventType );
+    pUpdateQuery->bindValue( 4, llDayStartMS );
+
+    if ( !pUpdateQuery->exec() )
+    {
+        SetLastError( QString("iC3_DeviceEventCountTable::addToDay() - Query Error: %1").arg( pUpdateQuery->lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    // the first event of the day
+    if ( pUpdateQuery->numRowsAffected() == 0 )
+    {
+        pInsertQuery->bindValue( e_EVENT_COUNT_TABLE_DEVICE_ID_COL, iDeviceID );
+        pInsertQuery->bindValue( e_EVENT_COUNT_TABLE_EVENT_TYPE_COL, iEventType );
+        pInsertQuery->bindValue( e_EVENT_COUNT_TABLE_DAY_START_COL, llDayStartMS );
+        pInsertQuery->bindValue( e_EVENT_COUNT_TABLE_EVENT_COUNT_COL, llCount );
+        pInsertQuery->bindValue( e_EVENT_COUNT_TABLE_TOTAL_DURATION_COL, llDurationMS );
+
+        if ( !pInsertQuery->exec() )
+        {
+            SetLastError( QString("iC3_DeviceEventCountTable::addToDay() - Query Error: %1").arg( pInsertQuery->lastError().text() ) );
+            qDebug() << m_sLastError;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getCount() - sums a device's counts of one event type over the days starting in
+*                llStartTimeMS <= dayStartMS < llEndTimeMS.  One day is a single row read
+*                through the key.
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @param iDeviceID - the device
+*   @param iEventType - an eDeviceEventTypes value
+*   @param llStartTimeMS - local midnight starting the first day (inclusive)
+*   @param llEndTimeMS - local midnight ending the last day (exclusive)
+*   @param count - set to the totals; 0 if no event started in the range
+*   @retval true - if the query succeeded
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DeviceEventCountTable::getCount( QSqlDatabase & database,
+                                          int iDeviceID,
+                                          int iEventType,
+                                          qint64 llStartTimeMS,
+                                          qint64 llEndTimeMS,
+                                          iC3_DeviceEventCount & count )
+{
+    ClearLastError();
+
+    count.iDeviceID = iDeviceID;
+    count.iEventType = iEventType;
+    count.llBeginTimeMS = llStartTimeMS;
+    count.llEndTimeMS = llEndTimeMS;
+    count.llCount = 0;
+    count.llTotalDurationMS = 0;
+
+    QSqlQuery * pQuery = getPreparedQuery( database, e_EVENT_COUNT_STMT_SELECT_SUM,
+                                           QString("SELECT SUM( %5 ), SUM( %6 ) FROM %1 WHERE %2 = ? AND %3 = ? AND %4 >= ? AND %4 < ?")
+                                               .arg( m_sTableName )
+                                               .arg( getColumnDef( e_EVENT_COUNT_TABLE_DEVICE_ID_COL )->getColumnName() )
+                                               .arg( getColumnDef( e_EVENT_COUNT_TABLE_EVENT_TYPE_COL )->getColumnName() )
+                                               .arg( getColumnDef( e_EVENT_COUNT_TABLE_DAY_START_COL )->getColumnName() )
+                                               .arg( getColumnDef( e_EVENT_COUNT_TABLE_EVENT_COUNT_COL )->getColumnName() )
+                                               .arg( getColumnDef( e_EVENT_COUNT_TABLE_TOTAL_DURATION_COL )->getColumnName() ) );
+    if ( pQuery == NULL )
+    {
+        return false;
+    }
+
+    pQuery->bindValue( 0, iDeviceID );
+    pQuery->bindValue( 1, iEventType );
+    pQuery->bindValue( 2, llStartTimeMS );
+    pQuery->bindValue( 3, llEndTimeMS );
+
+    if ( !pQuery->exec() )
+    {
+        SetLastError( QString("iC3_DeviceEventCountTable::getCount() - Query Error: %1").arg( pQuery->lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    // SUM() of no rows is NULL, which reads as 0
+    if ( pQuery->next() )
+    {
+        count.llCount = pQuery->value( 0 ).toLongLong();
+        count.llTotalDurationMS = pQuery->value( 1 ).toLongLong();
+    }
+
+    pQuery->finish();
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getSQL_ColumnNames() - returns "( col, col, ... )" for all columns
+*   @retval column name list usable in an sql statement
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+QString iC3_DeviceEventCountTable::getSQL_ColumnNames( void )
+{
+    QString sColumnNames = QString("( %1").arg( getColumnDef( 0 )->getColumnName() );
+
+    for ( int iIndex = 1; iIndex < e_NUMBER_OF_EVENT_COUNT_TABLE_COLUMNS; iIndex++ )
+    {
+        sColumnNames.append( QString(", %1").arg( getColumnDef( iIndex )->getColumnName() ) );
+    }
+
+    sColumnNames.append( " )" );
+
+    return sColumnNames;
+}
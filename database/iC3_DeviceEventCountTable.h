@@ -0,0 +1,62 @@
+#ifndef IC3_DEVICEEVENTCOUNTTABLE_H
+#define IC3_DEVICEEVENTCOUNTTABLE_H
+
+/**
+*     @file iC3_DeviceEventCountTable.h
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief This header file defines the iC3_DeviceEventCountTable class.  DeviceEventCounts
+*            holds, per device, event type and local day, the number of events that started
+*            that day and the total duration of those that have ended.  The request processor
+*            updates it in the same transaction as DeviceEvents, so a count for a day is a
+*            single row read rather than a scan of the events.
+*/
+
+#include "iC3_DatabaseTable.h"
+#include "iC3_DeviceEvent.h"
+
+class iC3_DeviceEventCountTable : public iC3_DatabaseTable
+{
+public:
+    iC3_DeviceEventCountTable();
+
+    enum eIC3_DeviceEventCountTableColumns
+    {
+        e_EVENT_COUNT_TABLE_DEVICE_ID_COL           = 0,
+        e_EVENT_COUNT_TABLE_EVENT_TYPE_COL          = 1,
+        e_EVENT_COUNT_TABLE_DAY_START_COL           = 2,
+        e_EVENT_COUNT_TABLE_EVENT_COUNT_COL         = 3,
+        e_EVENT_COUNT_TABLE_TOTAL_DURATION_COL      = 4,
+
+        e_NUMBER_OF_EVENT_COUNT_TABLE_COLUMNS
+    };
+
+    enum eIC3_DeviceEventCountTableStatements
+    {
+        e_EVENT_COUNT_STMT_UPDATE                   = 0,
+        e_EVENT_COUNT_STMT_INSERT                   = 1,
+        e_EVENT_COUNT_STMT_SELECT_SUM               = 2
+    };
+
+    bool CreateTable( QSqlDatabase & database );
+
+    static qint64 getDayStartMS( qint64 llTimeMS );
+
+    bool addToDay( QSqlDatabase & database,
+                   int iDeviceID,
+                   int iEventType,
+                   qint64 llDayStartMS,
+                   qint64 llCount,
+                   qint64 llDurationMS );
+
+    bool getCount( QSqlDatabase & database,
+                   int iDeviceID,
+                   int iEventType,
+                   qint64 llStartTimeMS,
+                   qint64 llEndTimeMS,
+                   iC3_DeviceEventCount & count );
+
+    QString getSQL_ColumnNames( void );
+};
+
+#endif // IC3_DEVICEEVENTCOUNTTABLE_H
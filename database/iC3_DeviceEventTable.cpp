@@ -0,0 +1,368 @@
+/**
+*     @file iC3_DeviceEventTable.cpp
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief this cpp file implements the iC3_DeviceEventTable class.
+*/
+
+#include <QSqlError>
+#include <QDebug>
+#include <QVariant>
+
+#include "iC3_DeviceEventTable.h"
+
+//-----------------------------------------------------------------------------------------------
+/** constructor
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_DeviceEventTable::iC3_DeviceEventTable()
+{
+    iC3_DatabaseColumnDef * pColumn;
+
+    m_sTableName = "DeviceEvents";
+
+    setNumberOfColumns( e_NUMBER_OF_DEVICE_EVENT_TABLE_COLUMNS );
+
+    pColumn = new iC3_DatabaseColumnDef( tr("deviceID"), "INTEGER", "NOT NULL" );
+    AddColumnDef( e_DEVICE_EVENT_TABLE_DEVICE_ID_COL, pColumn );
+
+    // an eDeviceEventTypes value
+    pColumn = new iC3_DatabaseColumnDef( tr("eventType"), "INTEGER", "NOT NULL" );
+    AddColumnDef( e_DEVICE_EVENT_TABLE_EVENT_TYPE_COL, pColumn );
+
+    pColumn = new iC3_DatabaseColumnDef( tr("startTimeMS"), "INTEGER", "NOT NULL" );
+    AddColumnDef( e_DEVICE_EVENT_TABLE_START_TIME_COL, pColumn );
+
+    // NULL until the event ends
+    pColumn = new iC3_DatabaseColumnDef( tr("endTimeMS"), "INTEGER", "" );
+    AddColumnDef( e_DEVICE_EVENT_TABLE_END_TIME_COL, pColumn );
+
+    pColumn = new iC3_DatabaseColumnDef( tr("durationMS"), "INTEGER", "" );
+    AddColumnDef( e_DEVICE_EVENT_TABLE_DURATION_COL, pColumn );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** CreateTable() - creates the DeviceEvents table, its (deviceID, eventType, startTimeMS) index
+*                   and the endTimeMS index that finds the active events, if they do not exist.
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @retval true - the table exists
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DeviceEventTable::CreateTable( QSqlDatabase & database )
+{
+    QSqlQuery query( database );
+
+    ClearLastError();
+
+    if ( !database.isOpen() )
+    {
+        SetLastError( "iC3_DeviceEventTable::CreateTable() - Database is not open" );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    QString sIndexSQL = QString("CREATE INDEX IF NOT EXISTS %1_DeviceTypeStart ON %1 ( %2, %3, %4 )")
+                            .arg( m_sTableName )
+                            .arg( getColumnDef( e_DEVICE_EVENT_TABLE_DEVICE_ID_COL )->getColumnName() )
+                            .arg( getColumnDef( e_DEVICE_EVENT_TABLE_EVENT_TYPE_COL )->getColumnName() )
+                            .arg( getColumnDef( e_DEVICE_EVENT_TABLE_START_TIME_COL )->getColumnName() );
+
+    // SQLite indexes NULLs, so the active events are found without a scan
+    QString sActiveIndexSQL = QString("CREATE INDEX IF NOT EXISTS %1_End ON %1 ( %2 )")
+                                  .arg( m_sTableName )
+                                  .arg( getColumnDef( e_DEVICE_EVENT_TABLE_END_TIME_COL )->getColumnName() );
+
+    if ( !query.exec( getTableCreationSQL( m_sTableName ) ) || !query.exec( sIndexSQL ) || !query.exec( sActiveIndexSQL ) )
+    {
+        SetLastError( QString("iC3_DeviceEventTable::CreateTable() - Query Error: %1").arg( query.lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** startEvent() - writes a new active event
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @param iDeviceID - the device
+*   @param iEventType - an eDeviceEventTypes value
+*   @param llStartTimeMS - time of the status poll that started it, ms since the epoch
+*   @retval true - the event was written
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DeviceEventTable::startEvent( QSqlDatabase & database, int iDeviceID, int iEventType, qint64 llStartTimeMS )
+{
+    ClearLastError();
+
+    QSqlQuery * pQuery = getPreparedQuery( database, e_DEVICE_EVENT_STMT_INSERT,
+                                           QString("INSERT INTO %1 %2 VALUES ( ?, ?, ?, ?, ? )")
+                                               .arg( m_sTableName ).arg( getSQL_ColumnNames() ) );
+    if ( pQuery == NULL )
+    {
+        return false;
+    }
+
+    pQuery->bindValue( e_DEVICE_EVENT_TABLE_DEVICE_ID_COL, iDeviceID );
+    pQuery->bindValue( e_DEVICE_EVENT_TABLE_EVENT_TYPE_COL, iEventType );
+    pQuery->bindValue( e_DEVICE_EVENT_TABLE_START_TIME_COL, llStartTimeMS );
+    pQuery->bindValue( e_DEVICE_EVENT_TABLE_END_TIME_COL, QVariant( QVariant::LongLong ) );
+    pQuery->bindValue( e_DEVICE_EVENT_TABLE_DURATION_COL, QVariant( QVariant::LongLong ) );
+
+    if ( !pQuery->exec() )
+    {
+        SetLastError( QString("iC3_DeviceEventTable::startEvent() - Query Error: %1").arg( pQuery->lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** endEvent() - records the end time and duration of an active event
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @param iDeviceID - the device
+*   @param iEventType - an eDeviceEventTypes value
+*   @param llStartTimeMS - the start time the event was written with
+*   @param llEndTimeMS - time of the status poll that ended it, ms since the epoch
+*   @param llDurationMS - set to the duration recorded; 0 if the clock was set back before
+*                         llStartTimeMS
+*   @retval true - the event was updated, or was not active
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DeviceEventTable::endEvent( QSqlDatabase & database,
+                                     int iDeviceID,
+                                     int iEventType,
+                                     qint64 llStartTimeMS,
+                                     qint64 llEndTimeMS,
+                                     qint64 & llDurationMS )
+{
+    ClearLastError();
+
+    llDurationMS = qMax( llEndTimeMS - llStartTimeMS, Q_INT64_C(0) );
+
+    QString sEndColumn = getColumnDef( e_DEVICE_EVENT_TABLE_END_TIME_COL )->getColumnName();
+
+    QSqlQuery * pQuery = getPreparedQuery( database, e_DEVICE_EVENT_STMT_END,
+                                           QString("UPDATE %1 SET %5 = ?, %6 = ? WHERE %2 = ? AND %3 = ? AND %4 = ? AND %5 IS NULL")
+                                               .arg( m_sTableName )
+                                               .arg( getColumnDef( e_DEVICE_EVENT_TABLE_DEVICE_ID_COL )->getColumnName() )
+                                               .arg( getColumnDef( e_DEVICE_EVENT_TABLE_EVENT_TYPE_COL )->getColumnName() )
+                                               .arg( getColumnDef( e_DEVICE_EVENT_TABLE_START_TIME_COL )->getColumnName() )
+                                               .arg( sEndColumn )
+                                               .arg( getColumnDef( e_DEVICE_EVENT_TABLE_DURATION_COL )->getColumnName() ) );
+    if ( pQuery == NULL )
+    {
+        return false;
+    }
+
+    pQuery->bindValue( 0, llEndTimeMS );
+    pQuery->bindValue( 1, llDurationMS );
+    pQuery->bindValue( 2, iDeviceID );
+    pQuery->bindValue( 3, iEventType );
+    pQuery->bindValue( 4, llStartTimeMS );
+
+    if ( !pQuery->exec() )
+    {
+        SetLastError( QString("iC3_DeviceEventTable::endEvent() - Query Error: %1").arg( pQuery->lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getActiveEvents() - retrieves every event that has not ended, for all devices
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @param events - the events found are appended here
+*   @retval true - if the query succeeded
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DeviceEventTable::getActiveEvents( QSqlDatabase & database, QVector<iC3_DeviceEvent> & events )
+{
+    ClearLastError();
+
+    QSqlQuery * pQuery = getPreparedQuery( database, e_DEVICE_EVENT_STMT_SELECT_ACTIVE,
+                                           QString("SELECT * FROM %1 WHERE %2 IS NULL")
+                                               .arg( m_sTableName )
+                                               .arg( getColumnDef( e_DEVICE_EVENT_TABLE_END_TIME_COL )->getColumnName() ) );
+    if ( pQuery == NULL )
+    {
+        return false;
+    }
+
+    pQuery->setForwardOnly( true );
+
+    if ( !pQuery->exec() )
+    {
+        SetLastError( QString("iC3_DeviceEventTable::getActiveEvents() - Query Error: %1").arg( pQuery->lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    iC3_DeviceEvent event;
+    while ( pQuery->next() )
+    {
+        eventFromQuery( event, *pQuery );
+        events.append( event );
+    }
+
+    pQuery->finish();
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getEventsInRange() - retrieves a device's events of one type that were active at any time
+*                        in llStartTimeMS <= time < llEndTimeMS, oldest first.  Events of one
+*                        type never overlap, so only the last one starting before the range
+*                        can reach into it.  Run inside a read transaction so both queries see
+*                        the same events.
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @param iDeviceID - the device
+*   @param iEventType - an eDeviceEventTypes value
+*   @param llStartTimeMS - start of the range, ms since the epoch (inclusive)
+*   @param llEndTimeMS - end of the range, ms since the epoch (exclusive)
+*   @param events - the events found are appended here
+*   @retval true - if the queries succeeded
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_DeviceEventTable::getEventsInRange( QSqlDatabase & database,
+                                             int iDeviceID,
+                                             int iEventType,
+                                             qint64 llStartTimeMS,
+                                             qint64 llEndTimeMS,
+                                             QVector<iC3_DeviceEvent> & events )
+{
+    ClearLastError();
+
+    QString sDeviceColumn = getColumnDef( e_DEVICE_EVENT_TABLE_DEVICE_ID_COL )->getColumnName();
+    QString sTypeColumn = getColumnDef( e_DEVICE_EVENT_TABLE_EVENT_TYPE_COL )->getColumnName();
+    QString sStartColumn = getColumnDef( e_DEVICE_EVENT_TABLE_START_TIME_COL )->getColumnName();
+
+    QSqlQuery * pQuery = getPreparedQuery( database, e_DEVICE_EVENT_STMT_SELECT_BEFORE,
+                                           QString("SELECT * FROM %1 WHERE %2 = ? AND %3 = ? AND %4 < ? ORDER BY %4 DESC LIMIT 1")
+                                               .arg( m_sTableName ).arg( sDeviceColumn ).arg( sTypeColumn ).arg( sStartColumn ) );
+    if ( pQuery == NULL )
+    {
+        return false;
+    }
+
+    pQuery->bindValue( 0, iDeviceID );
+    pQuery->bindValue( 1, iEventType );
+    pQuery->bindValue( 2, llStartTimeMS );
+
+    if ( !pQuery->exec() )
+    {
+        SetLastError( QString("iC3_DeviceEventTable::getEventsInRange() - Query Error: %1").arg( pQuery->lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    iC3_DeviceEvent event;
+
+    if ( pQuery->next() )
+    {
+        eventFromQuery( event, *pQuery );
+
+        if ( ( event.llEndTimeMS == 0 ) || ( event.llEndTimeMS > llStartTimeMS ) )
+        {
+            events.append( event );
+        }
+    }
+    pQuery->finish();
+
+    pQuery = getPreparedQuery( database, e_DEVICE_EVENT_STMT_SELECT_RANGE,
+                               QString("SELECT * FROM %1 WHERE %2 = ? AND %3 = ? AND %4 >= ? AND %4 < ? ORDER BY %4")
+                                   .arg( m_sTableName ).arg( sDeviceColumn ).arg( sTypeColumn ).arg( sStartColumn ) );
+    if ( pQuery == NULL )
+    {
+        return false;
+    }
+
+    pQuery->setForwardOnly( true );
+    pQuery->bindValue( 0, iDeviceID );
+    pQuery->bindValue( 1, iEventType );
+    pQuery->bindValue( 2, llStartTimeMS );
+    pQuery->bindValue( 3, llEndTimeMS );
+
+    if ( !pQuery->exec() )
+    {
+        SetLastError( QString("iC3_DeviceEventTable::getEventsInRange() - Query Error: %1").arg( pQuery->lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    while ( pQuery->next() )
+    {
+        eventFromQuery( event, *pQuery );
+        events.append( event );
+    }
+
+    pQuery->finish();
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getSQL_ColumnNames() - returns "( col, col, ... )" for all columns
+*   @retval column name list usable in an sql statement
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+QString iC3_DeviceEventTable::getSQL_ColumnNames( void )
+{
+    QString sColumnNames = QString("( %1").arg( getColumnDef( 0 )->getColumnName() );
+
+    for ( int iIndex = 1; iIndex < e_NUMBER_OF_DEVICE_EVENT_TABLE_COLUMNS; iIndex++ )
+    {
+        sColumnNames.append( QString(", %1").arg( getColumnDef( iIndex )->getColumnName() ) );
+    }
+
+    sColumnNames.append( " )" );
+
+    return sColumnNames;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** eventFromQuery() - fills an event from the current row of a SELECT * query
+*   @param event - the event to fill
+*   @param query - positioned on a row
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_DeviceEventTable::eventFromQuery( iC3_DeviceEvent & event, QSqlQuery & query )
+{
+    event.iDeviceID = query.value( e_DEVICE_EVENT_TABLE_DEVICE_ID_COL ).toInt();
+    event.iEventType = query.value( e_DEVICE_EVENT_TABLE_EVENT_TYPE_COL ).toInt();
+    event.llStartTimeMS = query.value( e_DEVICE_EVENT_TABLE_START_TIME_COL ).toLongLong();
+
+    // NULL while active reads as 0
+    event.llEndTimeMS = query.value( e_DEVICE_EVENT_TABLE_END_TIME_COL ).toLongLong();
+    event.llDurationMS = query.value( e_DEVICE_EVENT_TABLE_DURATION_COL ).toLongLong();
+}
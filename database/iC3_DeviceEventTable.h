@@ -0,0 +1,67 @@
+#ifndef IC3_DEVICEEVENTTABLE_H
+#define IC3_DEVICEEVENTTABLE_H
+
+/**
+*     @file iC3_DeviceEventTable.h
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief This header file defines the iC3_DeviceEventTable class.  DeviceEvents holds one
+*            row per door opening or alarm, written by the request processor when a status poll
+*            starts it and completed with its end time and duration when a later poll ends it.
+*/
+
+#include <QVector>
+#include "iC3_DatabaseTable.h"
+#include "iC3_DeviceEvent.h"
+
+class iC3_DeviceEventTable : public iC3_DatabaseTable
+{
+public:
+    iC3_DeviceEventTable();
+
+    enum eIC3_DeviceEventTableColumns
+    {
+        e_DEVICE_EVENT_TABLE_DEVICE_ID_COL          = 0,
+        e_DEVICE_EVENT_TABLE_EVENT_TYPE_COL         = 1,
+        e_DEVICE_EVENT_TABLE_START_TIME_COL         = 2,
+        e_DEVICE_EVENT_TABLE_END_TIME_COL           = 3,
+        e_DEVICE_EVENT_TABLE_DURATION_COL           = 4,
+
+        e_NUMBER_OF_DEVICE_EVENT_TABLE_COLUMNS
+    };
+
+    enum eIC3_DeviceEventTableStatements
+    {
+        e_DEVICE_EVENT_STMT_INSERT                  = 0,
+        e_DEVICE_EVENT_STMT_END                     = 1,
+        e_DEVICE_EVENT_STMT_SELECT_ACTIVE           = 2,
+        e_DEVICE_EVENT_STMT_SELECT_BEFORE           = 3,
+        e_DEVICE_EVENT_STMT_SELECT_RANGE            = 4
+    };
+
+    bool CreateTable( QSqlDatabase & database );
+
+    bool startEvent( QSqlDatabase & database, int iDeviceID, int iEventType, qint64 llStartTimeMS );
+    bool endEvent( QSqlDatabase & database,
+                   int iDeviceID,
+                   int iEventType,
+                   qint64 llStartTimeMS,
+                   qint64 llEndTimeMS,
+                   qint64 & llDurationMS );
+
+    bool getActiveEvents( QSqlDatabase & database, QVector<iC3_DeviceEvent> & events );
+    bool getEventsInRange( QSqlDatabase & database,
+                           int iDeviceID,
+                           int iEventType,
+                           qint64 llStartTimeMS,
+                           qint64 llEndTimeMS,
+                           QVector<iC3_DeviceEvent> & events );
+
+    QString getSQL_ColumnNames( void );
+
+private:
+
+    void eventFromQuery( iC3_DeviceEvent & event, QSqlQuery & query );
+};
+
+#endif // IC3_DEVICEEVENTTABLE_H
@@ -0,0 +1,79 @@
+#ifndef IC3_DEVICESTATUS_H
+#define IC3_DEVICESTATUS_H
+
+/**
+*     @file iC3_DeviceStatus.h
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief This header file defines iC3_DeviceStatus, the state fields of one status poll.
+*            The probe temperatures go to the Transducers table; everything else in the poll
+*            is kept here and journaled by iC3_StatusJournalTable.
+*/
+
+#include <QtGlobal>
+#include <QMetaType>
+#include <QString>
+
+// the value of each field is stored in the StatusJournal as its ID - append new fields at the
+// end and never renumber
+enum eDeviceStatusFields
+{
+    eDEVICE_STATUS_PRIMARY_PROBE_OFFSET          = 0,
+    eDEVICE_STATUS_CONTROL_PROBE_OFFSET          = 1,
+    eDEVICE_STATUS_DEVICE_TYPE                   = 2,
+    eDEVICE_STATUS_AC_VOLT                       = 3,
+    eDEVICE_STATUS_BATTERY_VOLT                  = 4,
+    eDEVICE_STATUS_PRODUCT_MAX_TEMP              = 5,
+    eDEVICE_STATUS_PRODUCT_MIN_TEMP              = 6,
+    eDEVICE_STATUS_MIN_MAX_LAST_RESET            = 7,
+    eDEVICE_STATUS_POWER_STATE                   = 8,
+    eDEVICE_STATUS_BATTERY_STATE                 = 9,
+    eDEVICE_STATUS_DOOR_STATUS                   = 10,
+    eDEVICE_STATUS_PELTIER_TEST_ACTIVE           = 11,
+    eDEVICE_STATUS_DOOR_ALARM_ACTIVE             = 12,
+    eDEVICE_STATUS_PRIMARY_PROBE_ALARM           = 13,
+    eDEVICE_STATUS_SECONDARY_PROBE_ALARM         = 14,
+    eDEVICE_STATUS_CONTROL_PROBE_ALARM           = 15,
+    eDEVICE_STATUS_COMPRESSOR_PROBE_ALARM        = 16,
+    eDEVICE_STATUS_COMPRESSOR_STATE              = 17,
+    eDEVICE_STATUS_LOCK_STATE                    = 18,
+    eDEVICE_STATUS_DEFROST_STATUS                = 19,
+
+    eDEVICE_STATUS_FIELD_COUNT
+};
+
+// the key of each field in the unit's JSON status reply, in eDeviceStatusFields order
+static const char * const DEVICE_STATUS_FIELD_KEYS[eDEVICE_STATUS_FIELD_COUNT] =
+{
+    "primaryProbeOffset",
+    "controlProbeOffset",
+    "deviceType",
+    "acVolt",
+    "batteryVolt",
+    "productMaxTemp",
+    "productMinTemp",
+    "minMaxLastReset",
+    "powerState",
+    "batteryState",
+    "doorStatus",
+    "peltierTestActive",
+    "doorAlarmActive",
+    "primaryProbeAlarmActive",
+    "secondaryProbeAlarmActive",
+    "controlProbeAlarmActive",
+    "compressorProbeAlarmActive",
+    "compressorState",
+    "lockState",
+    "defrostStatus"
+};
+
+struct iC3_DeviceStatus
+{
+    int     iDeviceID;
+    qint64  llStatusTimeMS;                         // ms since 1970-01-01T00:00:00 UTC
+    QString asFields[eDEVICE_STATUS_FIELD_COUNT];   // as reported, empty if not reported
+};
+
+Q_DECLARE_METATYPE(iC3_DeviceStatus)
+
+#endif // IC3_DEVICESTATUS_H
@@ -0,0 +1,410 @@
+/**
+*     @file iC3_ExportFormatter.cpp
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief this cpp file implements iC3_ExportFormatter.
+*/
+
+#include <QDateTime>
+#include <limits>
+#include <cstdlib>
+#include <cstring>
+
+#include "iC3_ExportFormatter.h"
+
+namespace
+{
+    const qint64 MS_PER_DAY = Q_INT64_C(24) * 60 * 60 * 1000;
+
+    // |value| below this goes through the exact 6 decimal fast path of formatDouble()
+    const double SHORTEST_FAST_PATH_LIMIT = 1.0E12;
+    const int    SHORTEST_FAST_PATH_DECIMALS = 6;
+    const qint64 SHORTEST_FAST_PATH_SCALE = 1000000;
+
+    const int    MAX_FIXED_DECIMALS = 9;
+    const qint64 POWERS_OF_TEN[MAX_FIXED_DECIMALS + 1] = { 1, 10, 100, 1000, 10000, 100000, 1000000,
+                                                            10000000, 100000000, 1000000000 };
+
+    inline qint64 floorDivide( qint64 llValue, qint64 llDivisor )
+    {
+        qint64 llQuotient = llValue / llDivisor;
+        return ( ( llValue % llDivisor ) < 0 ) ? ( llQuotient - 1 ) : llQuotient;
+    }
+
+    inline char * writeDigits( char * pOut, qint64 llValue, int iWidth )
+    {
+        for ( int iIndex = iWidth - 1; iIndex >= 0; iIndex-- )
+        {
+            pOut[iIndex] = (char) ( '0' + llValue % 10 );
+            llValue /= 10;
+        }
+        return pOut + iWidth;
+    }
+
+    // %.15G is enough for most values; %.17G always reads back exactly
+    char * writeShortestGeneral( char * pOut, double dValue )
+    {
+        int iLength = qsnprintf( pOut, EXPORT_FORMAT_MAX_FIELD_LENGTH, "%.15G", dValue );
+
+        if ( ( dValue == dValue ) && ( strtod( pOut, NULL ) != dValue ) )
+        {
+            iLength = qsnprintf( pOut, EXPORT_FORMAT_MAX_FIELD_LENGTH, "%.17G", dValue );
+        }
+
+        return pOut + iLength;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** constructor - 24 hour, year first, local time, minutes
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_ExportFormatter::iC3_ExportFormatter()
+{
+    setFormat( eDATE_FORMAT_YYYYMMDD, eTIME_FORMAT_24_HOUR );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** constructor
+*   @param dateFormat, timeFormat, ePrecision, bLocalTime, iDecimals - see setFormat()
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_ExportFormatter::iC3_ExportFormatter( eDateFormats dateFormat,
+                                          eTimeFormats timeFormat,
+                                          eExportTimePrecision ePrecision,
+                                          bool bLocalTime,
+                                          int iDecimals )
+{
+    setFormat( dateFormat, timeFormat, ePrecision, bLocalTime, iDecimals );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** setFormat() - resolves the formats into the field layout used by every later call
+*   @param dateFormat - day/month/year order, as the GUI setting
+*   @param timeFormat - 12 or 24 hour, as the GUI setting (eTIME_FORMAT_NOT_SET means 24 hour)
+*   @param ePrecision - how much of the time to write
+*   @param bLocalTime - true: formatDateTime() converts to local time; false: writes UTC
+*   @param iDecimals - decimals for formatDouble(), or -1 for the shortest text that reads
+*                      back as the same double
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_ExportFormatter::setFormat( eDateFormats dateFormat,
+                                     eTimeFormats timeFormat,
+                                     eExportTimePrecision ePrecision,
+                                     bool bLocalTime,
+                                     int iDecimals )
+{
+    switch ( dateFormat )
+    {
+    case eDATE_FORMAT_MMDDYY:
+        m_aeDateFields[0] = eFIELD_MONTH;
+        m_aeDateFields[1] = eFIELD_DAY;
+        m_aeDateFields[2] = eFIELD_YEAR;
+        m_cDateSeparator = '/';
+        break;
+    case eDATE_FORMAT_DDMMYY:
+        m_aeDateFields[0] = eFIELD_DAY;
+        m_aeDateFields[1] = eFIELD_MONTH;
+        m_aeDateFields[2] = eFIELD_YEAR;
+        m_cDateSeparator = '/';
+        break;
+    case eDATE_FORMAT_YYYYMMDD:
+    default:
+        m_aeDateFields[0] = eFIELD_YEAR;
+        m_aeDateFields[1] = eFIELD_MONTH;
+        m_aeDateFields[2] = eFIELD_DAY;
+        m_cDateSeparator = '-';
+        break;
+    }
+
+    m_b12Hour = ( timeFormat == eTIME_FORMAT_12_HOUR );
+    m_ePrecision = ePrecision;
+    m_bLocalTime = bLocalTime;
+    m_iDecimals = qMin( iDecimals, MAX_FIXED_DECIMALS );
+
+    m_llCachedDayNumber = std::numeric_limits<qint64>::min();
+    m_iCachedDateLength = 0;
+
+    for ( int iIndex = 0; iIndex < EXPORT_FORMAT_OFFSET_CACHE_SIZE; iIndex++ )
+    {
+        m_allOffsetSlots[iIndex] = std::numeric_limits<qint64>::min();
+        m_allOffsetsMS[iIndex] = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+bool iC3_ExportFormatter::isLocalTime( void ) const
+{
+    return m_bLocalTime;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** formatDateTime() - writes "<date> <time>" for a time in ms since the epoch.  The date text
+*                      is only rebuilt when the day changes and the local time offset comes
+*                      from a small cache, so consecutive samples cost a few integer divides.
+*   @param pOut - where to write (at least EXPORT_FORMAT_MAX_FIELD_LENGTH chars)
+*   @param llTimeMS - ms since 1970-01-01T00:00:00 UTC
+*   @retval pointer just past the text written
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+char * iC3_ExportFormatter::formatDateTime( char * pOut, qint64 llTimeMS )
+{
+    if ( m_bLocalTime )
+    {
+        llTimeMS += getLocalOffsetMS( llTimeMS );
+    }
+
+    qint64 llDayNumber = floorDivide( llTimeMS, MS_PER_DAY );
+    int iMSOfDay = (int) ( llTimeMS - llDayNumber * MS_PER_DAY );
+
+    if ( llDayNumber != m_llCachedDayNumber )
+    {
+        // days since 1970-01-01 to a proleptic Gregorian date
+        qint64 llShifted = llDayNumber + 719468;
+        qint64 llEra = floorDivide( llShifted, 146097 );
+        int iDayOfEra = (int) ( llShifted - llEra * 146097 );
+        int iYearOfEra = ( iDayOfEra - iDayOfEra / 1460 + iDayOfEra / 36524 - iDayOfEra / 146096 ) / 365;
+        int iDayOfYear = iDayOfEra - ( 365 * iYearOfEra + iYearOfEra / 4 - iYearOfEra / 100 );
+        int iMonthIndex = ( 5 * iDayOfYear + 2 ) / 153;
+        int iDay = iDayOfYear - ( 153 * iMonthIndex + 2 ) / 5 + 1;
+        int iMonth = ( iMonthIndex < 10 ) ? ( iMonthIndex + 3 ) : ( iMonthIndex - 9 );
+        int iYear = (int) ( iYearOfEra + llEra * 400 ) + ( ( iMonth <= 2 ) ? 1 : 0 );
+
+        char * p = formatDate( m_acCachedDate, iYear, iMonth, iDay );
+        *p++ = ' ';
+
+        m_iCachedDateLength = (int) ( p - m_acCachedDate );
+        m_llCachedDayNumber = llDayNumber;
+    }
+
+    memcpy( pOut, m_acCachedDate, m_iCachedDateLength );
+
+    return formatTime( pOut + m_iCachedDateLength, iMSOfDay );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** formatDate() - writes a date in the resolved field order
+*   @param pOut - where to write (at least 10 chars)
+*   @param iYear, iMonth, iDay - the date; years outside 0 - 9999 are clamped
+*   @retval pointer just past the text written
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+char * iC3_ExportFormatter::formatDate( char * pOut, int iYear, int iMonth, int iDay ) const
+{
+    for ( int iField = 0; iField < 3; iField++ )
+    {
+        if ( iField > 0 )
+        {
+            *pOut++ = m_cDateSeparator;
+        }
+
+        switch ( m_aeDateFields[iField] )
+        {
+        case eFIELD_DAY:
+            pOut = writeDigits( pOut, iDay, 2 );
+            break;
+        case eFIELD_MONTH:
+            pOut = writeDigits( pOut, iMonth, 2 );
+            break;
+        case eFIELD_YEAR:
+            pOut = writeDigits( pOut, qBound( 0, iYear, 9999 ), 4 );
+            break;
+        }
+    }
+
+    return pOut;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** formatTime() - writes a time of day as "hh:mm" / "h:mm ap", plus seconds and ms as the
+*                  precision asks
+*   @param pOut - where to write (at least 16 chars)
+*   @param iMSOfDay - ms since midnight
+*   @retval pointer just past the text written
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+char * iC3_ExportFormatter::formatTime( char * pOut, int iMSOfDay ) const
+{
+    int iHour = iMSOfDay / 3600000;
+
+    if ( m_b12Hour )
+    {
+        int iHour12 = ( iHour % 12 == 0 ) ? 12 : ( iHour % 12 );
+        pOut = writeDigits( pOut, iHour12, ( iHour12 < 10 ) ? 1 : 2 );
+    }
+    else
+    {
+        pOut = writeDigits( pOut, iHour, 2 );
+    }
+
+    *pOut++ = ':';
+    pOut = writeDigits( pOut, ( iMSOfDay / 60000 ) % 60, 2 );
+
+    if ( m_ePrecision >= eEXPORT_TIME_SECONDS )
+    {
+        *pOut++ = ':';
+        pOut = writeDigits( pOut, ( iMSOfDay / 1000 ) % 60, 2 );
+    }
+
+    if ( m_ePrecision >= eEXPORT_TIME_MILLISECONDS )
+    {
+        *pOut++ = '.';
+        pOut = writeDigits( pOut, iMSOfDay % 1000, 3 );
+    }
+
+    if ( m_b12Hour )
+    {
+        *pOut++ = ' ';
+        *pOut++ = ( iHour < 12 ) ? 'a' : 'p';
+        *pOut++ = 'm';
+    }
+
+    return pOut;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** formatDouble() - writes a value with the configured number of decimals, or as the shortest
+*                    text that reads back as the same double.  Readings that parse from up to
+*                    6 decimals (every DMM reading) take an integer-only path; anything else,
+*                    including overload values and NaN, falls back to %G.
+*   @param pOut - where to write (at least EXPORT_FORMAT_MAX_FIELD_LENGTH chars)
+*   @param dValue - the value
+*   @retval pointer just past the text written
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+char * iC3_ExportFormatter::formatDouble( char * pOut, double dValue ) const
+{
+    if ( !( dValue > -SHORTEST_FAST_PATH_LIMIT && dValue < SHORTEST_FAST_PATH_LIMIT ) )
+    {
+        return writeShortestGeneral( pOut, dValue );
+    }
+
+    int iDecimals = m_iDecimals;
+    qint64 llScale = ( iDecimals >= 0 ) ? POWERS_OF_TEN[iDecimals] : SHORTEST_FAST_PATH_SCALE;
+
+    if ( qAbs( dValue ) * (double) llScale >= 9.0E18 )
+    {
+        return pOut + qsnprintf( pOut, EXPORT_FORMAT_MAX_FIELD_LENGTH, "%.*f", iDecimals, dValue );
+    }
+
+    qint64 llScaled = qRound64( dValue * (double) llScale );
+
+    if ( iDecimals < 0 )
+    {
+        if ( (double) llScaled / (double) llScale != dValue )
+        {
+            return writeShortestGeneral( pOut, dValue );
+        }
+
+        // drop the trailing zeros of the 6 decimals
+        iDecimals = SHORTEST_FAST_PATH_DECIMALS;
+        while ( ( iDecimals > 0 ) && ( llScaled % 10 == 0 ) )
+        {
+            llScaled /= 10;
+            llScale /= 10;
+            iDecimals--;
+        }
+    }
+
+    if ( llScaled < 0 )
+    {
+        *pOut++ = '-';
+        llScaled = -llScaled;
+    }
+
+    pOut = formatInteger( pOut, llScaled / llScale );
+
+    if ( iDecimals > 0 )
+    {
+        *pOut++ = '.';
+        pOut = writeDigits( pOut, llScaled % llScale, iDecimals );
+    }
+
+    return pOut;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** formatInteger() - writes a decimal integer
+*   @param pOut - where to write (at least 20 chars)
+*   @param llValue - the value
+*   @retval pointer just past the text written
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+char * iC3_ExportFormatter::formatInteger( char * pOut, qint64 llValue )
+{
+    char acDigits[24];
+    int iLength = 0;
+    quint64 ullValue = ( llValue < 0 ) ? ( 0 - (quint64) llValue ) : (quint64) llValue;
+
+    do
+    {
+        acDigits[iLength++] = (char) ( '0' + ullValue % 10 );
+        ullValue /= 10;
+    } while ( ullValue != 0 );
+
+    if ( llValue < 0 )
+    {
+        *pOut++ = '-';
+    }
+
+    while ( iLength > 0 )
+    {
+        *pOut++ = acDigits[--iLength];
+    }
+
+    return pOut;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** dateTimeToString() - formatDateTime() for callers that want a QString
+*   @param llTimeMS - ms since the epoch
+*   @retval the formatted date and time
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+QString iC3_ExportFormatter::dateTimeToString( qint64 llTimeMS )
+{
+    char acText[EXPORT_FORMAT_MAX_FIELD_LENGTH];
+    char * pEnd = formatDateTime( acText, llTimeMS );
+
+    return QString::fromLatin1( acText, (int) ( pEnd - acText ) );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getLocalOffsetMS() - local time minus UTC at llTimeMS.  Qt's conversion is only run once
+*                        per 15 minute slot; an export walking forward through time hits the
+*                        cache for every other sample.
+*   @param llTimeMS - ms since the epoch
+*   @retval offset in ms
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+qint64 iC3_ExportFormatter::getLocalOffsetMS( qint64 llTimeMS )
+{
+    qint64 llSlot = floorDivide( llTimeMS, EXPORT_FORMAT_OFFSET_SLOT_MS );
+    int iIndex = (int) ( llSlot & ( EXPORT_FORMAT_OFFSET_CACHE_SIZE - 1 ) );
+
+    if ( m_allOffsetSlots[iIndex] != llSlot )
+    {
+        qint64 llSlotStartMS = llSlot * EXPORT_FORMAT_OFFSET_SLOT_MS;
+        QDateTime localTime = QDateTime::fromMSecsSinceEpoch( llSlotStartMS ).toLocalTime();
+        QDateTime localFieldsAsUTC( localTime.date(), localTime.time(), Qt::UTC );
+
+        m_allOffsetSlots[iIndex] = llSlot;
+        m_allOffsetsMS[iIndex] = localFieldsAsUTC.toMSecsSinceEpoch() - llSlotStartMS;
+    }
+
+    return m_allOffsetsMS[iIndex];
+}
@@ -0,0 +1,88 @@
+#ifndef IC3_EXPORTFORMATTER_H
+#define IC3_EXPORTFORMATTER_H
+
+/**
+*     @file iC3_ExportFormatter.h
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief This header file defines iC3_ExportFormatter, which writes dates, times and numbers
+*            for CSV files and reports straight into a char buffer.  The eDateFormats /
+*            eTimeFormats pair is resolved once, when the formatter is set up, into a field
+*            order and a few flags, instead of building and parsing a Qt format string for
+*            every cell.
+*/
+
+#include <QtGlobal>
+#include <QString>
+
+#include "iC3_DMM_Constants.h"
+
+enum eExportTimePrecision
+{
+    eEXPORT_TIME_MINUTES            = 0,        // hh:mm - what the GUI shows
+    eEXPORT_TIME_SECONDS            = 1,        // hh:mm:ss
+    eEXPORT_TIME_MILLISECONDS       = 2         // hh:mm:ss.zzz
+};
+
+// longest text any one format call writes (a %.17G double is 24 chars)
+static const int EXPORT_FORMAT_MAX_FIELD_LENGTH = 32;
+
+// the local time offset is cached per 15 minute slot of UTC time; every time zone changes
+// its offset on a 15 minute boundary
+static const qint64 EXPORT_FORMAT_OFFSET_SLOT_MS    = 15 * 60 * 1000;
+static const int    EXPORT_FORMAT_OFFSET_CACHE_SIZE = 64;       // power of 2
+
+class iC3_ExportFormatter
+{
+public:
+    iC3_ExportFormatter();
+    iC3_ExportFormatter( eDateFormats dateFormat,
+                         eTimeFormats timeFormat,
+                         eExportTimePrecision ePrecision = eEXPORT_TIME_MINUTES,
+                         bool bLocalTime = true,
+                         int iDecimals = -1 );
+
+    void setFormat( eDateFormats dateFormat,
+                    eTimeFormats timeFormat,
+                    eExportTimePrecision ePrecision = eEXPORT_TIME_MINUTES,
+                    bool bLocalTime = true,
+                    int iDecimals = -1 );
+
+    bool isLocalTime( void ) const;
+
+    char * formatDateTime( char * pOut, qint64 llTimeMS );
+    char * formatDate( char * pOut, int iYear, int iMonth, int iDay ) const;
+    char * formatTime( char * pOut, int iMSOfDay ) const;
+    char * formatDouble( char * pOut, double dValue ) const;
+    static char * formatInteger( char * pOut, qint64 llValue );
+
+    QString dateTimeToString( qint64 llTimeMS );
+
+private:
+    enum eDateFields
+    {
+        eFIELD_DAY                  = 0,
+        eFIELD_MONTH                = 1,
+        eFIELD_YEAR                 = 2
+    };
+
+    qint64 getLocalOffsetMS( qint64 llTimeMS );
+
+    // resolved format
+    eDateFields m_aeDateFields[3];
+    char m_cDateSeparator;
+    bool m_b12Hour;
+    eExportTimePrecision m_ePrecision;
+    bool m_bLocalTime;
+    int m_iDecimals;                                // -1: shortest text that reads back exactly
+
+    // date text of the last day formatted, including the trailing space
+    qint64 m_llCachedDayNumber;
+    char m_acCachedDate[12];
+    int m_iCachedDateLength;
+
+    qint64 m_allOffsetSlots[EXPORT_FORMAT_OFFSET_CACHE_SIZE];
+    qint64 m_allOffsetsMS[EXPORT_FORMAT_OFFSET_CACHE_SIZE];
+};
+
+#endif // IC3_EXPORTFORMATTER_H
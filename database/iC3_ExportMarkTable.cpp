@@ -0,0 +1,216 @@
+/**
+*     @file iC3_ExportMarkTable.cpp
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief this cpp file implements the iC3_ExportMarkTable class.
+*/
+
+#include <QSqlError>
+#include <QDebug>
+#include <QVariant>
+
+#include "iC3_ExportMarkTable.h"
+
+//-----------------------------------------------------------------------------------------------
+/** constructor
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_ExportMarkTable::iC3_ExportMarkTable()
+{
+    iC3_DatabaseColumnDef * pColumn;
+
+    m_sTableName = "ExportMarks";
+
+    setNumberOfColumns( e_NUMBER_OF_EXPORT_MARK_TABLE_COLUMNS );
+
+    pColumn = new iC3_DatabaseColumnDef( tr("destination"), "TEXT", "NOT NULL" );
+    AddColumnDef( e_EXPORT_MARK_TABLE_DESTINATION_COL, pColumn );
+
+    pColumn = new iC3_DatabaseColumnDef( tr("deviceID"), "INTEGER", "NOT NULL" );
+    AddColumnDef( e_EXPORT_MARK_TABLE_DEVICE_ID_COL, pColumn );
+
+    pColumn = new iC3_DatabaseColumnDef( tr("lastSampleTimeMS"), "INTEGER", "NOT NULL" );
+    AddColumnDef( e_EXPORT_MARK_TABLE_LAST_TIME_COL, pColumn );
+
+    pColumn = new iC3_DatabaseColumnDef( tr("lastSequenceIndex"), "INTEGER", "NOT NULL" );
+    AddColumnDef( e_EXPORT_MARK_TABLE_LAST_SEQUENCE_COL, pColumn );
+
+    pColumn = new iC3_DatabaseColumnDef( tr("previousSampleTimeMS"), "INTEGER", "NOT NULL" );
+    AddColumnDef( e_EXPORT_MARK_TABLE_PREVIOUS_TIME_COL, pColumn );
+
+    pColumn = new iC3_DatabaseColumnDef( tr("previousSequenceIndex"), "INTEGER", "NOT NULL" );
+    AddColumnDef( e_EXPORT_MARK_TABLE_PREVIOUS_SEQUENCE_COL, pColumn );
+
+    // NULL once the file holding the rows up to the mark is in place
+    pColumn = new iC3_DatabaseColumnDef( tr("pendingFileName"), "TEXT", "" );
+    AddColumnDef( e_EXPORT_MARK_TABLE_PENDING_FILE_COL, pColumn );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** CreateTable() - creates the ExportMarks table and its (destination, deviceID) key if they
+*                   do not exist.
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @retval true - the table exists
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_ExportMarkTable::CreateTable( QSqlDatabase & database )
+{
+    QSqlQuery query( database );
+
+    ClearLastError();
+
+    if ( !database.isOpen() )
+    {
+        SetLastError( "iC3_ExportMarkTable::CreateTable() - Database is not open" );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    QString sIndexSQL = QString("CREATE UNIQUE INDEX IF NOT EXISTS %1_DestinationDevice ON %1 ( %2, %3 )")
+                            .arg( m_sTableName )
+                            .arg( getColumnDef( e_EXPORT_MARK_TABLE_DESTINATION_COL )->getColumnName() )
+                            .arg( getColumnDef( e_EXPORT_MARK_TABLE_DEVICE_ID_COL )->getColumnName() );
+
+    if ( !query.exec( getTableCreationSQL( m_sTableName ) ) || !query.exec( sIndexSQL ) )
+    {
+        SetLastError( QString("iC3_ExportMarkTable::CreateTable() - Query Error: %1").arg( query.lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** readMark() - reads a destination's mark for a device.  A destination that has never been
+*                exported to gets a mark before the first possible sample and no pending file.
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @param sDestination - the export destination
+*   @param iDeviceID - the device
+*   @param mark - set to the stored (or initial) mark
+*   @retval true - the query succeeded
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_ExportMarkTable::readMark( QSqlDatabase & database,
+                                    const QString & sDestination,
+                                    int iDeviceID,
+                                    iC3_ExportMark & mark )
+{
+    ClearLastError();
+
+    QSqlQuery * pQuery = getPreparedQuery( database, e_EXPORT_MARK_STMT_READ,
+                                           QString("SELECT * FROM %1 WHERE %2 = ? AND %3 = ?")
+                                               .arg( m_sTableName )
+                                               .arg( getColumnDef( e_EXPORT_MARK_TABLE_DESTINATION_COL )->getColumnName() )
+                                               .arg( getColumnDef( e_EXPORT_MARK_TABLE_DEVICE_ID_COL )->getColumnName() ) );
+    if ( pQuery == NULL )
+    {
+        return false;
+    }
+
+    pQuery->bindValue( 0, sDestination );
+    pQuery->bindValue( 1, iDeviceID );
+
+    if ( !pQuery->exec() )
+    {
+        SetLastError( QString("iC3_ExportMarkTable::readMark() - Query Error: %1").arg( pQuery->lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    mark.sDestination = sDestination;
+    mark.iDeviceID = iDeviceID;
+
+    if ( pQuery->next() )
+    {
+        mark.llLastSampleTimeMS = pQuery->value( e_EXPORT_MARK_TABLE_LAST_TIME_COL ).toLongLong();
+        mark.llLastSequenceIndex = pQuery->value( e_EXPORT_MARK_TABLE_LAST_SEQUENCE_COL ).toLongLong();
+        mark.llPreviousSampleTimeMS = pQuery->value( e_EXPORT_MARK_TABLE_PREVIOUS_TIME_COL ).toLongLong();
+        mark.llPreviousSequenceIndex = pQuery->value( e_EXPORT_MARK_TABLE_PREVIOUS_SEQUENCE_COL ).toLongLong();
+        mark.sPendingFileName = pQuery->value( e_EXPORT_MARK_TABLE_PENDING_FILE_COL ).toString();
+    }
+    else
+    {
+        mark.llLastSampleTimeMS = 0;
+        mark.llLastSequenceIndex = -1;
+        mark.llPreviousSampleTimeMS = mark.llLastSampleTimeMS;
+        mark.llPreviousSequenceIndex = mark.llLastSequenceIndex;
+        mark.sPendingFileName.clear();
+    }
+
+    pQuery->finish();
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** writeMark() - stores a destination's mark for a device, replacing the previous one
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @param mark - the mark to store
+*   @retval true - the mark was written
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_ExportMarkTable::writeMark( QSqlDatabase & database, const iC3_ExportMark & mark )
+{
+    ClearLastError();
+
+    QSqlQuery * pQuery = getPreparedQuery( database, e_EXPORT_MARK_STMT_WRITE,
+                                           QString("INSERT OR REPLACE INTO %1 %2 VALUES ( ?, ?, ?, ?, ?, ?, ? )")
+                                               .arg( m_sTableName ).arg( getSQL_ColumnNames() ) );
+    if ( pQuery == NULL )
+    {
+        return false;
+    }
+
+    pQuery->bindValue( e_EXPORT_MARK_TABLE_DESTINATION_COL, mark.sDestination );
+    pQuery->bindValue( e_EXPORT_MARK_TABLE_DEVICE_ID_COL, mark.iDeviceID );
+    pQuery->bindValue( e_EXPORT_MARK_TABLE_LAST_TIME_COL, mark.llLastSampleTimeMS );
+    pQuery->bindValue( e_EXPORT_MARK_TABLE_LAST_SEQUENCE_COL, mark.llLastSequenceIndex );
+    pQuery->bindValue( e_EXPORT_MARK_TABLE_PREVIOUS_TIME_COL, mark.llPreviousSampleTimeMS );
+    pQuery->bindValue( e_EXPORT_MARK_TABLE_PREVIOUS_SEQUENCE_COL, mark.llPreviousSequenceIndex );
+    pQuery->bindValue( e_EXPORT_MARK_TABLE_PENDING_FILE_COL,
+                       mark.sPendingFileName.isEmpty() ? QVariant( QVariant::String ) : QVariant( mark.sPendingFileName ) );
+
+    if ( !pQuery->exec() )
+    {
+        SetLastError( QString("iC3_ExportMarkTable::writeMark() - Query Error: %1").arg( pQuery->lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getSQL_ColumnNames() - returns "( col, col, ... )" for all columns
+*   @retval column name list usable in an sql statement
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+QString iC3_ExportMarkTable::getSQL_ColumnNames( void )
+{
+    QString sColumnNames = QString("( %1").arg( getColumnDef( 0 )->getColumnName() );
+
+    for ( int iIndex = 1; iIndex < e_NUMBER_OF_EXPORT_MARK_TABLE_COLUMNS; iIndex++ )
+    {
+        sColumnNames.append( QString(", %1").arg( getColumnDef( iIndex )->getColumnName() ) );
+    }
+
+    sColumnNames.append( " )" );
+
+    return sColumnNames;
+}
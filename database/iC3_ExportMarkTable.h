@@ -0,0 +1,67 @@
+#ifndef IC3_EXPORTMARKTABLE_H
+#define IC3_EXPORTMARKTABLE_H
+
+/**
+*     @file iC3_ExportMarkTable.h
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief This header file defines the iC3_ExportMarkTable class.  One row per export
+*            destination and device records the last sample already exported there, so each
+*            incremental export only writes what is new.
+*/
+
+#include "iC3_DatabaseTable.h"
+
+struct iC3_ExportMark
+{
+    QString sDestination;
+    int     iDeviceID;
+
+    // (time, sequence) of the last sample exported - the export order
+    qint64  llLastSampleTimeMS;
+    qint64  llLastSequenceIndex;
+
+    // while sPendingFileName is set, the mark above belongs to that file, which may not have
+    // been put in place yet, and these hold the mark to fall back to if it never was
+    qint64  llPreviousSampleTimeMS;
+    qint64  llPreviousSequenceIndex;
+    QString sPendingFileName;
+};
+
+class iC3_ExportMarkTable : public iC3_DatabaseTable
+{
+public:
+    iC3_ExportMarkTable();
+
+    enum eIC3_ExportMarkTableColumns
+    {
+        e_EXPORT_MARK_TABLE_DESTINATION_COL         = 0,
+        e_EXPORT_MARK_TABLE_DEVICE_ID_COL           = 1,
+        e_EXPORT_MARK_TABLE_LAST_TIME_COL           = 2,
+        e_EXPORT_MARK_TABLE_LAST_SEQUENCE_COL       = 3,
+        e_EXPORT_MARK_TABLE_PREVIOUS_TIME_COL       = 4,
+        e_EXPORT_MARK_TABLE_PREVIOUS_SEQUENCE_COL   = 5,
+        e_EXPORT_MARK_TABLE_PENDING_FILE_COL        = 6,
+
+        e_NUMBER_OF_EXPORT_MARK_TABLE_COLUMNS
+    };
+
+    enum eIC3_ExportMarkTableStatements
+    {
+        e_EXPORT_MARK_STMT_READ                     = 0,
+        e_EXPORT_MARK_STMT_WRITE                    = 1
+    };
+
+    bool CreateTable( QSqlDatabase & database );
+
+    bool readMark( QSqlDatabase & database,
+                   const QString & sDestination,
+                   int iDeviceID,
+                   iC3_ExportMark & mark );
+
+    bool writeMark( QSqlDatabase & database, const iC3_ExportMark & mark );
+
+    QString getSQL_ColumnNames( void );
+};
+
+#endif // IC3_EXPORTMARKTABLE_H
@@ -0,0 +1,249 @@
+/**
+*     @file iC3_SequenceAllocator.cpp
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief this cpp file implements the iC3_SequenceAllocator class.
+*/
+
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QThread>
+#include <QDebug>
+
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
+
+#include "iC3_SequenceAllocator.h"
+
+//-----------------------------------------------------------------------------------------------
+/** constructor
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_SequenceAllocator::iC3_SequenceAllocator() :
+    m_bOpen( 0 ),
+    m_llNextIndex( 1 ),
+    m_llReservedEnd( 1 ),
+    m_bReserving( 0 )
+{
+}
+
+//-----------------------------------------------------------------------------------------------
+/** open() - continues the sequence recorded in sFileName and reserves the first block.  Not
+*            thread safe; call before any allocate().
+*   @param sFileName - the sequence file, created (with its directory) if it does not exist
+*   @param llLastUsedIndex - the highest index already stored anywhere; allocation continues
+*                            after it if the file is behind (or new)
+*   @retval true - indices can be allocated
+*   @retval false - the file could not be read or written.  Use GetLastError() to retrieve
+*                   error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_SequenceAllocator::open( const QString & sFileName, qint64 llLastUsedIndex )
+{
+    close();
+
+    m_sFileName = sFileName;
+
+    qint64 llNextIndex = qMax( llLastUsedIndex + 1, Q_INT64_C(1) );
+    QFile file( sFileName );
+
+    if ( file.exists() )
+    {
+        quint32 ulMagic = 0;
+        quint32 ulVersion = 0;
+        qint64 llReservedEnd = 0;
+
+        if ( !file.open( QIODevice::ReadOnly ) )
+        {
+            m_sLastError = QString("iC3_SequenceAllocator::open() - Unable to open: %1: %2").arg( sFileName ).arg( file.errorString() );
+            qDebug() << m_sLastError;
+            return false;
+        }
+
+        QDataStream stream( &file );
+
+        stream >> ulMagic >> ulVersion >> llReservedEnd;
+
+        // continuing from a guess could hand out an index twice
+        if ( ( stream.status() != QDataStream::Ok ) ||
+             ( ulMagic != SEQUENCE_FILE_MAGIC ) || ( ulVersion != SEQUENCE_FILE_VERSION ) )
+        {
+            m_sLastError = QString("iC3_SequenceAllocator::open() - Not a valid sequence file: %1").arg( sFileName );
+            qDebug() << m_sLastError;
+            return false;
+        }
+
+        // any index below the recorded end may have been handed out before the process stopped
+        llNextIndex = qMax( llNextIndex, llReservedEnd );
+    }
+    else if ( !QDir().mkpath( QFileInfo( sFileName ).absolutePath() ) )
+    {
+        m_sLastError = QString("iC3_SequenceAllocator::open() - Unable to create directory for: %1").arg( sFileName );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    if ( !writeReservedEnd( llNextIndex + SEQUENCE_ALLOCATOR_BLOCK_SIZE ) )
+    {
+        return false;
+    }
+
+    m_llNextIndex.store( llNextIndex );
+    m_llReservedEnd.store( llNextIndex + SEQUENCE_ALLOCATOR_BLOCK_SIZE );
+    m_bReserving.storeRelease( 0 );
+    m_bOpen.storeRelease( 1 );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** close() - stops allocation.  The rest of the reserved block is skipped by the next open().
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_SequenceAllocator::close( void )
+{
+    m_bOpen.storeRelease( 0 );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** allocate() - hands out the next sequence index.  Safe to call from any thread; an atomic
+*                increment within the reserved block, with the sequence file written once per
+*                SEQUENCE_ALLOCATOR_BLOCK_SIZE indices by whichever caller reaches the refill
+*                point.  Indices from concurrent callers are unique and increase in the order
+*                they were allocated, but need not be consecutive.
+*   @param llSequenceIndex - set to the index allocated
+*   @retval true - the index is reserved in the sequence file
+*   @retval false - the allocator is not open, or the next block could not be reserved
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_SequenceAllocator::allocate( qint64 & llSequenceIndex )
+{
+    if ( m_bOpen.loadAcquire() == 0 )
+    {
+        return false;
+    }
+
+    llSequenceIndex = m_llNextIndex.fetch_add( 1 );
+
+    qint64 llReservedEnd = m_llReservedEnd.load( std::memory_order_acquire );
+
+    // reserve the next block while the rest of this one is still being handed out; a failure
+    // here is retried when the block runs out
+    if ( ( llReservedEnd - llSequenceIndex == SEQUENCE_ALLOCATOR_REFILL_REMAINING ) &&
+         m_bReserving.testAndSetAcquire( 0, 1 ) )
+    {
+        reserveThrough( llReservedEnd );
+        m_bReserving.storeRelease( 0 );
+    }
+
+    while ( llSequenceIndex >= m_llReservedEnd.load( std::memory_order_acquire ) )
+    {
+        if ( m_bReserving.testAndSetAcquire( 0, 1 ) )
+        {
+            bool bReserved = reserveThrough( llSequenceIndex );
+            m_bReserving.storeRelease( 0 );
+
+            if ( !bReserved )
+            {
+                return false;
+            }
+        }
+        else
+        {
+            // another caller is writing the file
+            QThread::yieldCurrentThread();
+        }
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** GetLastError() - returns the last error encountered by open() or a block reservation
+*   @retval QString - error description
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+QString iC3_SequenceAllocator::GetLastError( void )
+{
+    return m_sLastError;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** reserveThrough() - extends the reserved block to cover llSequenceIndex and a full block
+*                      after it.  Called only by the caller holding m_bReserving.
+*   @param llSequenceIndex - the index that must be reserved
+*   @retval true - llSequenceIndex is reserved
+*   @retval false - the sequence file could not be written
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_SequenceAllocator::reserveThrough( qint64 llSequenceIndex )
+{
+    if ( llSequenceIndex < m_llReservedEnd.load( std::memory_order_acquire ) )
+    {
+        return true;
+    }
+
+    qint64 llReservedEnd = llSequenceIndex + SEQUENCE_ALLOCATOR_BLOCK_SIZE;
+
+    if ( !writeReservedEnd( llReservedEnd ) )
+    {
+        return false;
+    }
+
+    // only now may indices of the new block be handed out
+    m_llReservedEnd.store( llReservedEnd, std::memory_order_release );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** writeReservedEnd() - replaces the sequence file with one recording llReservedEnd.  The new
+*                        file is synced and renamed over the old, so a crash leaves one or the
+*                        other, never a partial file.
+*   @param llReservedEnd - the first index not reserved
+*   @retval true - the file records llReservedEnd
+*   @retval false - an error occurred.  Use GetLastError() to retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_SequenceAllocator::writeReservedEnd( qint64 llReservedEnd )
+{
+    QSaveFile file( m_sFileName );
+
+    if ( !file.open( QIODevice::WriteOnly ) )
+    {
+        m_sLastError = QString("iC3_SequenceAllocator::writeReservedEnd() - Unable to open: %1: %2").arg( m_sFileName ).arg( file.errorString() );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    QDataStream stream( &file );
+
+    stream << SEQUENCE_FILE_MAGIC << SEQUENCE_FILE_VERSION << llReservedEnd;
+
+    bool bRC = ( stream.status() == QDataStream::Ok ) && file.flush();
+
+#ifdef Q_OS_UNIX
+    bRC = bRC && ( ::fsync( file.handle() ) == 0 );
+#endif
+
+    if ( !bRC || !file.commit() )
+    {
+        m_sLastError = QString("iC3_SequenceAllocator::writeReservedEnd() - Unable to write: %1: %2").arg( m_sFileName ).arg( file.errorString() );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,56 @@
+#ifndef IC3_SEQUENCEALLOCATOR_H
+#define IC3_SEQUENCEALLOCATOR_H
+
+/**
+*     @file iC3_SequenceAllocator.h
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief This header file defines the iC3_SequenceAllocator class, which hands out event
+*            sequence indices from any thread without a lock.  Indices are reserved in blocks
+*            and only the end of the reserved block is written to the sequence file, so an
+*            index is never handed out twice, even across a crash; the indices left unused in
+*            a block when the process stops are skipped.
+*/
+
+#include <QtGlobal>
+#include <QAtomicInt>
+#include <QString>
+#include <atomic>
+
+// indices reserved per write of the sequence file
+static const qint64 SEQUENCE_ALLOCATOR_BLOCK_SIZE       = 4096;
+
+// the caller that takes the index this far from the end of the block reserves the next one, so
+// the others rarely find the block used up and have to wait for the write
+static const qint64 SEQUENCE_ALLOCATOR_REFILL_REMAINING = SEQUENCE_ALLOCATOR_BLOCK_SIZE / 4;
+
+static const quint32 SEQUENCE_FILE_MAGIC                = 0x69433353;   // "iC3S"
+static const quint32 SEQUENCE_FILE_VERSION              = 1;
+
+class iC3_SequenceAllocator
+{
+public:
+    iC3_SequenceAllocator();
+
+    bool open( const QString & sFileName, qint64 llLastUsedIndex );
+    void close( void );
+
+    bool allocate( qint64 & llSequenceIndex );
+
+    QString GetLastError( void );
+
+private:
+
+    bool reserveThrough( qint64 llSequenceIndex );
+    bool writeReservedEnd( qint64 llReservedEnd );
+
+    QString m_sFileName;                            // set by open() before any allocate()
+    QString m_sLastError;                           // written by open() and the reserving caller
+
+    QAtomicInt m_bOpen;
+    std::atomic<qint64> m_llNextIndex;
+    std::atomic<qint64> m_llReservedEnd;            // indices below this are recorded in the file
+    QAtomicInt m_bReserving;                        // held by the one caller writing the file
+};
+
+#endif // IC3_SEQUENCEALLOCATOR_H
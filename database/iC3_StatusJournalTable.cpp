@@ -0,0 +1,269 @@
+/**
+*     @file iC3_StatusJournalTable.cpp
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief this cpp file implements the iC3_StatusJournalTable class.
+*/
+
+#include <QSqlError>
+#include <QDebug>
+#include <QVariant>
+
+#include "iC3_StatusJournalTable.h"
+
+//-----------------------------------------------------------------------------------------------
+/** constructor
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_StatusJournalTable::iC3_StatusJournalTable()
+{
+    iC3_DatabaseColumnDef * pColumn;
+
+    m_sTableName = "StatusJournal";
+
+    setNumberOfColumns( e_NUMBER_OF_STATUS_JOURNAL_TABLE_COLUMNS );
+
+    pColumn = new iC3_DatabaseColumnDef( tr("deviceID"), "INTEGER", "NOT NULL" );
+    AddColumnDef( e_STATUS_JOURNAL_TABLE_DEVICE_ID_COL, pColumn );
+
+    pColumn = new iC3_DatabaseColumnDef( tr("statusTimeMS"), "INTEGER", "NOT NULL" );
+    AddColumnDef( e_STATUS_JOURNAL_TABLE_STATUS_TIME_COL, pColumn );
+
+    // an eDeviceStatusFields value
+    pColumn = new iC3_DatabaseColumnDef( tr("fieldID"), "INTEGER", "NOT NULL" );
+    AddColumnDef( e_STATUS_JOURNAL_TABLE_FIELD_ID_COL, pColumn );
+
+    // 1 on every row of a keyframe, 0 on a change
+    pColumn = new iC3_DatabaseColumnDef( tr("keyframe"), "INTEGER", "NOT NULL" );
+    AddColumnDef( e_STATUS_JOURNAL_TABLE_KEYFRAME_COL, pColumn );
+
+    pColumn = new iC3_DatabaseColumnDef( tr("value"), "TEXT", "NOT NULL" );
+    AddColumnDef( e_STATUS_JOURNAL_TABLE_VALUE_COL, pColumn );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** CreateTable() - creates the StatusJournal table and its (deviceID, statusTimeMS) index if
+*                   they do not exist.
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @retval true - the table exists
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_StatusJournalTable::CreateTable( QSqlDatabase & database )
+{
+    QSqlQuery query( database );
+
+    ClearLastError();
+
+    if ( !database.isOpen() )
+    {
+        SetLastError( "iC3_StatusJournalTable::CreateTable() - Database is not open" );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    QString sIndexSQL = QString("CREATE INDEX IF NOT EXISTS %1_DeviceTime ON %1 ( %2, %3 )")
+                            .arg( m_sTableName )
+                            .arg( getColumnDef( e_STATUS_JOURNAL_TABLE_DEVICE_ID_COL )->getColumnName() )
+                            .arg( getColumnDef( e_STATUS_JOURNAL_TABLE_STATUS_TIME_COL )->getColumnName() );
+
+    if ( !query.exec( getTableCreationSQL( m_sTableName ) ) || !query.exec( sIndexSQL ) )
+    {
+        SetLastError( QString("iC3_StatusJournalTable::CreateTable() - Query Error: %1").arg( query.lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** journalStatus() - writes the fields of a status poll that differ from the previous poll, or
+*                     all of them as a keyframe
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @param status - the status just polled
+*   @param pPreviousStatus - the device's last journaled status, NULL to write a keyframe
+*   @param iRowsWritten - set to the number of rows written
+*   @retval true - the changes were written
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.  Rows already written are not removed.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_StatusJournalTable::journalStatus( QSqlDatabase & database,
+                                            const iC3_DeviceStatus & status,
+                                            const iC3_DeviceStatus * pPreviousStatus,
+                                            int & iRowsWritten )
+{
+    ClearLastError();
+
+    iRowsWritten = 0;
+
+    QSqlQuery * pQuery = getPreparedQuery( database, e_STATUS_JOURNAL_STMT_INSERT,
+                                           QString("INSERT INTO %1 %2 VALUES ( ?, ?, ?, ?, ? )")
+                                               .arg( m_sTableName ).arg( getSQL_ColumnNames() ) );
+    if ( pQuery == NULL )
+    {
+        return false;
+    }
+
+    int iKeyframe = ( pPreviousStatus == NULL ) ? 1 : 0;
+
+    for ( int iField = 0; iField < eDEVICE_STATUS_FIELD_COUNT; iField++ )
+    {
+        if ( ( pPreviousStatus != NULL ) && ( pPreviousStatus->asFields[iField] == status.asFields[iField] ) )
+        {
+            continue;
+        }
+
+        pQuery->bindValue( e_STATUS_JOURNAL_TABLE_DEVICE_ID_COL, status.iDeviceID );
+        pQuery->bindValue( e_STATUS_JOURNAL_TABLE_STATUS_TIME_COL, status.llStatusTimeMS );
+        pQuery->bindValue( e_STATUS_JOURNAL_TABLE_FIELD_ID_COL, iField );
+        pQuery->bindValue( e_STATUS_JOURNAL_TABLE_KEYFRAME_COL, iKeyframe );
+        pQuery->bindValue( e_STATUS_JOURNAL_TABLE_VALUE_COL,
+                           status.asFields[iField].isNull() ? QString("") : status.asFields[iField] );
+
+        if ( !pQuery->exec() )
+        {
+            SetLastError( QString("iC3_StatusJournalTable::journalStatus() - Query Error: %1").arg( pQuery->lastError().text() ) );
+            qDebug() << m_sLastError;
+            return false;
+        }
+
+        iRowsWritten++;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getStatusAtTime() - rebuilds a device's status as it was at llTimeMS from the last keyframe
+*                       at or before that time and the changes journaled after it.  Run inside
+*                       a read transaction so both queries see the same journal.
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @param iDeviceID - the device
+*   @param llTimeMS - ms since the epoch
+*   @param status - set to the rebuilt status.  llStatusTimeMS is the time of the last change
+*                   applied; 0, with every field empty, if nothing was journaled by llTimeMS.
+*   @retval true - the queries succeeded
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_StatusJournalTable::getStatusAtTime( QSqlDatabase & database,
+                                              int iDeviceID,
+                                              qint64 llTimeMS,
+                                              iC3_DeviceStatus & status )
+{
+    ClearLastError();
+
+    status.iDeviceID = iDeviceID;
+    status.llStatusTimeMS = 0;
+    for ( int iField = 0; iField < eDEVICE_STATUS_FIELD_COUNT; iField++ )
+    {
+        status.asFields[iField].clear();
+    }
+
+    QString sDeviceColumn = getColumnDef( e_STATUS_JOURNAL_TABLE_DEVICE_ID_COL )->getColumnName();
+    QString sTimeColumn = getColumnDef( e_STATUS_JOURNAL_TABLE_STATUS_TIME_COL )->getColumnName();
+
+    // walks the (deviceID, statusTimeMS) index back from llTimeMS, so it reads no further than
+    // one keyframe interval
+    QSqlQuery * pQuery = getPreparedQuery( database, e_STATUS_JOURNAL_STMT_FIND_KEYFRAME,
+                                           QString("SELECT %3 FROM %1 WHERE %2 = ? AND %3 <= ? AND %4 = 1 ORDER BY %3 DESC LIMIT 1")
+                                               .arg( m_sTableName )
+                                               .arg( sDeviceColumn )
+                                               .arg( sTimeColumn )
+                                               .arg( getColumnDef( e_STATUS_JOURNAL_TABLE_KEYFRAME_COL )->getColumnName() ) );
+    if ( pQuery == NULL )
+    {
+        return false;
+    }
+
+    pQuery->bindValue( 0, iDeviceID );
+    pQuery->bindValue( 1, llTimeMS );
+
+    if ( !pQuery->exec() )
+    {
+        SetLastError( QString("iC3_StatusJournalTable::getStatusAtTime() - Query Error: %1").arg( pQuery->lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    if ( !pQuery->next() )
+    {
+        pQuery->finish();
+        return true;
+    }
+
+    qint64 llKeyframeTimeMS = pQuery->value( 0 ).toLongLong();
+    pQuery->finish();
+
+    pQuery = getPreparedQuery( database, e_STATUS_JOURNAL_STMT_SELECT_RANGE,
+                               QString("SELECT %3, %4, %5 FROM %1 WHERE %2 = ? AND %3 >= ? AND %3 <= ? ORDER BY %3, rowid")
+                                   .arg( m_sTableName )
+                                   .arg( sDeviceColumn )
+                                   .arg( sTimeColumn )
+                                   .arg( getColumnDef( e_STATUS_JOURNAL_TABLE_FIELD_ID_COL )->getColumnName() )
+                                   .arg( getColumnDef( e_STATUS_JOURNAL_TABLE_VALUE_COL )->getColumnName() ) );
+    if ( pQuery == NULL )
+    {
+        return false;
+    }
+
+    pQuery->setForwardOnly( true );
+    pQuery->bindValue( 0, iDeviceID );
+    pQuery->bindValue( 1, llKeyframeTimeMS );
+    pQuery->bindValue( 2, llTimeMS );
+
+    if ( !pQuery->exec() )
+    {
+        SetLastError( QString("iC3_StatusJournalTable::getStatusAtTime() - Query Error: %1").arg( pQuery->lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    while ( pQuery->next() )
+    {
+        int iField = pQuery->value( 1 ).toInt();
+
+        // a field written by a newer build is skipped
+        if ( ( iField >= 0 ) && ( iField < eDEVICE_STATUS_FIELD_COUNT ) )
+        {
+            status.asFields[iField] = pQuery->value( 2 ).toString();
+        }
+        status.llStatusTimeMS = pQuery->value( 0 ).toLongLong();
+    }
+
+    pQuery->finish();
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getSQL_ColumnNames() - returns "( col, col, ... )" for all columns
+*   @retval column name list usable in an sql statement
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+QString iC3_StatusJournalTable::getSQL_ColumnNames( void )
+{
+    QString sColumnNames = QString("( %1").arg( getColumnDef( 0 )->getColumnName() );
+
+    for ( int iIndex = 1; iIndex < e_NUMBER_OF_STATUS_JOURNAL_TABLE_COLUMNS; iIndex++ )
+    {
+        sColumnNames.append( QString(", %1").arg( getColumnDef( iIndex )->getColumnName() ) );
+    }
+
+    sColumnNames.append( " )" );
+
+    return sColumnNames;
+}
@@ -0,0 +1,55 @@
+#ifndef IC3_STATUSJOURNALTABLE_H
+#define IC3_STATUSJOURNALTABLE_H
+
+/**
+*     @file iC3_StatusJournalTable.h
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief This header file defines the iC3_StatusJournalTable class.  The StatusJournal holds
+*            one row per status field that changed since the device's previous poll.  Every so
+*            often a keyframe writes all of the fields, so the state at any time is the last
+*            keyframe before it with the changes since applied in order.
+*/
+
+#include "iC3_DatabaseTable.h"
+#include "iC3_DeviceStatus.h"
+
+class iC3_StatusJournalTable : public iC3_DatabaseTable
+{
+public:
+    iC3_StatusJournalTable();
+
+    enum eIC3_StatusJournalTableColumns
+    {
+        e_STATUS_JOURNAL_TABLE_DEVICE_ID_COL        = 0,
+        e_STATUS_JOURNAL_TABLE_STATUS_TIME_COL      = 1,
+        e_STATUS_JOURNAL_TABLE_FIELD_ID_COL         = 2,
+        e_STATUS_JOURNAL_TABLE_KEYFRAME_COL         = 3,
+        e_STATUS_JOURNAL_TABLE_VALUE_COL            = 4,
+
+        e_NUMBER_OF_STATUS_JOURNAL_TABLE_COLUMNS
+    };
+
+    enum eIC3_StatusJournalTableStatements
+    {
+        e_STATUS_JOURNAL_STMT_INSERT                = 0,
+        e_STATUS_JOURNAL_STMT_FIND_KEYFRAME         = 1,
+        e_STATUS_JOURNAL_STMT_SELECT_RANGE          = 2
+    };
+
+    bool CreateTable( QSqlDatabase & database );
+
+    bool journalStatus( QSqlDatabase & database,
+                        const iC3_DeviceStatus & status,
+                        const iC3_DeviceStatus * pPreviousStatus,
+                        int & iRowsWritten );
+
+    bool getStatusAtTime( QSqlDatabase & database,
+                          int iDeviceID,
+                          qint64 llTimeMS,
+                          iC3_DeviceStatus & status );
+
+    QString getSQL_ColumnNames( void );
+};
+
+#endif // IC3_STATUSJOURNALTABLE_H
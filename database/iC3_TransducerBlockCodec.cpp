@@ -0,0 +1,225 @@
+/**
+*     @file iC3_TransducerBlockCodec.cpp
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief this cpp file implements iC3_TransducerBlockCodec.
+*/
+
+#include <limits>
+
+#include "iC3_TransducerBlockCodec.h"
+
+namespace
+{
+    // +/- 2^40 centi-degrees is far beyond any real temperature, anything outside is a sentinel
+    const qint64 MAX_FIXED_POINT_MAGNITUDE = Q_INT64_C(1) << 40;
+    const qint64 OUT_OF_RANGE_CODE         = std::numeric_limits<qint64>::max();
+
+    const int MAX_VARINT_BYTES = 10;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** encodeBlock() - packs samples (one device, oldest first) into a block
+*   @param pSamples - the samples to pack
+*   @param iCount - number of samples
+*   @param baBlock - receives the encoded block (replaces any previous contents)
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_TransducerBlockCodec::encodeBlock( const iC3_TransducerSample * pSamples, int iCount, QByteArray & baBlock )
+{
+    baBlock.clear();
+    baBlock.reserve( 16 + iCount * ( 2 + TRANSDUCER_NUMBER_OF_RTDS ) );
+
+    baBlock.append( (char) TRANSDUCER_BLOCK_FORMAT_VERSION );
+    appendVarint( baBlock, (quint64) iCount );
+
+    if ( iCount <= 0 )
+    {
+        return;
+    }
+
+    // time stamps: absolute, delta, then delta-of-delta
+    appendVarint( baBlock, zigZagEncode( pSamples[0].llSampleTimeMS ) );
+
+    qint64 llPreviousDelta = 0;
+    for ( int iIndex = 1; iIndex < iCount; iIndex++ )
+    {
+        qint64 llDelta = pSamples[iIndex].llSampleTimeMS - pSamples[iIndex - 1].llSampleTimeMS;
+        appendVarint( baBlock, zigZagEncode( llDelta - llPreviousDelta ) );
+        llPreviousDelta = llDelta;
+    }
+
+    // values: one channel at a time so runs of equal deltas sit together.  The subtraction is
+    // done unsigned so the reserved out of range code wraps instead of overflowing.
+    for ( int iChannel = 0; iChannel < TRANSDUCER_NUMBER_OF_RTDS; iChannel++ )
+    {
+        quint64 ullPrevious = 0;
+        for ( int iIndex = 0; iIndex < iCount; iIndex++ )
+        {
+            quint64 ullValue = (quint64) toFixedPoint( pSamples[iIndex].adRTDValues[iChannel] );
+            appendVarint( baBlock, zigZagEncode( (qint64) ( ullValue - ullPrevious ) ) );
+            ullPrevious = ullValue;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** decodeBlock() - unpacks a block, appending its samples to samples
+*   @param baBlock - the encoded block
+*   @param iDeviceID - device the block belongs to (not stored in the block)
+*   @param samples - the decoded samples are appended here.  Blocks do not keep the sequence
+*                    index, it is returned as 0.
+*   @retval true - the block was decoded
+*   @retval false - the block is truncated, corrupt or of an unknown format; samples is left
+*                   as it was
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerBlockCodec::decodeBlock( const QByteArray & baBlock, int iDeviceID, QVector<iC3_TransducerSample> & samples )
+{
+    const char * pCursor = baBlock.constData();
+    const char * pEnd = pCursor + baBlock.size();
+    quint64 ullValue;
+
+    if ( ( pCursor >= pEnd ) || ( (quint8) *pCursor != TRANSDUCER_BLOCK_FORMAT_VERSION ) )
+    {
+        return false;
+    }
+    pCursor++;
+
+    // every sample needs at least one byte per channel - reject counts the data cannot hold
+    if ( !readVarint( pCursor, pEnd, ullValue ) || ( ullValue > (quint64) ( pEnd - pCursor ) ) )
+    {
+        return false;
+    }
+
+    int iCount = (int) ullValue;
+    int iFirst = samples.size();
+
+    if ( iCount == 0 )
+    {
+        return true;
+    }
+
+    samples.resize( iFirst + iCount );
+    iC3_TransducerSample * pSamples = samples.data() + iFirst;
+
+    if ( !readVarint( pCursor, pEnd, ullValue ) )
+    {
+        samples.resize( iFirst );
+        return false;
+    }
+
+    qint64 llTime = zigZagDecode( ullValue );
+    qint64 llDelta = 0;
+
+    for ( int iIndex = 0; iIndex < iCount; iIndex++ )
+    {
+        if ( iIndex > 0 )
+        {
+            if ( !readVarint( pCursor, pEnd, ullValue ) )
+            {
+                samples.resize( iFirst );
+                return false;
+            }
+            llDelta += zigZagDecode( ullValue );
+            llTime += llDelta;
+        }
+
+        pSamples[iIndex].llSequenceIndex = 0;
+        pSamples[iIndex].iDeviceID = iDeviceID;
+        pSamples[iIndex].llSampleTimeMS = llTime;
+    }
+
+    for ( int iChannel = 0; iChannel < TRANSDUCER_NUMBER_OF_RTDS; iChannel++ )
+    {
+        quint64 ullFixed = 0;
+        for ( int iIndex = 0; iIndex < iCount; iIndex++ )
+        {
+            if ( !readVarint( pCursor, pEnd, ullValue ) )
+            {
+                samples.resize( iFirst );
+                return false;
+            }
+            ullFixed += (quint64) zigZagDecode( ullValue );
+            pSamples[iIndex].adRTDValues[iChannel] = fromFixedPoint( (qint64) ullFixed );
+        }
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+void iC3_TransducerBlockCodec::appendVarint( QByteArray & baBlock, quint64 ullValue )
+{
+    while ( ullValue >= 0x80 )
+    {
+        baBlock.append( (char) ( ( ullValue & 0x7F ) | 0x80 ) );
+        ullValue >>= 7;
+    }
+    baBlock.append( (char) ullValue );
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerBlockCodec::readVarint( const char * & pCursor, const char * pEnd, quint64 & ullValue )
+{
+    ullValue = 0;
+
+    for ( int iByte = 0; ( iByte < MAX_VARINT_BYTES ) && ( pCursor < pEnd ); iByte++ )
+    {
+        quint8 ucByte = (quint8) *pCursor++;
+        ullValue |= (quint64) ( ucByte & 0x7F ) << ( 7 * iByte );
+
+        if ( ( ucByte & 0x80 ) == 0 )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+quint64 iC3_TransducerBlockCodec::zigZagEncode( qint64 llValue )
+{
+    return ( (quint64) llValue << 1 ) ^ (quint64) ( llValue >> 63 );
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+qint64 iC3_TransducerBlockCodec::zigZagDecode( quint64 ullValue )
+{
+    return (qint64) ( ullValue >> 1 ) ^ -(qint64) ( ullValue & 1 );
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+qint64 iC3_TransducerBlockCodec::toFixedPoint( double dValue )
+{
+    double dScaled = dValue * TRANSDUCER_BLOCK_SCALE;
+
+    // written so that NaN fails the test as well
+    if ( !( ( dScaled > -(double) MAX_FIXED_POINT_MAGNITUDE ) && ( dScaled < (double) MAX_FIXED_POINT_MAGNITUDE ) ) )
+    {
+        return OUT_OF_RANGE_CODE;
+    }
+
+    return ( dScaled < 0.0 ) ? (qint64) ( dScaled - 0.5 ) : (qint64) ( dScaled + 0.5 );
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+double iC3_TransducerBlockCodec::fromFixedPoint( qint64 llValue )
+{
+    if ( llValue == OUT_OF_RANGE_CODE )
+    {
+        return TRANSDUCER_BLOCK_OUT_OF_RANGE_VALUE;
+    }
+
+    return (double) llValue / TRANSDUCER_BLOCK_SCALE;
+}
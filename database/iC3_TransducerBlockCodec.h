@@ -0,0 +1,51 @@
+#ifndef IC3_TRANSDUCERBLOCKCODEC_H
+#define IC3_TRANSDUCERBLOCKCODEC_H
+
+/**
+*     @file iC3_TransducerBlockCodec.h
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief This header file defines iC3_TransducerBlockCodec, which packs a run of one
+*            device's transducer samples into a compact BLOB and back.
+*
+*            Block layout (all integers are LEB128 varints, signed ones zig-zag encoded):
+*               format version (1 byte)
+*               sample count
+*               first sample time, ms since the epoch
+*               time delta to the second sample, then delta-of-delta for every later sample
+*               for each RTD channel: first value, then value deltas, in centi-degrees
+*
+*            A steady poll interval makes every delta-of-delta 0 and a steady temperature makes
+*            every value delta 0, so a typical sample costs about 6 bytes instead of ~60.
+*/
+
+#include <QByteArray>
+#include <QVector>
+
+#include "iC3_TransducerSample.h"
+
+static const quint8 TRANSDUCER_BLOCK_FORMAT_VERSION = 1;
+static const int    TRANSDUCER_BLOCK_SCALE          = 100;          // fixed point: centi-degrees
+
+// values that do not fit the fixed point range (meter overload, open probe, NaN) are stored as
+// a reserved code and decoded as this value
+static const double TRANSDUCER_BLOCK_OUT_OF_RANGE_VALUE = 9.9E37;
+
+class iC3_TransducerBlockCodec
+{
+public:
+    static void encodeBlock( const iC3_TransducerSample * pSamples, int iCount, QByteArray & baBlock );
+    static bool decodeBlock( const QByteArray & baBlock, int iDeviceID, QVector<iC3_TransducerSample> & samples );
+
+private:
+    static void   appendVarint( QByteArray & baBlock, quint64 ullValue );
+    static bool   readVarint( const char * & pCursor, const char * pEnd, quint64 & ullValue );
+
+    static quint64 zigZagEncode( qint64 llValue );
+    static qint64  zigZagDecode( quint64 ullValue );
+
+    static qint64 toFixedPoint( double dValue );
+    static double fromFixedPoint( qint64 llValue );
+};
+
+#endif // IC3_TRANSDUCERBLOCKCODEC_H
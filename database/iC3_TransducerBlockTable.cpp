@@ -0,0 +1,392 @@
+/**
+*     @file iC3_TransducerBlockTable.cpp
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief this cpp file implements the iC3_TransducerBlockTable class.
+*/
+
+#include <QSqlError>
+#include <QDebug>
+#include <QVariant>
+
+#include "iC3_TransducerBlockTable.h"
+#include "iC3_TransducerBlockCodec.h"
+
+//-----------------------------------------------------------------------------------------------
+/** constructor
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_TransducerBlockTable::iC3_TransducerBlockTable()
+{
+    iC3_DatabaseColumnDef * pColumn;
+
+    m_sTableName = "TransducerBlocks";
+
+    setNumberOfColumns( e_NUMBER_OF_TRANSDUCER_BLOCK_TABLE_COLUMNS );
+
+    pColumn = new iC3_DatabaseColumnDef( tr("deviceID"), "INTEGER", "NOT NULL" );
+    AddColumnDef( e_TRANSDUCER_BLOCK_TABLE_DEVICE_ID_COL, pColumn );
+
+    // hour boundary, ms since the epoch (UTC)
+    pColumn = new iC3_DatabaseColumnDef( tr("blockStartMS"), "INTEGER", "NOT NULL" );
+    AddColumnDef( e_TRANSDUCER_BLOCK_TABLE_BLOCK_START_COL, pColumn );
+
+    // time of the last sample in the block
+    pColumn = new iC3_DatabaseColumnDef( tr("blockEndMS"), "INTEGER", "NOT NULL" );
+    AddColumnDef( e_TRANSDUCER_BLOCK_TABLE_BLOCK_END_COL, pColumn );
+
+    pColumn = new iC3_DatabaseColumnDef( tr("sampleCount"), "INTEGER", "NOT NULL" );
+    AddColumnDef( e_TRANSDUCER_BLOCK_TABLE_SAMPLE_COUNT_COL, pColumn );
+
+    pColumn = new iC3_DatabaseColumnDef( tr("samples"), "BLOB", "" );
+    AddColumnDef( e_TRANSDUCER_BLOCK_TABLE_SAMPLES_COL, pColumn );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** CreateTable() - creates the TransducerBlocks table and its (deviceID, blockStartMS) key if
+*                   they do not exist.
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @retval true - the table exists
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerBlockTable::CreateTable( QSqlDatabase & database )
+{
+    QSqlQuery query( database );
+
+    ClearLastError();
+
+    if ( !database.isOpen() )
+    {
+        SetLastError( "iC3_TransducerBlockTable::CreateTable() - Database is not open" );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    QString sIndexSQL = QString("CREATE UNIQUE INDEX IF NOT EXISTS %1_DeviceStart ON %1 ( %2, %3 )")
+                            .arg( m_sTableName )
+                            .arg( getColumnDef( e_TRANSDUCER_BLOCK_TABLE_DEVICE_ID_COL )->getColumnName() )
+                            .arg( getColumnDef( e_TRANSDUCER_BLOCK_TABLE_BLOCK_START_COL )->getColumnName() );
+
+    if ( !query.exec( getTableCreationSQL( m_sTableName ) ) || !query.exec( sIndexSQL ) )
+    {
+        SetLastError( QString("iC3_TransducerBlockTable::CreateTable() - Query Error: %1").arg( query.lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getBlockStartMS() - returns the start of the block a sample time falls in
+*   @param llSampleTimeMS - ms since the epoch
+*   @retval block start, ms since the epoch
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+qint64 iC3_TransducerBlockTable::getBlockStartMS( qint64 llSampleTimeMS )
+{
+    qint64 llRemainder = llSampleTimeMS % TRANSDUCER_BLOCK_DURATION_MS;
+
+    if ( llRemainder < 0 )
+    {
+        llRemainder += TRANSDUCER_BLOCK_DURATION_MS;
+    }
+
+    return llSampleTimeMS - llRemainder;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** writeBlock() - encodes samples and stores them as the device's block, replacing any block
+*                  already stored for that hour.
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @param iDeviceID - the device the samples belong to
+*   @param llBlockStartMS - the block's hour boundary
+*   @param samples - every sample of the block, oldest first
+*   @retval true - the block was written
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerBlockTable::writeBlock( QSqlDatabase & database,
+                                           int iDeviceID,
+                                           qint64 llBlockStartMS,
+                                           const QVector<iC3_TransducerSample> & samples )
+{
+    ClearLastError();
+
+    if ( samples.isEmpty() )
+    {
+        return true;
+    }
+
+    QSqlQuery * pQuery = getPreparedQuery( database, e_TRANSDUCER_BLOCK_STMT_WRITE,
+                                           QString("INSERT OR REPLACE INTO %1 %2 VALUES ( ?, ?, ?, ?, ? )")
+                                               .arg( m_sTableName ).arg( getSQL_ColumnNames() ) );
+    if ( pQuery == NULL )
+    {
+        return false;
+    }
+
+    QByteArray baBlock;
+    iC3_TransducerBlockCodec::encodeBlock( samples.constData(), samples.size(), baBlock );
+
+    pQuery->bindValue( e_TRANSDUCER_BLOCK_TABLE_DEVICE_ID_COL, iDeviceID );
+    pQuery->bindValue( e_TRANSDUCER_BLOCK_TABLE_BLOCK_START_COL, llBlockStartMS );
+    pQuery->bindValue( e_TRANSDUCER_BLOCK_TABLE_BLOCK_END_COL, samples.last().llSampleTimeMS );
+    pQuery->bindValue( e_TRANSDUCER_BLOCK_TABLE_SAMPLE_COUNT_COL, samples.size() );
+    pQuery->bindValue( e_TRANSDUCER_BLOCK_TABLE_SAMPLES_COL, baBlock );
+
+    if ( !pQuery->exec() )
+    {
+        SetLastError( QString("iC3_TransducerBlockTable::writeBlock() - Query Error: %1").arg( pQuery->lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** readBlock() - decodes one device's block for one hour
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @param iDeviceID - the device
+*   @param llBlockStartMS - the block's hour boundary
+*   @param samples - the block's samples are appended here (nothing if there is no block)
+*   @retval true - the query succeeded and any block found was decoded
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerBlockTable::readBlock( QSqlDatabase & database,
+                                          int iDeviceID,
+                                          qint64 llBlockStartMS,
+                                          QVector<iC3_TransducerSample> & samples )
+{
+    ClearLastError();
+
+    QSqlQuery * pQuery = getPreparedQuery( database, e_TRANSDUCER_BLOCK_STMT_READ,
+                                           QString("SELECT %1 FROM %2 WHERE %3 = ? AND %4 = ?")
+                                               .arg( getColumnDef( e_TRANSDUCER_BLOCK_TABLE_SAMPLES_COL )->getColumnName() )
+                                               .arg( m_sTableName )
+                                               .arg( getColumnDef( e_TRANSDUCER_BLOCK_TABLE_DEVICE_ID_COL )->getColumnName() )
+                                               .arg( getColumnDef( e_TRANSDUCER_BLOCK_TABLE_BLOCK_START_COL )->getColumnName() ) );
+    if ( pQuery == NULL )
+    {
+        return false;
+    }
+
+    pQuery->bindValue( 0, iDeviceID );
+    pQuery->bindValue( 1, llBlockStartMS );
+
+    if ( !pQuery->exec() )
+    {
+        SetLastError( QString("iC3_TransducerBlockTable::readBlock() - Query Error: %1").arg( pQuery->lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    bool bRC = true;
+    if ( pQuery->next() )
+    {
+        bRC = decodeBlockInRange( pQuery->value( 0 ).toByteArray(), iDeviceID,
+                                  llBlockStartMS, llBlockStartMS + TRANSDUCER_BLOCK_DURATION_MS, samples );
+    }
+
+    pQuery->finish();
+
+    return bRC;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getEntriesInRange() - decodes the device's samples with llStartTimeMS <= time < llEndTimeMS
+*                         from the blocks, oldest first.  Only the blocks overlapping the range
+*                         are read.
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @param iDeviceID - the device whose samples are wanted
+*   @param llStartTimeMS - start of the range, ms since the epoch (inclusive)
+*   @param llEndTimeMS - end of the range, ms since the epoch (exclusive)
+*   @param samples - the samples found are appended here
+*   @retval true - if the query succeeded (samples may still be empty)
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerBlockTable::getEntriesInRange( QSqlDatabase & database,
+                                                  int iDeviceID,
+                                                  qint64 llStartTimeMS,
+                                                  qint64 llEndTimeMS,
+                                                  QVector<iC3_TransducerSample> & samples )
+{
+    ClearLastError();
+
+    QString sStartColumn = getColumnDef( e_TRANSDUCER_BLOCK_TABLE_BLOCK_START_COL )->getColumnName();
+
+    QSqlQuery * pQuery = getPreparedQuery( database, e_TRANSDUCER_BLOCK_STMT_SELECT_RANGE,
+                                           QString("SELECT %1 FROM %2 WHERE %3 = ? AND %4 >= ? AND %4 < ? ORDER BY %4")
+                                               .arg( getColumnDef( e_TRANSDUCER_BLOCK_TABLE_SAMPLES_COL )->getColumnName() )
+                                               .arg( m_sTableName )
+                                               .arg( getColumnDef( e_TRANSDUCER_BLOCK_TABLE_DEVICE_ID_COL )->getColumnName() )
+                                               .arg( sStartColumn ) );
+    if ( pQuery == NULL )
+    {
+        return false;
+    }
+
+    pQuery->setForwardOnly( true );
+    pQuery->bindValue( 0, iDeviceID );
+    pQuery->bindValue( 1, getBlockStartMS( llStartTimeMS ) );
+    pQuery->bindValue( 2, llEndTimeMS );
+
+    if ( !pQuery->exec() )
+    {
+        SetLastError( QString("iC3_TransducerBlockTable::getEntriesInRange() - Query Error: %1").arg( pQuery->lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    while ( pQuery->next() )
+    {
+        if ( !decodeBlockInRange( pQuery->value( 0 ).toByteArray(), iDeviceID, llStartTimeMS, llEndTimeMS, samples ) )
+        {
+            pQuery->finish();
+            return false;
+        }
+    }
+
+    pQuery->finish();
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getNextBlockStartMS() - finds the device's first block at or after the hour holding
+*                           llFromTimeMS without decoding anything, so readers can skip over
+*                           hours that have no blocks.
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @param iDeviceID - the device
+*   @param llFromTimeMS - where to start looking, ms since the epoch
+*   @param llBlockStartMS - set to the hour boundary of the block found
+*   @param bFound - set to false when the device has no later blocks
+*   @retval true - the query succeeded
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerBlockTable::getNextBlockStartMS( QSqlDatabase & database,
+                                                    int iDeviceID,
+                                                    qint64 llFromTimeMS,
+                                                    qint64 & llBlockStartMS,
+                                                    bool & bFound )
+{
+    ClearLastError();
+
+    QString sStartColumn = getColumnDef( e_TRANSDUCER_BLOCK_TABLE_BLOCK_START_COL )->getColumnName();
+
+    QSqlQuery * pQuery = getPreparedQuery( database, e_TRANSDUCER_BLOCK_STMT_NEXT_BLOCK,
+                                           QString("SELECT %1 FROM %2 WHERE %3 = ? AND %1 >= ? ORDER BY %1 LIMIT 1")
+                                               .arg( sStartColumn )
+                                               .arg( m_sTableName )
+                                               .arg( getColumnDef( e_TRANSDUCER_BLOCK_TABLE_DEVICE_ID_COL )->getColumnName() ) );
+    if ( pQuery == NULL )
+    {
+        return false;
+    }
+
+    pQuery->bindValue( 0, iDeviceID );
+    pQuery->bindValue( 1, getBlockStartMS( llFromTimeMS ) );
+
+    if ( !pQuery->exec() )
+    {
+        SetLastError( QString("iC3_TransducerBlockTable::getNextBlockStartMS() - Query Error: %1").arg( pQuery->lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    bFound = pQuery->next();
+    if ( bFound )
+    {
+        llBlockStartMS = pQuery->value( 0 ).toLongLong();
+    }
+
+    pQuery->finish();
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getSQL_ColumnNames() - returns "( col, col, ... )" for all columns
+*   @retval column name list usable in an sql statement
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+QString iC3_TransducerBlockTable::getSQL_ColumnNames( void )
+{
+    QString sColumnNames = QString("( %1").arg( getColumnDef( 0 )->getColumnName() );
+
+    for ( int iIndex = 1; iIndex < e_NUMBER_OF_TRANSDUCER_BLOCK_TABLE_COLUMNS; iIndex++ )
+    {
+        sColumnNames.append( QString(", %1").arg( getColumnDef( iIndex )->getColumnName() ) );
+    }
+    sColumnNames.append( " )" );
+
+    return sColumnNames;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** decodeBlockInRange() - decodes a block and keeps the samples inside the range
+*   @retval true - the block was decoded
+*   @retval false - the block is corrupt, see GetLastError()
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerBlockTable::decodeBlockInRange( const QByteArray & baBlock, int iDeviceID,
+                                                   qint64 llStartTimeMS, qint64 llEndTimeMS,
+                                                   QVector<iC3_TransducerSample> & samples )
+{
+    int iFirst = samples.size();
+
+    if ( !iC3_TransducerBlockCodec::decodeBlock( baBlock, iDeviceID, samples ) )
+    {
+        SetLastError( QString("iC3_TransducerBlockTable - corrupt block for device %1").arg( iDeviceID ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    // samples are in time order - drop the ones before and after the range
+    int iLast = samples.size();
+    int iBegin = iFirst;
+    while ( ( iBegin < iLast ) && ( samples.at( iBegin ).llSampleTimeMS < llStartTimeMS ) )
+    {
+        iBegin++;
+    }
+
+    int iEnd = iLast;
+    while ( ( iEnd > iBegin ) && ( samples.at( iEnd - 1 ).llSampleTimeMS >= llEndTimeMS ) )
+    {
+        iEnd--;
+    }
+
+    if ( iBegin > iFirst )
+    {
+        samples.remove( iFirst, iBegin - iFirst );
+        iEnd -= iBegin - iFirst;
+    }
+    samples.resize( iEnd );
+
+    return true;
+}
@@ -0,0 +1,76 @@
+#ifndef IC3_TRANSDUCERBLOCKTABLE_H
+#define IC3_TRANSDUCERBLOCKTABLE_H
+
+/**
+*     @file iC3_TransducerBlockTable.h
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief This header file defines the iC3_TransducerBlockTable class.  Compacted transducer
+*            history is kept here as one iC3_TransducerBlockCodec BLOB per device per hour.
+*/
+
+#include <QVector>
+#include "iC3_DatabaseTable.h"
+#include "iC3_TransducerSample.h"
+
+static const qint64 TRANSDUCER_BLOCK_DURATION_MS = 60 * 60 * 1000;
+
+class iC3_TransducerBlockTable : public iC3_DatabaseTable
+{
+public:
+    iC3_TransducerBlockTable();
+
+    enum eIC3_TransducerBlockTableColumns
+    {
+        e_TRANSDUCER_BLOCK_TABLE_DEVICE_ID_COL      = 0,
+        e_TRANSDUCER_BLOCK_TABLE_BLOCK_START_COL    = 1,
+        e_TRANSDUCER_BLOCK_TABLE_BLOCK_END_COL      = 2,
+        e_TRANSDUCER_BLOCK_TABLE_SAMPLE_COUNT_COL   = 3,
+        e_TRANSDUCER_BLOCK_TABLE_SAMPLES_COL        = 4,
+
+        e_NUMBER_OF_TRANSDUCER_BLOCK_TABLE_COLUMNS
+    };
+
+    enum eIC3_TransducerBlockTableStatements
+    {
+        e_TRANSDUCER_BLOCK_STMT_WRITE               = 0,
+        e_TRANSDUCER_BLOCK_STMT_READ                = 1,
+        e_TRANSDUCER_BLOCK_STMT_SELECT_RANGE        = 2,
+        e_TRANSDUCER_BLOCK_STMT_NEXT_BLOCK          = 3
+    };
+
+    bool CreateTable( QSqlDatabase & database );
+
+    static qint64 getBlockStartMS( qint64 llSampleTimeMS );
+
+    bool writeBlock( QSqlDatabase & database,
+                     int iDeviceID,
+                     qint64 llBlockStartMS,
+                     const QVector<iC3_TransducerSample> & samples );
+
+    bool readBlock( QSqlDatabase & database,
+                    int iDeviceID,
+                    qint64 llBlockStartMS,
+                    QVector<iC3_TransducerSample> & samples );
+
+    bool getEntriesInRange( QSqlDatabase & database,
+                            int iDeviceID,
+                            qint64 llStartTimeMS,
+                            qint64 llEndTimeMS,
+                            QVector<iC3_TransducerSample> & samples );
+
+    bool getNextBlockStartMS( QSqlDatabase & database,
+                              int iDeviceID,
+                              qint64 llFromTimeMS,
+                              qint64 & llBlockStartMS,
+                              bool & bFound );
+
+    QString getSQL_ColumnNames( void );
+
+private:
+
+    bool decodeBlockInRange( const QByteArray & baBlock, int iDeviceID, qint64 llStartTimeMS, qint64 llEndTimeMS,
+                             QVector<iC3_TransducerSample> & samples );
+};
+
+#endif // IC3_TRANSDUCERBLOCKTABLE_H
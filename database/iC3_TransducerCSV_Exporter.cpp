@@ -0,0 +1,794 @@
+/**
+*     @file iC3_TransducerCSV_Exporter.cpp
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief this cpp file implements the iC3_TransducerCSV_Exporter class.
+*/
+
+#include <QDebug>
+#include <QSqlError>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <limits>
+#include <algorithm>
+
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
+
+#include "iC3_TransducerCSV_Exporter.h"
+#include "iC3_DMM_Constants.h"
+
+namespace
+{
+    // longest row: 20 + 11 digit columns, a 26 char date/time and five %.17G temperatures,
+    // plus separators
+    const int MAX_ROW_LENGTH = 256;
+
+    bool sampleTimeLessThan( const iC3_TransducerSample & first, const iC3_TransducerSample & second )
+    {
+        return first.llSampleTimeMS < second.llSampleTimeMS;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** constructor
+*   @param parent - QObject pointer parent (unused)
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_TransducerCSV_Exporter::iC3_TransducerCSV_Exporter(QObject *parent) :
+    QThread(parent),
+    m_uiTransactionID( 0 ),
+    m_iDeviceID( TRANSDUCER_LOCAL_DEVICE_ID ),
+    m_llBeginTimeMS( 0 ),
+    m_llEndTimeMS( 0 ),
+    m_bCancelRequested( 0 ),
+    m_llRowsWritten( 0 ),
+    m_llAfterTimeMS( 0 ),
+    m_llAfterSequenceIndex( -1 ),
+    m_llProgressBeginMS( 0 ),
+    m_llProgressEndMS( 0 ),
+    m_eDateFormat( eDATE_FORMAT_YYYYMMDD ),
+    m_eTimeFormat( eTIME_FORMAT_24_HOUR ),
+    m_bLocalTime( false )
+{
+}
+
+//-----------------------------------------------------------------------------------------------
+/** destructor - an export still running is cancelled and waited for
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_TransducerCSV_Exporter::~iC3_TransducerCSV_Exporter()
+{
+    cancelExport();
+    wait();
+}
+
+//-----------------------------------------------------------------------------------------------
+/** startExport() - starts writing a device's samples with llBeginTimeMS <= time < llEndTimeMS,
+*                   oldest first, to sCSVFileName.  The file is written as sCSVFileName.part and
+*                   only renamed once complete, so a cancelled or failed export never leaves a
+*                   truncated CSV behind.  Returns immediately; the outcome is reported by
+*                   signalExportComplete(), signalExportCancelled() or signalExportFailed().
+*   @param uiTransactionID - identifies the signals that follow
+*   @param sDatabaseFileName - the SQLite database file
+*   @param sCSVFileName - the file to create (replaced if it exists)
+*   @param iDeviceID - the device whose samples are exported
+*   @param llBeginTimeMS - start of the range, ms since the epoch (inclusive)
+*   @param llEndTimeMS - end of the range, ms since the epoch (exclusive)
+*   @retval true - the export was started
+*   @retval false - an export is already running
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerCSV_Exporter::startExport( uint uiTransactionID,
+                                              const QString & sDatabaseFileName,
+                                              const QString & sCSVFileName,
+                                              int iDeviceID,
+                                              qint64 llBeginTimeMS,
+                                              qint64 llEndTimeMS )
+{
+    if ( isRunning() )
+    {
+        return false;
+    }
+
+    m_uiTransactionID = uiTransactionID;
+    m_sDatabaseFileName = sDatabaseFileName;
+    m_sCSVFileName = sCSVFileName;
+    m_sDestination.clear();
+    m_iDeviceID = iDeviceID;
+    m_llBeginTimeMS = qMax( llBeginTimeMS, Q_INT64_C(0) );      // no samples predate the epoch
+    m_llEndTimeMS = llEndTimeMS;
+    m_bCancelRequested.storeRelease( 0 );
+
+    start( QThread::LowPriority );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** startIncrementalExport() - starts writing the device's samples that sDestination has not
+*                              received yet to sCSVFileName, and advances the destination's
+*                              mark once the file is in place.  Nothing is duplicated or
+*                              skipped across crashes:
+*                              1. the rows go to sCSVFileName.part, which is synced to disk
+*                              2. the new mark is committed with sCSVFileName as pending
+*                              3. the .part file is renamed to sCSVFileName
+*                              4. the pending file name is cleared
+*                              An export interrupted between 2 and 4 is finished (or the mark
+*                              rolled back) by the destination's next export.  When there is
+*                              nothing new no file is written.  Outcome signals are as for
+*                              startExport().
+*   @param uiTransactionID - identifies the signals that follow
+*   @param sDatabaseFileName - the SQLite database file
+*   @param sDestination - names the consumer, e.g. "nightly" - each keeps its own mark
+*   @param sCSVFileName - the file to create; use a new name for each export
+*   @param iDeviceID - the device whose samples are exported
+*   @param llEndLimitMS - samples from this time on are left for a later export, e.g. because
+*                         older samples may still be added before it (exclusive)
+*   @retval true - the export was started
+*   @retval false - an export is already running
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerCSV_Exporter::startIncrementalExport( uint uiTransactionID,
+                                                         const QString & sDatabaseFileName,
+                                                         const QString & sDestination,
+                                                         const QString & sCSVFileName,
+                                                         int iDeviceID,
+                                                         qint64 llEndLimitMS )
+{
+    if ( isRunning() || sDestination.isEmpty() )
+    {
+        return false;
+    }
+
+    m_uiTransactionID = uiTransactionID;
+    m_sDatabaseFileName = sDatabaseFileName;
+    m_sCSVFileName = sCSVFileName;
+    m_sDestination = sDestination;
+    m_iDeviceID = iDeviceID;
+    m_llEndTimeMS = llEndLimitMS;
+    m_bCancelRequested.storeRelease( 0 );
+
+    start( QThread::LowPriority );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** cancelExport() - asks a running export to stop.  It stops after the hour being written and
+*                    then emits signalExportCancelled().  Safe to call from any thread.
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_TransducerCSV_Exporter::cancelExport( void )
+{
+    m_bCancelRequested.storeRelease( 1 );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** setExportFormat() - sets how the following exports write the sample time.  Times are always
+*                       written to the ms and temperatures as the shortest text that reads back
+*                       as the stored value.  Ignored while an export is running.
+*   @param dateFormat - date field order (default eDATE_FORMAT_YYYYMMDD)
+*   @param timeFormat - 12 or 24 hour (default eTIME_FORMAT_24_HOUR)
+*   @param bLocalTime - true: local time; false: UTC (default)
+*   @retval true - the format was set
+*   @retval false - an export is running
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerCSV_Exporter::setExportFormat( eDateFormats dateFormat, eTimeFormats timeFormat, bool bLocalTime )
+{
+    if ( isRunning() )
+    {
+        return false;
+    }
+
+    m_eDateFormat = dateFormat;
+    m_eTimeFormat = timeFormat;
+    m_bLocalTime = bLocalTime;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** setSegmentStorePath() - sets where the following exports read raw samples from besides the
+*                           database
+*   @param sSegmentStorePath - the transducer segment store, empty if it is not used
+*   @retval true - the path was set
+*   @retval false - an export is running
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerCSV_Exporter::setSegmentStorePath( const QString & sSegmentStorePath )
+{
+    if ( isRunning() )
+    {
+        return false;
+    }
+
+    m_SegmentReader.setRootPath( sSegmentStorePath );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** run() - exporter thread
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_TransducerCSV_Exporter::run()
+{
+    QString sPartFileName = m_sCSVFileName + ".part";
+
+    m_sLastError.clear();
+    m_llRowsWritten = 0;
+    m_Formatter.setFormat( m_eDateFormat, m_eTimeFormat, eEXPORT_TIME_MILLISECONDS, m_bLocalTime );
+    m_baOutput.clear();
+    m_baOutput.reserve( TRANSDUCER_EXPORT_BUFFER_BYTES + MAX_ROW_LENGTH );
+
+    if ( !openConnection() )
+    {
+        emit signalExportFailed( m_uiTransactionID, m_sLastError );
+        return;
+    }
+
+    bool bIncremental = !m_sDestination.isEmpty();
+    iC3_ExportMark mark;
+    bool bRC = true;
+
+    m_llAfterTimeMS = m_llBeginTimeMS;
+    m_llAfterSequenceIndex = -1;
+
+    if ( bIncremental )
+    {
+        bRC = m_ExportMarkTable.readMark( m_db, m_sDestination, m_iDeviceID, mark );
+        if ( !bRC )
+        {
+            m_sLastError = m_ExportMarkTable.GetLastError();
+        }
+        else if ( resolvePendingExport( mark ) )
+        {
+            m_llBeginTimeMS = mark.llLastSampleTimeMS;
+            m_llEndTimeMS = qMin( QDateTime::currentMSecsSinceEpoch() - TRANSDUCER_EXPORT_SETTLE_MS, m_llEndTimeMS );
+            m_llAfterTimeMS = mark.llLastSampleTimeMS;
+            m_llAfterSequenceIndex = mark.llLastSequenceIndex;
+        }
+        else
+        {
+            bRC = false;
+        }
+    }
+
+    if ( bRC )
+    {
+        m_CSVFile.setFileName( sPartFileName );
+
+        bRC = m_CSVFile.open( QIODevice::WriteOnly | QIODevice::Truncate );
+        if ( !bRC )
+        {
+            m_sLastError = QString("iC3_TransducerCSV_Exporter::run() - Could not open a CSV file for writing: %1").arg( sPartFileName );
+            qDebug() << m_sLastError;
+        }
+        else
+        {
+            bRC = exportRows() && flushOutput() && syncOutput();
+            m_CSVFile.close();
+        }
+    }
+
+    bool bCancelled = ( m_bCancelRequested.loadAcquire() != 0 );
+
+    if ( bRC && !bCancelled )
+    {
+        if ( !bIncremental )
+        {
+            bRC = replaceFile( sPartFileName, m_sCSVFileName );
+        }
+        else if ( m_llRowsWritten > 0 )
+        {
+            bRC = commitIncrementalExport( mark, sPartFileName );
+        }
+    }
+
+    closeConnection();
+    m_samples.clear();
+    m_baOutput.clear();
+
+    // every path that did not put the file in place leaves the .part behind
+    QFile::remove( sPartFileName );
+
+    if ( bCancelled )
+    {
+        emit signalExportCancelled( m_uiTransactionID );
+    }
+    else if ( !bRC )
+    {
+        emit signalExportFailed( m_uiTransactionID, m_sLastError );
+    }
+    else
+    {
+        emit signalExportComplete( m_uiTransactionID, m_llRowsWritten );
+    }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** openConnection() - opens the exporter's own connection, read-only unless the export has a
+*                      mark to write.  The database runs in WAL mode, so reading here never
+*                      blocks the request processor's writes.
+*   @retval true - the connection is open
+*   @retval false - the open failed, see m_sLastError
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerCSV_Exporter::openConnection( void )
+{
+    m_db = QSqlDatabase::addDatabase( "QSQLITE", HELMER_DB_EXPORT_CONNECTION_NAME );
+    m_db.setDatabaseName( m_sDatabaseFileName );
+
+    // a plain export only reads; an incremental one also writes its mark
+    if ( m_sDestination.isEmpty() )
+    {
+        m_db.setConnectOptions( "QSQLITE_OPEN_READONLY" );
+    }
+
+    if ( !m_db.open() )
+    {
+        m_sLastError = QString("iC3_TransducerCSV_Exporter::openConnection() - Unable to open the database: %1").arg( m_db.lastError().text() );
+        qDebug() << m_sLastError;
+        closeConnection();
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** closeConnection() - releases the prepared statements and removes the connection
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_TransducerCSV_Exporter::closeConnection( void )
+{
+    m_TransducerTable.clearPreparedQueries( m_db );
+    m_TransducerBlockTable.clearPreparedQueries( m_db );
+    m_ExportMarkTable.clearPreparedQueries( m_db );
+    m_SegmentReader.close();
+    m_db.close();
+    m_db = QSqlDatabase();
+
+    QSqlDatabase::removeDatabase( HELMER_DB_EXPORT_CONNECTION_NAME );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** resolvePendingExport() - finishes an incremental export that was interrupted after its mark
+*                            was committed.  If the synced .part file is still there it is put
+*                            in place; if the file is already in place the mark just loses its
+*                            pending name; if neither exists the mark goes back to where it was.
+*   @param mark - the destination's mark, updated to the resolved state
+*   @retval true - the mark has no pending file
+*   @retval false - an error occurred, see m_sLastError
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerCSV_Exporter::resolvePendingExport( iC3_ExportMark & mark )
+{
+    if ( mark.sPendingFileName.isEmpty() )
+    {
+        return true;
+    }
+
+    QString sPendingPartFileName = mark.sPendingFileName + ".part";
+
+    qDebug() << "iC3_TransducerCSV_Exporter::resolvePendingExport() - completing interrupted export" << mark.sPendingFileName;
+
+    bool bDelivered = QFile::exists( sPendingPartFileName ) ? replaceFile( sPendingPartFileName, mark.sPendingFileName )
+                                                            : QFile::exists( mark.sPendingFileName );
+    if ( !bDelivered )
+    {
+        mark.llLastSampleTimeMS = mark.llPreviousSampleTimeMS;
+        mark.llLastSequenceIndex = mark.llPreviousSequenceIndex;
+    }
+
+    mark.sPendingFileName.clear();
+
+    if ( !m_ExportMarkTable.writeMark( m_db, mark ) )
+    {
+        m_sLastError = m_ExportMarkTable.GetLastError();
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** commitIncrementalExport() - steps 2 to 4 of an incremental export (see
+*                               startIncrementalExport()).  The synced .part file already holds
+*                               every row up to m_llAfterTimeMS / m_llAfterSequenceIndex.
+*   @param mark - the destination's mark before this export, advanced on success
+*   @param sPartFileName - the synced output
+*   @retval true - the file is in place and the mark advanced
+*   @retval false - an error occurred, see m_sLastError.  The mark is where it was, or is left
+*                   pending for the next export to resolve.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerCSV_Exporter::commitIncrementalExport( iC3_ExportMark & mark, const QString & sPartFileName )
+{
+    mark.llPreviousSampleTimeMS = mark.llLastSampleTimeMS;
+    mark.llPreviousSequenceIndex = mark.llLastSequenceIndex;
+    mark.llLastSampleTimeMS = m_llAfterTimeMS;
+    mark.llLastSequenceIndex = m_llAfterSequenceIndex;
+    mark.sPendingFileName = m_sCSVFileName;
+
+    if ( !m_ExportMarkTable.writeMark( m_db, mark ) )
+    {
+        m_sLastError = m_ExportMarkTable.GetLastError();
+        return false;
+    }
+
+    if ( !replaceFile( sPartFileName, m_sCSVFileName ) )
+    {
+        // the rows never reached the destination - put the mark back
+        mark.llLastSampleTimeMS = mark.llPreviousSampleTimeMS;
+        mark.llLastSequenceIndex = mark.llPreviousSequenceIndex;
+        mark.sPendingFileName.clear();
+        m_ExportMarkTable.writeMark( m_db, mark );
+        return false;
+    }
+
+    mark.sPendingFileName.clear();
+
+    if ( !m_ExportMarkTable.writeMark( m_db, mark ) )
+    {
+        // the file is in place, so the next export resolves the pending mark forwards
+        qDebug() << m_ExportMarkTable.GetLastError();
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** replaceFile() - renames sFromFileName to sToFileName, replacing any file of that name
+*   @param sFromFileName - the file to move
+*   @param sToFileName - its new name
+*   @retval true - the file was renamed
+*   @retval false - the rename failed, see m_sLastError
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerCSV_Exporter::replaceFile( const QString & sFromFileName, const QString & sToFileName )
+{
+    QFile::remove( sToFileName );
+
+    if ( !QFile::rename( sFromFileName, sToFileName ) )
+    {
+        m_sLastError = QString("iC3_TransducerCSV_Exporter::replaceFile() - Could not rename %1 to %2").arg( sFromFileName ).arg( sToFileName );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** exportRows() - writes the header and then the range one block-sized window at a time.
+*                  Windows with no data are skipped with two index seeks, so a sparse range
+*                  costs no more than the data in it.
+*   @retval true - every row was formatted (the tail may still be in m_baOutput)
+*   @retval false - cancelled, or an error occurred, see m_sLastError
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerCSV_Exporter::exportRows( void )
+{
+    QElapsedTimer progressTimer;
+    qint64 llCursorMS = m_llBeginTimeMS;
+    bool bFirstWindow = true;
+
+    m_llProgressBeginMS = m_llBeginTimeMS;
+    m_llProgressEndMS = qMin( m_llEndTimeMS, QDateTime::currentMSecsSinceEpoch() );
+
+    appendHeader();
+    progressTimer.start();
+
+    while ( llCursorMS < m_llEndTimeMS )
+    {
+        if ( m_bCancelRequested.loadAcquire() != 0 )
+        {
+            return false;
+        }
+
+        qint64 llWindowStartMS;
+        qint64 llWindowEndMS;
+        bool bMoreData;
+
+        if ( !readWindow( llCursorMS, llWindowStartMS, llWindowEndMS, bMoreData ) )
+        {
+            return false;
+        }
+
+        if ( !bMoreData )
+        {
+            break;
+        }
+
+        if ( bFirstWindow )
+        {
+            // progress is measured from the first data, not from a begin time that may be 1970
+            m_llProgressBeginMS = llWindowStartMS;
+            bFirstWindow = false;
+        }
+
+        if ( !writeSamples() )
+        {
+            return false;
+        }
+
+        llCursorMS = llWindowEndMS;
+
+        if ( progressTimer.elapsed() >= TRANSDUCER_EXPORT_PROGRESS_INTERVAL_MS )
+        {
+            emit signalExportProgress( m_uiTransactionID, m_llRowsWritten, getPercentComplete( llCursorMS ) );
+            progressTimer.restart();
+        }
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** readWindow() - reads the samples of the next window that holds data into m_samples.  A
+*                  window never crosses a block boundary, so at most one block is decoded and
+*                  merged with the raw rows of the same hour.  Each window is read inside one
+*                  read transaction so a compaction running meanwhile cannot move rows between
+*                  the two reads.
+*   @param llFromTimeMS - no samples before this time are wanted
+*   @param llWindowStartMS - set to the time of the first sample at or after llFromTimeMS
+*   @param llWindowEndMS - set to the end of the window (exclusive)
+*   @param bMoreData - set to false when there are no samples left in the range
+*   @retval true - the reads succeeded
+*   @retval false - an error occurred, see m_sLastError
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerCSV_Exporter::readWindow( qint64 llFromTimeMS, qint64 & llWindowStartMS, qint64 & llWindowEndMS, bool & bMoreData )
+{
+    QVector<iC3_TransducerSample> firstRawSample;
+    qint64 llBlockStartMS = 0;
+    bool bBlockFound = false;
+
+    m_samples.clear();
+    bMoreData = false;
+
+    if ( !m_db.transaction() )
+    {
+        m_sLastError = QString("iC3_TransducerCSV_Exporter::readWindow() - Unable to begin a read: %1").arg( m_db.lastError().text() );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    bool bRC = m_TransducerTable.getEntriesInRange( m_db, m_iDeviceID, llFromTimeMS, m_llEndTimeMS, 1, firstRawSample ) &&
+               m_TransducerBlockTable.getNextBlockStartMS( m_db, m_iDeviceID, llFromTimeMS, llBlockStartMS, bBlockFound );
+
+    if ( bRC && m_SegmentReader.isEnabled() )
+    {
+        bRC = m_SegmentReader.getEntriesInRange( m_iDeviceID, llFromTimeMS, m_llEndTimeMS, 1, firstRawSample );
+    }
+
+    if ( bRC )
+    {
+        llWindowStartMS = m_llEndTimeMS;
+
+        for ( int iIndex = 0; iIndex < firstRawSample.size(); iIndex++ )
+        {
+            llWindowStartMS = qMin( llWindowStartMS, firstRawSample.at( iIndex ).llSampleTimeMS );
+        }
+
+        if ( bBlockFound )
+        {
+            llWindowStartMS = qMin( llWindowStartMS, qMax( llBlockStartMS, llFromTimeMS ) );
+        }
+
+        bMoreData = ( llWindowStartMS < m_llEndTimeMS );
+    }
+
+    if ( bRC && bMoreData )
+    {
+        llWindowEndMS = qMin( iC3_TransducerBlockTable::getBlockStartMS( llWindowStartMS ) + TRANSDUCER_BLOCK_DURATION_MS,
+                              m_llEndTimeMS );
+
+        bRC = m_TransducerBlockTable.getEntriesInRange( m_db, m_iDeviceID, llWindowStartMS, llWindowEndMS, m_samples );
+        if ( bRC )
+        {
+            bool bMerging = !m_samples.isEmpty();
+
+            bRC = m_TransducerTable.getEntriesInRange( m_db, m_iDeviceID, llWindowStartMS, llWindowEndMS,
+                                                       std::numeric_limits<int>::max(), m_samples );
+            if ( bRC && m_SegmentReader.isEnabled() )
+            {
+                int iFirstSegmentSample = m_samples.size();
+
+                bRC = m_SegmentReader.getEntriesInRange( m_iDeviceID, llWindowStartMS, llWindowEndMS,
+                                                         std::numeric_limits<int>::max(), m_samples );
+                bMerging = bMerging || ( ( iFirstSegmentSample > 0 ) && ( iFirstSegmentSample < m_samples.size() ) );
+            }
+            if ( bRC && bMerging )
+            {
+                std::stable_sort( m_samples.begin(), m_samples.end(), sampleTimeLessThan );
+            }
+        }
+    }
+
+    // nothing was written - ending the read just releases the snapshot
+    m_db.commit();
+
+    if ( !bRC )
+    {
+        m_sLastError = m_TransducerBlockTable.GetLastError();
+        if ( m_sLastError.isEmpty() )
+        {
+            m_sLastError = m_TransducerTable.GetLastError();
+        }
+        if ( m_sLastError.isEmpty() )
+        {
+            m_sLastError = m_SegmentReader.GetLastError();
+        }
+    }
+
+    return bRC;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** writeSamples() - formats m_samples into the output buffer, writing the buffer to the file
+*                    each time it fills
+*   @retval true - the samples were formatted
+*   @retval false - a file write failed, see m_sLastError
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerCSV_Exporter::writeSamples( void )
+{
+    char acRow[MAX_ROW_LENGTH];
+
+    for ( int iIndex = 0; iIndex < m_samples.size(); iIndex++ )
+    {
+        const iC3_TransducerSample & sample = m_samples.at( iIndex );
+        char * p = acRow;
+
+        // skip what an incremental export already delivered (compacted samples keep their time
+        // but lose their sequence index, so the time decides)
+        if ( ( sample.llSampleTimeMS < m_llAfterTimeMS ) ||
+             ( ( sample.llSampleTimeMS == m_llAfterTimeMS ) && ( sample.llSequenceIndex <= m_llAfterSequenceIndex ) ) )
+        {
+            continue;
+        }
+
+        p = iC3_ExportFormatter::formatInteger( p, sample.llSequenceIndex );
+        *p++ = ',';
+        *p++ = ' ';
+        p = iC3_ExportFormatter::formatInteger( p, sample.iDeviceID );
+        *p++ = ',';
+        *p++ = ' ';
+        p = m_Formatter.formatDateTime( p, sample.llSampleTimeMS );
+
+        for ( int iRTD = 0; iRTD < TRANSDUCER_NUMBER_OF_RTDS; iRTD++ )
+        {
+            *p++ = ',';
+            *p++ = ' ';
+            p = m_Formatter.formatDouble( p, sample.adRTDValues[iRTD] );
+        }
+
+        *p++ = '\r';
+        *p++ = '\n';
+
+        m_baOutput.append( acRow, (int) ( p - acRow ) );
+        m_llRowsWritten++;
+        m_llAfterTimeMS = sample.llSampleTimeMS;
+        m_llAfterSequenceIndex = sample.llSequenceIndex;
+
+        if ( ( m_baOutput.size() >= TRANSDUCER_EXPORT_BUFFER_BYTES ) && !flushOutput() )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** flushOutput() - writes the output buffer to the file and empties it, keeping its capacity
+*   @retval true - the buffer was written
+*   @retval false - the write failed, see m_sLastError
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerCSV_Exporter::flushOutput( void )
+{
+    if ( m_baOutput.isEmpty() )
+    {
+        return true;
+    }
+
+    if ( m_CSVFile.write( m_baOutput ) != m_baOutput.size() )
+    {
+        m_sLastError = QString("iC3_TransducerCSV_Exporter::flushOutput() - Write to %1 failed: %2")
+                           .arg( m_CSVFile.fileName() ).arg( m_CSVFile.errorString() );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    // resize rather than clear() so the allocation is reused
+    m_baOutput.resize( 0 );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** syncOutput() - makes sure everything written is on disk before the file is put in place
+*   @retval true - the file is synced
+*   @retval false - the sync failed, see m_sLastError
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerCSV_Exporter::syncOutput( void )
+{
+    bool bRC = m_CSVFile.flush();
+
+#ifdef Q_OS_UNIX
+    bRC = bRC && ( ::fsync( m_CSVFile.handle() ) == 0 );
+#endif
+
+    if ( !bRC )
+    {
+        m_sLastError = QString("iC3_TransducerCSV_Exporter::syncOutput() - Could not sync %1").arg( m_CSVFile.fileName() );
+        qDebug() << m_sLastError;
+    }
+
+    return bRC;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** appendHeader() - the column names line, matching the Transducers table
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_TransducerCSV_Exporter::appendHeader( void )
+{
+    QString sHeader = QString( IC3_SCHEMA_COLUMN_NAMES( TRANSDUCER_KEY_COLUMNS ) " (%1), "
+                               IC3_SCHEMA_COLUMN_NAMES( TRANSDUCER_RTD_COLUMNS ) )
+                          .arg( m_Formatter.isLocalTime() ? "local" : "UTC" );
+
+    sHeader.append( "\r\n" );
+    m_baOutput.append( sHeader.toLatin1() );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getPercentComplete() - how far through the range llPositionMS is
+*   @param llPositionMS - everything before this time has been written
+*   @retval 0 - 100
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+int iC3_TransducerCSV_Exporter::getPercentComplete( qint64 llPositionMS ) const
+{
+    if ( m_llProgressEndMS <= m_llProgressBeginMS )
+    {
+        return 100;
+    }
+
+    double dFraction = (double) ( llPositionMS - m_llProgressBeginMS ) / (double) ( m_llProgressEndMS - m_llProgressBeginMS );
+
+    return qBound( 0, (int) ( dFraction * 100.0 ), 100 );
+}
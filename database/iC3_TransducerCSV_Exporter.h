@@ -0,0 +1,127 @@
+#ifndef IC3_TRANSDUCERCSV_EXPORTER_H
+#define IC3_TRANSDUCERCSV_EXPORTER_H
+
+/**
+*     @file iC3_TransducerCSV_Exporter.h
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief This header file defines the iC3_TransducerCSV_Exporter class.  The exporter writes
+*            one device's transducer history (compacted blocks and raw rows) for a time range to
+*            a CSV file on its own thread and its own connection, so an export never holds up
+*            the request processor or the GUI.  An incremental export writes only the samples
+*            after the destination's mark in ExportMarks, the one table this connection writes.
+*/
+
+#include <QThread>
+#include <QAtomicInt>
+#include <QSqlDatabase>
+#include <QFile>
+#include <QByteArray>
+#include <QVector>
+
+#include "iC3_TransducerTable.h"
+#include "iC3_TransducerBlockTable.h"
+#include "iC3_ExportMarkTable.h"
+#include "iC3_ExportFormatter.h"
+#include "iC3_TransducerSegmentReader.h"
+
+// rows are formatted into one reusable buffer that is written out whenever it passes this size
+static const int TRANSDUCER_EXPORT_BUFFER_BYTES         = 1024 * 1024;
+static const int TRANSDUCER_EXPORT_PROGRESS_INTERVAL_MS = 250;
+
+// an incremental export also stops this far short of now, for samples time stamped but not
+// yet queued; the ones queued, uncommitted or spilled are held back by the caller's end limit
+static const int TRANSDUCER_EXPORT_SETTLE_MS            = 5000;
+
+class iC3_TransducerCSV_Exporter : public QThread
+{
+    Q_OBJECT
+public:
+    explicit iC3_TransducerCSV_Exporter(QObject *parent = 0);
+    ~iC3_TransducerCSV_Exporter();
+
+    bool startExport( uint uiTransactionID,
+                      const QString & sDatabaseFileName,
+                      const QString & sCSVFileName,
+                      int iDeviceID,
+                      qint64 llBeginTimeMS,
+                      qint64 llEndTimeMS );
+    bool startIncrementalExport( uint uiTransactionID,
+                                 const QString & sDatabaseFileName,
+                                 const QString & sDestination,
+                                 const QString & sCSVFileName,
+                                 int iDeviceID,
+                                 qint64 llEndLimitMS );
+    void cancelExport( void );
+    bool setExportFormat( eDateFormats dateFormat, eTimeFormats timeFormat, bool bLocalTime );
+    bool setSegmentStorePath( const QString & sSegmentStorePath );
+
+signals:
+
+    void signalExportProgress( uint uiTransactionID, qint64 llRowsWritten, int iPercentComplete );
+    void signalExportComplete( uint uiTransactionID, qint64 llRowsWritten );
+    void signalExportCancelled( uint uiTransactionID );
+    void signalExportFailed( uint uiTransactionID, QString sErrorMessage );
+
+protected:
+
+    void run();
+
+private:
+
+    bool openConnection( void );
+    void closeConnection( void );
+
+    bool exportRows( void );
+    bool readWindow( qint64 llFromTimeMS, qint64 & llWindowStartMS, qint64 & llWindowEndMS, bool & bMoreData );
+    bool writeSamples( void );
+    bool flushOutput( void );
+    bool syncOutput( void );
+
+    bool resolvePendingExport( iC3_ExportMark & mark );
+    bool commitIncrementalExport( iC3_ExportMark & mark, const QString & sPartFileName );
+    bool replaceFile( const QString & sFromFileName, const QString & sToFileName );
+
+    void appendHeader( void );
+
+    int getPercentComplete( qint64 llPositionMS ) const;
+
+    // parameters of the export in progress - written before start()
+    uint m_uiTransactionID;
+    QString m_sDatabaseFileName;
+    QString m_sCSVFileName;
+    QString m_sDestination;                         // empty for a plain range export
+    int m_iDeviceID;
+    qint64 m_llBeginTimeMS;
+    qint64 m_llEndTimeMS;                           // incremental: the limit until run() sets it
+
+    QAtomicInt m_bCancelRequested;
+
+    // used on the exporter thread only
+    QSqlDatabase m_db;
+    iC3_TransducerTable m_TransducerTable;
+    iC3_TransducerBlockTable m_TransducerBlockTable;
+    iC3_ExportMarkTable m_ExportMarkTable;
+    iC3_TransducerSegmentReader m_SegmentReader;   // root path set before start()
+
+    QFile m_CSVFile;
+    QByteArray m_baOutput;
+    QVector<iC3_TransducerSample> m_samples;
+    qint64 m_llRowsWritten;
+
+    // only samples after (time, sequence) are written; updated to the last sample written
+    qint64 m_llAfterTimeMS;
+    qint64 m_llAfterSequenceIndex;
+    qint64 m_llProgressBeginMS;
+    qint64 m_llProgressEndMS;
+
+    // how the sample time is written - set before start()
+    eDateFormats m_eDateFormat;
+    eTimeFormats m_eTimeFormat;
+    bool m_bLocalTime;
+    iC3_ExportFormatter m_Formatter;
+
+    QString m_sLastError;
+};
+
+#endif // IC3_TRANSDUCERCSV_EXPORTER_H
@@ -0,0 +1,51 @@
+#ifndef IC3_TRANSDUCERROLLUP_H
+#define IC3_TRANSDUCERROLLUP_H
+
+/**
+*     @file iC3_TransducerRollup.h
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief This header file defines iC3_TransducerRollup, the per-probe count/min/max/sum of
+*            one device's samples over one rollup bucket (a minute or an hour).
+*/
+
+#include <QtGlobal>
+#include <QMetaType>
+#include <QVector>
+
+#include "iC3_TransducerSample.h"
+
+enum eTransducerRollupLevels
+{
+    eTRANSDUCER_ROLLUP_1_MINUTE  = 0,
+    eTRANSDUCER_ROLLUP_1_HOUR    = 1,
+
+    eTRANSDUCER_ROLLUP_LEVEL_COUNT
+};
+
+static const qint64 TRANSDUCER_ROLLUP_1_MINUTE_MS = 60 * 1000;
+static const qint64 TRANSDUCER_ROLLUP_1_HOUR_MS   = 60 * 60 * 1000;
+
+static const char TRANSDUCER_ROLLUP_1_MINUTE_TABLE_NAME[] = "TransducerRollup1Min";
+static const char TRANSDUCER_ROLLUP_1_HOUR_TABLE_NAME[]   = "TransducerRollup1Hour";
+
+static const double TRANSDUCER_ROLLUP_VALID_LIMIT = 1.0E30;
+
+struct iC3_TransducerRollup
+{
+    int    iDeviceID;
+    qint64 llBucketStartMS;                         // ms since the epoch (UTC)
+    int    iSampleCount;
+
+    // per probe - readings outside +/-TRANSDUCER_ROLLUP_VALID_LIMIT (overload, open probe) are
+    // not counted, so aiCount can be lower than iSampleCount
+    int    aiCount[TRANSDUCER_NUMBER_OF_RTDS];
+    double adMin[TRANSDUCER_NUMBER_OF_RTDS];
+    double adMax[TRANSDUCER_NUMBER_OF_RTDS];
+    double adSum[TRANSDUCER_NUMBER_OF_RTDS];        // mean = adSum / aiCount
+};
+
+Q_DECLARE_METATYPE(iC3_TransducerRollup)
+Q_DECLARE_METATYPE(QVector<iC3_TransducerRollup>)
+
+#endif // IC3_TRANSDUCERROLLUP_H
@@ -0,0 +1,443 @@
+/**
+*     @file iC3_TransducerRollupTable.cpp
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief this cpp file implements the iC3_TransducerRollupTable class.
+*/
+
+#include <QSqlError>
+#include <QDebug>
+#include <QVariant>
+
+#include "iC3_TransducerRollupTable.h"
+
+//-----------------------------------------------------------------------------------------------
+/** constructor
+*   @param sTableName - name of the table for this rollup level
+*   @param llBucketMS - length of one bucket
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_TransducerRollupTable::iC3_TransducerRollupTable( const QString & sTableName, qint64 llBucketMS ) :
+    m_llBucketMS( llBucketMS )
+{
+    iC3_DatabaseColumnDef * pColumn;
+
+    m_sTableName = sTableName;
+
+    setNumberOfColumns( e_NUMBER_OF_ROLLUP_TABLE_COLUMNS );
+
+    pColumn = new iC3_DatabaseColumnDef( tr("deviceID"), "INTEGER", "NOT NULL" );
+    AddColumnDef( e_ROLLUP_TABLE_DEVICE_ID_COL, pColumn );
+
+    pColumn = new iC3_DatabaseColumnDef( tr("bucketStartMS"), "INTEGER", "NOT NULL" );
+    AddColumnDef( e_ROLLUP_TABLE_BUCKET_START_COL, pColumn );
+
+    pColumn = new iC3_DatabaseColumnDef( tr("sampleCount"), "INTEGER", "NOT NULL" );
+    AddColumnDef( e_ROLLUP_TABLE_SAMPLE_COUNT_COL, pColumn );
+
+    for ( int iRTD = 0; iRTD < TRANSDUCER_NUMBER_OF_RTDS; iRTD++ )
+    {
+        int iColumn = e_ROLLUP_TABLE_FIRST_RTD_COL + iRTD * e_ROLLUP_TABLE_COLUMNS_PER_RTD;
+
+        pColumn = new iC3_DatabaseColumnDef( QString("RTD%1Count").arg( iRTD + 1 ), "INTEGER", "NOT NULL" );
+        AddColumnDef( iColumn, pColumn );
+
+        pColumn = new iC3_DatabaseColumnDef( QString("RTD%1Min").arg( iRTD + 1 ), "REAL", "" );
+        AddColumnDef( iColumn + 1, pColumn );
+
+        pColumn = new iC3_DatabaseColumnDef( QString("RTD%1Max").arg( iRTD + 1 ), "REAL", "" );
+        AddColumnDef( iColumn + 2, pColumn );
+
+        pColumn = new iC3_DatabaseColumnDef( QString("RTD%1Sum").arg( iRTD + 1 ), "REAL", "" );
+        AddColumnDef( iColumn + 3, pColumn );
+    }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** CreateTable() - creates the rollup table and its (deviceID, bucketStartMS) key if they do
+*                   not exist.
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @retval true - the table exists
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerRollupTable::CreateTable( QSqlDatabase & database )
+{
+    QSqlQuery query( database );
+
+    ClearLastError();
+
+    if ( !database.isOpen() )
+    {
+        SetLastError( QString("iC3_TransducerRollupTable::CreateTable() - Database is not open") );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    QString sIndexSQL = QString("CREATE UNIQUE INDEX IF NOT EXISTS %1_DeviceBucket ON %1 ( %2, %3 )")
+                            .arg( m_sTableName )
+                            .arg( getColumnDef( e_ROLLUP_TABLE_DEVICE_ID_COL )->getColumnName() )
+                            .arg( getColumnDef( e_ROLLUP_TABLE_BUCKET_START_COL )->getColumnName() );
+
+    if ( !query.exec( getTableCreationSQL( m_sTableName ) ) || !query.exec( sIndexSQL ) )
+    {
+        SetLastError( QString("iC3_TransducerRollupTable::CreateTable() - Query Error: %1").arg( query.lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+qint64 iC3_TransducerRollupTable::getBucketMS( void ) const
+{
+    return m_llBucketMS;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getBucketStartMS() - returns the start of the bucket a sample time falls in
+*   @param llSampleTimeMS - ms since the epoch
+*   @retval bucket start, ms since the epoch
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+qint64 iC3_TransducerRollupTable::getBucketStartMS( qint64 llSampleTimeMS ) const
+{
+    qint64 llRemainder = llSampleTimeMS % m_llBucketMS;
+
+    if ( llRemainder < 0 )
+    {
+        llRemainder += m_llBucketMS;
+    }
+
+    return llSampleTimeMS - llRemainder;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** clearRollup() - resets a rollup to an empty bucket
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_TransducerRollupTable::clearRollup( iC3_TransducerRollup & rollup, int iDeviceID, qint64 llBucketStartMS )
+{
+    rollup.iDeviceID = iDeviceID;
+    rollup.llBucketStartMS = llBucketStartMS;
+    rollup.iSampleCount = 0;
+
+    for ( int iRTD = 0; iRTD < TRANSDUCER_NUMBER_OF_RTDS; iRTD++ )
+    {
+        rollup.aiCount[iRTD] = 0;
+        rollup.adMin[iRTD] = 0.0;
+        rollup.adMax[iRTD] = 0.0;
+        rollup.adSum[iRTD] = 0.0;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** addSample() - accumulates one sample into a rollup
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_TransducerRollupTable::addSample( iC3_TransducerRollup & rollup, const iC3_TransducerSample & sample )
+{
+    rollup.iSampleCount++;
+
+    for ( int iRTD = 0; iRTD < TRANSDUCER_NUMBER_OF_RTDS; iRTD++ )
+    {
+        double dValue = sample.adRTDValues[iRTD];
+
+        // written so that NaN is rejected as well
+        if ( !( ( dValue > -TRANSDUCER_ROLLUP_VALID_LIMIT ) && ( dValue < TRANSDUCER_ROLLUP_VALID_LIMIT ) ) )
+        {
+            continue;
+        }
+
+        if ( rollup.aiCount[iRTD] == 0 )
+        {
+            rollup.adMin[iRTD] = dValue;
+            rollup.adMax[iRTD] = dValue;
+        }
+        else
+        {
+            rollup.adMin[iRTD] = qMin( rollup.adMin[iRTD], dValue );
+            rollup.adMax[iRTD] = qMax( rollup.adMax[iRTD], dValue );
+        }
+
+        rollup.aiCount[iRTD]++;
+        rollup.adSum[iRTD] += dValue;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** mergeRollup() - combines another rollup of the same bucket into rollup
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_TransducerRollupTable::mergeRollup( iC3_TransducerRollup & rollup, const iC3_TransducerRollup & other )
+{
+    rollup.iSampleCount += other.iSampleCount;
+
+    for ( int iRTD = 0; iRTD < TRANSDUCER_NUMBER_OF_RTDS; iRTD++ )
+    {
+        if ( other.aiCount[iRTD] == 0 )
+        {
+            continue;
+        }
+
+        if ( rollup.aiCount[iRTD] == 0 )
+        {
+            rollup.adMin[iRTD] = other.adMin[iRTD];
+            rollup.adMax[iRTD] = other.adMax[iRTD];
+        }
+        else
+        {
+            rollup.adMin[iRTD] = qMin( rollup.adMin[iRTD], other.adMin[iRTD] );
+            rollup.adMax[iRTD] = qMax( rollup.adMax[iRTD], other.adMax[iRTD] );
+        }
+
+        rollup.aiCount[iRTD] += other.aiCount[iRTD];
+        rollup.adSum[iRTD] += other.adSum[iRTD];
+    }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** mergeIntoTable() - adds a partial rollup to the stored row for its bucket, creating the row
+*                      if needed.  Run inside the writer's transaction.
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @param rollup - the samples accumulated since the bucket was last merged
+*   @retval true - the bucket was updated
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerRollupTable::mergeIntoTable( QSqlDatabase & database, const iC3_TransducerRollup & rollup )
+{
+    ClearLastError();
+
+    if ( rollup.iSampleCount == 0 )
+    {
+        return true;
+    }
+
+    QSqlQuery * pReadQuery = getPreparedQuery( database, e_ROLLUP_STMT_READ,
+                                               QString("SELECT * FROM %1 WHERE %2 = ? AND %3 = ?")
+                                                   .arg( m_sTableName )
+                                                   .arg( getColumnDef( e_ROLLUP_TABLE_DEVICE_ID_COL )->getColumnName() )
+                                                   .arg( getColumnDef( e_ROLLUP_TABLE_BUCKET_START_COL )->getColumnName() ) );
+
+    QString sPlaceholders = "?";
+    for ( int iIndex = 1; iIndex < e_NUMBER_OF_ROLLUP_TABLE_COLUMNS; iIndex++ )
+    {
+        sPlaceholders.append( ", ?" );
+    }
+
+    QSqlQuery * pWriteQuery = getPreparedQuery( database, e_ROLLUP_STMT_WRITE,
+                                                QString("INSERT OR REPLACE INTO %1 %2 VALUES ( %3 )")
+                                                    .arg( m_sTableName ).arg( getSQL_ColumnNames() ).arg( sPlaceholders ) );
+    if ( ( pReadQuery == NULL ) || ( pWriteQuery == NULL ) )
+    {
+        return false;
+    }
+
+    iC3_TransducerRollup merged = rollup;
+
+    pReadQuery->bindValue( 0, rollup.iDeviceID );
+    pReadQuery->bindValue( 1, rollup.llBucketStartMS );
+
+    if ( !pReadQuery->exec() )
+    {
+        SetLastError( QString("iC3_TransducerRollupTable::mergeIntoTable() - Query Error: %1").arg( pReadQuery->lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    if ( pReadQuery->next() )
+    {
+        iC3_TransducerRollup stored;
+        updateRollupFromQuery( stored, *pReadQuery );
+        mergeRollup( merged, stored );
+    }
+    pReadQuery->finish();
+
+    pWriteQuery->bindValue( e_ROLLUP_TABLE_DEVICE_ID_COL, merged.iDeviceID );
+    pWriteQuery->bindValue( e_ROLLUP_TABLE_BUCKET_START_COL, merged.llBucketStartMS );
+    pWriteQuery->bindValue( e_ROLLUP_TABLE_SAMPLE_COUNT_COL, merged.iSampleCount );
+
+    for ( int iRTD = 0; iRTD < TRANSDUCER_NUMBER_OF_RTDS; iRTD++ )
+    {
+        int iColumn = e_ROLLUP_TABLE_FIRST_RTD_COL + iRTD * e_ROLLUP_TABLE_COLUMNS_PER_RTD;
+        bool bHaveValues = ( merged.aiCount[iRTD] > 0 );
+
+        pWriteQuery->bindValue( iColumn, merged.aiCount[iRTD] );
+        pWriteQuery->bindValue( iColumn + 1, bHaveValues ? QVariant( merged.adMin[iRTD] ) : QVariant() );
+        pWriteQuery->bindValue( iColumn + 2, bHaveValues ? QVariant( merged.adMax[iRTD] ) : QVariant() );
+        pWriteQuery->bindValue( iColumn + 3, merged.adSum[iRTD] );
+    }
+
+    if ( !pWriteQuery->exec() )
+    {
+        SetLastError( QString("iC3_TransducerRollupTable::mergeIntoTable() - Query Error: %1").arg( pWriteQuery->lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getRollupsInRange() - retrieves a device's buckets with llStartTimeMS <= start < llEndTimeMS,
+*                         oldest first.
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @param iDeviceID - the device whose rollups are wanted
+*   @param llStartTimeMS - start of the range, ms since the epoch (inclusive)
+*   @param llEndTimeMS - end of the range, ms since the epoch (exclusive)
+*   @param rollups - the buckets found are appended here
+*   @retval true - if the query succeeded
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerRollupTable::getRollupsInRange( QSqlDatabase & database,
+                                                   int iDeviceID,
+                                                   qint64 llStartTimeMS,
+                                                   qint64 llEndTimeMS,
+                                                   QVector<iC3_TransducerRollup> & rollups )
+{
+    ClearLastError();
+
+    QString sBucketColumn = getColumnDef( e_ROLLUP_TABLE_BUCKET_START_COL )->getColumnName();
+
+    QSqlQuery * pQuery = getPreparedQuery( database, e_ROLLUP_STMT_SELECT_RANGE,
+                                           QString("SELECT * FROM %1 WHERE %2 = ? AND %3 >= ? AND %3 < ? ORDER BY %3")
+                                               .arg( m_sTableName )
+                                               .arg( getColumnDef( e_ROLLUP_TABLE_DEVICE_ID_COL )->getColumnName() )
+                                               .arg( sBucketColumn ) );
+    if ( pQuery == NULL )
+    {
+        return false;
+    }
+
+    pQuery->setForwardOnly( true );
+    pQuery->bindValue( 0, iDeviceID );
+    pQuery->bindValue( 1, llStartTimeMS );
+    pQuery->bindValue( 2, llEndTimeMS );
+
+    if ( !pQuery->exec() )
+    {
+        SetLastError( QString("iC3_TransducerRollupTable::getRollupsInRange() - Query Error: %1").arg( pQuery->lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    iC3_TransducerRollup rollup;
+    while ( pQuery->next() )
+    {
+        updateRollupFromQuery( rollup, *pQuery );
+        rollups.append( rollup );
+    }
+
+    pQuery->finish();
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** deleteRollupsBefore() - deletes up to iMaxRows buckets that start before llBeforeTimeMS.
+*                           Buckets are written roughly in time order, so walking the rowid
+*                           finds the old ones first without an index on the bucket alone.
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @param llBeforeTimeMS - buckets starting before this time are deleted
+*   @param iMaxRows - the most rows to delete in this call
+*   @param iDeleted - set to the number of rows deleted
+*   @retval true - the delete succeeded
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerRollupTable::deleteRollupsBefore( QSqlDatabase & database, qint64 llBeforeTimeMS, int iMaxRows, int & iDeleted )
+{
+    ClearLastError();
+
+    iDeleted = 0;
+
+    QSqlQuery * pQuery = getPreparedQuery( database, e_ROLLUP_STMT_DELETE_BEFORE,
+                                           QString("DELETE FROM %1 WHERE rowid IN ( SELECT rowid FROM %1 WHERE %2 < ? ORDER BY rowid LIMIT ? )")
+                                               .arg( m_sTableName )
+                                               .arg( getColumnDef( e_ROLLUP_TABLE_BUCKET_START_COL )->getColumnName() ) );
+    if ( pQuery == NULL )
+    {
+        return false;
+    }
+
+    pQuery->bindValue( 0, llBeforeTimeMS );
+    pQuery->bindValue( 1, iMaxRows );
+
+    if ( !pQuery->exec() )
+    {
+        SetLastError( QString("iC3_TransducerRollupTable::deleteRollupsBefore() - Query Error: %1").arg( pQuery->lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    iDeleted = pQuery->numRowsAffected();
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getSQL_ColumnNames() - returns "( col, col, ... )" for all columns
+*   @retval column name list usable in an sql statement
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+QString iC3_TransducerRollupTable::getSQL_ColumnNames( void )
+{
+    QString sColumnNames = QString("( %1").arg( getColumnDef( 0 )->getColumnName() );
+
+    for ( int iIndex = 1; iIndex < e_NUMBER_OF_ROLLUP_TABLE_COLUMNS; iIndex++ )
+    {
+        sColumnNames.append( QString(", %1").arg( getColumnDef( iIndex )->getColumnName() ) );
+    }
+    sColumnNames.append( " )" );
+
+    return sColumnNames;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** updateRollupFromQuery() - copies the current row of a "SELECT *" into a rollup
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_TransducerRollupTable::updateRollupFromQuery( iC3_TransducerRollup & rollup, QSqlQuery & query )
+{
+    rollup.iDeviceID = query.value( e_ROLLUP_TABLE_DEVICE_ID_COL ).toInt();
+    rollup.llBucketStartMS = query.value( e_ROLLUP_TABLE_BUCKET_START_COL ).toLongLong();
+    rollup.iSampleCount = query.value( e_ROLLUP_TABLE_SAMPLE_COUNT_COL ).toInt();
+
+    for ( int iRTD = 0; iRTD < TRANSDUCER_NUMBER_OF_RTDS; iRTD++ )
+    {
+        int iColumn = e_ROLLUP_TABLE_FIRST_RTD_COL + iRTD * e_ROLLUP_TABLE_COLUMNS_PER_RTD;
+
+        rollup.aiCount[iRTD] = query.value( iColumn ).toInt();
+        rollup.adMin[iRTD] = query.value( iColumn + 1 ).toDouble();
+        rollup.adMax[iRTD] = query.value( iColumn + 2 ).toDouble();
+        rollup.adSum[iRTD] = query.value( iColumn + 3 ).toDouble();
+    }
+}
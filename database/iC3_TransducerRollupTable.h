@@ -0,0 +1,68 @@
+#ifndef IC3_TRANSDUCERROLLUPTABLE_H
+#define IC3_TRANSDUCERROLLUPTABLE_H
+
+/**
+*     @file iC3_TransducerRollupTable.h
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief This header file defines the iC3_TransducerRollupTable class.  One instance per
+*            rollup level; the table name and bucket length are given to the constructor.
+*/
+
+#include <QVector>
+#include "iC3_DatabaseTable.h"
+#include "iC3_TransducerRollup.h"
+
+class iC3_TransducerRollupTable : public iC3_DatabaseTable
+{
+public:
+    iC3_TransducerRollupTable( const QString & sTableName, qint64 llBucketMS );
+
+    enum eIC3_TransducerRollupTableColumns
+    {
+        e_ROLLUP_TABLE_DEVICE_ID_COL                = 0,
+        e_ROLLUP_TABLE_BUCKET_START_COL             = 1,
+        e_ROLLUP_TABLE_SAMPLE_COUNT_COL             = 2,
+        e_ROLLUP_TABLE_FIRST_RTD_COL                = 3,    // then count, min, max, sum per RTD
+
+        e_ROLLUP_TABLE_COLUMNS_PER_RTD              = 4,
+        e_NUMBER_OF_ROLLUP_TABLE_COLUMNS            = e_ROLLUP_TABLE_FIRST_RTD_COL + e_ROLLUP_TABLE_COLUMNS_PER_RTD * TRANSDUCER_NUMBER_OF_RTDS
+    };
+
+    enum eIC3_TransducerRollupTableStatements
+    {
+        e_ROLLUP_STMT_READ                          = 0,
+        e_ROLLUP_STMT_WRITE                         = 1,
+        e_ROLLUP_STMT_SELECT_RANGE                  = 2,
+        e_ROLLUP_STMT_DELETE_BEFORE                 = 3
+    };
+
+    bool CreateTable( QSqlDatabase & database );
+
+    qint64 getBucketMS( void ) const;
+    qint64 getBucketStartMS( qint64 llSampleTimeMS ) const;
+
+    static void clearRollup( iC3_TransducerRollup & rollup, int iDeviceID, qint64 llBucketStartMS );
+    static void addSample( iC3_TransducerRollup & rollup, const iC3_TransducerSample & sample );
+    static void mergeRollup( iC3_TransducerRollup & rollup, const iC3_TransducerRollup & other );
+
+    bool mergeIntoTable( QSqlDatabase & database, const iC3_TransducerRollup & rollup );
+
+    bool getRollupsInRange( QSqlDatabase & database,
+                            int iDeviceID,
+                            qint64 llStartTimeMS,
+                            qint64 llEndTimeMS,
+                            QVector<iC3_TransducerRollup> & rollups );
+
+    bool deleteRollupsBefore( QSqlDatabase & database, qint64 llBeforeTimeMS, int iMaxRows, int & iDeleted );
+
+    QString getSQL_ColumnNames( void );
+
+private:
+
+    void updateRollupFromQuery( iC3_TransducerRollup & rollup, QSqlQuery & query );
+
+    qint64 m_llBucketMS;
+};
+
+#endif // IC3_TRANSDUCERROLLUPTABLE_H
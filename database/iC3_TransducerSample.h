@@ -0,0 +1,30 @@
+#ifndef IC3_TRANSDUCERSAMPLE_H
+#define IC3_TRANSDUCERSAMPLE_H
+
+/**
+*     @file iC3_TransducerSample.h
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief This header file defines iC3_TransducerSample, one row of RTD temperatures as it
+*            is written to and read from the Transducers table.
+*/
+
+#include <QtGlobal>
+#include <QMetaType>
+#include <QVector>
+
+static const int TRANSDUCER_NUMBER_OF_RTDS = 5;
+static const int TRANSDUCER_LOCAL_DEVICE_ID = 0;        // the unit's own Fluke
+
+struct iC3_TransducerSample
+{
+    qint64 llSequenceIndex;                         // assigned by the database on insert
+    int    iDeviceID;
+    qint64 llSampleTimeMS;                          // ms since 1970-01-01T00:00:00 UTC
+    double adRTDValues[TRANSDUCER_NUMBER_OF_RTDS];
+};
+
+Q_DECLARE_METATYPE(iC3_TransducerSample)
+Q_DECLARE_METATYPE(QVector<iC3_TransducerSample>)
+
+#endif // IC3_TRANSDUCERSAMPLE_H
@@ -0,0 +1,170 @@
+/**
+*     @file iC3_TransducerSegment.cpp
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief this cpp file implements iC3_TransducerSegment.
+*/
+
+#include <QDir>
+#include <string.h>
+#include <stddef.h>
+
+#include "iC3_TransducerSegment.h"
+
+//-----------------------------------------------------------------------------------------------
+/** getDeviceDirectory() - the directory holding one device's segments
+*   @param sRootPath - the segment store's root directory
+*   @param iDeviceID - the device
+*   @retval the directory path, ending in '/'
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+QString iC3_TransducerSegment::getDeviceDirectory( const QString & sRootPath, int iDeviceID )
+{
+    QString sDirectory = sRootPath;
+
+    if ( !sDirectory.endsWith( '/' ) )
+    {
+        sDirectory.append( '/' );
+    }
+
+    return sDirectory + QString("device_%1/").arg( iDeviceID );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getSegmentFileName() - a segment's file name.  The sequence index comes first and both
+*                          numbers are zero padded, so the names sort in the order the segments
+*                          were written even when the clock has been set back.
+*   @param llFirstSequenceIndex - sequence index of the segment's first sample
+*   @param llFirstSampleTimeMS - time of the segment's first sample
+*   @retval the file name, without a directory
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+QString iC3_TransducerSegment::getSegmentFileName( qint64 llFirstSequenceIndex, qint64 llFirstSampleTimeMS )
+{
+    return QString("%1_%2%3").arg( llFirstSequenceIndex, 16, 10, QChar('0') )
+                             .arg( qMax( llFirstSampleTimeMS, Q_INT64_C(0) ), 16, 10, QChar('0') )
+                             .arg( TRANSDUCER_SEGMENT_FILE_SUFFIX );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getFirstSequenceIndex() - the sequence index a segment file name starts with
+*   @param sFileName - a segment file name, with or without a directory
+*   @retval the sequence index, 0 if the name is not a segment name
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+qint64 iC3_TransducerSegment::getFirstSequenceIndex( const QString & sFileName )
+{
+    return sFileName.section( '/', -1 ).section( '_', 0, 0 ).toLongLong();
+}
+
+//-----------------------------------------------------------------------------------------------
+/** listSegments() - the segment files in a device directory, oldest first
+*   @param sDeviceDirectory - from getDeviceDirectory()
+*   @retval file names, without the directory; empty if the directory does not exist
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+QStringList iC3_TransducerSegment::listSegments( const QString & sDeviceDirectory )
+{
+    QDir directory( sDeviceDirectory );
+
+    return directory.entryList( QStringList( QString("*%1").arg( TRANSDUCER_SEGMENT_FILE_SUFFIX ) ),
+                                QDir::Files, QDir::Name );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** initHeader() - fills in the header of a new segment
+*   @param header - the header to fill in
+*   @param iDeviceID - the device the segment belongs to
+*   @param llFirstSampleTimeMS - time of the segment's first sample
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_TransducerSegment::initHeader( iC3_TransducerSegmentHeader & header, int iDeviceID, qint64 llFirstSampleTimeMS )
+{
+    memset( &header, 0, sizeof( header ) );
+    memcpy( header.acMagic, TRANSDUCER_SEGMENT_MAGIC, sizeof( header.acMagic ) );
+    header.ulFormatVersion = TRANSDUCER_SEGMENT_FORMAT_VERSION;
+    header.ulRecordSize = sizeof( iC3_TransducerSegmentRecord );
+    header.lDeviceID = iDeviceID;
+    header.llFirstSampleTimeMS = llFirstSampleTimeMS;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** isValidHeader() - checks that a header is a segment of this format for the device
+*   @param header - the header read from the file
+*   @param iDeviceID - the device the segment should belong to
+*   @retval true - the records can be read with this build
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerSegment::isValidHeader( const iC3_TransducerSegmentHeader & header, int iDeviceID )
+{
+    return ( memcmp( header.acMagic, TRANSDUCER_SEGMENT_MAGIC, sizeof( header.acMagic ) ) == 0 ) &&
+           ( header.ulFormatVersion == TRANSDUCER_SEGMENT_FORMAT_VERSION ) &&
+           ( header.ulRecordSize == sizeof( iC3_TransducerSegmentRecord ) ) &&
+           ( header.lDeviceID == iDeviceID );
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+void iC3_TransducerSegment::sampleToRecord( const iC3_TransducerSample & sample, iC3_TransducerSegmentRecord & record )
+{
+    record.llSequenceIndex = sample.llSequenceIndex;
+    record.llSampleTimeMS = sample.llSampleTimeMS;
+    for ( int iRTD = 0; iRTD < TRANSDUCER_NUMBER_OF_RTDS; iRTD++ )
+    {
+        record.adRTDValues[iRTD] = sample.adRTDValues[iRTD];
+    }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** recordToSample() - copies a record out of a mapped segment
+*   @param pRecord - the record in the mapping
+*   @param iDeviceID - the segment's device
+*   @param sample - set to the record's sample
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_TransducerSegment::recordToSample( const uchar * pRecord, int iDeviceID, iC3_TransducerSample & sample )
+{
+    iC3_TransducerSegmentRecord record;
+
+    // the mapping is page aligned and every field 8 byte aligned, but a copy costs nothing here
+    memcpy( &record, pRecord, sizeof( record ) );
+
+    sample.llSequenceIndex = record.llSequenceIndex;
+    sample.iDeviceID = iDeviceID;
+    sample.llSampleTimeMS = record.llSampleTimeMS;
+    for ( int iRTD = 0; iRTD < TRANSDUCER_NUMBER_OF_RTDS; iRTD++ )
+    {
+        sample.adRTDValues[iRTD] = record.adRTDValues[iRTD];
+    }
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+qint64 iC3_TransducerSegment::recordTimeMS( const uchar * pRecord )
+{
+    qint64 llSampleTimeMS;
+
+    memcpy( &llSampleTimeMS, pRecord + offsetof( iC3_TransducerSegmentRecord, llSampleTimeMS ), sizeof( llSampleTimeMS ) );
+
+    return llSampleTimeMS;
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+qint64 iC3_TransducerSegment::recordSequenceIndex( const uchar * pRecord )
+{
+    qint64 llSequenceIndex;
+
+    memcpy( &llSequenceIndex, pRecord + offsetof( iC3_TransducerSegmentRecord, llSequenceIndex ), sizeof( llSequenceIndex ) );
+
+    return llSequenceIndex;
+}
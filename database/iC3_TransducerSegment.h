@@ -0,0 +1,76 @@
+#ifndef IC3_TRANSDUCERSEGMENT_H
+#define IC3_TRANSDUCERSEGMENT_H
+
+/**
+*     @file iC3_TransducerSegment.h
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief This header file defines the layout of a transducer segment file and
+*            iC3_TransducerSegment, the helpers shared by the segment writer and reader.
+*
+*            When the segment store is enabled, raw samples are appended to fixed-size records
+*            in segment files instead of being inserted into the Transducers table:
+*               <root>/device_<ID>/<first sequence index>_<first sample time>.seg
+*            Each file is a 32 byte header followed by one 56 byte record per sample, in the
+*            order written.  A file only ever grows, so a reader can map it and read records
+*            in place; the writer starts a new file when one reaches its size or time limit,
+*            and when the clock goes back, so the records of every file are in time order.
+*            Files are native byte order - they are read on the unit that wrote them.
+*/
+
+#include <QtGlobal>
+#include <QString>
+#include <QStringList>
+
+#include "iC3_TransducerSample.h"
+
+static const char   TRANSDUCER_SEGMENT_MAGIC[8]           = { 'i', 'C', '3', 'S', 'E', 'G', '\0', '\0' };
+static const quint32 TRANSDUCER_SEGMENT_FORMAT_VERSION     = 1;
+static const char   TRANSDUCER_SEGMENT_FILE_SUFFIX[]       = ".seg";
+
+// records per entry of the sparse time index a reader builds when it maps a segment
+static const int    TRANSDUCER_SEGMENT_INDEX_STRIDE       = 256;
+
+// a reader keeps at most this many segments mapped, unmapping the least recently used
+static const int    TRANSDUCER_SEGMENT_MAX_MAPPED         = 8;
+
+// a segment is closed at whichever limit comes first; ~4 MB is about 3 days at one sample a
+// second and keeps a mapped file small enough for a 32 bit address space
+static const qint64 TRANSDUCER_SEGMENT_MAX_BYTES          = 4 * 1024 * 1024;
+static const qint64 TRANSDUCER_SEGMENT_MAX_DURATION_MS    = 24 * 60 * 60 * 1000;
+
+struct iC3_TransducerSegmentHeader
+{
+    char    acMagic[8];
+    quint32 ulFormatVersion;
+    quint32 ulRecordSize;                           // sizeof( iC3_TransducerSegmentRecord )
+    qint32  lDeviceID;
+    quint32 ulReserved;
+    qint64  llFirstSampleTimeMS;
+};
+
+struct iC3_TransducerSegmentRecord
+{
+    qint64 llSequenceIndex;                         // per device, counts up across segments
+    qint64 llSampleTimeMS;
+    double adRTDValues[TRANSDUCER_NUMBER_OF_RTDS];
+};
+
+class iC3_TransducerSegment
+{
+public:
+    static QString getDeviceDirectory( const QString & sRootPath, int iDeviceID );
+    static QString getSegmentFileName( qint64 llFirstSequenceIndex, qint64 llFirstSampleTimeMS );
+    static qint64 getFirstSequenceIndex( const QString & sFileName );
+    static QStringList listSegments( const QString & sDeviceDirectory );
+
+    static void initHeader( iC3_TransducerSegmentHeader & header, int iDeviceID, qint64 llFirstSampleTimeMS );
+    static bool isValidHeader( const iC3_TransducerSegmentHeader & header, int iDeviceID );
+
+    static void sampleToRecord( const iC3_TransducerSample & sample, iC3_TransducerSegmentRecord & record );
+    static void recordToSample( const uchar * pRecord, int iDeviceID, iC3_TransducerSample & sample );
+    static qint64 recordTimeMS( const uchar * pRecord );
+    static qint64 recordSequenceIndex( const uchar * pRecord );
+};
+
+#endif // IC3_TRANSDUCERSEGMENT_H
@@ -0,0 +1,614 @@
+/**
+*     @file iC3_TransducerSegmentReader.cpp
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief this cpp file implements the iC3_TransducerSegmentReader class.
+*/
+
+#include <QFileInfo>
+#include <QDebug>
+#include <limits>
+#include <algorithm>
+
+#include "iC3_TransducerSegmentReader.h"
+
+namespace
+{
+    // the order the Transducers table returns rows in
+    bool sampleKeyLessThan( const iC3_TransducerSample & first, const iC3_TransducerSample & second )
+    {
+        return ( first.llSampleTimeMS < second.llSampleTimeMS ) ||
+               ( ( first.llSampleTimeMS == second.llSampleTimeMS ) && ( first.llSequenceIndex < second.llSequenceIndex ) );
+    }
+
+    const uchar * getRecord( const uchar * pMapping, qint64 llIndex )
+    {
+        return pMapping + sizeof( iC3_TransducerSegmentHeader ) + llIndex * sizeof( iC3_TransducerSegmentRecord );
+    }
+}
+
+//-----------------------------------------------------------------------------------------------
+/** constructor
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_TransducerSegmentReader::iC3_TransducerSegmentReader() :
+    m_iMappedSegments( 0 ),
+    m_ullUseCounter( 0 )
+{
+}
+
+//-----------------------------------------------------------------------------------------------
+/** destructor - unmaps every segment
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_TransducerSegmentReader::~iC3_TransducerSegmentReader()
+{
+    close();
+}
+
+//-----------------------------------------------------------------------------------------------
+/** setRootPath() - reads segments from sRootPath from now on
+*   @param sRootPath - the segment store's root directory, empty to disable the reader
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_TransducerSegmentReader::setRootPath( const QString & sRootPath )
+{
+    close();
+
+    m_sRootPath = sRootPath;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** close() - unmaps every segment and forgets what it knew about them
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_TransducerSegmentReader::close( void )
+{
+    QHash<int, QList<Segment *> >::iterator it;
+
+    for ( it = m_Segments.begin(); it != m_Segments.end(); ++it )
+    {
+        for ( int iIndex = 0; iIndex < it.value().size(); iIndex++ )
+        {
+            unmapSegment( it.value().at( iIndex ) );
+            delete it.value().at( iIndex );
+        }
+    }
+
+    m_Segments.clear();
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerSegmentReader::isEnabled( void ) const
+{
+    return !m_sRootPath.isEmpty();
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getEntriesInRange() - retrieves up to iMaxEntries of a device's samples with
+*                         llStartTimeMS <= time < llEndTimeMS, in (time, sequence) order
+*   @param iDeviceID - the device whose samples are wanted
+*   @param llStartTimeMS - start of the range, ms since the epoch (inclusive)
+*   @param llEndTimeMS - end of the range, ms since the epoch (exclusive)
+*   @param iMaxEntries - page size
+*   @param samples - the samples found are appended here
+*   @retval true - the segments were read (fewer than iMaxEntries samples means the range is done)
+*   @retval false - an error occurred.  Use GetLastError() to retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerSegmentReader::getEntriesInRange( int iDeviceID,
+                                                     qint64 llStartTimeMS,
+                                                     qint64 llEndTimeMS,
+                                                     int iMaxEntries,
+                                                     QVector<iC3_TransducerSample> & samples )
+{
+    iC3_TransducerSample cursor;
+
+    // a cursor just before the first possible sample at llStartTimeMS
+    cursor.llSequenceIndex = -1;
+    cursor.iDeviceID = iDeviceID;
+    cursor.llSampleTimeMS = llStartTimeMS;
+
+    return getNextEntriesInRange( cursor, llEndTimeMS, iMaxEntries, samples );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getNextEntriesInRange() - keyset pagination: retrieves up to iMaxEntries samples of
+*                             lastSample's device that follow lastSample in (time, sequence)
+*                             order and are before llEndTimeMS.  Each segment that can hold
+*                             such samples is searched from the cursor, not scanned.
+*   @param lastSample - the last sample of the previous page
+*   @param llEndTimeMS - end of the range, ms since the epoch (exclusive)
+*   @param iMaxEntries - page size
+*   @param samples - the samples found are appended here
+*   @retval true - the segments were read (fewer than iMaxEntries samples means the range is done)
+*   @retval false - an error occurred.  Use GetLastError() to retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerSegmentReader::getNextEntriesInRange( const iC3_TransducerSample & lastSample,
+                                                         qint64 llEndTimeMS,
+                                                         int iMaxEntries,
+                                                         QVector<iC3_TransducerSample> & samples )
+{
+    QList<Segment *> * pSegments = refreshSegments( lastSample.iDeviceID );
+
+    if ( pSegments == NULL )
+    {
+        return false;
+    }
+
+    int iFirstSample = samples.size();
+    int iSources = 0;
+    qint64 llLatestTimeMS = std::numeric_limits<qint64>::min();
+
+    for ( int iSegment = 0; iSegment < pSegments->size(); iSegment++ )
+    {
+        Segment * pSegment = pSegments->at( iSegment );
+
+        if ( ( pSegment->llRecordCount == 0 ) ||
+             ( pSegment->llLastTimeMS < lastSample.llSampleTimeMS ) ||
+             ( pSegment->llFirstTimeMS >= llEndTimeMS ) )
+        {
+            continue;
+        }
+
+        // with a full page, a later segment can only matter if the clock was set back into it
+        if ( ( samples.size() - iFirstSample >= iMaxEntries ) && ( pSegment->llFirstTimeMS >= llLatestTimeMS ) )
+        {
+            continue;
+        }
+
+        if ( !mapSegment( pSegment ) )
+        {
+            return false;
+        }
+
+        int iTaken = 0;
+
+        for ( qint64 llIndex = findFirstAtOrAfter( pSegment, lastSample.llSampleTimeMS );
+              ( llIndex < pSegment->llRecordCount ) && ( iTaken < iMaxEntries );
+              llIndex++ )
+        {
+            const uchar * pRecord = getRecord( pSegment->pMapping, llIndex );
+            qint64 llSampleTimeMS = iC3_TransducerSegment::recordTimeMS( pRecord );
+
+            if ( llSampleTimeMS >= llEndTimeMS )
+            {
+                break;
+            }
+
+            if ( ( llSampleTimeMS == lastSample.llSampleTimeMS ) &&
+                 ( iC3_TransducerSegment::recordSequenceIndex( pRecord ) <= lastSample.llSequenceIndex ) )
+            {
+                continue;
+            }
+
+            iC3_TransducerSample sample;
+
+            iC3_TransducerSegment::recordToSample( pRecord, lastSample.iDeviceID, sample );
+            samples.append( sample );
+            llLatestTimeMS = qMax( llLatestTimeMS, llSampleTimeMS );
+            iTaken++;
+        }
+
+        if ( iTaken > 0 )
+        {
+            iSources++;
+        }
+    }
+
+    // segments only overlap in time after the clock was set back
+    if ( iSources > 1 )
+    {
+        std::sort( samples.begin() + iFirstSample, samples.end(), sampleKeyLessThan );
+        if ( samples.size() - iFirstSample > iMaxEntries )
+        {
+            samples.resize( iFirstSample + iMaxEntries );
+        }
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getLastEntries() - retrieves a device's most recent samples, oldest first.  Reads back
+*                      from the end of the newest segments.
+*   @param iDeviceID - the device whose samples are wanted
+*   @param iNumberOfEntries - the number of samples to retrieve
+*   @param samples - the samples found are appended here
+*   @retval true - the segments were read
+*   @retval false - an error occurred.  Use GetLastError() to retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerSegmentReader::getLastEntries( int iDeviceID, int iNumberOfEntries, QVector<iC3_TransducerSample> & samples )
+{
+    QList<Segment *> * pSegments = refreshSegments( iDeviceID );
+
+    if ( pSegments == NULL )
+    {
+        return false;
+    }
+
+    if ( iNumberOfEntries <= 0 )
+    {
+        return true;
+    }
+
+    QVector<iC3_TransducerSample> found;
+    int iSources = 0;
+    qint64 llEarliestTimeMS = std::numeric_limits<qint64>::max();
+
+    for ( int iSegment = pSegments->size() - 1; iSegment >= 0; iSegment-- )
+    {
+        Segment * pSegment = pSegments->at( iSegment );
+
+        if ( pSegment->llRecordCount == 0 )
+        {
+            continue;
+        }
+
+        // once there are enough, an older segment can only matter if the clock was set back
+        if ( ( found.size() >= iNumberOfEntries ) && ( pSegment->llLastTimeMS < llEarliestTimeMS ) )
+        {
+            continue;
+        }
+
+        if ( !mapSegment( pSegment ) )
+        {
+            return false;
+        }
+
+        qint64 llFirstIndex = qMax( Q_INT64_C(0), pSegment->llRecordCount - iNumberOfEntries );
+
+        for ( qint64 llIndex = llFirstIndex; llIndex < pSegment->llRecordCount; llIndex++ )
+        {
+            iC3_TransducerSample sample;
+
+            iC3_TransducerSegment::recordToSample( getRecord( pSegment->pMapping, llIndex ), iDeviceID, sample );
+            found.append( sample );
+            llEarliestTimeMS = qMin( llEarliestTimeMS, sample.llSampleTimeMS );
+        }
+
+        iSources++;
+    }
+
+    if ( iSources > 1 )
+    {
+        std::sort( found.begin(), found.end(), sampleKeyLessThan );
+    }
+
+    for ( int iIndex = qMax( 0, found.size() - iNumberOfEntries ); iIndex < found.size(); iIndex++ )
+    {
+        samples.append( found.at( iIndex ) );
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+QString iC3_TransducerSegmentReader::GetLastError( void )
+{
+    return m_sLastError;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** refreshSegments() - brings the device's segment list up to date with its directory.
+*                      Segments deleted by retention are dropped, new ones added, and the
+*                      newest one's size re-read, since that is the one still growing.
+*   @param iDeviceID - the device
+*   @retval the device's segments, oldest first; NULL on error.  Use GetLastError() to
+*           retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+QList<iC3_TransducerSegmentReader::Segment *> * iC3_TransducerSegmentReader::refreshSegments( int iDeviceID )
+{
+    if ( !isEnabled() )
+    {
+        m_sLastError = "iC3_TransducerSegmentReader::refreshSegments() - Segment store is not enabled";
+        qDebug() << m_sLastError;
+        return NULL;
+    }
+
+    QString sDirectory = iC3_TransducerSegment::getDeviceDirectory( m_sRootPath, iDeviceID );
+    QStringList asNames = iC3_TransducerSegment::listSegments( sDirectory );
+    QList<Segment *> & segments = m_Segments[iDeviceID];
+    QList<Segment *> current;
+    int iExisting = 0;
+
+    // both lists are in file name order
+    for ( int iName = 0; iName < asNames.size(); iName++ )
+    {
+        QString sFileName = sDirectory + asNames.at( iName );
+
+        while ( ( iExisting < segments.size() ) && ( segments.at( iExisting )->sFileName < sFileName ) )
+        {
+            unmapSegment( segments.at( iExisting ) );
+            delete segments.at( iExisting );
+            iExisting++;
+        }
+
+        if ( ( iExisting < segments.size() ) && ( segments.at( iExisting )->sFileName == sFileName ) )
+        {
+            current.append( segments.at( iExisting ) );
+            iExisting++;
+            continue;
+        }
+
+        Segment * pSegment = new Segment;
+
+        pSegment->sFileName = sFileName;
+        pSegment->llFileSize = -1;
+        pSegment->bComplete = false;
+        pSegment->llRecordCount = 0;
+        pSegment->llFirstTimeMS = 0;
+        pSegment->llLastTimeMS = 0;
+        pSegment->pFile = NULL;
+        pSegment->pMapping = NULL;
+        pSegment->ullLastUsed = 0;
+        current.append( pSegment );
+    }
+
+    while ( iExisting < segments.size() )
+    {
+        unmapSegment( segments.at( iExisting ) );
+        delete segments.at( iExisting );
+        iExisting++;
+    }
+
+    segments = current;
+
+    // a segment stops growing before the next one is created, so one last look at its size
+    // once a newer one exists is enough
+    for ( int iSegment = 0; iSegment < segments.size(); iSegment++ )
+    {
+        Segment * pSegment = segments.at( iSegment );
+
+        if ( pSegment->bComplete )
+        {
+            continue;
+        }
+
+        if ( !updateSegment( iDeviceID, pSegment ) )
+        {
+            return NULL;
+        }
+
+        pSegment->bComplete = ( iSegment < segments.size() - 1 );
+    }
+
+    return &segments;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** updateSegment() - re-reads a segment's size and, if it has grown, its record count and
+*                     last sample time.  A mapping that no longer covers every record is dropped.
+*   @param iDeviceID - the segment's device
+*   @param pSegment - the segment
+*   @retval true - the segment is up to date; a file that is not a valid segment is left
+*                  with no records
+*   @retval false - an error occurred.  Use GetLastError() to retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerSegmentReader::updateSegment( int iDeviceID, Segment * pSegment )
+{
+    qint64 llFileSize = QFileInfo( pSegment->sFileName ).size();
+
+    // a segment just created may not have its header written yet
+    if ( ( llFileSize == pSegment->llFileSize ) || ( llFileSize < (qint64) sizeof( iC3_TransducerSegmentHeader ) ) )
+    {
+        return true;
+    }
+
+    unmapSegment( pSegment );
+
+    QFile file( pSegment->sFileName );
+
+    if ( !file.open( QIODevice::ReadOnly ) )
+    {
+        m_sLastError = QString("iC3_TransducerSegmentReader::updateSegment() - Unable to open: %1: %2")
+                           .arg( pSegment->sFileName ).arg( file.errorString() );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    if ( pSegment->llFileSize < 0 )
+    {
+        iC3_TransducerSegmentHeader header;
+
+        if ( ( file.read( reinterpret_cast<char *>( &header ), sizeof( header ) ) != (qint64) sizeof( header ) ) ||
+             !iC3_TransducerSegment::isValidHeader( header, iDeviceID ) )
+        {
+            qDebug() << QString("iC3_TransducerSegmentReader::updateSegment() - Not a valid segment: %1").arg( pSegment->sFileName );
+            pSegment->llFileSize = llFileSize;
+            pSegment->bComplete = true;
+            return true;
+        }
+
+        pSegment->llFirstTimeMS = header.llFirstSampleTimeMS;
+    }
+
+    // a partial record at the end is ignored until the rest of it is written
+    pSegment->llFileSize = llFileSize;
+    pSegment->llRecordCount = ( llFileSize - (qint64) sizeof( iC3_TransducerSegmentHeader ) ) / (qint64) sizeof( iC3_TransducerSegmentRecord );
+
+    if ( pSegment->llRecordCount > 0 )
+    {
+        iC3_TransducerSegmentRecord record;
+
+        if ( !file.seek( sizeof( iC3_TransducerSegmentHeader ) + ( pSegment->llRecordCount - 1 ) * sizeof( record ) ) ||
+             ( file.read( reinterpret_cast<char *>( &record ), sizeof( record ) ) != (qint64) sizeof( record ) ) )
+        {
+            m_sLastError = QString("iC3_TransducerSegmentReader::updateSegment() - Read Error: %1: %2")
+                               .arg( pSegment->sFileName ).arg( file.errorString() );
+            qDebug() << m_sLastError;
+            pSegment->llFileSize = -1;
+            pSegment->llRecordCount = 0;
+            return false;
+        }
+
+        pSegment->llLastTimeMS = record.llSampleTimeMS;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** mapSegment() - maps a segment's header and records and builds its sparse time index.  When
+*                  TRANSDUCER_SEGMENT_MAX_MAPPED segments are already mapped the least recently
+*                  used one is unmapped first.
+*   @param pSegment - the segment
+*   @retval true - pSegment->pMapping is valid
+*   @retval false - an error occurred.  Use GetLastError() to retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerSegmentReader::mapSegment( Segment * pSegment )
+{
+    pSegment->ullLastUsed = ++m_ullUseCounter;
+
+    if ( pSegment->pMapping != NULL )
+    {
+        return true;
+    }
+
+    if ( m_iMappedSegments >= TRANSDUCER_SEGMENT_MAX_MAPPED )
+    {
+        Segment * pLeastRecent = NULL;
+        QHash<int, QList<Segment *> >::iterator it;
+
+        for ( it = m_Segments.begin(); it != m_Segments.end(); ++it )
+        {
+            for ( int iIndex = 0; iIndex < it.value().size(); iIndex++ )
+            {
+                Segment * pMapped = it.value().at( iIndex );
+
+                if ( ( pMapped->pMapping != NULL ) &&
+                     ( ( pLeastRecent == NULL ) || ( pMapped->ullLastUsed < pLeastRecent->ullLastUsed ) ) )
+                {
+                    pLeastRecent = pMapped;
+                }
+            }
+        }
+
+        if ( pLeastRecent != NULL )
+        {
+            unmapSegment( pLeastRecent );
+        }
+    }
+
+    QFile * pFile = new QFile( pSegment->sFileName );
+    qint64 llMappedSize = sizeof( iC3_TransducerSegmentHeader ) + pSegment->llRecordCount * sizeof( iC3_TransducerSegmentRecord );
+
+    if ( !pFile->open( QIODevice::ReadOnly ) )
+    {
+        m_sLastError = QString("iC3_TransducerSegmentReader::mapSegment() - Unable to open: %1: %2")
+                           .arg( pSegment->sFileName ).arg( pFile->errorString() );
+        qDebug() << m_sLastError;
+        delete pFile;
+        return false;
+    }
+
+    uchar * pMapping = pFile->map( 0, llMappedSize );
+
+    if ( pMapping == NULL )
+    {
+        m_sLastError = QString("iC3_TransducerSegmentReader::mapSegment() - Unable to map: %1: %2")
+                           .arg( pSegment->sFileName ).arg( pFile->errorString() );
+        qDebug() << m_sLastError;
+        delete pFile;
+        return false;
+    }
+
+    pSegment->pFile = pFile;
+    pSegment->pMapping = pMapping;
+    m_iMappedSegments++;
+
+    pSegment->timeIndex.resize( ( pSegment->llRecordCount + TRANSDUCER_SEGMENT_INDEX_STRIDE - 1 ) / TRANSDUCER_SEGMENT_INDEX_STRIDE );
+    for ( int iEntry = 0; iEntry < pSegment->timeIndex.size(); iEntry++ )
+    {
+        pSegment->timeIndex[iEntry] = iC3_TransducerSegment::recordTimeMS(
+                                          getRecord( pMapping, (qint64) iEntry * TRANSDUCER_SEGMENT_INDEX_STRIDE ) );
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** unmapSegment() - releases a segment's mapping and index, if it has one
+*   @param pSegment - the segment
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_TransducerSegmentReader::unmapSegment( Segment * pSegment )
+{
+    if ( pSegment->pMapping == NULL )
+    {
+        return;
+    }
+
+    pSegment->pFile->unmap( pSegment->pMapping );
+    pSegment->pFile->close();
+    delete pSegment->pFile;
+    pSegment->pFile = NULL;
+    pSegment->pMapping = NULL;
+    pSegment->timeIndex.clear();
+    m_iMappedSegments--;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** findFirstAtOrAfter() - the index of a mapped segment's first record at or after llTimeMS.
+*                          The sparse index narrows the search to one stride of records.
+*   @param pSegment - the segment, which must be mapped
+*   @param llTimeMS - ms since the epoch
+*   @retval the record index, llRecordCount if every record is earlier
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+qint64 iC3_TransducerSegmentReader::findFirstAtOrAfter( const Segment * pSegment, qint64 llTimeMS ) const
+{
+    const qint64 * pIndexBegin = pSegment->timeIndex.constData();
+    const qint64 * pIndexEnd = pIndexBegin + pSegment->timeIndex.size();
+    qint64 llEntry = std::lower_bound( pIndexBegin, pIndexEnd, llTimeMS ) - pIndexBegin;
+
+    if ( llEntry == 0 )
+    {
+        return 0;
+    }
+
+    // the answer lies after the record of the entry before and at or before this entry's
+    qint64 llLow = ( llEntry - 1 ) * TRANSDUCER_SEGMENT_INDEX_STRIDE + 1;
+    qint64 llHigh = ( llEntry < pSegment->timeIndex.size() ) ? llEntry * TRANSDUCER_SEGMENT_INDEX_STRIDE
+                                                            : pSegment->llRecordCount;
+
+    while ( llLow < llHigh )
+    {
+        qint64 llMiddle = llLow + ( llHigh - llLow ) / 2;
+
+        if ( iC3_TransducerSegment::recordTimeMS( getRecord( pSegment->pMapping, llMiddle ) ) < llTimeMS )
+        {
+            llLow = llMiddle + 1;
+        }
+        else
+        {
+            llHigh = llMiddle;
+        }
+    }
+
+    return llLow;
+}
@@ -0,0 +1,75 @@
+#ifndef IC3_TRANSDUCERSEGMENTREADER_H
+#define IC3_TRANSDUCERSEGMENTREADER_H
+
+/**
+*     @file iC3_TransducerSegmentReader.h
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief This header file defines the iC3_TransducerSegmentReader class, which reads raw
+*            samples from the segment store.  Segments are memory mapped on first use and
+*            searched through a sparse time index, so a range read touches only the pages it
+*            returns.  Each read connection and the exporter own one; it must only be used on
+*            one thread.
+*/
+
+#include <QFile>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QVector>
+
+#include "iC3_TransducerSegment.h"
+
+class iC3_TransducerSegmentReader
+{
+public:
+    iC3_TransducerSegmentReader();
+    ~iC3_TransducerSegmentReader();
+
+    void setRootPath( const QString & sRootPath );
+    void close( void );
+    bool isEnabled( void ) const;
+
+    bool getEntriesInRange( int iDeviceID,
+                            qint64 llStartTimeMS,
+                            qint64 llEndTimeMS,
+                            int iMaxEntries,
+                            QVector<iC3_TransducerSample> & samples );
+    bool getNextEntriesInRange( const iC3_TransducerSample & lastSample,
+                                qint64 llEndTimeMS,
+                                int iMaxEntries,
+                                QVector<iC3_TransducerSample> & samples );
+    bool getLastEntries( int iDeviceID, int iNumberOfEntries, QVector<iC3_TransducerSample> & samples );
+
+    QString GetLastError( void );
+
+private:
+
+    struct Segment
+    {
+        QString sFileName;
+        qint64  llFileSize;                         // -1 until the header has been read
+        bool    bComplete;                          // a newer segment exists, so this one is final
+        qint64  llRecordCount;
+        qint64  llFirstTimeMS;
+        qint64  llLastTimeMS;
+        QFile * pFile;                              // open while mapped
+        uchar * pMapping;                           // header and llRecordCount records, or NULL
+        QVector<qint64> timeIndex;                  // time of every TRANSDUCER_SEGMENT_INDEX_STRIDE'th record
+        quint64 ullLastUsed;
+    };
+
+    QList<Segment *> * refreshSegments( int iDeviceID );
+    bool updateSegment( int iDeviceID, Segment * pSegment );
+    bool mapSegment( Segment * pSegment );
+    void unmapSegment( Segment * pSegment );
+    qint64 findFirstAtOrAfter( const Segment * pSegment, qint64 llTimeMS ) const;
+
+    QString m_sRootPath;
+    QHash<int, QList<Segment *> > m_Segments;
+    int m_iMappedSegments;
+    quint64 m_ullUseCounter;
+    QString m_sLastError;
+};
+
+#endif // IC3_TRANSDUCERSEGMENTREADER_H
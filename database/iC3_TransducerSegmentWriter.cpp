@@ -0,0 +1,526 @@
+/**
+*     @file iC3_TransducerSegmentWriter.cpp
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief this cpp file implements the iC3_TransducerSegmentWriter class.
+*/
+
+#include <QDir>
+#include <QDebug>
+
+#include "iC3_TransducerSegmentWriter.h"
+
+//-----------------------------------------------------------------------------------------------
+/** constructor
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_TransducerSegmentWriter::iC3_TransducerSegmentWriter()
+{
+}
+
+//-----------------------------------------------------------------------------------------------
+/** destructor - flushes and closes any open segments
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_TransducerSegmentWriter::~iC3_TransducerSegmentWriter()
+{
+    close();
+}
+
+//-----------------------------------------------------------------------------------------------
+/** open() - starts writing segments under sRootPath.  No file is opened until a device's
+*            first sample.
+*   @param sRootPath - the segment store's root directory, created if it does not exist
+*   @retval true - the directory exists
+*   @retval false - it could not be created.  Use GetLastError() to retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerSegmentWriter::open( const QString & sRootPath )
+{
+    close();
+
+    if ( !QDir().mkpath( sRootPath ) )
+    {
+        m_sLastError = QString("iC3_TransducerSegmentWriter::open() - Unable to create directory: %1").arg( sRootPath );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    m_sRootPath = sRootPath;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** close() - flushes and closes every device's segment
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_TransducerSegmentWriter::close( void )
+{
+    QHash<int, ActiveSegment>::iterator it;
+
+    for ( it = m_ActiveSegments.begin(); it != m_ActiveSegments.end(); ++it )
+    {
+        closeSegment( it.value() );
+    }
+
+    m_ActiveSegments.clear();
+    m_sRootPath.clear();
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerSegmentWriter::isOpen( void ) const
+{
+    return !m_sRootPath.isEmpty();
+}
+
+//-----------------------------------------------------------------------------------------------
+/** append() - appends a sample to its device's current segment, starting a new segment when
+*              the current one is full, too old, or the sample is older than its last record.
+*              The record is buffered; it reaches the file, and readers, at the next flush().
+*   @param sample - the sample to append.  A sample without a sequence index (0) is given the
+*                   one after the device's last.
+*   @retval true - the sample was appended
+*   @retval false - an error occurred.  Use GetLastError() to retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerSegmentWriter::append( iC3_TransducerSample & sample )
+{
+    ActiveSegment * pSegment = getActiveSegment( sample.iDeviceID );
+
+    if ( pSegment == NULL )
+    {
+        return false;
+    }
+
+    if ( sample.llSequenceIndex <= 0 )
+    {
+        sample.llSequenceIndex = pSegment->llNextSequenceIndex;
+    }
+
+    // a new segment is named after this sample's index
+    pSegment->llNextSequenceIndex = qMax( pSegment->llNextSequenceIndex, sample.llSequenceIndex );
+
+    // a clock set back starts a new segment so every segment stays in time order
+    bool bNewSegment = ( pSegment->pFile == NULL ) ||
+                       ( pSegment->llSize + (qint64) sizeof( iC3_TransducerSegmentRecord ) > TRANSDUCER_SEGMENT_MAX_BYTES ) ||
+                       ( sample.llSampleTimeMS - pSegment->llFirstTimeMS >= TRANSDUCER_SEGMENT_MAX_DURATION_MS ) ||
+                       ( sample.llSampleTimeMS < pSegment->llLastTimeMS );
+
+    if ( bNewSegment && !startSegment( sample.iDeviceID, sample.llSampleTimeMS, *pSegment ) )
+    {
+        return false;
+    }
+
+    iC3_TransducerSegmentRecord record;
+
+    iC3_TransducerSegment::sampleToRecord( sample, record );
+
+    if ( pSegment->pFile->write( reinterpret_cast<const char *>( &record ), sizeof( record ) ) != (qint64) sizeof( record ) )
+    {
+        m_sLastError = QString("iC3_TransducerSegmentWriter::append() - Write Error: %1: %2")
+                           .arg( pSegment->pFile->fileName() ).arg( pSegment->pFile->errorString() );
+        qDebug() << m_sLastError;
+
+        // a partial record stays behind in that file; readers ignore it, and the next sample
+        // starts a new segment rather than writing after it
+        closeSegment( *pSegment );
+        return false;
+    }
+
+    pSegment->llSize += sizeof( record );
+    pSegment->llLastTimeMS = sample.llSampleTimeMS;
+
+    // samples replayed from the spill journal keep their older indexes and must not move the
+    // sequence back - the next segment would sort before the ones written since
+    pSegment->llNextSequenceIndex = qMax( pSegment->llNextSequenceIndex, sample.llSequenceIndex + 1 );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** flush() - writes every segment's buffered records to its file
+*   @retval true - all records were written
+*   @retval false - an error occurred.  Use GetLastError() to retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerSegmentWriter::flush( void )
+{
+    bool bFlushed = true;
+    QHash<int, ActiveSegment>::iterator it;
+
+    for ( it = m_ActiveSegments.begin(); it != m_ActiveSegments.end(); ++it )
+    {
+        QFile * pFile = it.value().pFile;
+
+        if ( ( pFile != NULL ) && !pFile->flush() )
+        {
+            m_sLastError = QString("iC3_TransducerSegmentWriter::flush() - Write Error: %1: %2")
+                               .arg( pFile->fileName() ).arg( pFile->errorString() );
+            qDebug() << m_sLastError;
+            bFlushed = false;
+        }
+    }
+
+    return bFlushed;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** deleteSegmentsBefore() - deletes the segments whose last sample is older than
+*                            llBeforeTimeMS.  A device's newest segment is never deleted.
+*   @param llBeforeTimeMS - ms since the epoch
+*   @param iDeleted - set to the number of segment files deleted
+*   @retval true - the old segments were deleted
+*   @retval false - an error occurred.  Use GetLastError() to retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerSegmentWriter::deleteSegmentsBefore( qint64 llBeforeTimeMS, int & iDeleted )
+{
+    iDeleted = 0;
+
+    if ( !isOpen() )
+    {
+        return true;
+    }
+
+    QStringList asDevices = QDir( m_sRootPath ).entryList( QStringList("device_*"), QDir::Dirs );
+
+    for ( int iDevice = 0; iDevice < asDevices.size(); iDevice++ )
+    {
+        bool bOk;
+        int iDeviceID = asDevices.at( iDevice ).mid( 7 ).toInt( &bOk );
+
+        if ( !bOk )
+        {
+            continue;
+        }
+
+        QString sDirectory = iC3_TransducerSegment::getDeviceDirectory( m_sRootPath, iDeviceID );
+        QStringList asSegments = iC3_TransducerSegment::listSegments( sDirectory );
+
+        // the last is the one being written to
+        for ( int iIndex = 0; iIndex < asSegments.size() - 1; iIndex++ )
+        {
+            QFile file( sDirectory + asSegments.at( iIndex ) );
+            qint64 llRecords;
+            qint64 llLastTimeMS = 0;
+
+            if ( !file.open( QIODevice::ReadOnly ) )
+            {
+                m_sLastError = QString("iC3_TransducerSegmentWriter::deleteSegmentsBefore() - Unable to open: %1: %2")
+                                   .arg( file.fileName() ).arg( file.errorString() );
+                qDebug() << m_sLastError;
+                return false;
+            }
+
+            llRecords = ( file.size() - (qint64) sizeof( iC3_TransducerSegmentHeader ) ) / (qint64) sizeof( iC3_TransducerSegmentRecord );
+
+            if ( llRecords > 0 )
+            {
+                iC3_TransducerSegmentRecord record;
+
+                if ( !file.seek( sizeof( iC3_TransducerSegmentHeader ) + ( llRecords - 1 ) * sizeof( iC3_TransducerSegmentRecord ) ) ||
+                     ( file.read( reinterpret_cast<char *>( &record ), sizeof( record ) ) != (qint64) sizeof( record ) ) )
+                {
+                    m_sLastError = QString("iC3_TransducerSegmentWriter::deleteSegmentsBefore() - Read Error: %1: %2")
+                                       .arg( file.fileName() ).arg( file.errorString() );
+                    qDebug() << m_sLastError;
+                    return false;
+                }
+
+                llLastTimeMS = record.llSampleTimeMS;
+            }
+
+            file.close();
+
+            if ( llLastTimeMS >= llBeforeTimeMS )
+            {
+                continue;
+            }
+
+            if ( !file.remove() )
+            {
+                m_sLastError = QString("iC3_TransducerSegmentWriter::deleteSegmentsBefore() - Unable to delete: %1: %2")
+                                   .arg( file.fileName() ).arg( file.errorString() );
+                qDebug() << m_sLastError;
+                return false;
+            }
+
+            iDeleted++;
+        }
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getLastSequenceIndex() - the highest sequence index written to any device's segments, read
+*                            from the records of each device's newest segment
+*   @param llSequenceIndex - set to the highest sequence index, 0 if there are no segments
+*   @retval true - the segments were read
+*   @retval false - an error occurred.  Use GetLastError() to retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerSegmentWriter::getLastSequenceIndex( qint64 & llSequenceIndex )
+{
+    llSequenceIndex = 0;
+
+    if ( !isOpen() )
+    {
+        return true;
+    }
+
+    QStringList asDevices = QDir( m_sRootPath ).entryList( QStringList("device_*"), QDir::Dirs );
+
+    for ( int iDevice = 0; iDevice < asDevices.size(); iDevice++ )
+    {
+        bool bOk;
+        int iDeviceID = asDevices.at( iDevice ).mid( 7 ).toInt( &bOk );
+
+        if ( !bOk )
+        {
+            continue;
+        }
+
+        // the device's segment is reopened here, and stays open for its next sample
+        ActiveSegment * pSegment = getActiveSegment( iDeviceID );
+
+        if ( pSegment == NULL )
+        {
+            return false;
+        }
+
+        llSequenceIndex = qMax( llSequenceIndex, pSegment->llNextSequenceIndex - 1 );
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------
+QString iC3_TransducerSegmentWriter::GetLastError( void )
+{
+    return m_sLastError;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getActiveSegment() - the device's current segment.  On the device's first sample since
+*                        open() the newest segment on disk is reopened, so a restart carries
+*                        on appending to it and continues its sequence.
+*   @param iDeviceID - the device
+*   @retval the device's segment, NULL on error.  Use GetLastError() to retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_TransducerSegmentWriter::ActiveSegment * iC3_TransducerSegmentWriter::getActiveSegment( int iDeviceID )
+{
+    QHash<int, ActiveSegment>::iterator it = m_ActiveSegments.find( iDeviceID );
+
+    if ( it != m_ActiveSegments.end() )
+    {
+        return &it.value();
+    }
+
+    if ( !isOpen() )
+    {
+        m_sLastError = "iC3_TransducerSegmentWriter::getActiveSegment() - Segment store is not open";
+        qDebug() << m_sLastError;
+        return NULL;
+    }
+
+    QString sDirectory = iC3_TransducerSegment::getDeviceDirectory( m_sRootPath, iDeviceID );
+
+    if ( !QDir().mkpath( sDirectory ) )
+    {
+        m_sLastError = QString("iC3_TransducerSegmentWriter::getActiveSegment() - Unable to create directory: %1").arg( sDirectory );
+        qDebug() << m_sLastError;
+        return NULL;
+    }
+
+    ActiveSegment segment;
+    QStringList asSegments = iC3_TransducerSegment::listSegments( sDirectory );
+
+    segment.pFile = NULL;
+    segment.llFirstTimeMS = 0;
+    segment.llLastTimeMS = 0;
+    segment.llSize = 0;
+    segment.llNextSequenceIndex = 1;
+
+    while ( !asSegments.isEmpty() )
+    {
+        QString sFileName = sDirectory + asSegments.takeLast();
+
+        if ( recoverSegment( iDeviceID, sFileName, segment ) )
+        {
+            break;
+        }
+
+        // moved out of the store so readers skip it too; the one before it is tried instead
+        QFile::rename( sFileName, sFileName + ".bad" );
+    }
+
+    return &m_ActiveSegments.insert( iDeviceID, segment ).value();
+}
+
+//-----------------------------------------------------------------------------------------------
+/** recoverSegment() - reopens an existing segment for appending.  A partial record left by a
+*                      crash mid-write is cut off.
+*   @param iDeviceID - the segment's device
+*   @param sFileName - the segment file
+*   @param segment - set to the reopened segment
+*   @retval true - the segment was reopened
+*   @retval false - it could not be opened or is not a valid segment.  Use GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerSegmentWriter::recoverSegment( int iDeviceID, const QString & sFileName, ActiveSegment & segment )
+{
+    QFile * pFile = new QFile( sFileName );
+    iC3_TransducerSegmentHeader header;
+    iC3_TransducerSegmentRecord record;
+    qint64 llRecords;
+
+    if ( !pFile->open( QIODevice::ReadWrite ) )
+    {
+        m_sLastError = QString("iC3_TransducerSegmentWriter::recoverSegment() - Unable to open: %1: %2")
+                           .arg( sFileName ).arg( pFile->errorString() );
+        qDebug() << m_sLastError;
+        delete pFile;
+        return false;
+    }
+
+    if ( ( pFile->read( reinterpret_cast<char *>( &header ), sizeof( header ) ) != (qint64) sizeof( header ) ) ||
+         !iC3_TransducerSegment::isValidHeader( header, iDeviceID ) )
+    {
+        m_sLastError = QString("iC3_TransducerSegmentWriter::recoverSegment() - Not a valid segment: %1").arg( sFileName );
+        qDebug() << m_sLastError;
+        delete pFile;
+        return false;
+    }
+
+    llRecords = ( pFile->size() - (qint64) sizeof( header ) ) / (qint64) sizeof( record );
+
+    segment.llSize = sizeof( header ) + llRecords * sizeof( record );
+
+    if ( ( pFile->size() != segment.llSize ) && !pFile->resize( segment.llSize ) )
+    {
+        m_sLastError = QString("iC3_TransducerSegmentWriter::recoverSegment() - Unable to truncate: %1: %2")
+                           .arg( sFileName ).arg( pFile->errorString() );
+        qDebug() << m_sLastError;
+        delete pFile;
+        return false;
+    }
+
+    segment.llFirstTimeMS = header.llFirstSampleTimeMS;
+    segment.llLastTimeMS = header.llFirstSampleTimeMS;
+    segment.llNextSequenceIndex = iC3_TransducerSegment::getFirstSequenceIndex( sFileName );
+
+    // replayed samples can follow newer ones, so the sequence carries on from the highest
+    // index in the segment rather than the last
+    for ( qint64 llRecord = 0; llRecord < llRecords; llRecord++ )
+    {
+        if ( pFile->read( reinterpret_cast<char *>( &record ), sizeof( record ) ) != (qint64) sizeof( record ) )
+        {
+            m_sLastError = QString("iC3_TransducerSegmentWriter::recoverSegment() - Read Error: %1: %2")
+                               .arg( sFileName ).arg( pFile->errorString() );
+            qDebug() << m_sLastError;
+            delete pFile;
+            return false;
+        }
+
+        segment.llLastTimeMS = record.llSampleTimeMS;
+        segment.llNextSequenceIndex = qMax( segment.llNextSequenceIndex, record.llSequenceIndex + 1 );
+    }
+
+    if ( !pFile->seek( segment.llSize ) )
+    {
+        m_sLastError = QString("iC3_TransducerSegmentWriter::recoverSegment() - Seek Error: %1: %2")
+                           .arg( sFileName ).arg( pFile->errorString() );
+        qDebug() << m_sLastError;
+        delete pFile;
+        return false;
+    }
+
+    segment.pFile = pFile;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** startSegment() - closes the device's current segment and starts a new one
+*   @param iDeviceID - the device
+*   @param llFirstTimeMS - time of the first sample that will be written to it
+*   @param segment - the device's segment; llNextSequenceIndex is kept
+*   @retval true - the new segment is open
+*   @retval false - an error occurred.  Use GetLastError() to retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerSegmentWriter::startSegment( int iDeviceID, qint64 llFirstTimeMS, ActiveSegment & segment )
+{
+    closeSegment( segment );
+
+    QString sFileName = iC3_TransducerSegment::getDeviceDirectory( m_sRootPath, iDeviceID ) +
+                        iC3_TransducerSegment::getSegmentFileName( segment.llNextSequenceIndex, llFirstTimeMS );
+    QFile * pFile = new QFile( sFileName );
+    iC3_TransducerSegmentHeader header;
+
+    if ( !pFile->open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+    {
+        m_sLastError = QString("iC3_TransducerSegmentWriter::startSegment() - Unable to create: %1: %2")
+                           .arg( sFileName ).arg( pFile->errorString() );
+        qDebug() << m_sLastError;
+        delete pFile;
+        return false;
+    }
+
+    iC3_TransducerSegment::initHeader( header, iDeviceID, llFirstTimeMS );
+
+    if ( pFile->write( reinterpret_cast<const char *>( &header ), sizeof( header ) ) != (qint64) sizeof( header ) )
+    {
+        m_sLastError = QString("iC3_TransducerSegmentWriter::startSegment() - Write Error: %1: %2")
+                           .arg( sFileName ).arg( pFile->errorString() );
+        qDebug() << m_sLastError;
+        pFile->close();
+        pFile->remove();
+        delete pFile;
+        return false;
+    }
+
+    segment.pFile = pFile;
+    segment.llFirstTimeMS = llFirstTimeMS;
+    segment.llLastTimeMS = llFirstTimeMS;
+    segment.llSize = sizeof( header );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** closeSegment() - flushes and closes a segment's file
+*   @param segment - the segment; pFile is NULL afterwards
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_TransducerSegmentWriter::closeSegment( ActiveSegment & segment )
+{
+    if ( segment.pFile != NULL )
+    {
+        segment.pFile->close();
+        delete segment.pFile;
+        segment.pFile = NULL;
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef IC3_TRANSDUCERSEGMENTWRITER_H
+#define IC3_TRANSDUCERSEGMENTWRITER_H
+
+/**
+*     @file iC3_TransducerSegmentWriter.h
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief This header file defines the iC3_TransducerSegmentWriter class, which appends raw
+*            samples to each device's current segment file.  Used by the request processor
+*            thread only.
+*/
+
+#include <QFile>
+#include <QHash>
+#include <QString>
+
+#include "iC3_TransducerSegment.h"
+
+class iC3_TransducerSegmentWriter
+{
+public:
+    iC3_TransducerSegmentWriter();
+    ~iC3_TransducerSegmentWriter();
+
+    bool open( const QString & sRootPath );
+    void close( void );
+    bool isOpen( void ) const;
+
+    bool append( iC3_TransducerSample & sample );
+    bool flush( void );
+
+    bool deleteSegmentsBefore( qint64 llBeforeTimeMS, int & iDeleted );
+    bool getLastSequenceIndex( qint64 & llSequenceIndex );
+
+    QString GetLastError( void );
+
+private:
+
+    struct ActiveSegment
+    {
+        QFile * pFile;                              // NULL until the device's first sample
+        qint64  llFirstTimeMS;
+        qint64  llLastTimeMS;
+        qint64  llSize;                             // bytes written, header included
+        qint64  llNextSequenceIndex;
+    };
+
+    ActiveSegment * getActiveSegment( int iDeviceID );
+    bool recoverSegment( int iDeviceID, const QString & sFileName, ActiveSegment & segment );
+    bool startSegment( int iDeviceID, qint64 llFirstTimeMS, ActiveSegment & segment );
+    void closeSegment( ActiveSegment & segment );
+
+    QString m_sRootPath;
+    QHash<int, ActiveSegment> m_ActiveSegments;
+    QString m_sLastError;
+};
+
+#endif // IC3_TRANSDUCERSEGMENTWRITER_H
@@ -0,0 +1,515 @@
+/**
+*     @file iC3_TransducerSpillJournal.cpp
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief this cpp file implements the iC3_TransducerSpillJournal class.
+*
+*            An append writes its record, then moves the tail, then syncs the file once.  A
+*            crash during the sync can leave the tail on disk without the record, so open()
+*            checks the CRC of every record still to be replayed and moves the tail back to
+*            the first one that does not match.  Only the last append can be affected, and it
+*            had not been reported as stored.  setSequenceIndex() rewrites records in place,
+*            and sync() puts them on disk before they are replayed.  consume() moves the head
+*            without a sync; after a power loss a few records may be replayed twice.
+*/
+
+#include <QDir>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QDebug>
+#include <string.h>
+
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
+
+#include "iC3_TransducerSpillJournal.h"
+
+//-----------------------------------------------------------------------------------------------
+/** constructor
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_TransducerSpillJournal::iC3_TransducerSpillJournal() :
+    m_pMapping( NULL ),
+    m_pHeader( NULL )
+{
+}
+
+//-----------------------------------------------------------------------------------------------
+/** destructor
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_TransducerSpillJournal::~iC3_TransducerSpillJournal()
+{
+    close();
+}
+
+//-----------------------------------------------------------------------------------------------
+/** open() - opens the journal, creating it if it does not exist.  The records of an existing
+*            journal that were not replayed are kept.
+*   @param sFileName - the journal file
+*   @param ulCapacity - records in the ring of a new journal; an existing one keeps its own
+*   @retval true - the journal is open
+*   @retval false - the file could not be created, mapped or is not a spill journal.  Use
+*                   GetLastError() to retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerSpillJournal::open( const QString & sFileName, quint32 ulCapacity )
+{
+    close();
+
+    QMutexLocker locker( &m_Mutex );
+
+    if ( !QDir().mkpath( QFileInfo( sFileName ).absolutePath() ) )
+    {
+        m_sLastError = QString("iC3_TransducerSpillJournal::open() - Unable to create the directory of %1").arg( sFileName );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    m_File.setFileName( sFileName );
+
+    bool bNewFile = !m_File.exists() || ( m_File.size() == 0 );
+
+    if ( !m_File.open( QIODevice::ReadWrite ) )
+    {
+        m_sLastError = QString("iC3_TransducerSpillJournal::open() - Unable to open: %1: %2").arg( sFileName ).arg( m_File.errorString() );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    if ( bNewFile )
+    {
+        if ( !createFile( qMax( ulCapacity, (quint32) 1 ) ) )
+        {
+            m_File.close();
+            return false;
+        }
+
+        return true;
+    }
+
+    if ( m_File.size() < (qint64) sizeof( iC3_TransducerSpillHeader ) )
+    {
+        m_sLastError = QString("iC3_TransducerSpillJournal::open() - Not a spill journal: %1").arg( sFileName );
+        qDebug() << m_sLastError;
+        m_File.close();
+        return false;
+    }
+
+    m_pMapping = m_File.map( 0, m_File.size() );
+
+    if ( m_pMapping == NULL )
+    {
+        m_sLastError = QString("iC3_TransducerSpillJournal::open() - Unable to map: %1: %2").arg( sFileName ).arg( m_File.errorString() );
+        qDebug() << m_sLastError;
+        m_File.close();
+        return false;
+    }
+
+    m_pHeader = reinterpret_cast<iC3_TransducerSpillHeader *>( m_pMapping );
+
+    qint64 llExpectedSize = (qint64) sizeof( iC3_TransducerSpillHeader ) +
+                            (qint64) m_pHeader->ulCapacity * (qint64) sizeof( iC3_TransducerSpillRecord );
+
+    // never replaced - a journal that does not check out may still hold samples
+    if ( ( memcmp( m_pHeader->acMagic, TRANSDUCER_SPILL_MAGIC, sizeof( TRANSDUCER_SPILL_MAGIC ) ) != 0 ) ||
+         ( m_pHeader->ulFormatVersion != TRANSDUCER_SPILL_FORMAT_VERSION ) ||
+         ( m_pHeader->ulRecordSize != sizeof( iC3_TransducerSpillRecord ) ) ||
+         ( m_pHeader->ulCapacity == 0 ) ||
+         ( m_File.size() != llExpectedSize ) ||
+         ( m_pHeader->llHead < 0 ) ||
+         ( m_pHeader->llTail < m_pHeader->llHead ) ||
+         ( m_pHeader->llTail - m_pHeader->llHead > m_pHeader->ulCapacity ) )
+    {
+        m_sLastError = QString("iC3_TransducerSpillJournal::open() - Not a spill journal: %1").arg( sFileName );
+        qDebug() << m_sLastError;
+        m_File.unmap( m_pMapping );
+        m_pMapping = NULL;
+        m_pHeader = NULL;
+        m_File.close();
+        return false;
+    }
+
+    return recoverRecords();
+}
+
+//-----------------------------------------------------------------------------------------------
+/** close() - unmaps and closes the journal
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_TransducerSpillJournal::close( void )
+{
+    QMutexLocker locker( &m_Mutex );
+
+    if ( m_pMapping != NULL )
+    {
+        m_File.unmap( m_pMapping );
+        m_pMapping = NULL;
+        m_pHeader = NULL;
+    }
+
+    m_File.close();
+}
+
+//-----------------------------------------------------------------------------------------------
+/** isOpen() - tells whether the journal is open
+*   @retval true - the journal is open
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerSpillJournal::isOpen( void )
+{
+    QMutexLocker locker( &m_Mutex );
+
+    return ( m_pMapping != NULL );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** append() - adds a sample at the tail of the journal and syncs it to disk
+*   @param sample - the sample; a sequence index of 0 is assigned when it is replayed
+*   @retval true - the sample is on disk
+*   @retval false - the journal is closed or full, or the sync failed.  Use GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerSpillJournal::append( const iC3_TransducerSample & sample )
+{
+    QMutexLocker locker( &m_Mutex );
+
+    if ( m_pMapping == NULL )
+    {
+        m_sLastError = QString("iC3_TransducerSpillJournal::append() - The journal is not open");
+        return false;
+    }
+
+    if ( m_pHeader->llTail - m_pHeader->llHead >= m_pHeader->ulCapacity )
+    {
+        m_sLastError = QString("iC3_TransducerSpillJournal::append() - The journal is full (%1 samples)").arg( m_pHeader->ulCapacity );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    iC3_TransducerSpillRecord record;
+
+    record.lDeviceID = sample.iDeviceID;
+    record.llSequenceIndex = qMax( sample.llSequenceIndex, Q_INT64_C(0) );
+    record.llSampleTimeMS = sample.llSampleTimeMS;
+
+    for ( int iRTD = 0; iRTD < TRANSDUCER_NUMBER_OF_RTDS; iRTD++ )
+    {
+        record.adRTDValues[iRTD] = sample.adRTDValues[iRTD];
+    }
+
+    record.ulCRC = calculateCRC( record );
+
+    memcpy( getRecord( m_pHeader->llTail ), &record, sizeof( record ) );
+    m_pHeader->llTail++;
+
+#ifdef Q_OS_UNIX
+    // the mapping shares the file's page cache, so this writes the record and the header
+    if ( ::fsync( m_File.handle() ) != 0 )
+    {
+        m_pHeader->llTail--;
+        m_sLastError = QString("iC3_TransducerSpillJournal::append() - Unable to sync: %1").arg( m_File.fileName() );
+        qDebug() << m_sLastError;
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** peek() - reads the oldest samples not yet replayed, without removing them.  Remove them
+*            with consume() once they are stored.
+*   @param iMaxRecords - the most samples to read
+*   @param samples - the samples are appended here, oldest first
+*   @retval int - the number of samples read
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+int iC3_TransducerSpillJournal::peek( int iMaxRecords, QVector<iC3_TransducerSample> & samples )
+{
+    QMutexLocker locker( &m_Mutex );
+
+    if ( m_pMapping == NULL )
+    {
+        return 0;
+    }
+
+    int iRecords = (int) qMin( (qint64) qMax( iMaxRecords, 0 ), m_pHeader->llTail - m_pHeader->llHead );
+
+    for ( int i = 0; i < iRecords; i++ )
+    {
+        const iC3_TransducerSpillRecord * pRecord = getRecord( m_pHeader->llHead + i );
+        iC3_TransducerSample sample;
+
+        sample.iDeviceID = pRecord->lDeviceID;
+        sample.llSequenceIndex = pRecord->llSequenceIndex;
+        sample.llSampleTimeMS = pRecord->llSampleTimeMS;
+
+        for ( int iRTD = 0; iRTD < TRANSDUCER_NUMBER_OF_RTDS; iRTD++ )
+        {
+            sample.adRTDValues[iRTD] = pRecord->adRTDValues[iRTD];
+        }
+
+        samples.append( sample );
+    }
+
+    return iRecords;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** setSequenceIndex() - records the sequence index given to a sample being replayed, so a
+*                        replay that has to be repeated stores it under the same index.  Call
+*                        sync() before the sample is replayed.
+*   @param iRecord - the sample's position in the last peek(), 0 being the oldest
+*   @param llSequenceIndex - the index
+*   @retval true - the index was recorded
+*   @retval false - there is no such record
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerSpillJournal::setSequenceIndex( int iRecord, qint64 llSequenceIndex )
+{
+    QMutexLocker locker( &m_Mutex );
+
+    if ( ( m_pMapping == NULL ) || ( iRecord < 0 ) || ( iRecord >= m_pHeader->llTail - m_pHeader->llHead ) )
+    {
+        return false;
+    }
+
+    iC3_TransducerSpillRecord * pRecord = getRecord( m_pHeader->llHead + iRecord );
+
+    pRecord->llSequenceIndex = llSequenceIndex;
+    pRecord->ulCRC = calculateCRC( *pRecord );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** sync() - writes the records changed by setSequenceIndex() to disk
+*   @retval true - the journal is on disk
+*   @retval false - the journal is closed or the sync failed.  Use GetLastError() to retrieve
+*                   error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerSpillJournal::sync( void )
+{
+    QMutexLocker locker( &m_Mutex );
+
+    if ( m_pMapping == NULL )
+    {
+        m_sLastError = QString("iC3_TransducerSpillJournal::sync() - The journal is not open");
+        return false;
+    }
+
+#ifdef Q_OS_UNIX
+    if ( ::fsync( m_File.handle() ) != 0 )
+    {
+        m_sLastError = QString("iC3_TransducerSpillJournal::sync() - Unable to sync: %1").arg( m_File.fileName() );
+        qDebug() << m_sLastError;
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** consume() - removes the oldest samples once they have been stored
+*   @param iRecords - the number of samples to remove
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_TransducerSpillJournal::consume( int iRecords )
+{
+    QMutexLocker locker( &m_Mutex );
+
+    if ( m_pMapping == NULL )
+    {
+        return;
+    }
+
+    m_pHeader->llHead += qMin( (qint64) qMax( iRecords, 0 ), m_pHeader->llTail - m_pHeader->llHead );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getCount() - returns the number of samples waiting to be replayed
+*   @retval qint64 - the number of samples, 0 while the journal is closed
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+qint64 iC3_TransducerSpillJournal::getCount( void )
+{
+    QMutexLocker locker( &m_Mutex );
+
+    if ( m_pMapping == NULL )
+    {
+        return 0;
+    }
+
+    return m_pHeader->llTail - m_pHeader->llHead;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getOldestSampleTimeMS() - returns the earliest sample time of a device's samples waiting to
+*                             be replayed.  Those samples reach the database after newer ones,
+*                             so nothing from this time on is final yet.
+*   @param iDeviceID - the device
+*   @retval qint64 - ms since the epoch; -1 when none of the device's samples are waiting
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+qint64 iC3_TransducerSpillJournal::getOldestSampleTimeMS( int iDeviceID )
+{
+    QMutexLocker locker( &m_Mutex );
+    qint64 llOldestTimeMS = -1;
+
+    if ( m_pMapping == NULL )
+    {
+        return llOldestTimeMS;
+    }
+
+    for ( qint64 llRecord = m_pHeader->llHead; llRecord < m_pHeader->llTail; llRecord++ )
+    {
+        const iC3_TransducerSpillRecord * pRecord = getRecord( llRecord );
+
+        if ( ( pRecord->lDeviceID == iDeviceID ) &&
+             ( ( llOldestTimeMS < 0 ) || ( pRecord->llSampleTimeMS < llOldestTimeMS ) ) )
+        {
+            llOldestTimeMS = pRecord->llSampleTimeMS;
+        }
+    }
+
+    return llOldestTimeMS;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** GetLastError() - returns the last error encountered
+*   @retval QString - error description
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+QString iC3_TransducerSpillJournal::GetLastError( void )
+{
+    QMutexLocker locker( &m_Mutex );
+
+    return m_sLastError;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** createFile() - sizes the empty, open m_File for ulCapacity records, maps it and writes the
+*                  header.  The caller holds m_Mutex.
+*   @param ulCapacity - records in the ring
+*   @retval true - the journal is ready
+*   @retval false - an error occurred, see m_sLastError
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerSpillJournal::createFile( quint32 ulCapacity )
+{
+    qint64 llSize = (qint64) sizeof( iC3_TransducerSpillHeader ) + (qint64) ulCapacity * (qint64) sizeof( iC3_TransducerSpillRecord );
+
+    if ( !m_File.resize( llSize ) || ( ( m_pMapping = m_File.map( 0, llSize ) ) == NULL ) )
+    {
+        m_sLastError = QString("iC3_TransducerSpillJournal::createFile() - Unable to create: %1: %2").arg( m_File.fileName() ).arg( m_File.errorString() );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    m_pHeader = reinterpret_cast<iC3_TransducerSpillHeader *>( m_pMapping );
+
+    memset( m_pHeader, 0, sizeof( iC3_TransducerSpillHeader ) );
+    memcpy( m_pHeader->acMagic, TRANSDUCER_SPILL_MAGIC, sizeof( TRANSDUCER_SPILL_MAGIC ) );
+    m_pHeader->ulFormatVersion = TRANSDUCER_SPILL_FORMAT_VERSION;
+    m_pHeader->ulRecordSize = sizeof( iC3_TransducerSpillRecord );
+    m_pHeader->ulCapacity = ulCapacity;
+
+#ifdef Q_OS_UNIX
+    ::fsync( m_File.handle() );
+#endif
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** recoverRecords() - moves the tail back to the first record, from the head, whose CRC does
+*                      not match.  The caller holds m_Mutex.
+*   @retval true - always; the journal is usable
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerSpillJournal::recoverRecords( void )
+{
+    for ( qint64 llRecord = m_pHeader->llHead; llRecord < m_pHeader->llTail; llRecord++ )
+    {
+        const iC3_TransducerSpillRecord * pRecord = getRecord( llRecord );
+
+        if ( pRecord->ulCRC != calculateCRC( *pRecord ) )
+        {
+            qDebug() << "iC3_TransducerSpillJournal::recoverRecords() - dropped" << ( m_pHeader->llTail - llRecord )
+                     << "incomplete records from" << m_File.fileName();
+            m_pHeader->llTail = llRecord;
+
+#ifdef Q_OS_UNIX
+            ::fsync( m_File.handle() );
+#endif
+            break;
+        }
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getRecord() - returns the slot of a record
+*   @param llRecord - the record's number, counting every record ever appended
+*   @retval pointer to the record in the mapping
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+iC3_TransducerSpillRecord * iC3_TransducerSpillJournal::getRecord( qint64 llRecord ) const
+{
+    qint64 llSlot = llRecord % m_pHeader->ulCapacity;
+
+    return reinterpret_cast<iC3_TransducerSpillRecord *>( m_pMapping + sizeof( iC3_TransducerSpillHeader ) +
+                                                          llSlot * sizeof( iC3_TransducerSpillRecord ) );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** calculateCRC() - CRC-32 (IEEE 802.3) of a record, excluding its CRC field
+*   @param record - the record
+*   @retval quint32 - the CRC
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+quint32 iC3_TransducerSpillJournal::calculateCRC( const iC3_TransducerSpillRecord & record )
+{
+    const uchar * pData = reinterpret_cast<const uchar *>( &record ) + sizeof( record.ulCRC );
+    const uchar * pEnd = reinterpret_cast<const uchar *>( &record ) + sizeof( record );
+    quint32 ulCRC = 0xFFFFFFFF;
+
+    while ( pData < pEnd )
+    {
+        ulCRC ^= *pData++;
+
+        for ( int iBit = 0; iBit < 8; iBit++ )
+        {
+            ulCRC = ( ulCRC >> 1 ) ^ ( 0xEDB88320 & ( 0 - ( ulCRC & 1 ) ) );
+        }
+    }
+
+    return ~ulCRC;
+}
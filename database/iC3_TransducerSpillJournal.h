@@ -0,0 +1,93 @@
+#ifndef IC3_TRANSDUCERSPILLJOURNAL_H
+#define IC3_TRANSDUCERSPILLJOURNAL_H
+
+/**
+*     @file iC3_TransducerSpillJournal.h
+*     @date 10/19/2026
+*     @version 1.0
+*     @brief This header file defines the iC3_TransducerSpillJournal class, which keeps the
+*            transducer samples that could not be written to the database - it was closed,
+*            locked or full - until they can be replayed into it.
+*
+*            The journal is one fixed-size, memory mapped file: a 64 byte header followed by a
+*            ring of 64 byte records, each with a CRC-32.  The header holds two counters that
+*            only grow: records appended (the tail) and records replayed (the head); a record's
+*            slot is its number modulo the capacity.  Each append is synced before it returns,
+*            so a sample accepted by the journal survives a crash or power loss.  When the ring
+*            is full further samples are refused rather than overwriting older ones.  Files
+*            are native byte order - they are read on the unit that wrote them.  Safe to use
+*            from any thread.
+*/
+
+#include <QtGlobal>
+#include <QString>
+#include <QFile>
+#include <QMutex>
+#include <QVector>
+
+#include "iC3_TransducerSample.h"
+
+static const char    TRANSDUCER_SPILL_MAGIC[8]          = { 'i', 'C', '3', 'S', 'P', 'I', 'L', 'L' };
+static const quint32 TRANSDUCER_SPILL_FORMAT_VERSION    = 1;
+
+// records in the ring; 65536 x 64 bytes is 4 MB, about 18 hours of one device at one sample a
+// second
+static const quint32 TRANSDUCER_SPILL_CAPACITY          = 65536;
+
+struct iC3_TransducerSpillHeader
+{
+    char    acMagic[8];
+    quint32 ulFormatVersion;
+    quint32 ulRecordSize;                           // sizeof( iC3_TransducerSpillRecord )
+    quint32 ulCapacity;                             // records in the ring
+    quint32 ulReserved;
+    qint64  llHead;                                 // records replayed
+    qint64  llTail;                                 // records appended
+    char    acPadding[24];
+};
+
+struct iC3_TransducerSpillRecord
+{
+    quint32 ulCRC;                                  // CRC-32 of the rest of the record
+    qint32  lDeviceID;
+    qint64  llSequenceIndex;                        // 0: assigned when replayed
+    qint64  llSampleTimeMS;
+    double  adRTDValues[TRANSDUCER_NUMBER_OF_RTDS];
+};
+
+class iC3_TransducerSpillJournal
+{
+public:
+    iC3_TransducerSpillJournal();
+    ~iC3_TransducerSpillJournal();
+
+    bool open( const QString & sFileName, quint32 ulCapacity = TRANSDUCER_SPILL_CAPACITY );
+    void close( void );
+    bool isOpen( void );
+
+    bool append( const iC3_TransducerSample & sample );
+    int peek( int iMaxRecords, QVector<iC3_TransducerSample> & samples );
+    bool setSequenceIndex( int iRecord, qint64 llSequenceIndex );
+    bool sync( void );
+    void consume( int iRecords );
+    qint64 getCount( void );
+    qint64 getOldestSampleTimeMS( int iDeviceID );
+
+    QString GetLastError( void );
+
+private:
+
+    bool createFile( quint32 ulCapacity );
+    bool recoverRecords( void );
+    iC3_TransducerSpillRecord * getRecord( qint64 llRecord ) const;
+    static quint32 calculateCRC( const iC3_TransducerSpillRecord & record );
+
+    QFile m_File;
+    uchar * m_pMapping;                             // NULL while closed
+    iC3_TransducerSpillHeader * m_pHeader;          // the start of m_pMapping
+
+    QMutex m_Mutex;                                 // guards everything above
+    QString m_sLastError;
+};
+
+#endif // IC3_TRANSDUCERSPILLJOURNAL_H
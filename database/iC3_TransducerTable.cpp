@@ -7,412 +7,640 @@
 
 iC3_TransducerTable::iC3_TransducerTable()
 {
-    iC3_DatabaseColumnDef * pColumn;
+    // the columns are declared by TRANSDUCER_TABLE_COLUMNS() in the header
+    m_sTableName = TRANSDUCER_TABLE_NAME;
+}
 
-    m_sTableName = "Transducers";
 
-    setNumberOfColumns( e_NUMBER_OF_TRANSDUCER_TABLE_COLUMNS );
+QString iC3_TransducerTable::getTableCreationSQL( void )
+{
+    return QString( IC3_SCHEMA_CREATE_SQL( TRANSDUCER_TABLE_NAME, TRANSDUCER_TABLE_COLUMNS ) );
+}
 
-//    pColumn = new iC3_DatabaseColumnDef( tr("eventSequenceIndex"), "BIGINT UNSIGNED", "PRIMARY KEY" );  //64 bit
-//    AddColumnDef( e_ACCESS_LOG_TABLE_EVENT_SEQUENCE_INDEX_COL, pColumn );
+//-----------------------------------------------------------------------------------------------
+/** CreateTable() - creates the Transducers table and its index if they do not exist.
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @retval true - the table and index exist
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @author  Doug Sanqunetti
+*   @date 09/01/2013
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerTable::CreateTable( QSqlDatabase & database )
+{
+    ClearLastError();
 
-    pColumn = new iC3_DatabaseColumnDef( tr("dateTime"), "DATETIME", "" );
-    AddColumnDef( e_TRANSDUCER_TABLE_DATE_TIME_COL , pColumn );
+    if ( !database.isOpen() )
+    {
+        QString sErrorMessage = "iC3_TransducerTable::CreateTable() - Database is not open";
+        SetLastError( sErrorMessage );
+        qDebug() << m_sLastError;
+        return false;
+    }
 
-    pColumn = new iC3_DatabaseColumnDef( tr("RTD1Temperature"), "FLOAT", "" );
-    AddColumnDef( e_TRANSDUCER_TABLE_RTD_1_TEMP_COL, pColumn );
+    if ( !execSQL( database, getTableCreationSQL(), "CreateTable" ) )
+    {
+        return false;
+    }
 
-    pColumn = new iC3_DatabaseColumnDef( tr("RTD2Temperature"), "FLOAT", "" );
-    AddColumnDef( e_TRANSDUCER_TABLE_RTD_2_TEMP_COL, pColumn );
+    // (deviceID, sampleTimeMS, sequenceIndex) leads so range and last-N lookups are a single
+    // index seek already in ORDER BY order; the RTD columns make it covering so those lookups
+    // never visit the table itself.
+    return execSQL( database,
+                    "CREATE INDEX IF NOT EXISTS " TRANSDUCER_TABLE_INDEX_NAME " ON " TRANSDUCER_TABLE_NAME
+                    " ( deviceID, sampleTimeMS, sequenceIndex, " IC3_SCHEMA_COLUMN_NAMES( TRANSDUCER_RTD_COLUMNS ) " )",
+                    "CreateTable" );
+}
 
-    pColumn = new iC3_DatabaseColumnDef( tr("RTD3Temperature"), "FLOAT", "" );
-    AddColumnDef( e_TRANSDUCER_TABLE_RTD_3_TEMP_COL, pColumn );
+//-----------------------------------------------------------------------------------------------
+/** upgradeSchema() - brings a Transducers table written by an older build up to the current
+*                     layout.  Must be called inside a transaction, before CreateTable().
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @param iFromVersion - the PRAGMA user_version found in the database
+*   @retval true - the table is at the current layout (or does not exist yet)
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerTable::upgradeSchema( QSqlDatabase & database, int iFromVersion )
+{
+    ClearLastError();
 
-    pColumn = new iC3_DatabaseColumnDef( tr("RTD4Temperature"), "FLOAT", "" );
-    AddColumnDef( e_TRANSDUCER_TABLE_RTD_4_TEMP_COL, pColumn );
+    // version 0: ( dateTime, RTD1Temperature .. RTD5Temperature ), no key and no index.  dateTime
+    // holds local time text ('yyyy-MM-dd hh:mm:ss') or, for rows logged after the statements
+    // were prepared, integer ms since the epoch.
+    if ( ( iFromVersion < 1 ) && hasColumn( database, m_sTableName, "dateTime" ) )
+    {
+        QString sOldTableName = QString("%1_v0").arg( m_sTableName );
+        QString sCopySQL = QString("INSERT INTO %1 ( deviceID, sampleTimeMS, " IC3_SCHEMA_COLUMN_NAMES( TRANSDUCER_RTD_COLUMNS ) " ) "
+                                   "SELECT %2, "
+                                   "CASE WHEN typeof(dateTime) = 'integer' THEN dateTime "
+                                   "ELSE CAST( strftime('%s', dateTime, 'utc') AS INTEGER ) * 1000 END, "
+                                   IC3_SCHEMA_COLUMN_NAMES( TRANSDUCER_RTD_COLUMNS ) " FROM %3 ORDER BY rowid")
+                               .arg( m_sTableName )
+                               .arg( TRANSDUCER_LOCAL_DEVICE_ID )
+                               .arg( sOldTableName );
+
+        qDebug() << "iC3_TransducerTable::upgradeSchema() - converting version 0 Transducers table";
+
+        if ( !execSQL( database, QString("ALTER TABLE %1 RENAME TO %2").arg( m_sTableName ).arg( sOldTableName ), "upgradeSchema" ) ||
+             !execSQL( database, getTableCreationSQL(), "upgradeSchema" ) ||
+             !execSQL( database, sCopySQL, "upgradeSchema" ) ||
+             !execSQL( database, QString("DROP TABLE %1").arg( sOldTableName ), "upgradeSchema" ) )
+        {
+            return false;
+        }
+    }
 
-    pColumn = new iC3_DatabaseColumnDef( tr("RTD5Temperature"), "FLOAT", "" );
-    AddColumnDef( e_TRANSDUCER_TABLE_RTD_5_TEMP_COL, pColumn );
+    return true;
 }
 
-
-QString iC3_TransducerTable::getTableCreationSQL( void )
+//-----------------------------------------------------------------------------------------------
+/** insertNewEntry() - inserts a new entry for the local device, time stamped now, into the
+*                      Transducers table.
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @param fRTD1Val..fRTD5Val - RTD temperatures
+*   @retval true - if the data was successfully inserted
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @author  Doug Sanqunetti
+*   @date 09/01/2013
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerTable::insertNewEntry( QSqlDatabase &database,
+                                          double fRTD1Val,
+                                          double fRTD2Val,
+                                          double fRTD3Val,
+                                          double fRTD4Val,
+                                          double fRTD5Val )
 {
-    return iC3_DatabaseTable::getTableCreationSQL( m_sTableName );
+    iC3_TransducerSample sample;
+
+    sample.llSequenceIndex = 0;
+    sample.iDeviceID = TRANSDUCER_LOCAL_DEVICE_ID;
+    sample.llSampleTimeMS = QDateTime::currentMSecsSinceEpoch();
+    sample.adRTDValues[0] = fRTD1Val;
+    sample.adRTDValues[1] = fRTD2Val;
+    sample.adRTDValues[2] = fRTD3Val;
+    sample.adRTDValues[3] = fRTD4Val;
+    sample.adRTDValues[4] = fRTD5Val;
+
+    return insertNewEntry( database, sample );
 }
 
-bool iC3_TransducerTable::CreateTable( QSqlDatabase & database )
+//-----------------------------------------------------------------------------------------------
+/** insertNewEntry() - inserts a sample into the Transducers table using the connection's
+*                      prepared insert statement.  A sample without a sequence index (0) is
+*                      given the next rowid by SQLite.
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @param sample - the device, time stamp and RTD values to insert
+*   @retval true - if the data was successfully inserted
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerTable::insertNewEntry( QSqlDatabase & database, const iC3_TransducerSample & sample )
 {
-    bool bRC = false;
-    QString sCreationSQL;
-    QSqlQuery query( database );
-
     ClearLastError();
 
-    if ( database.isOpen() )
+    QSqlQuery * pQuery = getPreparedQuery( database, e_TRANSDUCER_STMT_INSERT,
+                                           IC3_SCHEMA_INSERT_SQL( TRANSDUCER_TABLE_NAME, TRANSDUCER_TABLE_COLUMNS ) );
+    if ( pQuery == NULL )
     {
-        sCreationSQL = getTableCreationSQL();
-//        qDebug() << sCreationSQL;
-        bRC = query.exec( sCreationSQL );
+        return false;
+    }
 
-        if ( bRC == false )
-        {
-            QString sQueryError = query.lastError().text();
-            SetLastError( QString("iC3_TransducerTable::CreateTable() - Query Error: %1").arg(sQueryError));
-            qDebug() << m_sLastError;
-            return false;
-        }
+    bindSample( pQuery, sample );
+
+    // NULL into the INTEGER PRIMARY KEY lets SQLite pick the rowid
+    if ( sample.llSequenceIndex <= 0 )
+    {
+        pQuery->bindValue( e_TRANSDUCER_TABLE_SEQUENCE_INDEX_COL, QVariant( QVariant::LongLong ) );
     }
-    else
+
+    if ( !pQuery->exec() )
     {
-        QString sErrorMessage = "iC3_TransducerTable::CreateTable() - Database is not open";
-        SetLastError( sErrorMessage );
+        QString sQueryError = pQuery->lastError().text();
+        SetLastError( QString("iC3_TransducerTable::InsertNewEntry() - Query Error: %1").arg(sQueryError));
         qDebug() << m_sLastError;
         return false;
     }
 
-    return bRC;
+    return true;
 }
 
-QString iC3_TransducerTable::getSQL_ColumnNames( void )
+//-----------------------------------------------------------------------------------------------
+/** insertReplayedEntry() - inserts a sample replayed from the spill journal.  The sample keeps
+*                           the sequence index it was given when it was spilled, so a replay
+*                           repeated after a crash finds the row already there and leaves it.
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @param sample - the sample, with its sequence index
+*   @param bInserted - set false when the row was already stored
+*   @retval true - if the sample is stored
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerTable::insertReplayedEntry( QSqlDatabase & database, const iC3_TransducerSample & sample, bool & bInserted )
 {
-    QString sColumnNames;
+    ClearLastError();
 
-    int iIndex;
+    bInserted = false;
+
+    QSqlQuery * pQuery = getPreparedQuery( database, e_TRANSDUCER_STMT_INSERT_OR_IGNORE,
+                                           IC3_SCHEMA_INSERT_OR_IGNORE_SQL( TRANSDUCER_TABLE_NAME, TRANSDUCER_TABLE_COLUMNS ) );
+    if ( pQuery == NULL )
+    {
+        return false;
+    }
 
-    sColumnNames = QString("( %1").arg(getColumnDef(0)->getColumnName());
+    bindSample( pQuery, sample );
 
-    for (iIndex = 1; iIndex < e_NUMBER_OF_TRANSDUCER_TABLE_COLUMNS; iIndex++ )
+    if ( sample.llSequenceIndex <= 0 )
     {
-        sColumnNames.append(QString(", %1").arg(getColumnDef(iIndex)->getColumnName()));
+        pQuery->bindValue( e_TRANSDUCER_TABLE_SEQUENCE_INDEX_COL, QVariant( QVariant::LongLong ) );
     }
-    sColumnNames.append(" )");
 
-    return sColumnNames;
+    if ( !pQuery->exec() )
+    {
+        QString sQueryError = pQuery->lastError().text();
+        SetLastError( QString("iC3_TransducerTable::insertReplayedEntry() - Query Error: %1").arg(sQueryError));
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    bInserted = ( pQuery->numRowsAffected() > 0 );
+
+    return true;
 }
 
 //-----------------------------------------------------------------------------------------------
-/** getSQL_ColumnValues() - returns the Access Log Table column values in a form usable in an
-*                          sql insert statement.
-*   @param pAccessControlEntry - Pointer to an iC3_AccessLogData object containing the column
-*                                data.
-*   @retval Access Log Table column values in a form usable in an sql statement (QString)
-*   @author  Doug Sanqunetti
-*   @date 09/01/2013
+/** getEntriesInRange() - retrieves the first page of a device's samples with
+*                         llStartTimeMS <= time < llEndTimeMS, oldest first.  Pass the last
+*                         sample returned to getNextEntriesInRange() for the following page.
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @param iDeviceID - the device whose samples are wanted
+*   @param llStartTimeMS - start of the range, ms since the epoch (inclusive)
+*   @param llEndTimeMS - end of the range, ms since the epoch (exclusive)
+*   @param iMaxEntries - page size
+*   @param samples - the samples found are appended here
+*   @retval true - if the query succeeded (samples may still be empty)
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
 */
 //-----------------------------------------------------------------------------------------------
-QString iC3_TransducerTable::getSQL_ColumnValues(  iC3_AccessLogData *pAccessLogEntry )
+bool iC3_TransducerTable::getEntriesInRange( QSqlDatabase & database,
+                                             int iDeviceID,
+                                             qint64 llStartTimeMS,
+                                             qint64 llEndTimeMS,
+                                             int iMaxEntries,
+                                             QVector<iC3_TransducerSample> & samples )
 {
-    QString sValueString;
-
-//    QDateTime dtAccessDateTime = QDateTime( pAccessLogEntry->getAccessDate(),
-//                                            pAccessLogEntry->getAccessTime(),
-//                                            Qt::LocalTime );
-
-//    sValueString = QString("VALUES ( ");
-//    sValueString.append(QString("%1, ").arg( pAccessLogEntry->getAccessEvent() ));
-//    sValueString.append(QString("%1, ").arg( SQL_FormatString(pAccessLogEntry->getUser())));
-//    sValueString.append(QString("%1, ").arg( SQL_FormatQDateTime(dtAccessDateTime)));
-//    sValueString.append(QString("%1, ").arg( pAccessLogEntry->getAccessMethodEnum()));
-//    sValueString.append(QString("%1, ").arg( pAccessLogEntry->getIntDurationMinutes()));
-//    sValueString.append(QString("%1, ").arg( SQL_FormatBoolean(pAccessLogEntry->getAccessEventViewed())));
-//    sValueString.append(QString("%1, ").arg( SQL_FormatBoolean(pAccessLogEntry->getAccessEventDownloaded())));
-//    sValueString.append(QString("%1 )").arg( pAccessLogEntry->getEventSequenceIndex()));
-
-    return sValueString;
+    iC3_TransducerSample cursor;
+
+    // a cursor just before the first possible row at llStartTimeMS
+    cursor.llSequenceIndex = -1;
+    cursor.iDeviceID = iDeviceID;
+    cursor.llSampleTimeMS = llStartTimeMS;
+
+    return getNextEntriesInRange( database, cursor, llEndTimeMS, iMaxEntries, samples );
 }
 
 //-----------------------------------------------------------------------------------------------
-/** updateAccessLogDataFromQuery() - updates an iC3_AccessLogData object with the column
-*                                values returned in a QSqlQuery.
-*   @param pAccessLogEntry - Pointer to an iC3_AccessLogData object containing the column
-*                                data.
-*   @param query - Reference to a QSqlQuery containing the results of an executed query
-*   @retval true - if the query is valid and pAccessLogEntry != NULL
+/** getNextEntriesInRange() - keyset pagination: retrieves up to iMaxEntries samples of
+*                             lastSample's device that follow lastSample in (time, sequence)
+*                             order and are before llEndTimeMS.  Each page is one index seek
+*                             no matter how deep into the table it is.
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @param lastSample - the last sample of the previous page
+*   @param llEndTimeMS - end of the range, ms since the epoch (exclusive)
+*   @param iMaxEntries - page size
+*   @param samples - the samples found are appended here
+*   @retval true - if the query succeeded (fewer than iMaxEntries samples means the range is done)
 *   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
 *                   retrieve error information.
-*   @author  Doug Sanqunetti
-*   @date 09/01/2013
+*   @date 10/19/2026
 */
 //-----------------------------------------------------------------------------------------------
-bool iC3_TransducerTable::updateAccessLogDataFromQuery( iC3_AccessLogData * pAccessLogEntry, QSqlQuery & query )
+bool iC3_TransducerTable::getNextEntriesInRange( QSqlDatabase & database,
+                                                 const iC3_TransducerSample & lastSample,
+                                                 qint64 llEndTimeMS,
+                                                 int iMaxEntries,
+                                                 QVector<iC3_TransducerSample> & samples )
 {
-    QDateTime accessDateTime;
+    ClearLastError();
 
-    if (    ( query.isValid() )
-         && ( pAccessLogEntry != NULL )
-       )
+    // "time >= ?" bounds the index seek; the OR only filters the rows sharing lastSample's time
+    QSqlQuery * pQuery = getPreparedQuery( database, e_TRANSDUCER_STMT_SELECT_RANGE,
+                                           IC3_SCHEMA_SELECT_SQL( TRANSDUCER_TABLE_NAME, TRANSDUCER_TABLE_COLUMNS )
+                                           " INDEXED BY " TRANSDUCER_TABLE_INDEX_NAME
+                                           " WHERE deviceID = ? AND sampleTimeMS >= ? AND ( sampleTimeMS > ? OR sequenceIndex > ? )"
+                                           " AND sampleTimeMS < ? ORDER BY sampleTimeMS, sequenceIndex LIMIT ?" );
+    if ( pQuery == NULL )
     {
-//        pAccessLogEntry->setAccessEvent(query.value(e_ACCESS_LOG_TABLE_ACCESSS_EVENT_COL).toInt());
-//        pAccessLogEntry->setUser( query.value(e_ACCESS_LOG_TABLE_USER_NAME_COL).toString());
-//        accessDateTime = query.value(e_ACCESS_LOG_TABLE_DATE_TIME_COL).toDateTime();
-//        pAccessLogEntry->setAccessDate(accessDateTime.date());
-//        pAccessLogEntry->setAccessTime(accessDateTime.time());
-//        pAccessLogEntry->setAccessMethod(query.value( e_ACCESS_LOG_TABLE_ACCESS_METHOD_COL).toInt());
-//        pAccessLogEntry->setDurationMinutes(query.value(e_ACCESS_LOG_TABLE_ACCESS_DURATION_COL).toInt());
-//        pAccessLogEntry->setAccessEventViewed(query.value( e_ACCESS_LOG_TABLE_VIEWED_COL).toBool());
-//        pAccessLogEntry->setAccessEventDownloaded(query.value(e_ACCESS_LOG_TABLE_DOWNLOADED_COL).toBool());
-//        pAccessLogEntry->setEventSequenceIndex(query.value(e_ACCESS_LOG_TABLE_EVENT_SEQUENCE_INDEX_COL).toLongLong());
-        return true;
+        return false;
     }
-    else
+
+    pQuery->bindValue( 0, lastSample.iDeviceID );
+    pQuery->bindValue( 1, lastSample.llSampleTimeMS );
+    pQuery->bindValue( 2, lastSample.llSampleTimeMS );
+    pQuery->bindValue( 3, lastSample.llSequenceIndex );
+    pQuery->bindValue( 4, llEndTimeMS );
+    pQuery->bindValue( 5, iMaxEntries );
+
+    return selectEntries( pQuery, "getNextEntriesInRange", samples );
+}
+
+//-----------------------------------------------------------------------------------------------
+/** getLastEntries() - retrieves a device's most recent samples, oldest first.  Reads backwards
+*                      from the end of the index rather than counting the table.
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @param iDeviceID - the device whose samples are wanted
+*   @param iNumberOfEntries - the number of samples to retrieve
+*   @param samples - the samples found are appended here
+*   @retval true - if the query succeeded
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerTable::getLastEntries( QSqlDatabase & database,
+                                          int iDeviceID,
+                                          int iNumberOfEntries,
+                                          QVector<iC3_TransducerSample> & samples )
+{
+    ClearLastError();
+
+    QSqlQuery * pQuery = getPreparedQuery( database, e_TRANSDUCER_STMT_SELECT_LAST_N,
+                                           IC3_SCHEMA_SELECT_SQL( TRANSDUCER_TABLE_NAME, TRANSDUCER_TABLE_COLUMNS )
+                                           " INDEXED BY " TRANSDUCER_TABLE_INDEX_NAME
+                                           " WHERE deviceID = ? ORDER BY sampleTimeMS DESC, sequenceIndex DESC LIMIT ?" );
+    if ( pQuery == NULL )
+    {
+        return false;
+    }
+
+    pQuery->bindValue( 0, iDeviceID );
+    pQuery->bindValue( 1, iNumberOfEntries );
+
+    int iFirstNewEntry = samples.size();
+
+    if ( !selectEntries( pQuery, "getLastEntries", samples ) )
     {
-        m_sLastError = "iC3_DatabaseAccessLogTable::updateAccessControlDataFromQuery():  query.isValid() returned false";
         return false;
     }
+
+    // newest first out of the index - flip the new entries to oldest first
+    for ( int iLow = iFirstNewEntry, iHigh = samples.size() - 1; iLow < iHigh; iLow++, iHigh-- )
+    {
+        qSwap( samples[iLow], samples[iHigh] );
+    }
+
+    return true;
 }
 
 //-----------------------------------------------------------------------------------------------
-/** insertNewEntry() - inserts a new Access Log entry into the Access Log table.
+/** deleteEntriesInRange() - deletes a device's samples with llStartTimeMS <= time < llEndTimeMS
 *   @param database - a reference to the QSqlDatabase object where the table exists.
 *                     The database must already be open.
-*   @param pEntry - Pointer to an iC3_AccessLogData object containing the data to be inserted
-*   @retval true - if the data was successfully inserted
+*   @param iDeviceID - the device whose samples are deleted
+*   @param llStartTimeMS - start of the range, ms since the epoch (inclusive)
+*   @param llEndTimeMS - end of the range, ms since the epoch (exclusive)
+*   @retval true - the delete succeeded
 *   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
 *                   retrieve error information.
-*   @author  Doug Sanqunetti
-*   @date 09/01/2013
+*   @date 10/19/2026
 */
 //-----------------------------------------------------------------------------------------------
-bool iC3_TransducerTable::insertNewEntry( QSqlDatabase &database,
-                                          double fRTD1Val,
-                                          double fRTD2Val,
-                                          double fRTD3Val,
-                                          double fRTD4Val,
-                                          double fRTD5Val )
+bool iC3_TransducerTable::deleteEntriesInRange( QSqlDatabase & database,
+                                                int iDeviceID,
+                                                qint64 llStartTimeMS,
+                                                qint64 llEndTimeMS )
 {
-    QString queryString;
-    QSqlQuery query( database );
-    bool bRC = false;
-
     ClearLastError();
 
-    if ( database.isOpen() )
+    QSqlQuery * pQuery = getPreparedQuery( database, e_TRANSDUCER_STMT_DELETE_RANGE,
+                                           "DELETE FROM " TRANSDUCER_TABLE_NAME
+                                           " WHERE deviceID = ? AND sampleTimeMS >= ? AND sampleTimeMS < ?" );
+    if ( pQuery == NULL )
     {
-        queryString = QString( "INSERT INTO %1 ").arg(m_sTableName);
+        return false;
+    }
 
-        queryString.append( getSQL_ColumnNames());
+    pQuery->bindValue( 0, iDeviceID );
+    pQuery->bindValue( 1, llStartTimeMS );
+    pQuery->bindValue( 2, llEndTimeMS );
 
-        queryString.append(" VALUES ( ");
-        queryString.append(QString("%1, ").arg( SQL_FormatQDateTime(QDateTime::currentDateTime())));
-        queryString.append(QString("%1, ").arg( SQL_FormatDouble(fRTD1Val)));
-        queryString.append(QString("%1, ").arg( SQL_FormatDouble(fRTD2Val)));
-        queryString.append(QString("%1, ").arg( SQL_FormatDouble(fRTD3Val)));
-        queryString.append(QString("%1, ").arg( SQL_FormatDouble(fRTD4Val)));
-        queryString.append(QString("%1 )").arg( SQL_FormatDouble(fRTD5Val)));
+    if ( !pQuery->exec() )
+    {
+        SetLastError( QString("iC3_TransducerTable::deleteEntriesInRange() - Query Error: %1").arg( pQuery->lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
 
-//        qDebug() << queryString;
+    return true;
+}
 
-        bRC = query.exec(queryString);
+//-----------------------------------------------------------------------------------------------
+/** deleteEntriesBefore() - deletes up to iMaxRows of a device's oldest samples taken before
+*                           llBeforeTimeMS.  The rows are found with a seek on the
+*                           (deviceID, sampleTimeMS) index, so only the rows deleted are visited.
+*   @param database - a reference to the QSqlDatabase object where the table exists.
+*                     The database must already be open.
+*   @param iDeviceID - the device whose samples are deleted
+*   @param llBeforeTimeMS - samples before this time are deleted
+*   @param iMaxRows - the most rows to delete in this call
+*   @param iDeleted - set to the number of rows deleted
+*   @retval true - the delete succeeded
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerTable::deleteEntriesBefore( QSqlDatabase & database, int iDeviceID, qint64 llBeforeTimeMS, int iMaxRows, int & iDeleted )
+{
+    ClearLastError();
 
-        if ( bRC == false )
-        {
-            QString sQueryError = query.lastError().text();
-            SetLastError( QString("iC3_TransducerTable::InsertNewEntry() - Query Error: %1").arg(sQueryError));
-            qDebug() << m_sLastError;
-            return false;
-        }
+    iDeleted = 0;
+
+    QSqlQuery * pQuery = getPreparedQuery( database, e_TRANSDUCER_STMT_DELETE_BEFORE,
+                                           "DELETE FROM " TRANSDUCER_TABLE_NAME " WHERE sequenceIndex IN "
+                                           "( SELECT sequenceIndex FROM " TRANSDUCER_TABLE_NAME " INDEXED BY " TRANSDUCER_TABLE_INDEX_NAME
+                                           " WHERE deviceID = ? AND sampleTimeMS < ? ORDER BY sampleTimeMS LIMIT ? )" );
+    if ( pQuery == NULL )
+    {
+        return false;
     }
-    else
+
+    pQuery->bindValue( 0, iDeviceID );
+    pQuery->bindValue( 1, llBeforeTimeMS );
+    pQuery->bindValue( 2, iMaxRows );
+
+    if ( !pQuery->exec() )
     {
-        QString sErrorMessage = "iC3_TransducerTable::InsertNewEntry() - Database is not open";
-        SetLastError( sErrorMessage );
+        SetLastError( QString("iC3_TransducerTable::deleteEntriesBefore() - Query Error: %1").arg( pQuery->lastError().text() ) );
         qDebug() << m_sLastError;
         return false;
     }
 
+    iDeleted = pQuery->numRowsAffected();
+
     return true;
 }
 
 //-----------------------------------------------------------------------------------------------
-/** getAccessLogEntry() - retrieves an Access Log entry from the Access Log table.
+/** getNextDeviceID() - finds the lowest device ID above iAfterDeviceID that has samples.  One
+*                       index seek per call, so walking every device never scans the table.
 *   @param database - a reference to the QSqlDatabase object where the table exists.
 *                     The database must already be open.
-*   @param ulEventSequenceIndex - Event Sequence Index of the Log Entry to be retrieved
-*   @param pAccessLogEntry - pointer to an iC3_AccessLogData object where the Access
-*                      Log entry will be stored.
-*   @retval true - if the data was successfully retrieved
+*   @param iAfterDeviceID - the previous device ID (-1 to start)
+*   @param iDeviceID - set to the device found
+*   @param bFound - set to false when there are no more devices
+*   @retval true - the query succeeded
 *   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
 *                   retrieve error information.
-*   @author  Doug Sanqunetti
-*   @date 09/01/2013
+*   @date 10/19/2026
 */
 //-----------------------------------------------------------------------------------------------
-bool iC3_TransducerTable::getAccessLogEntry( QSqlDatabase & database,
-                                                    quint32 ulEventSequenceIndex,
-                                                    iC3_AccessLogData * pAccessLogEntry )
+bool iC3_TransducerTable::getNextDeviceID( QSqlDatabase & database, int iAfterDeviceID, int & iDeviceID, bool & bFound )
 {
-    bool bRC = false;
-    QSqlQuery query( database );
-    QString queryString;
+    ClearLastError();
 
-    if ( database.isOpen() )
+    QSqlQuery * pQuery = getPreparedQuery( database, e_TRANSDUCER_STMT_NEXT_DEVICE,
+                                           "SELECT deviceID FROM " TRANSDUCER_TABLE_NAME " INDEXED BY " TRANSDUCER_TABLE_INDEX_NAME
+                                           " WHERE deviceID > ? ORDER BY deviceID LIMIT 1" );
+    if ( pQuery == NULL )
     {
-        queryString = QString( "SELECT * FROM %1 WHERE %2 = %3").arg(m_sTableName).arg(getColumnDef(e_NUMBER_OF_TRANSDUCER_TABLE_COLUMNS)->getColumnName()).arg(ulEventSequenceIndex);
-        qDebug() << queryString;
-        bRC = query.exec(queryString);
-
-         if ( bRC == false )
-         {
-             QString sQueryError = query.lastError().text();
-             SetLastError( QString("iC3_DatabaseAccessLogTable::getAccessLogEntry() - Query Error: %1").arg(sQueryError));
-             qDebug() << m_sLastError;
-             return false;
-         }
-
-         if( query.next() == true )
-         {
-             bRC = true;
-             updateAccessLogDataFromQuery( pAccessLogEntry, query );
-         }
-         else
-         {
-             bRC = false;
-         }
-     }
-     else
-     {
-         QString sErrorMessage = "iC3_DatabaseAccessLogTable::getAccessLogEntry() - Database is not open";
-         SetLastError( sErrorMessage );
-         qDebug() << m_sLastError;
-         return false;
-     }
-
-    return bRC;
+        return false;
+    }
+
+    pQuery->bindValue( 0, iAfterDeviceID );
+
+    if ( !pQuery->exec() )
+    {
+        SetLastError( QString("iC3_TransducerTable::getNextDeviceID() - Query Error: %1").arg( pQuery->lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    bFound = pQuery->next();
+    if ( bFound )
+    {
+        iDeviceID = pQuery->value( 0 ).toInt();
+    }
+
+    pQuery->finish();
+
+    return true;
 }
 
 //-----------------------------------------------------------------------------------------------
-/** getLastMultAccessLogData() - retrieves the last n Access Log entries from the Access Log table.
+/** getLastSequenceIndex() - the highest sequence index in the table.  A single seek to the end
+*                            of the rowid b-tree.
 *   @param database - a reference to the QSqlDatabase object where the table exists.
 *                     The database must already be open.
-*   @param uiNumberOfEntries - the number of access log entries to retrieve
-*   @param pReturnData - pointer to an iC3_DatabaseAccessLogData object where the Access
-*                      Log entries will be stored.
-*   @retval true - if the data was successfully retrieved
+*   @param llSequenceIndex - set to the highest sequence index, 0 if the table is empty
+*   @retval true - if the query succeeded
 *   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
 *                   retrieve error information.
-*   @author  Doug Sanqunetti
-*   @date 09/01/2013
+*   @date 10/19/2026
 */
 //-----------------------------------------------------------------------------------------------
-bool iC3_TransducerTable::getLastMultAccessLogData( QSqlDatabase &database,
-                                                           unsigned int uiNumberOfEntries,
-                                                           iC3_DatabaseAccessLogData * pReturnData )
+bool iC3_TransducerTable::getLastSequenceIndex( QSqlDatabase & database, qint64 & llSequenceIndex )
 {
-    bool bRC = false;
+    ClearLastError();
 
-    iC3_AccessLogData * pAccessLogEntry;
-    QString sColumnName;
-    QString queryString;
+    QSqlQuery * pQuery = getPreparedQuery( database, e_TRANSDUCER_STMT_LAST_SEQUENCE,
+                                           "SELECT MAX(sequenceIndex) FROM " TRANSDUCER_TABLE_NAME );
+    if ( pQuery == NULL )
+    {
+        return false;
+    }
+
+    if ( !pQuery->exec() || !pQuery->next() )
+    {
+        SetLastError( QString("iC3_TransducerTable::getLastSequenceIndex() - Query Error: %1").arg( pQuery->lastError().text() ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    // MAX() of an empty table is NULL, which converts to 0
+    llSequenceIndex = pQuery->value( 0 ).toLongLong();
+
+    pQuery->finish();
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------
+/** execSQL() - executes a one-off statement, recording any error
+*   @param database - the open database
+*   @param sSQL - the statement
+*   @param pFunctionName - caller's name for the error message
+*   @retval true - the statement succeeded
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerTable::execSQL( QSqlDatabase & database, const QString & sSQL, const char * pFunctionName )
+{
     QSqlQuery query( database );
 
-    ClearLastError();
+    if ( !query.exec( sSQL ) )
+    {
+        QString sQueryError = query.lastError().text();
+        SetLastError( QString("iC3_TransducerTable::%1() - Query Error: %2").arg( pFunctionName ).arg( sQueryError ) );
+        qDebug() << m_sLastError;
+        return false;
+    }
+
+    return true;
+}
 
-    sColumnName = m_qlColumnDefinitions.at(e_NUMBER_OF_TRANSDUCER_TABLE_COLUMNS)->getColumnName();
+//-----------------------------------------------------------------------------------------------
+/** hasColumn() - checks whether an existing table has a column
+*   @param database - the open database
+*   @param sTableName - the table to check
+*   @param sColumnName - the column to look for
+*   @retval true - the table exists and has the column
+*   @retval false - the table or the column does not exist
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerTable::hasColumn( QSqlDatabase & database, const QString & sTableName, const QString & sColumnName )
+{
+    QSqlQuery query( database );
 
-    if ( database.isOpen() )
+    if ( !query.exec( QString("PRAGMA table_info(%1)").arg( sTableName ) ) )
     {
-        queryString = QString( "SELECT * FROM %1 ORDER BY %2 ASC LIMIT ((Select count([%2]) from [%1])-%3),%3").arg(m_sTableName).arg(sColumnName).arg(uiNumberOfEntries);
-        qDebug() << queryString;
-        bRC = query.exec(queryString);
+        return false;
+    }
 
-        if ( bRC == false )
+    while ( query.next() )
+    {
+        // table_info columns: cid, name, type, notnull, dflt_value, pk
+        if ( query.value( 1 ).toString().compare( sColumnName, Qt::CaseInsensitive ) == 0 )
         {
-            QString sQueryError = query.lastError().text();
-            SetLastError( QString("iC3_DatabaseAccessLogTable::getLastMultAccessLogData() - Query Error: %1").arg(sQueryError));
-            qDebug() << m_sLastError;
-            return false;
+            return true;
         }
+    }
 
-        while ( query.next() )
-        {
-//            pAccessLogEntry = new iC3_AccessLogData();
-
-            if( pAccessLogEntry == NULL )
-            {
-                SetLastError(QString("iC3_DatabaseAccessLogTable::getLastMultAccessLogData()-unable to create a new iC3_AccessLogData object"));
-                return false;
-            }
-
-            if ( updateAccessLogDataFromQuery( pAccessLogEntry, query ) == true )
-            {
-//                pReturnData->AddAccessLogEntry(pAccessLogEntry);
-            }
-            else
-            {
-                return false;
-            }
+    return false;
+}
 
-        }
-    }
-    else
+//-----------------------------------------------------------------------------------------------
+/** selectEntries() - executes a bound select and appends every row to samples
+*   @param pQuery - the prepared, bound query
+*   @param pFunctionName - caller's name for the error message
+*   @param samples - the rows are appended here
+*   @retval true - the query succeeded
+*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
+*                   retrieve error information.
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+bool iC3_TransducerTable::selectEntries( QSqlQuery * pQuery, const char * pFunctionName, QVector<iC3_TransducerSample> & samples )
+{
+    pQuery->setForwardOnly( true );
+
+    if ( !pQuery->exec() )
     {
-        QString sErrorMessage = "iC3_DatabaseAccessLogTable::getLastMultiEvents() - Database is not open";
-        SetLastError( sErrorMessage );
+        QString sQueryError = pQuery->lastError().text();
+        SetLastError( QString("iC3_TransducerTable::%1() - Query Error: %2").arg( pFunctionName ).arg( sQueryError ) );
         qDebug() << m_sLastError;
+        return false;
     }
 
-    return bRC;
+    iC3_TransducerSample sample;
+    while ( pQuery->next() )
+    {
+        updateSampleFromQuery( sample, *pQuery );
+        samples.append( sample );
+    }
+
+    pQuery->finish();
+
+    return true;
 }
 
 //-----------------------------------------------------------------------------------------------
-/** updateAccessLogEntry() - updates an Access Log entry in the Access Control table.
-*   @param database - a reference to the QSqlDatabase object where the table exists.
-*                     The database must already be open.
-*   @param pAccessLogEntry - pointer to an iC3_AccessLogData object containing the
-*                     Access Log entry to be updated.
-*   @retval true - if the data was successfully updated
-*   @retval false - an error occurred.  Use iC3_DatabaseTable::GetLastError() to
-*                   retrieve error information.
-*   @author  Doug Sanqunetti
-*   @date 09/01/2013
+/** bindSample() - binds every column of a sample to a statement listing the columns in enum
+*                  order
+*   @param pQuery - the prepared query
+*   @param row - the sample to bind
+*   @retval none
+*   @date 10/19/2026
 */
 //-----------------------------------------------------------------------------------------------
-bool iC3_TransducerTable::updateAccessLogEntry( QSqlDatabase & database,
-                                                       iC3_AccessLogData *pAccessLogEntry )
+void iC3_TransducerTable::bindSample( QSqlQuery * pQuery, const iC3_TransducerSample & row )
 {
-    bool bRC = false;
-    QSqlQuery query( database );
-    QString queryString;
-
-//    if ( database.isOpen() )
-//    {
-//        quint32 ulEventSequenceIndex =  pAccessLogEntry->getEventSequenceIndex();
-
-//        QDateTime dtAccessDateTime = QDateTime( pAccessLogEntry->getAccessDate(),
-//                                                pAccessLogEntry->getAccessTime(),
-//                                                Qt::LocalTime );
-
-//        queryString = QString( "UPDATE %1 SET ").arg(m_sTableName);
-
-//        queryString.append( QString("%1 = %2, ").arg(getColumnDef(e_ACCESS_LOG_TABLE_ACCESSS_EVENT_COL)->getColumnName()).arg(pAccessLogEntry->getAccessEvent()));
-//        queryString.append( QString("%1 = %2, ").arg(getColumnDef(e_ACCESS_LOG_TABLE_USER_NAME_COL)->getColumnName()).arg(SQL_FormatString(pAccessLogEntry->getUser())));
-//        queryString.append( QString("%1 = %2, ").arg(getColumnDef(e_ACCESS_LOG_TABLE_DATE_TIME_COL)->getColumnName()).arg(SQL_FormatQDateTime(dtAccessDateTime)));
-//        queryString.append( QString("%1 = %2, ").arg(getColumnDef(e_ACCESS_LOG_TABLE_ACCESS_METHOD_COL)->getColumnName()).arg(pAccessLogEntry->getAccessMethodEnum()));
-//        queryString.append( QString("%1 = %2, ").arg(getColumnDef(e_ACCESS_LOG_TABLE_ACCESS_DURATION_COL)->getColumnName()).arg(pAccessLogEntry->getIntDurationMinutes()));
-//        queryString.append( QString("%1 = %2, ").arg(getColumnDef(e_ACCESS_LOG_TABLE_VIEWED_COL)->getColumnName()).arg(SQL_FormatBoolean(pAccessLogEntry->getAccessEventViewed())));
-//        queryString.append( QString("%1 = %2 ").arg(getColumnDef(e_ACCESS_LOG_TABLE_DOWNLOADED_COL)->getColumnName()).arg(SQL_FormatBoolean(pAccessLogEntry->getAccessEventDownloaded())));
-
-//        queryString.append( QString("WHERE %1 = %2").arg(m_qlColumnDefinitions.at(e_ACCESS_LOG_TABLE_EVENT_SEQUENCE_INDEX_COL)->getColumnName()).arg(ulEventSequenceIndex));
-
-//        qDebug() << queryString;
-//        bRC = query.exec(queryString);
-
-//        if ( bRC == false )
-//        {
-//            QString sQueryError = query.lastError().text();
-//            SetLastError( QString("iC3_DatabaseAccessLogTable::updateAccessLogEntry() - Query Error: %1").arg(sQueryError));
-//            qDebug() << m_sLastError;
-//            return false;
-//        }
-//    }
-//    else
-//    {
-//         QString sErrorMessage = "iC3_DatabaseAccessLogTable::updateAccessLogEntry() - Database is not open";
-//         SetLastError( sErrorMessage );
-//         qDebug() << m_sLastError;
-//         return false;
-//    }
-
-    return bRC;
+    TRANSDUCER_TABLE_COLUMNS( IC3_SCHEMA_BIND, IC3_SCHEMA_BIND )
+}
+
+//-----------------------------------------------------------------------------------------------
+/** updateSampleFromQuery() - copies the current row of an IC3_SCHEMA_SELECT_SQL() select into
+*                             a sample
+*   @param row - the sample to fill in
+*   @param query - a query positioned on a valid row
+*   @retval none
+*   @date 10/19/2026
+*/
+//-----------------------------------------------------------------------------------------------
+void iC3_TransducerTable::updateSampleFromQuery( iC3_TransducerSample & row, QSqlQuery & query )
+{
+    TRANSDUCER_TABLE_COLUMNS( IC3_SCHEMA_READ, IC3_SCHEMA_READ )
 }
@@ -2,10 +2,35 @@
 #define IC3_TRANSDUCERTABLE_H
 
 #include <QFile>
+#include <QVector>
 #include "iC3_DatabaseTable.h"
-
-class iC3_DatabaseAccessLogData;
-class iC3_AccessLogData;
+#include "iC3_DatabaseSchema.h"
+#include "iC3_TransducerSample.h"
+
+#define TRANSDUCER_TABLE_NAME           "Transducers"
+
+// (deviceID, sampleTimeMS, sequenceIndex) covering index, see CreateTable()
+#define TRANSDUCER_TABLE_INDEX_NAME     TRANSDUCER_TABLE_NAME "_DeviceTime"
+
+// Transducers columns, see iC3_DatabaseSchema.h.  The key columns and the RTD columns are
+// listed separately so either group's names can be used on its own.
+// sequenceIndex - rowid alias, increases with every insert, breaks ties between equal sample times
+// sampleTimeMS - ms since the epoch (UTC), bound as an integer
+#define TRANSDUCER_KEY_COLUMNS( FIRST, NEXT ) \
+    FIRST( e_TRANSDUCER_TABLE_SEQUENCE_INDEX_COL,   sequenceIndex,      "INTEGER",  "PRIMARY KEY",          llSequenceIndex,    toLongLong ) \
+    NEXT(  e_TRANSDUCER_TABLE_DEVICE_ID_COL,        deviceID,           "INTEGER",  "NOT NULL DEFAULT 0",   iDeviceID,          toInt ) \
+    NEXT(  e_TRANSDUCER_TABLE_SAMPLE_TIME_COL,      sampleTimeMS,       "INTEGER",  "NOT NULL",             llSampleTimeMS,     toLongLong )
+
+#define TRANSDUCER_RTD_COLUMNS( FIRST, NEXT ) \
+    FIRST( e_TRANSDUCER_TABLE_RTD_1_TEMP_COL,       RTD1Temperature,    "REAL",     "",                     adRTDValues[0],     toDouble ) \
+    NEXT(  e_TRANSDUCER_TABLE_RTD_2_TEMP_COL,       RTD2Temperature,    "REAL",     "",                     adRTDValues[1],     toDouble ) \
+    NEXT(  e_TRANSDUCER_TABLE_RTD_3_TEMP_COL,       RTD3Temperature,    "REAL",     "",                     adRTDValues[2],     toDouble ) \
+    NEXT(  e_TRANSDUCER_TABLE_RTD_4_TEMP_COL,       RTD4Temperature,    "REAL",     "",                     adRTDValues[3],     toDouble ) \
+    NEXT(  e_TRANSDUCER_TABLE_RTD_5_TEMP_COL,       RTD5Temperature,    "REAL",     "",                     adRTDValues[4],     toDouble )
+
+#define TRANSDUCER_TABLE_COLUMNS( FIRST, NEXT ) \
+    TRANSDUCER_KEY_COLUMNS( FIRST, NEXT ) \
+    TRANSDUCER_RTD_COLUMNS( NEXT, NEXT )
 
 class iC3_TransducerTable : public iC3_DatabaseTable
 {
@@ -19,40 +44,74 @@ public:
                          double fRTD4Val,
                          double fRTD5Val );
 
-    bool getAccessLogEntry( QSqlDatabase & database,
-                            quint32 ulEventSequenceIndex,
-                            iC3_AccessLogData * pAccessLogEntry );
+    bool insertNewEntry( QSqlDatabase & database, const iC3_TransducerSample & sample );
+
+    bool insertReplayedEntry( QSqlDatabase & database, const iC3_TransducerSample & sample, bool & bInserted );
+
+    bool getEntriesInRange( QSqlDatabase & database,
+                            int iDeviceID,
+                            qint64 llStartTimeMS,
+                            qint64 llEndTimeMS,
+                            int iMaxEntries,
+                            QVector<iC3_TransducerSample> & samples );
+
+    bool getNextEntriesInRange( QSqlDatabase & database,
+                                const iC3_TransducerSample & lastSample,
+                                qint64 llEndTimeMS,
+                                int iMaxEntries,
+                                QVector<iC3_TransducerSample> & samples );
+
+    bool getLastEntries( QSqlDatabase & database,
+                         int iDeviceID,
+                         int iNumberOfEntries,
+                         QVector<iC3_TransducerSample> & samples );
+
+    bool deleteEntriesInRange( QSqlDatabase & database,
+                               int iDeviceID,
+                               qint64 llStartTimeMS,
+                               qint64 llEndTimeMS );
+
+    bool deleteEntriesBefore( QSqlDatabase & database, int iDeviceID, qint64 llBeforeTimeMS, int iMaxRows, int & iDeleted );
 
-    bool updateAccessLogEntry( QSqlDatabase & database,
-                               iC3_AccessLogData * pAccessLogEntry );
+    bool getNextDeviceID( QSqlDatabase & database, int iAfterDeviceID, int & iDeviceID, bool & bFound );
 
-    bool getLastMultAccessLogData( QSqlDatabase & database, unsigned int uiNumberOfEvents, iC3_DatabaseAccessLogData *pAccessLogData );
+    bool getLastSequenceIndex( QSqlDatabase & database, qint64 & llSequenceIndex );
 
 
     enum eIC3_TransducerTableColumns
     {
-        e_TRANSDUCER_TABLE_DATE_TIME_COL            = 0,
-        e_TRANSDUCER_TABLE_RTD_1_TEMP_COL           = 1,
-        e_TRANSDUCER_TABLE_RTD_2_TEMP_COL           = 2,
-        e_TRANSDUCER_TABLE_RTD_3_TEMP_COL           = 3,
-        e_TRANSDUCER_TABLE_RTD_4_TEMP_COL           = 4,
-        e_TRANSDUCER_TABLE_RTD_5_TEMP_COL           = 5,
+        TRANSDUCER_TABLE_COLUMNS( IC3_SCHEMA_ENUM, IC3_SCHEMA_ENUM )
 
         e_NUMBER_OF_TRANSDUCER_TABLE_COLUMNS
     };
 
+    // statements prepared once per connection through iC3_DatabaseTable::getPreparedQuery()
+    enum eIC3_TransducerTableStatements
+    {
+        e_TRANSDUCER_STMT_INSERT                    = 0,
+        e_TRANSDUCER_STMT_SELECT_RANGE              = 1,
+        e_TRANSDUCER_STMT_SELECT_LAST_N             = 2,
+        e_TRANSDUCER_STMT_DELETE_RANGE              = 3,
+        e_TRANSDUCER_STMT_NEXT_DEVICE               = 4,
+        e_TRANSDUCER_STMT_DELETE_BEFORE             = 5,
+        e_TRANSDUCER_STMT_LAST_SEQUENCE             = 6,
+        e_TRANSDUCER_STMT_INSERT_OR_IGNORE          = 7
+    };
+
     QString getTableCreationSQL( void );
 
     bool CreateTable( QSqlDatabase & database );
 
-    QString getSQL_ColumnNames( void );
-
-    QString getSQL_ColumnValues( iC3_AccessLogData *pAccessLogEntry );
-
-    bool updateAccessLogDataFromQuery( iC3_AccessLogData * pAccessLogEntry, QSqlQuery & query );
+    bool upgradeSchema( QSqlDatabase & database, int iFromVersion );
 
 private:
 
+    bool execSQL( QSqlDatabase & database, const QString & sSQL, const char * pFunctionName );
+    bool hasColumn( QSqlDatabase & database, const QString & sTableName, const QString & sColumnName );
+    bool selectEntries( QSqlQuery * pQuery, const char * pFunctionName, QVector<iC3_TransducerSample> & samples );
+    void bindSample( QSqlQuery * pQuery, const iC3_TransducerSample & row );
+    void updateSampleFromQuery( iC3_TransducerSample & row, QSqlQuery & query );
+
 };
 
 #endif // IC3_TRANSDUCERTABLE_H
@@ -9,9 +9,15 @@ QT       += widgets core gui network sql printsupport serialport
 TARGET = iC3SSLClient
 TEMPLATE = app
 
+# iC3_SequenceAllocator uses std::atomic for its 64 bit counters
+CONFIG += c++11
+
 INCLUDEPATH += ./qcustomplot \
                ./database \
 
+# database snapshots open their own connections with this library for the SQLite backup API
+LIBS += -lsqlite3
+
 SOURCES += main.cpp\
         client.cpp \
         QtJson.cpp \
@@ -21,7 +27,32 @@ SOURCES += main.cpp\
         ./database/iC3_DMM_UtilityFunctions.cpp \
         ./database/iC3_DatabaseColumnDef.cpp \
         ./database/iC3_TransducerTable.cpp \
-        SerialPortThread.cpp \
+        ./database/iC3_DatabaseRequest.cpp \
+        ./database/iC3_DatabaseRequestProcessor.cpp \
+        ./database/iC3_TransducerBlockCodec.cpp \
+        ./database/iC3_TransducerBlockTable.cpp \
+        ./database/iC3_TransducerRollupTable.cpp \
+        ./database/iC3_TransducerCSV_Exporter.cpp \
+        ./database/iC3_ExportMarkTable.cpp \
+        ./database/iC3_ExportFormatter.cpp \
+        ./database/iC3_DatabaseReadConnection.cpp \
+        ./database/iC3_DatabaseConnectionPool.cpp \
+        ./database/iC3_DatabaseSnapshot.cpp \
+        ./database/iC3_DatabaseMaintenance.cpp \
+        ./database/iC3_StatusJournalTable.cpp \
+        ./database/iC3_DeviceEventTable.cpp \
+        ./database/iC3_DeviceEventCountTable.cpp \
+        ./database/iC3_TransducerSegment.cpp \
+        ./database/iC3_TransducerSegmentWriter.cpp \
+        ./database/iC3_TransducerSegmentReader.cpp \
+        ./database/iC3_SequenceAllocator.cpp \
+        ./database/iC3_DatabaseShardCatalog.cpp \
+        ./database/iC3_TransducerSpillJournal.cpp \
+        SerialPortBroker.cpp \
+        SerialLatencyHistogram.cpp \
+        DoorControllerCodec.cpp \
+        DoorManager.cpp \
+        ScpiReplyDecoder.cpp \
         CalibrationManager.cpp \
         ErrorLogFile.cpp
 
@@ -32,9 +63,39 @@ HEADERS  += client.h \
             ./database/iC3_Database.h \
             ./database/iC3_DMM_UtilityFunctions.h \
             ./database/iC3_DatabaseColumnDef.h \
+            ./database/iC3_DatabaseSchema.h \
             ./database/iC3_DMM_Constants.h \
             ./database/iC3_TransducerTable.h \
-            SerialPortThread.h \
+            ./database/iC3_TransducerSample.h \
+            ./database/iC3_DatabaseRequest.h \
+            ./database/iC3_DatabaseRequestProcessor.h \
+            ./database/iC3_TransducerBlockCodec.h \
+            ./database/iC3_TransducerBlockTable.h \
+            ./database/iC3_TransducerRollup.h \
+            ./database/iC3_TransducerRollupTable.h \
+            ./database/iC3_TransducerCSV_Exporter.h \
+            ./database/iC3_ExportMarkTable.h \
+            ./database/iC3_ExportFormatter.h \
+            ./database/iC3_DatabaseReadConnection.h \
+            ./database/iC3_DatabaseConnectionPool.h \
+            ./database/iC3_DatabaseSnapshot.h \
+            ./database/iC3_DatabaseMaintenance.h \
+            ./database/iC3_StatusJournalTable.h \
+            ./database/iC3_DeviceStatus.h \
+            ./database/iC3_DeviceEvent.h \
+            ./database/iC3_DeviceEventTable.h \
+            ./database/iC3_DeviceEventCountTable.h \
+            ./database/iC3_TransducerSegment.h \
+            ./database/iC3_TransducerSegmentWriter.h \
+            ./database/iC3_TransducerSegmentReader.h \
+            ./database/iC3_SequenceAllocator.h \
+            ./database/iC3_DatabaseShardCatalog.h \
+            ./database/iC3_TransducerSpillJournal.h \
+            SerialPortBroker.h \
+            SerialLatencyHistogram.h \
+            DoorControllerCodec.h \
+            DoorManager.h \
+            ScpiReplyDecoder.h \
             CalibrationManager.h \
             ErrorLogFile.h
 
@@ -0,0 +1,135 @@
+#include "DoorControllerSimulator.h"
+#include "PtyDevice.h"
+
+#include <QTimer>
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+DoorControllerSimulatorConfig::DoorControllerSimulatorConfig() :
+    iLatencyMS( 15 ),
+    iJitterMS( 5 ),
+    iDropPercent( 0 ),
+    iCorruptPercent( 0 )
+{
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+DoorControllerSimulator::DoorControllerSimulator( PtyDevice * pPty, const DoorControllerSimulatorConfig & config,
+                                                  QObject *parent ) :
+    QObject( parent ),
+    m_pPty( pPty ),
+    m_Config( config ),
+    m_bDoorLocked( true ),
+    m_bLightOn( false ),
+    m_ulCommandCount( 0 )
+{
+    connect( m_pPty, SIGNAL(signalDataReceived(QByteArray)), this, SLOT(handleData(QByteArray)) );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+bool DoorControllerSimulator::isDoorLocked( void ) const
+{
+    return m_bDoorLocked;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+bool DoorControllerSimulator::isLightOn( void ) const
+{
+    return m_bLightOn;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+quint32 DoorControllerSimulator::getCommandCount( void ) const
+{
+    return m_ulCommandCount;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void DoorControllerSimulator::handleData( QByteArray baData )
+{
+    m_baRxBuffer.append( baData );
+
+    forever
+    {
+        int iFrameLength = m_Codec.extractFrame( m_baRxBuffer );
+
+        if ( iFrameLength == 0 )
+        {
+            break;
+        }
+
+        if ( iFrameLength < 0 )
+        {
+            m_baRxBuffer.remove( 0, -iFrameLength );
+            continue;
+        }
+
+        processFrame( m_baRxBuffer.left( iFrameLength ) );
+        m_baRxBuffer.remove( 0, iFrameLength );
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void DoorControllerSimulator::processFrame( const QByteArray & baFrame )
+{
+    DoorControllerFrame frame;
+
+    if ( !DoorControllerCodec::decodeFrame( baFrame, frame ) || ( frame.ucFunction != DOOR_FUNCTION_COMMAND ) )
+    {
+        return;
+    }
+
+    eDoorControllerCommands eCommand = DoorControllerCodec::commandForFrame( frame );
+    if ( eCommand == eDOOR_CMD_UNKNOWN )
+    {
+        return;
+    }
+
+    m_ulCommandCount++;
+
+    if ( ( m_Config.iDropPercent > 0 ) && ( ( qrand() % 100 ) < m_Config.iDropPercent ) )
+    {
+        return;
+    }
+
+    if ( frame.ucAddress == DOOR_ADDRESS_DOOR )
+    {
+        m_bDoorLocked = ( frame.ucState != 0 );
+    }
+    else
+    {
+        m_bLightOn = ( frame.ucState != 0 );
+    }
+
+    QByteArray baAck = DoorControllerCodec::encodeFrame( frame.ucAddress, DOOR_FUNCTION_ACK, frame.ucState );
+
+    if ( ( m_Config.iCorruptPercent > 0 ) && ( ( qrand() % 100 ) < m_Config.iCorruptPercent ) )
+    {
+        baAck[7] = (char) ( baAck[7] ^ 0x5A );
+    }
+
+    int iDelayMS = m_Config.iLatencyMS;
+    if ( m_Config.iJitterMS > 0 )
+    {
+        iDelayMS += ( qrand() % ( 2 * m_Config.iJitterMS + 1 ) ) - m_Config.iJitterMS;
+    }
+
+    m_PendingReplies.enqueue( baAck );
+    QTimer::singleShot( qMax( 0, iDelayMS ), this, SLOT(sendNextReply()) );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void DoorControllerSimulator::sendNextReply( void )
+{
+    if ( !m_PendingReplies.isEmpty() )
+    {
+        m_pPty->write( m_PendingReplies.dequeue() );
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef DOORCONTROLLERSIMULATOR_H
+#define DOORCONTROLLERSIMULATOR_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QQueue>
+
+#include "DoorControllerCodec.h"
+
+class PtyDevice;
+
+struct DoorControllerSimulatorConfig
+{
+    DoorControllerSimulatorConfig();
+
+    int iLatencyMS;
+    int iJitterMS;
+    int iDropPercent;       // commands silently ignored, to exercise timeouts and retries
+    int iCorruptPercent;    // ACKs sent with a bad checksum
+};
+
+//-----------------------------------------------------------------------------------------------------------------
+// DoorControllerSimulator - acknowledges lock/unlock/light frames the way the controller does and keeps track
+// of the resulting door and light state.
+//-----------------------------------------------------------------------------------------------------------------
+class DoorControllerSimulator : public QObject
+{
+    Q_OBJECT
+
+public:
+    DoorControllerSimulator( PtyDevice * pPty, const DoorControllerSimulatorConfig & config, QObject *parent = 0 );
+
+    bool    isDoorLocked( void ) const;
+    bool    isLightOn( void ) const;
+    quint32 getCommandCount( void ) const;
+
+private slots:
+    void handleData( QByteArray baData );
+    void sendNextReply( void );
+
+private:
+    void processFrame( const QByteArray & baFrame );
+
+    PtyDevice *                   m_pPty;
+    DoorControllerSimulatorConfig m_Config;
+    DoorControllerCodec           m_Codec;
+    QByteArray                    m_baRxBuffer;
+    QQueue<QByteArray>            m_PendingReplies;
+    bool                          m_bDoorLocked;
+    bool                          m_bLightOn;
+    quint32                       m_ulCommandCount;
+};
+
+#endif // DOORCONTROLLERSIMULATOR_H
@@ -0,0 +1,294 @@
+#include "FlukeSimulator.h"
+#include "PtyDevice.h"
+
+#include <QTimer>
+#include <QDebug>
+#include <math.h>
+
+static const int FLUKE_SIM_MAX_ERRORS = 10;
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+FlukeSimulatorConfig::FlukeSimulatorConfig() :
+    dBaseTemperature( 5.0 ),
+    dNoiseStdDev( 0.02 ),
+    iLatencyMS( 20 ),
+    iJitterMS( 5 ),
+    iOpenChannel( 0 )
+{
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+FlukeSimulator::FlukeSimulator( PtyDevice * pPty, const FlukeSimulatorConfig & config, QObject *parent ) :
+    QObject( parent ),
+    m_pPty( pPty ),
+    m_Config( config ),
+    m_bTriggerBus( false ),
+    m_bArmed( false ),
+    m_ulCommandCount( 0 )
+{
+    m_ScanList.append( FLUKE_SIM_FIRST_CHANNEL );
+
+    connect( m_pPty, SIGNAL(signalDataReceived(QByteArray)), this, SLOT(handleData(QByteArray)) );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+quint32 FlukeSimulator::getCommandCount( void ) const
+{
+    return m_ulCommandCount;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void FlukeSimulator::handleData( QByteArray baData )
+{
+    m_baRxBuffer.append( baData );
+
+    int iIndex;
+    while ( ( iIndex = m_baRxBuffer.indexOf( '\n' ) ) >= 0 )
+    {
+        QByteArray baLine = m_baRxBuffer.left( iIndex ).trimmed();
+        m_baRxBuffer.remove( 0, iIndex + 1 );
+
+        // several commands may share a line, separated by ';'
+        QList<QByteArray> commands = baLine.split( ';' );
+        foreach ( const QByteArray & baCommand, commands )
+        {
+            if ( !baCommand.trimmed().isEmpty() )
+            {
+                processCommand( baCommand.trimmed().toUpper() );
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void FlukeSimulator::processCommand( QByteArray baCommand )
+{
+    QList<int> channels;
+
+    m_ulCommandCount++;
+
+    if ( baCommand == "*IDN?" )
+    {
+        queueReply( "FLUKE,1586A,SIM00001,1.00" );
+    }
+    else if ( baCommand == "*RST" )
+    {
+        m_ScanList.clear();
+        m_ScanList.append( FLUKE_SIM_FIRST_CHANNEL );
+        m_bTriggerBus = false;
+        m_bArmed = false;
+        m_baLastReadings.clear();
+    }
+    else if ( baCommand == "*CLS" )
+    {
+        m_ErrorQueue.clear();
+    }
+    else if ( baCommand.startsWith( "SYST:ERR?" ) || baCommand.startsWith( "SYSTEM:ERROR?" ) )
+    {
+        queueReply( m_ErrorQueue.isEmpty() ? QByteArray("+0,\"No error\"") : m_ErrorQueue.dequeue() );
+    }
+    else if ( baCommand.startsWith( "MEAS:TEMP?" ) || baCommand.startsWith( "MEASURE:TEMPERATURE?" ) )
+    {
+        if ( parseChannelList( baCommand, channels ) )
+        {
+            queueReply( takeReadings( channels ) );
+        }
+    }
+    else if ( baCommand.startsWith( "CONF:TEMP" ) || baCommand.startsWith( "ROUT:SCAN" ) )
+    {
+        if ( parseChannelList( baCommand, channels ) )
+        {
+            m_ScanList = channels;
+        }
+    }
+    else if ( baCommand.startsWith( "TRIG:SOUR" ) )
+    {
+        if ( baCommand.endsWith( "BUS" ) )
+        {
+            m_bTriggerBus = true;
+        }
+        else if ( baCommand.endsWith( "IMM" ) || baCommand.endsWith( "IMMEDIATE" ) )
+        {
+            m_bTriggerBus = false;
+        }
+        else
+        {
+            pushError( -224, "Illegal parameter value" );
+        }
+    }
+    else if ( baCommand == "INIT" )
+    {
+        m_bArmed = true;
+        m_baLastReadings.clear();
+
+        if ( !m_bTriggerBus )
+        {
+            m_baLastReadings = takeReadings( m_ScanList );
+            m_bArmed = false;
+        }
+    }
+    else if ( baCommand == "*TRG" )
+    {
+        if ( m_bArmed && m_bTriggerBus )
+        {
+            m_baLastReadings = takeReadings( m_ScanList );
+            m_bArmed = false;
+        }
+        else
+        {
+            pushError( -211, "Trigger ignored" );
+        }
+    }
+    else if ( baCommand == "FETC?" )
+    {
+        if ( m_baLastReadings.isEmpty() )
+        {
+            pushError( -230, "Data corrupt or stale" );
+        }
+        else
+        {
+            queueReply( m_baLastReadings );
+        }
+    }
+    else if ( baCommand == "READ?" )
+    {
+        queueReply( takeReadings( m_ScanList ) );
+    }
+    else
+    {
+        pushError( -113, "Undefined header" );
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// Accepts (@101), (@101,102,105) and (@101:104).
+//-----------------------------------------------------------------------------------------------------------------
+bool FlukeSimulator::parseChannelList( const QByteArray & baCommand, QList<int> & channels )
+{
+    int iStart = baCommand.indexOf( "(@" );
+    int iEnd = baCommand.indexOf( ')', iStart );
+
+    channels.clear();
+
+    if ( ( iStart < 0 ) || ( iEnd < 0 ) )
+    {
+        pushError( -109, "Missing parameter" );
+        return false;
+    }
+
+    QList<QByteArray> items = baCommand.mid( iStart + 2, iEnd - iStart - 2 ).split( ',' );
+    foreach ( const QByteArray & baItem, items )
+    {
+        QList<QByteArray> range = baItem.split( ':' );
+        bool bFirstOK, bLastOK;
+        int iFirst = range.first().trimmed().toInt( &bFirstOK );
+        int iLast = range.last().trimmed().toInt( &bLastOK );
+
+        if ( !bFirstOK || !bLastOK || ( iFirst > iLast ) ||
+             ( iFirst < FLUKE_SIM_FIRST_CHANNEL ) || ( iLast > FLUKE_SIM_LAST_CHANNEL ) )
+        {
+            pushError( -222, "Data out of range" );
+            channels.clear();
+            return false;
+        }
+
+        for ( int iChannel = iFirst; iChannel <= iLast; iChannel++ )
+        {
+            channels.append( iChannel );
+        }
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+QByteArray FlukeSimulator::takeReadings( const QList<int> & channels )
+{
+    QByteArray baReadings;
+
+    foreach ( int iChannel, channels )
+    {
+        if ( !baReadings.isEmpty() )
+        {
+            baReadings.append( ',' );
+        }
+
+        double dValue = readChannel( iChannel );
+        if ( dValue >= 0.0 )
+        {
+            baReadings.append( '+' );
+        }
+        baReadings.append( QByteArray::number( dValue, 'E', 8 ) );
+    }
+
+    return baReadings;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+double FlukeSimulator::readChannel( int iChannel )
+{
+    if ( iChannel == m_Config.iOpenChannel )
+    {
+        return 9.91E37;
+    }
+
+    return m_Config.dBaseTemperature + 0.5 * ( iChannel - FLUKE_SIM_FIRST_CHANNEL ) +
+           m_Config.dNoiseStdDev * gaussianNoise();
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// Box-Muller
+//-----------------------------------------------------------------------------------------------------------------
+double FlukeSimulator::gaussianNoise( void )
+{
+    double dU1 = ( qrand() + 1.0 ) / ( RAND_MAX + 2.0 );
+    double dU2 = ( qrand() + 1.0 ) / ( RAND_MAX + 2.0 );
+
+    return sqrt( -2.0 * log( dU1 ) ) * cos( 2.0 * M_PI * dU2 );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void FlukeSimulator::pushError( int iCode, const char * pMessage )
+{
+    if ( m_ErrorQueue.size() >= FLUKE_SIM_MAX_ERRORS )
+    {
+        m_ErrorQueue.last() = QByteArray("-350,\"Queue overflow\"");
+        return;
+    }
+
+    m_ErrorQueue.enqueue( QString("%1,\"%2\"").arg( iCode ).arg( pMessage ).toLatin1() );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void FlukeSimulator::queueReply( const QByteArray & baReply )
+{
+    int iDelayMS = m_Config.iLatencyMS;
+
+    if ( m_Config.iJitterMS > 0 )
+    {
+        iDelayMS += ( qrand() % ( 2 * m_Config.iJitterMS + 1 ) ) - m_Config.iJitterMS;
+    }
+
+    m_PendingReplies.enqueue( baReply + "\r\n" );
+    QTimer::singleShot( qMax( 0, iDelayMS ), this, SLOT(sendNextReply()) );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// Replies always go out in command order, whichever timer fires first.
+//-----------------------------------------------------------------------------------------------------------------
+void FlukeSimulator::sendNextReply( void )
+{
+    if ( !m_PendingReplies.isEmpty() )
+    {
+        m_pPty->write( m_PendingReplies.dequeue() );
+    }
+}
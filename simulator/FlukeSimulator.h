@@ -0,0 +1,67 @@
+#ifndef FLUKESIMULATOR_H
+#define FLUKESIMULATOR_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QList>
+#include <QQueue>
+
+class PtyDevice;
+
+static const int FLUKE_SIM_FIRST_CHANNEL = 101;
+static const int FLUKE_SIM_LAST_CHANNEL  = 120;
+
+struct FlukeSimulatorConfig
+{
+    FlukeSimulatorConfig();
+
+    double dBaseTemperature;    // channel 101, each following channel reads 0.5 C warmer
+    double dNoiseStdDev;        // gaussian noise added to each reading
+    int    iLatencyMS;          // time from command terminator to reply
+    int    iJitterMS;           // +/- uniformly distributed on top of iLatencyMS
+    int    iOpenChannel;        // this channel reports an open thermocouple (9.91E37), 0 = none
+};
+
+//-----------------------------------------------------------------------------------------------------------------
+// FlukeSimulator - answers the subset of SCPI the client uses, in three modes:
+//   single  : MEAS:TEMP? TC,T,(@101,102)
+//   scan    : CONF:TEMP TC,T,(@101:104) or ROUT:SCAN (@...) followed by READ?
+//   trigger : TRIG:SOUR BUS, INIT, *TRG then FETC?
+// plus *IDN?, *RST, *CLS and an SYST:ERR? queue fed by anything it does not understand.
+//-----------------------------------------------------------------------------------------------------------------
+class FlukeSimulator : public QObject
+{
+    Q_OBJECT
+
+public:
+    FlukeSimulator( PtyDevice * pPty, const FlukeSimulatorConfig & config, QObject *parent = 0 );
+
+    quint32 getCommandCount( void ) const;
+
+private slots:
+    void handleData( QByteArray baData );
+    void sendNextReply( void );
+
+private:
+    void processCommand( QByteArray baCommand );
+    void queueReply( const QByteArray & baReply );
+    void pushError( int iCode, const char * pMessage );
+    bool parseChannelList( const QByteArray & baCommand, QList<int> & channels );
+    QByteArray takeReadings( const QList<int> & channels );
+    double readChannel( int iChannel );
+    double gaussianNoise( void );
+
+    PtyDevice *          m_pPty;
+    FlukeSimulatorConfig m_Config;
+    QByteArray           m_baRxBuffer;
+    QQueue<QByteArray>   m_PendingReplies;
+    QQueue<QByteArray>   m_ErrorQueue;
+
+    QList<int>           m_ScanList;
+    bool                 m_bTriggerBus;
+    bool                 m_bArmed;
+    QByteArray           m_baLastReadings;
+    quint32              m_ulCommandCount;
+};
+
+#endif // FLUKESIMULATOR_H
@@ -0,0 +1,182 @@
+#include "PtyDevice.h"
+
+#include <QSocketNotifier>
+#include <QFile>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+PtyDevice::PtyDevice( QObject *parent ) :
+    QObject( parent ),
+    m_iMasterFD( -1 ),
+    m_iSlaveFD( -1 ),
+    m_pNotifier( NULL )
+{
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+PtyDevice::~PtyDevice()
+{
+    close();
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+bool PtyDevice::open( const QString & sLinkPath )
+{
+    m_iMasterFD = posix_openpt( O_RDWR | O_NOCTTY );
+    if ( m_iMasterFD < 0 )
+    {
+        m_sLastError = QString("posix_openpt failed: %1").arg( strerror( errno ) );
+        return false;
+    }
+
+    if ( ( grantpt( m_iMasterFD ) != 0 ) || ( unlockpt( m_iMasterFD ) != 0 ) )
+    {
+        m_sLastError = QString("grantpt/unlockpt failed: %1").arg( strerror( errno ) );
+        close();
+        return false;
+    }
+
+    m_sSlavePath = QString::fromLocal8Bit( ptsname( m_iMasterFD ) );
+
+    // Hold the slave open ourselves: with no slave open, reads on the master fail with EIO and the notifier
+    // would spin whenever the application under test closes its port.
+    m_iSlaveFD = ::open( m_sSlavePath.toLocal8Bit().constData(), O_RDWR | O_NOCTTY );
+    if ( m_iSlaveFD < 0 )
+    {
+        m_sLastError = QString("Can't open %1: %2").arg( m_sSlavePath ).arg( strerror( errno ) );
+        close();
+        return false;
+    }
+
+    // raw mode - no echo, no line editing, no CR/LF translation
+    struct termios tio;
+    tcgetattr( m_iSlaveFD, &tio );
+    cfmakeraw( &tio );
+    tcsetattr( m_iSlaveFD, TCSANOW, &tio );
+
+    fcntl( m_iMasterFD, F_SETFL, fcntl( m_iMasterFD, F_GETFL ) | O_NONBLOCK );
+
+    if ( !sLinkPath.isEmpty() )
+    {
+        QFile::remove( sLinkPath );
+        if ( !QFile::link( m_sSlavePath, sLinkPath ) )
+        {
+            m_sLastError = QString("Can't create link %1 -> %2").arg( sLinkPath ).arg( m_sSlavePath );
+            close();
+            return false;
+        }
+        m_sLinkPath = sLinkPath;
+    }
+
+    m_pNotifier = new QSocketNotifier( m_iMasterFD, QSocketNotifier::Read, this );
+    connect( m_pNotifier, SIGNAL(activated(int)), this, SLOT(handleActivated(int)) );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void PtyDevice::close( void )
+{
+    if ( m_pNotifier != NULL )
+    {
+        m_pNotifier->setEnabled( false );
+        delete m_pNotifier;
+        m_pNotifier = NULL;
+    }
+
+    if ( !m_sLinkPath.isEmpty() )
+    {
+        QFile::remove( m_sLinkPath );
+        m_sLinkPath.clear();
+    }
+
+    if ( m_iSlaveFD >= 0 )
+    {
+        ::close( m_iSlaveFD );
+        m_iSlaveFD = -1;
+    }
+
+    if ( m_iMasterFD >= 0 )
+    {
+        ::close( m_iMasterFD );
+        m_iMasterFD = -1;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+qint64 PtyDevice::write( const QByteArray & baData )
+{
+    if ( m_iMasterFD < 0 )
+    {
+        return -1;
+    }
+
+    const char * pData = baData.constData();
+    qint64 llRemaining = baData.size();
+
+    while ( llRemaining > 0 )
+    {
+        ssize_t iWritten = ::write( m_iMasterFD, pData, llRemaining );
+        if ( iWritten < 0 )
+        {
+            if ( ( errno == EINTR ) || ( errno == EAGAIN ) )
+            {
+                continue;
+            }
+            m_sLastError = QString("Write to %1 failed: %2").arg( m_sSlavePath ).arg( strerror( errno ) );
+            return -1;
+        }
+        pData += iWritten;
+        llRemaining -= iWritten;
+    }
+
+    return baData.size();
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void PtyDevice::handleActivated( int iSocket )
+{
+    char buffer[512];
+    QByteArray baData;
+
+    forever
+    {
+        ssize_t iRead = ::read( iSocket, buffer, sizeof(buffer) );
+        if ( iRead <= 0 )
+        {
+            break;
+        }
+        baData.append( buffer, (int) iRead );
+    }
+
+    if ( !baData.isEmpty() )
+    {
+        emit signalDataReceived( baData );
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+QString PtyDevice::getSlavePath( void ) const
+{
+    return m_sSlavePath;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+QString PtyDevice::getLastError( void ) const
+{
+    return m_sLastError;
+}
@@ -0,0 +1,44 @@
+#ifndef PTYDEVICE_H
+#define PTYDEVICE_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QString>
+
+class QSocketNotifier;
+
+//-----------------------------------------------------------------------------------------------------------------
+// PtyDevice - the master side of a Linux pseudo-terminal.  The application under test opens the slave side
+// (getSlavePath(), or the optional symlink) as if it were a serial port.
+//-----------------------------------------------------------------------------------------------------------------
+class PtyDevice : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit PtyDevice( QObject *parent = 0 );
+    ~PtyDevice();
+
+    bool open( const QString & sLinkPath = QString() );
+    void close( void );
+    qint64 write( const QByteArray & baData );
+
+    QString getSlavePath( void ) const;
+    QString getLastError( void ) const;
+
+signals:
+    void signalDataReceived( QByteArray baData );
+
+private slots:
+    void handleActivated( int iSocket );
+
+private:
+    int               m_iMasterFD;
+    int               m_iSlaveFD;
+    QSocketNotifier * m_pNotifier;
+    QString           m_sSlavePath;
+    QString           m_sLinkPath;
+    QString           m_sLastError;
+};
+
+#endif // PTYDEVICE_H
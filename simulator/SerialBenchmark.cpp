@@ -0,0 +1,524 @@
+#include "SerialBenchmark.h"
+#include "ScpiReplyDecoder.h"
+
+#include <stdio.h>
+
+static const char BENCHMARK_FLUKE_COMMAND[] = "MEAS:TEMP? TC,T,(@101)\r\n";
+
+// how far the unit's own probes read from the reference before calibration
+static const double BENCHMARK_PRIMARY_PROBE_ERROR = -0.6;
+static const double BENCHMARK_CONTROL_PROBE_ERROR = 0.8;
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+SerialBenchmarkConfig::SerialBenchmarkConfig() :
+    iRequestsPerDevice( 1000 ),
+    iPipelineDepth( 4 ),
+    iStartupTimeoutMS( 10000 )
+{
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+BenchmarkCalibrationSource::BenchmarkCalibrationSource() :
+    m_dFlukeTemperature( 0.0 ),
+    m_dPrimaryOffset( 0.0 ),
+    m_dControlOffset( 0.0 ),
+    m_bCompressorState( false ),
+    m_iCalibrationRequests( 0 )
+{
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void BenchmarkCalibrationSource::setFlukeTemperature( double dTemperature )
+{
+    m_dFlukeTemperature = dTemperature;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void BenchmarkCalibrationSource::setCompressorState( bool bRunning )
+{
+    m_bCompressorState = bRunning;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+int BenchmarkCalibrationSource::getCalibrationRequestCount( void ) const
+{
+    return m_iCalibrationRequests;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// The unit applies the offset to the probe at once.
+//-----------------------------------------------------------------------------------------------------------------
+void BenchmarkCalibrationSource::sendCalibrationRequest( eRTDNumber eRTDNum, double dRTDOffsetVal )
+{
+    if ( eRTDNum == eRTD4 )
+    {
+        m_dControlOffset = dRTDOffsetVal;
+    }
+    else if ( eRTDNum == eRTD5 )
+    {
+        m_dPrimaryOffset = dRTDOffsetVal;
+    }
+
+    m_iCalibrationRequests++;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+double BenchmarkCalibrationSource::getFlukeTemp1()
+{
+    return m_dFlukeTemperature;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+double BenchmarkCalibrationSource::getPrimaryTemp()
+{
+    return m_dFlukeTemperature + BENCHMARK_PRIMARY_PROBE_ERROR + m_dPrimaryOffset;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+double BenchmarkCalibrationSource::getControlTemp()
+{
+    return m_dFlukeTemperature + BENCHMARK_CONTROL_PROBE_ERROR + m_dControlOffset;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+double BenchmarkCalibrationSource::getPrimaryOffset()
+{
+    return m_dPrimaryOffset;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+double BenchmarkCalibrationSource::getControlOffset()
+{
+    return m_dControlOffset;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+bool BenchmarkCalibrationSource::getCompressorState()
+{
+    return m_bCompressorState;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+QString BenchmarkCalibrationSource::getDeviceType()
+{
+    return QString("Refrigerator");
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+SerialBenchmark::DeviceStats::DeviceStats() :
+    iSent( 0 ),
+    iCompleted( 0 ),
+    iTimeouts( 0 ),
+    iErrors( 0 ),
+    iBadReplies( 0 ),
+    llTotalLatencyUS( 0 ),
+    llMaxLatencyUS( 0 )
+{
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+SerialBenchmark::SerialBenchmark( const QString & sFlukePort, const QString & sDoorPort,
+                                  const SerialBenchmarkConfig & config, QObject *parent ) :
+    QObject( parent ),
+    m_DoorManager( &m_Broker, this ),
+    m_Config( config ),
+    m_bFlukeConnected( false ),
+    m_eDoorCommand( eDOOR_CMD_UNKNOWN ),
+    m_llDoorCommandStartNS( 0 ),
+    m_pCalibrationManager( NULL ),
+    m_iCalibrationSteps( 0 ),
+    m_llCalibrationTotalNS( 0 ),
+    m_llCalibrationMaxNS( 0 ),
+    m_llRunStartNS( 0 ),
+    m_bRunning( false ),
+    m_iExitCode( 0 )
+{
+    // same descriptor as Client; DoorManager registers its own
+    SerialDeviceDescriptor flukeDescriptor;
+    flukeDescriptor.sDeviceName        = "Fluke";
+    flukeDescriptor.sPreferredPortName = sFlukePort;
+    flukeDescriptor.iBaudRate          = QSerialPort::Baud19200;
+    flukeDescriptor.baProbeRequest     = "*IDN?\r\n";
+    flukeDescriptor.baProbeSignature   = "FLUKE";
+    flukeDescriptor.pFrameExtractor    = QSharedPointer<SerialFrameExtractor>( new SerialLineFrameExtractor('\n') );
+
+    m_iFlukeDevice = m_Broker.registerDevice( flukeDescriptor );
+    m_DoorManager.setSerialPortName( sDoorPort );
+
+    m_FlukeStats.sName = flukeDescriptor.sDeviceName;
+    m_DoorStats.sName = "Door Controller";
+
+    connect( &m_Broker, SIGNAL(signalDeviceConnected(int,QString)), this, SLOT(handleDeviceConnected(int,QString)) );
+    connect( &m_Broker, SIGNAL(signalResponse(int,uint,QByteArray)), this, SLOT(handleResponse(int,uint,QByteArray)) );
+    connect( &m_Broker, SIGNAL(signalTimeout(int,uint,QString)), this, SLOT(handleTimeout(int,uint,QString)) );
+    connect( &m_Broker, SIGNAL(signalError(int,uint,QString)), this, SLOT(handleError(int,uint,QString)) );
+
+    connect( &m_DoorManager, SIGNAL(signalDoorUnlocked()), this, SLOT(handleDoorUnlocked()) );
+    connect( &m_DoorManager, SIGNAL(signalDoorLocked()), this, SLOT(handleDoorLocked()) );
+    connect( &m_DoorManager, SIGNAL(signalLightOff()), this, SLOT(handleLightOff()) );
+    connect( &m_DoorManager, SIGNAL(signalLightOn()), this, SLOT(handleLightOn()) );
+    connect( &m_DoorManager, SIGNAL(signalCommError(QString)), this, SLOT(handleDoorCommError(QString)) );
+
+    // its own timers are minutes apart; the benchmark steps it from the Fluke readings instead
+    m_pCalibrationManager = new CalibrationManager( &m_CalibrationSource, this );
+
+    m_StartupTimer.setSingleShot( true );
+    connect( &m_StartupTimer, SIGNAL(timeout()), this, SLOT(handleStartupTimeout()) );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialBenchmark::start( void )
+{
+    m_Clock.start();
+    m_StartupTimer.start( m_Config.iStartupTimeoutMS );
+    m_Broker.discoverDevices();
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+int SerialBenchmark::getExitCode( void ) const
+{
+    return m_iExitCode;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialBenchmark::handleStartupTimeout( void )
+{
+    fprintf( stderr, "Devices were not found within %d ms\n", m_Config.iStartupTimeoutMS );
+    m_iExitCode = 2;
+    emit signalFinished( m_iExitCode );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// DoorManager sees its device connect before this slot runs - it connected to the broker first.
+//-----------------------------------------------------------------------------------------------------------------
+void SerialBenchmark::handleDeviceConnected( int iDevice, QString sPortName )
+{
+    if ( m_bRunning )
+    {
+        return;
+    }
+
+    if ( iDevice == m_iFlukeDevice )
+    {
+        m_bFlukeConnected = true;
+        printf( "%s connected on %s\n", qPrintable( m_FlukeStats.sName ), qPrintable( sPortName ) );
+    }
+    else if ( m_DoorManager.isSerialPortFound() )
+    {
+        printf( "%s connected on %s\n", qPrintable( m_DoorStats.sName ), qPrintable( sPortName ) );
+    }
+
+    if ( !m_bFlukeConnected || !m_DoorManager.isSerialPortFound() )
+    {
+        return;
+    }
+
+    m_StartupTimer.stop();
+    m_bRunning = true;
+    m_llRunStartNS = m_Clock.nsecsElapsed();
+
+    for ( int iIndex = 0; iIndex < m_Config.iPipelineDepth; iIndex++ )
+    {
+        sendNextFluke();
+    }
+
+    sendNextDoorCommand();
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialBenchmark::sendNextFluke( void )
+{
+    if ( m_FlukeStats.iSent >= m_Config.iRequestsPerDevice )
+    {
+        return;
+    }
+
+    qint64 llStartNS = m_Clock.nsecsElapsed();
+    uint uiRequestID = m_Broker.submitRequest( m_iFlukeDevice, QByteArray( BENCHMARK_FLUKE_COMMAND ) );
+
+    m_FlukeRequestStartNS.insert( uiRequestID, llStartNS );
+    m_FlukeStats.iSent++;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// DoorManager keeps one command of each type outstanding and reports a failure without saying which, so the
+// commands go one at a time; each is timed from the call until DoorManager reports it acknowledged, retries
+// included.
+//-----------------------------------------------------------------------------------------------------------------
+void SerialBenchmark::sendNextDoorCommand( void )
+{
+    if ( m_DoorStats.iSent >= m_Config.iRequestsPerDevice )
+    {
+        return;
+    }
+
+    m_eDoorCommand = (eDoorControllerCommands) ( m_DoorStats.iSent % eDOOR_CMD_COUNT );
+    m_llDoorCommandStartNS = m_Clock.nsecsElapsed();
+    m_DoorStats.iSent++;
+
+    switch ( m_eDoorCommand )
+    {
+    case eDOOR_CMD_UNLOCK:
+        m_DoorManager.unlockDoor();
+        break;
+    case eDOOR_CMD_LOCK:
+        m_DoorManager.lockDoor();
+        break;
+    case eDOOR_CMD_LIGHT_OFF:
+        m_DoorManager.turnLightOff();
+        break;
+    case eDOOR_CMD_LIGHT_ON:
+    default:
+        m_DoorManager.turnLightOn();
+        break;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialBenchmark::recordLatency( DeviceStats & stats, qint64 llStartNS )
+{
+    qint64 llLatencyUS = ( m_Clock.nsecsElapsed() - llStartNS ) / 1000;
+
+    stats.iCompleted++;
+    stats.llTotalLatencyUS += llLatencyUS;
+    stats.llMaxLatencyUS = qMax( stats.llMaxLatencyUS, llLatencyUS );
+    stats.latency.addSample( llLatencyUS / 1000 );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialBenchmark::handleResponse( int iDevice, uint uiRequestID, QByteArray baResponse )
+{
+    if ( !m_bRunning || ( iDevice != m_iFlukeDevice ) || !m_FlukeRequestStartNS.contains( uiRequestID ) )
+    {
+        return;
+    }
+
+    ScpiNumericList readings;
+
+    if ( ScpiReplyDecoder::decodeNumericList( baResponse.constData(), baResponse.size(), readings ) &&
+         ( readings.iCount > 0 ) )
+    {
+        recordLatency( m_FlukeStats, m_FlukeRequestStartNS.value( uiRequestID ) );
+
+        if ( readings.aeStatus[0] == eSCPI_VALUE_OK )
+        {
+            runCalibrationStep( readings.adValues[0] );
+        }
+    }
+    else
+    {
+        m_FlukeStats.iBadReplies++;
+    }
+
+    m_FlukeRequestStartNS.remove( uiRequestID );
+    sendNextFluke();
+    checkFinished();
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialBenchmark::handleTimeout( int iDevice, uint uiRequestID, QString sMessage )
+{
+    Q_UNUSED(sMessage);
+
+    if ( !m_bRunning || ( iDevice != m_iFlukeDevice ) || !m_FlukeRequestStartNS.contains( uiRequestID ) )
+    {
+        return;
+    }
+
+    m_FlukeStats.iTimeouts++;
+    m_FlukeRequestStartNS.remove( uiRequestID );
+    sendNextFluke();
+    checkFinished();
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialBenchmark::handleError( int iDevice, uint uiRequestID, QString sError )
+{
+    Q_UNUSED(sError);
+
+    if ( !m_bRunning || ( iDevice != m_iFlukeDevice ) || !m_FlukeRequestStartNS.contains( uiRequestID ) )
+    {
+        return;
+    }
+
+    m_FlukeStats.iErrors++;
+    m_FlukeRequestStartNS.remove( uiRequestID );
+    sendNextFluke();
+    checkFinished();
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialBenchmark::handleDoorUnlocked( void )
+{
+    finishDoorCommand( eDOOR_CMD_UNLOCK, true );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialBenchmark::handleDoorLocked( void )
+{
+    finishDoorCommand( eDOOR_CMD_LOCK, true );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialBenchmark::handleLightOff( void )
+{
+    finishDoorCommand( eDOOR_CMD_LIGHT_OFF, true );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialBenchmark::handleLightOn( void )
+{
+    finishDoorCommand( eDOOR_CMD_LIGHT_ON, true );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// DoorManager has already retried; the command failed for good.
+//-----------------------------------------------------------------------------------------------------------------
+void SerialBenchmark::handleDoorCommError( QString sErrorMessage )
+{
+    Q_UNUSED(sErrorMessage);
+
+    finishDoorCommand( m_eDoorCommand, false );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialBenchmark::finishDoorCommand( eDoorControllerCommands eCommand, bool bSucceeded )
+{
+    if ( !m_bRunning || ( m_eDoorCommand == eDOOR_CMD_UNKNOWN ) )
+    {
+        return;
+    }
+
+    if ( !bSucceeded )
+    {
+        m_DoorStats.iErrors++;
+    }
+    else if ( eCommand != m_eDoorCommand )
+    {
+        m_DoorStats.iBadReplies++;
+    }
+    else
+    {
+        recordLatency( m_DoorStats, m_llDoorCommandStartNS );
+    }
+
+    m_eDoorCommand = eDOOR_CMD_UNKNOWN;
+    sendNextDoorCommand();
+    checkFinished();
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// One reading is one minute for CalibrationManager: the values it samples every minute are refreshed, every
+// BENCHMARK_READINGS_PER_FIFTEEN_MINUTES its stability and offset check runs, and once the temperature is stable
+// the compressor changes state every BENCHMARK_READINGS_PER_COMPRESSOR_PHASE readings.
+//-----------------------------------------------------------------------------------------------------------------
+void SerialBenchmark::runCalibrationStep( double dTemperature )
+{
+    qint64 llStartNS = m_Clock.nsecsElapsed();
+
+    m_iCalibrationSteps++;
+    m_CalibrationSource.setFlukeTemperature( dTemperature );
+    m_pCalibrationManager->slot_UpdateTemperatureValuesTimeout();
+
+    if ( ( m_pCalibrationManager->getCalibrationState() != eCALIBRATION_STATE_TEMPERATURE_UNSTABLE ) &&
+         ( m_iCalibrationSteps % BENCHMARK_READINGS_PER_COMPRESSOR_PHASE == 0 ) )
+    {
+        m_CalibrationSource.setCompressorState( !m_CalibrationSource.getCompressorState() );
+        m_pCalibrationManager->slot_CompressorStateCheckTimeout();
+    }
+
+    if ( m_iCalibrationSteps % BENCHMARK_READINGS_PER_FIFTEEN_MINUTES == 0 )
+    {
+        m_pCalibrationManager->slot_FifteenMinuteTimeout();
+    }
+
+    qint64 llElapsedNS = m_Clock.nsecsElapsed() - llStartNS;
+
+    m_llCalibrationTotalNS += llElapsedNS;
+    m_llCalibrationMaxNS = qMax( m_llCalibrationMaxNS, llElapsedNS );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialBenchmark::checkFinished( void )
+{
+    if ( ( m_FlukeStats.iSent < m_Config.iRequestsPerDevice ) || ( m_DoorStats.iSent < m_Config.iRequestsPerDevice ) ||
+         !m_FlukeRequestStartNS.isEmpty() || ( m_eDoorCommand != eDOOR_CMD_UNKNOWN ) )
+    {
+        return;
+    }
+
+    report();
+
+    m_bRunning = false;
+    m_iExitCode = ( ( m_FlukeStats.iCompleted == m_FlukeStats.iSent ) && ( m_DoorStats.iCompleted == m_DoorStats.iSent ) ) ? 0 : 1;
+    emit signalFinished( m_iExitCode );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void SerialBenchmark::report( void )
+{
+    double dElapsedS = ( m_Clock.nsecsElapsed() - m_llRunStartNS ) / 1.0E9;
+
+    printf( "\n%-16s %8s %8s %8s %8s %8s %10s %8s %8s %8s %8s\n",
+            "device", "sent", "ok", "timeout", "error", "bad", "req/s", "mean ms", "p50 ms", "p99 ms", "max ms" );
+
+    const DeviceStats * apStats[] = { &m_FlukeStats, &m_DoorStats };
+
+    for ( int iIndex = 0; iIndex < 2; iIndex++ )
+    {
+        const DeviceStats & stats = *apStats[iIndex];
+        double dMeanMS = ( stats.iCompleted > 0 ) ? ( stats.llTotalLatencyUS / 1000.0 / stats.iCompleted ) : 0.0;
+
+        printf( "%-16s %8d %8d %8d %8d %8d %10.1f %8.2f %8lld %8lld %8.2f\n",
+                qPrintable( stats.sName ),
+                stats.iSent,
+                stats.iCompleted,
+                stats.iTimeouts,
+                stats.iErrors,
+                stats.iBadReplies,
+                stats.iCompleted / dElapsedS,
+                dMeanMS,
+                (long long) stats.latency.getPercentileMS( 0.50 ),
+                (long long) stats.latency.getPercentileMS( 0.99 ),
+                stats.llMaxLatencyUS / 1000.0 );
+    }
+
+    printf( "\ncalibration: %d readings, mean %.1f us, max %.1f us, state %d, %d offset requests\n",
+            m_iCalibrationSteps,
+            ( m_iCalibrationSteps > 0 ) ? ( m_llCalibrationTotalNS / 1000.0 / m_iCalibrationSteps ) : 0.0,
+            m_llCalibrationMaxNS / 1000.0,
+            (int) m_pCalibrationManager->getCalibrationState(),
+            m_CalibrationSource.getCalibrationRequestCount() );
+
+    printf( "\nelapsed %.2f s\n", dElapsedS );
+    fflush( stdout );
+}
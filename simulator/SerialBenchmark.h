@@ -0,0 +1,141 @@
+#ifndef SERIALBENCHMARK_H
+#define SERIALBENCHMARK_H
+
+#include <QObject>
+#include <QHash>
+#include <QElapsedTimer>
+#include <QTimer>
+
+#include "SerialPortBroker.h"
+#include "SerialLatencyHistogram.h"
+#include "DoorControllerCodec.h"
+#include "DoorManager.h"
+#include "CalibrationManager.h"
+
+// each Fluke reading stands for one minute of the unit's life in the calibration run
+static const int BENCHMARK_READINGS_PER_FIFTEEN_MINUTES = 15;
+static const int BENCHMARK_READINGS_PER_COMPRESSOR_PHASE = 10;
+
+struct SerialBenchmarkConfig
+{
+    SerialBenchmarkConfig();
+
+    int iRequestsPerDevice;
+    int iPipelineDepth;         // Fluke requests kept queued in the broker; the door takes one command at a time
+    int iStartupTimeoutMS;
+};
+
+//-----------------------------------------------------------------------------------------------------------------
+// BenchmarkCalibrationSource - the unit as calibration sees it: the reference is the Fluke reading, and the
+// primary and control probes read it with a fixed error plus the offsets calibration has sent.
+//-----------------------------------------------------------------------------------------------------------------
+class BenchmarkCalibrationSource : public CalibrationDataSource
+{
+public:
+    BenchmarkCalibrationSource();
+
+    void setFlukeTemperature( double dTemperature );
+    void setCompressorState( bool bRunning );
+    int  getCalibrationRequestCount( void ) const;
+
+    void sendCalibrationRequest(eRTDNumber eRTDNum , double dRTDOffsetVal);
+
+    double getFlukeTemp1();
+    double getPrimaryTemp();
+    double getControlTemp();
+    double getPrimaryOffset();
+    double getControlOffset();
+    bool getCompressorState();
+    QString getDeviceType();
+
+private:
+    double m_dFlukeTemperature;
+    double m_dPrimaryOffset;
+    double m_dControlOffset;
+    bool   m_bCompressorState;
+    int    m_iCalibrationRequests;
+};
+
+//-----------------------------------------------------------------------------------------------------------------
+// SerialBenchmark - drives the Fluke through SerialPortBroker with the descriptor, frame extractor and reply
+// decoding the application uses, the door controller through DoorManager on the same broker, and feeds every
+// Fluke reading to CalibrationManager.  Reports throughput and round trip latency for both devices and the time
+// spent in calibration.
+//-----------------------------------------------------------------------------------------------------------------
+class SerialBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    SerialBenchmark( const QString & sFlukePort, const QString & sDoorPort, const SerialBenchmarkConfig & config,
+                     QObject *parent = 0 );
+
+    void start( void );
+    int  getExitCode( void ) const;
+
+signals:
+    void signalFinished( int iExitCode );
+
+private slots:
+    void handleDeviceConnected( int iDevice, QString sPortName );
+    void handleResponse( int iDevice, uint uiRequestID, QByteArray baResponse );
+    void handleTimeout( int iDevice, uint uiRequestID, QString sMessage );
+    void handleError( int iDevice, uint uiRequestID, QString sError );
+    void handleStartupTimeout( void );
+
+    void handleDoorUnlocked( void );
+    void handleDoorLocked( void );
+    void handleLightOff( void );
+    void handleLightOn( void );
+    void handleDoorCommError( QString sErrorMessage );
+
+private:
+
+    struct DeviceStats
+    {
+        DeviceStats();
+
+        QString                sName;
+        int                    iSent;
+        int                    iCompleted;
+        int                    iTimeouts;
+        int                    iErrors;
+        int                    iBadReplies;
+        qint64                 llTotalLatencyUS;
+        qint64                 llMaxLatencyUS;
+        SerialLatencyHistogram latency;
+    };
+
+    void sendNextFluke( void );
+    void sendNextDoorCommand( void );
+    void finishDoorCommand( eDoorControllerCommands eCommand, bool bSucceeded );
+    void recordLatency( DeviceStats & stats, qint64 llStartNS );
+    void runCalibrationStep( double dTemperature );
+    void checkFinished( void );
+    void report( void );
+
+    SerialPortBroker     m_Broker;
+    DoorManager          m_DoorManager;
+    SerialBenchmarkConfig m_Config;
+    int                  m_iFlukeDevice;
+    bool                 m_bFlukeConnected;
+    DeviceStats          m_FlukeStats;
+    DeviceStats          m_DoorStats;
+    QHash<uint, qint64>  m_FlukeRequestStartNS;
+    eDoorControllerCommands m_eDoorCommand;     // the one outstanding, eDOOR_CMD_UNKNOWN when none
+    qint64               m_llDoorCommandStartNS;
+
+    BenchmarkCalibrationSource m_CalibrationSource;
+    CalibrationManager * m_pCalibrationManager;
+    int                  m_iCalibrationSteps;
+    qint64               m_llCalibrationTotalNS;
+    qint64               m_llCalibrationMaxNS;
+
+    QElapsedTimer        m_Clock;
+    qint64               m_llRunStartNS;
+    QTimer               m_StartupTimer;
+    bool                 m_bRunning;
+    int                  m_iExitCode;
+};
+
+#endif // SERIALBENCHMARK_H
@@ -0,0 +1,142 @@
+#include <QCoreApplication>
+#include <QStringList>
+#include <QTime>
+
+#include <stdio.h>
+
+#include "PtyDevice.h"
+#include "FlukeSimulator.h"
+#include "DoorControllerSimulator.h"
+#include "SerialBenchmark.h"
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+static void printUsage( void )
+{
+    fprintf( stderr,
+             "Usage: iC3Simulator [options]\n"
+             "\n"
+             "  --fluke-link <path>     symlink to the Fluke pty          (default /tmp/ttyFLUKE)\n"
+             "  --door-link <path>      symlink to the door pty           (default /tmp/ttyDOOR)\n"
+             "  --temperature <C>       channel 101 temperature           (default 5.0)\n"
+             "  --noise <C>             reading noise std deviation       (default 0.02)\n"
+             "  --open-channel <n>      channel that reports an open TC   (default none)\n"
+             "  --fluke-latency <ms>    Fluke reply latency               (default 20)\n"
+             "  --door-latency <ms>     door controller ACK latency       (default 15)\n"
+             "  --jitter <ms>           +/- latency jitter for both       (default 5)\n"
+             "  --door-drop <%%>         door commands ignored             (default 0)\n"
+             "  --door-corrupt <%%>      door ACKs with a bad checksum     (default 0)\n"
+             "  --benchmark <n>         run n Fluke readings and n door commands through the client's\n"
+             "                          serial stack (DoorManager, CalibrationManager) and exit\n"
+             "  --pipeline <n>          benchmark Fluke requests kept queued (default 4)\n" );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// DoorManager and CalibrationManager log every command and reading with qDebug; during a benchmark that is
+// thousands of lines and the console becomes part of what is measured.
+//-----------------------------------------------------------------------------------------------------------------
+static void benchmarkMessageHandler( QtMsgType type, const QMessageLogContext & context, const QString & sMessage )
+{
+    Q_UNUSED(context);
+
+    if ( type != QtDebugMsg )
+    {
+        fprintf( stderr, "%s\n", qPrintable( sMessage ) );
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+
+    QString sFlukeLink("/tmp/ttyFLUKE");
+    QString sDoorLink("/tmp/ttyDOOR");
+    FlukeSimulatorConfig flukeConfig;
+    DoorControllerSimulatorConfig doorConfig;
+    SerialBenchmarkConfig benchmarkConfig;
+    bool bBenchmark = false;
+
+    QStringList args = a.arguments();
+    for ( int iIndex = 1; iIndex < args.size(); iIndex++ )
+    {
+        QString sOption = args.at( iIndex );
+
+        if ( ( sOption == "-h" ) || ( sOption == "--help" ) || ( iIndex + 1 >= args.size() ) )
+        {
+            printUsage();
+            return ( sOption == "-h" || sOption == "--help" ) ? 0 : 1;
+        }
+
+        QString sValue = args.at( ++iIndex );
+
+        if ( sOption == "--fluke-link" )            sFlukeLink = sValue;
+        else if ( sOption == "--door-link" )        sDoorLink = sValue;
+        else if ( sOption == "--temperature" )      flukeConfig.dBaseTemperature = sValue.toDouble();
+        else if ( sOption == "--noise" )            flukeConfig.dNoiseStdDev = sValue.toDouble();
+        else if ( sOption == "--open-channel" )     flukeConfig.iOpenChannel = sValue.toInt();
+        else if ( sOption == "--fluke-latency" )    flukeConfig.iLatencyMS = sValue.toInt();
+        else if ( sOption == "--door-latency" )     doorConfig.iLatencyMS = sValue.toInt();
+        else if ( sOption == "--jitter" )
+        {
+            flukeConfig.iJitterMS = sValue.toInt();
+            doorConfig.iJitterMS = sValue.toInt();
+        }
+        else if ( sOption == "--door-drop" )        doorConfig.iDropPercent = sValue.toInt();
+        else if ( sOption == "--door-corrupt" )     doorConfig.iCorruptPercent = sValue.toInt();
+        else if ( sOption == "--benchmark" )
+        {
+            bBenchmark = true;
+            benchmarkConfig.iRequestsPerDevice = sValue.toInt();
+        }
+        else if ( sOption == "--pipeline" )         benchmarkConfig.iPipelineDepth = sValue.toInt();
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    qsrand( QTime::currentTime().msec() );
+
+    PtyDevice flukePty;
+    PtyDevice doorPty;
+
+    if ( !flukePty.open( sFlukeLink ) )
+    {
+        fprintf( stderr, "%s\n", qPrintable( flukePty.getLastError() ) );
+        return 1;
+    }
+
+    if ( !doorPty.open( sDoorLink ) )
+    {
+        fprintf( stderr, "%s\n", qPrintable( doorPty.getLastError() ) );
+        return 1;
+    }
+
+    FlukeSimulator fluke( &flukePty, flukeConfig );
+    DoorControllerSimulator door( &doorPty, doorConfig );
+
+    printf( "Fluke simulator on %s (%s)\n", qPrintable( flukePty.getSlavePath() ), qPrintable( sFlukeLink ) );
+    printf( "Door controller simulator on %s (%s)\n", qPrintable( doorPty.getSlavePath() ), qPrintable( sDoorLink ) );
+    fflush( stdout );
+
+    if ( !bBenchmark )
+    {
+        return a.exec();
+    }
+
+    qInstallMessageHandler( benchmarkMessageHandler );
+
+    // use the pty paths directly - QSerialPort resolves symlinks differently between Qt versions
+    SerialBenchmark benchmark( flukePty.getSlavePath(), doorPty.getSlavePath(), benchmarkConfig );
+    QObject::connect( &benchmark, SIGNAL(signalFinished(int)), &a, SLOT(quit()) );
+
+    benchmark.start();
+    a.exec();
+
+    printf( "Fluke commands handled: %u, door commands handled: %u\n", fluke.getCommandCount(), door.getCommandCount() );
+
+    return benchmark.getExitCode();
+}
@@ -0,0 +1,42 @@
+#-------------------------------------------------
+#
+# Serial device simulator / benchmark for iC3SSLClient
+#
+# Creates pseudo-terminals that behave like the Fluke and the door/light
+# controller so the serial path can be exercised without the bench hardware.
+# Linux only (posix_openpt).
+#
+#-------------------------------------------------
+
+QT       += core serialport
+QT       -= gui
+
+TARGET = iC3Simulator
+CONFIG   += console
+CONFIG   -= app_bundle
+TEMPLATE = app
+
+INCLUDEPATH += ..
+
+SOURCES += main.cpp \
+        PtyDevice.cpp \
+        FlukeSimulator.cpp \
+        DoorControllerSimulator.cpp \
+        SerialBenchmark.cpp \
+        ../SerialPortBroker.cpp \
+        ../DoorManager.cpp \
+        ../CalibrationManager.cpp \
+        ../SerialLatencyHistogram.cpp \
+        ../DoorControllerCodec.cpp \
+        ../ScpiReplyDecoder.cpp
+
+HEADERS  += PtyDevice.h \
+            FlukeSimulator.h \
+            DoorControllerSimulator.h \
+            SerialBenchmark.h \
+            ../SerialPortBroker.h \
+            ../DoorManager.h \
+            ../CalibrationManager.h \
+            ../SerialLatencyHistogram.h \
+            ../DoorControllerCodec.h \
+            ../ScpiReplyDecoder.h
@@ -0,0 +1,29 @@
+#-------------------------------------------------
+#
+# Segment store check for iC3SSLClient
+#
+# Replays older samples through iC3_TransducerSegmentWriter the way the
+# spill journal does, across segment rotations, and checks that a reader
+# and a restarted writer still see the live samples written after them.
+#
+#-------------------------------------------------
+
+QT       += core testlib
+QT       -= gui
+
+TARGET = tst_segmentreplay
+CONFIG   += console testcase
+CONFIG   -= app_bundle
+TEMPLATE = app
+
+INCLUDEPATH += ../.. ../../database
+
+SOURCES += tst_segmentreplay.cpp \
+        ../../database/iC3_TransducerSegment.cpp \
+        ../../database/iC3_TransducerSegmentWriter.cpp \
+        ../../database/iC3_TransducerSegmentReader.cpp
+
+HEADERS  += ../../database/iC3_TransducerSegment.h \
+            ../../database/iC3_TransducerSegmentWriter.h \
+            ../../database/iC3_TransducerSegmentReader.h \
+            ../../database/iC3_TransducerSample.h
@@ -0,0 +1,181 @@
+#include <QtTest>
+#include <QTemporaryDir>
+
+#include "iC3_TransducerSegmentWriter.h"
+#include "iC3_TransducerSegmentReader.h"
+
+static const int    TEST_DEVICE_ID      = 3;
+static const qint64 TEST_START_TIME_MS  = Q_INT64_C(1800000000000);
+
+//-----------------------------------------------------------------------------------------------------------------
+// tst_SegmentReplay - samples replayed from the spill journal keep their older sequence indexes and times.  They
+// must not move the writer's sequence back, or a segment started during the replay is named before the live ones
+// and readers stop seeing the samples written to it.
+//-----------------------------------------------------------------------------------------------------------------
+class tst_SegmentReplay : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void replayAcrossRotationKeepsLiveSamplesVisible();
+    void unindexedSampleAfterReplayGetsNextIndex();
+    void restartAfterReplayContinuesSequence();
+
+private:
+    static iC3_TransducerSample makeSample( qint64 llSequenceIndex, qint64 llSampleTimeMS );
+    bool append( qint64 llSequenceIndex, qint64 llSampleTimeMS );
+    qint64 readLastSequenceIndex( iC3_TransducerSegmentReader & reader );
+    void writeLiveAndReplay( void );
+
+    QTemporaryDir * m_pStore;
+    iC3_TransducerSegmentWriter m_Writer;
+};
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void tst_SegmentReplay::init()
+{
+    m_pStore = new QTemporaryDir();
+    QVERIFY( m_pStore->isValid() );
+    QVERIFY( m_Writer.open( m_pStore->path() ) );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void tst_SegmentReplay::cleanup()
+{
+    m_Writer.close();
+    delete m_pStore;
+    m_pStore = NULL;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+iC3_TransducerSample tst_SegmentReplay::makeSample( qint64 llSequenceIndex, qint64 llSampleTimeMS )
+{
+    iC3_TransducerSample sample;
+
+    sample.llSequenceIndex = llSequenceIndex;
+    sample.iDeviceID = TEST_DEVICE_ID;
+    sample.llSampleTimeMS = llSampleTimeMS;
+
+    for ( int iRTD = 0; iRTD < TRANSDUCER_NUMBER_OF_RTDS; iRTD++ )
+    {
+        sample.adRTDValues[iRTD] = 4.0 + iRTD;
+    }
+
+    return sample;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+bool tst_SegmentReplay::append( qint64 llSequenceIndex, qint64 llSampleTimeMS )
+{
+    iC3_TransducerSample sample = makeSample( llSequenceIndex, llSampleTimeMS );
+
+    return m_Writer.append( sample ) && m_Writer.flush();
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+qint64 tst_SegmentReplay::readLastSequenceIndex( iC3_TransducerSegmentReader & reader )
+{
+    QVector<iC3_TransducerSample> samples;
+
+    if ( !reader.getLastEntries( TEST_DEVICE_ID, 1, samples ) || samples.isEmpty() )
+    {
+        return -1;
+    }
+
+    return samples.last().llSequenceIndex;
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+// live samples 101..110, then samples 5 and 6 spilled during an outage of more than a day are replayed: 5 starts a
+// new segment (it is older than the last record) and 6, a day later, rotates it while the replayed indexes are the
+// last written.  Live sample 111 goes to that segment.
+//-----------------------------------------------------------------------------------------------------------------
+void tst_SegmentReplay::writeLiveAndReplay( void )
+{
+    for ( int i = 0; i < 10; i++ )
+    {
+        QVERIFY( append( 101 + i, TEST_START_TIME_MS + i * 1000 ) );
+    }
+
+    QVERIFY( append( 5, TEST_START_TIME_MS - TRANSDUCER_SEGMENT_MAX_DURATION_MS - 3600000 ) );
+    QVERIFY( append( 6, TEST_START_TIME_MS - 3600000 ) );
+
+    QVERIFY( append( 111, TEST_START_TIME_MS + 10000 ) );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void tst_SegmentReplay::replayAcrossRotationKeepsLiveSamplesVisible()
+{
+    iC3_TransducerSegmentReader reader;
+    reader.setRootPath( m_pStore->path() );
+
+    writeLiveAndReplay();
+    if ( QTest::currentTestFailed() )
+    {
+        return;
+    }
+
+    QStringList asSegments = iC3_TransducerSegment::listSegments(
+        iC3_TransducerSegment::getDeviceDirectory( m_pStore->path(), TEST_DEVICE_ID ) );
+
+    QCOMPARE( asSegments.size(), 3 );
+    QCOMPARE( iC3_TransducerSegment::getFirstSequenceIndex( asSegments.last() ), Q_INT64_C(111) );
+    QCOMPARE( readLastSequenceIndex( reader ), Q_INT64_C(111) );
+
+    // the reader has seen the newest segment once; it must keep following it
+    QVERIFY( append( 112, TEST_START_TIME_MS + 11000 ) );
+    QCOMPARE( readLastSequenceIndex( reader ), Q_INT64_C(112) );
+
+    qint64 llLastSequenceIndex;
+    QVERIFY( m_Writer.getLastSequenceIndex( llLastSequenceIndex ) );
+    QCOMPARE( llLastSequenceIndex, Q_INT64_C(112) );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void tst_SegmentReplay::unindexedSampleAfterReplayGetsNextIndex()
+{
+    for ( int i = 0; i < 10; i++ )
+    {
+        QVERIFY( append( 101 + i, TEST_START_TIME_MS + i * 1000 ) );
+    }
+
+    QVERIFY( append( 5, TEST_START_TIME_MS + 10000 ) );
+
+    iC3_TransducerSample sample = makeSample( 0, TEST_START_TIME_MS + 11000 );
+    QVERIFY( m_Writer.append( sample ) );
+    QCOMPARE( sample.llSequenceIndex, Q_INT64_C(111) );
+}
+
+//-----------------------------------------------------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------------
+void tst_SegmentReplay::restartAfterReplayContinuesSequence()
+{
+    for ( int i = 0; i < 10; i++ )
+    {
+        QVERIFY( append( 101 + i, TEST_START_TIME_MS + i * 1000 ) );
+    }
+
+    // the replayed sample is the last record in the segment when the writer stops
+    QVERIFY( append( 5, TEST_START_TIME_MS + 10000 ) );
+
+    m_Writer.close();
+    QVERIFY( m_Writer.open( m_pStore->path() ) );
+
+    qint64 llLastSequenceIndex;
+    QVERIFY( m_Writer.getLastSequenceIndex( llLastSequenceIndex ) );
+    QCOMPARE( llLastSequenceIndex, Q_INT64_C(110) );
+}
+
+QTEST_APPLESS_MAIN(tst_SegmentReplay)
+
+#include "tst_segmentreplay.moc"